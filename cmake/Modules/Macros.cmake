@@ -101,3 +101,31 @@ macro(engine_add_library)
         set_target_properties(${THIS_TARGET} PROPERTIES FOLDER ${THIS_FOLDER})
     endif()
 endmacro()
+
+# Function to pack a data directory in a PackFile archive using the Packer tool
+function(engine_add_pack_archive)
+    set(one_val_args TARGET OUTPUT)
+    set(multi_val_args DIRECTORIES)
+
+    cmake_parse_arguments(THIS "${options}" "${one_val_args}" "${multi_val_args}" ${ARGN})
+
+    if(NOT THIS_TARGET)
+        message(FATAL_ERROR "TARGET argument not specified.")
+    endif()
+
+    if(NOT THIS_OUTPUT)
+        message(FATAL_ERROR "OUTPUT argument not specified.")
+    endif()
+
+    if(NOT THIS_DIRECTORIES)
+        message(FATAL_ERROR "DIRECTORIES argument not specified.")
+    endif()
+
+    add_custom_target(${THIS_TARGET}
+        COMMAND Packer "${THIS_OUTPUT}" ${THIS_DIRECTORIES}
+        DEPENDS Packer
+        COMMENT "Packing ${THIS_OUTPUT}"
+        VERBATIM
+    )
+    set_property(TARGET ${THIS_TARGET} PROPERTY FOLDER "Tools")
+endfunction(engine_add_pack_archive)
@@ -41,10 +41,14 @@ Main::Main(int argc, char* argv[])
     m_inputManager = std::make_unique<InputManager>();
     m_sceneManager = std::make_unique<SceneManager>();
     m_asyncTaskRunner = std::make_unique<AsyncTaskRunner>();
+    m_fileSystem->setTaskRunner(m_asyncTaskRunner.get());
+    m_inputManager->setTaskRunner(m_asyncTaskRunner.get());
 }
 
 Main::~Main() {
     shutdown();
+    m_fileSystem->setTaskRunner(nullptr);
+    m_inputManager->setTaskRunner(nullptr);
     m_asyncTaskRunner.reset();
     m_sceneManager.reset();
     m_inputManager.reset();
@@ -69,6 +73,10 @@ void Main::initialize(App* app) {
         // 2. Initialize the engine core subsystems
         LogManager::GetInstance().initialize();
         FileSystem::GetInstance().initialize();
+#ifdef ENGINE_DEBUG
+        // Reload the assets modified while the application is running
+        FileSystem::GetInstance().setFileWatchingEnabled(true);
+#endif
         SharedLibManager::GetInstance().initialize();
         InputManager::GetInstance().initialize();
 
@@ -112,6 +120,9 @@ void Main::run() {
         m_app->m_deltaTime = timer.getElapsedTime();
         timer.restart();
 
+        // The assets changed during the last frame are reloaded together
+        m_fileSystem->pollFileChanges();
+
         window.clear(Color::sBlack);
 
         m_app->update();
@@ -121,6 +132,7 @@ void Main::run() {
             activeScene->draw(window);
         }
 
+        TextureManager::GetInstance().advanceFrame();
         m_inputManager->advanceFrame();
         m_activeRenderer->advanceFrame();
     }
@@ -255,6 +267,10 @@ void Main::executeAsync(AsyncTaskRunner::Task&& task) {
     m_asyncTaskRunner->execute(std::move(task));
 }
 
+void Main::executeParallel(size_t count, const AsyncTaskRunner::IndexedTask& task) {
+    m_asyncTaskRunner->parallelFor(count, task);
+}
+
 void Main::initializePlugins() {
     for (auto& plugin : m_plugins) {
         plugin->initialize();
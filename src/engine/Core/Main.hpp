@@ -51,6 +51,12 @@ public:
 
     void executeAsync(Function<void()>&& task);
 
+    /**
+     * @brief Execute a task for each index in [0, count) using the
+     *        async workers, blocks until all of them are processed
+     */
+    void executeParallel(size_t count, const Function<void(size_t)>& task);
+
 private:
     /**
      * @brief Initialize all the loaded installed
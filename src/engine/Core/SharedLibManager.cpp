@@ -16,7 +16,7 @@ SharedLibManager::SharedLibManager() = default;
 SharedLibManager::~SharedLibManager() {
     // Unload & delete resources in turn
     for (auto& library : m_libraries) {
-        library.second.unload();
+        library.second->unload();
     }
     m_libraries.clear();
 }
@@ -26,21 +26,18 @@ void SharedLibManager::initialize() {}
 void SharedLibManager::shutdown() {}
 
 SharedLibrary* SharedLibManager::load(const StringView& name) {
-    auto it = std::find_if(m_libraries.begin(), m_libraries.end(), [&name](auto& pair) {
-        return pair.first == name;
-    });
-
+    auto it = m_libraries.find(name);
     if (it != m_libraries.end()) {
-        return &(it->second);
+        return it->second.get();
     }
 
-    SharedLibrary lib(name);
-    bool loaded = lib.load();
+    auto lib = std::make_unique<SharedLibrary>(name);
+    bool loaded = lib->load();
     if (loaded) {
-        auto result = m_libraries.emplace(name, std::move(lib));
-        return result.second ? &(result.first->second) : nullptr;
+        auto result = m_libraries.tryEmplace(String(name), std::move(lib));
+        return result.second ? result.first->second.get() : nullptr;
     }
-    LogError(sTag, lib.getErrorString());
+    LogError(sTag, lib->getErrorString());
     LogFatal(sTag, "Could not load SharedLibrary: {}", name);
 
     return nullptr;
@@ -4,9 +4,10 @@
 
 #include <System/SharedLibrary.hpp>
 #include <System/String.hpp>
+#include <Util/Container/FlatHashMap.hpp>
 #include <Util/Singleton.hpp>
 
-#include <map>
+#include <memory>
 
 namespace engine {
 
@@ -25,7 +26,9 @@ public:
     void unload(SharedLibrary* lib);
 
 private:
-    std::map<String, SharedLibrary> m_libraries;
+    // The libraries are allocated separately so the returned pointers
+    // stay valid when the map grows
+    FlatHashMap<String, std::unique_ptr<SharedLibrary>> m_libraries;
 };
 
 }  // namespace engine
@@ -1,19 +1,47 @@
 #include <Graphics/Image.hpp>
 #include <Graphics/ImageLoader.hpp>
 
+#include <utility>
+
 namespace engine {
 
-Image::Image() : m_size(0, 0), m_pixels(0) {}
+namespace {
+
+void NoopDeleter(void* /*unused*/) {}
+
+}  // namespace
+
+Image::Image() : m_size(0, 0), m_pixels(0), m_adoptedPixels(nullptr, &NoopDeleter) {}
+
+Image::Image(Image&& other) noexcept
+      : m_size(other.m_size),
+        m_pixels(std::move(other.m_pixels)),
+        m_adoptedPixels(std::move(other.m_adoptedPixels)) {
+    other.m_size = math::uvec2(0, 0);
+}
+
+Image::~Image() = default;
+
+Image& Image::operator=(Image&& other) noexcept {
+    m_size = other.m_size;
+    m_pixels = std::move(other.m_pixels);
+    m_adoptedPixels = std::move(other.m_adoptedPixels);
+    other.m_size = math::uvec2(0, 0);
+    return *this;
+}
 
 bool Image::loadFromFile(const String& filename) {
-    return io::ImageLoader::LoadFromFile(filename, m_pixels, m_size);
+    clear();
+    return io::ImageLoader::LoadFromFile(filename, *this);
 }
 
 bool Image::loadFromFileInMemory(const byte* buffer, uint32 len) {
-    return io::ImageLoader::LoadFromFileInMemory(buffer, len, m_pixels, m_size);
+    clear();
+    return io::ImageLoader::LoadFromFileInMemory(buffer, len, *this);
 }
 
 bool Image::loadFromMemory(const Color32* colorMap, uint32 width, uint32 height) {
+    clear();
     m_size.x = width;
     m_size.y = height;
     const byte* data = reinterpret_cast<const byte*>(colorMap);
@@ -21,10 +49,17 @@ bool Image::loadFromMemory(const Color32* colorMap, uint32 width, uint32 height)
     return true;
 }
 
+void Image::adopt(byte* pixels, const math::uvec2& size, PixelsDeleter deleter) {
+    clear();
+    m_size = size;
+    m_adoptedPixels = std::unique_ptr<byte, PixelsDeleter>(pixels, deleter ? deleter : &NoopDeleter);
+}
+
 void Image::clear() {
     m_size.x = 0;
     m_size.y = 0;
     m_pixels.clear();
+    m_adoptedPixels.reset();
 }
 
 const math::uvec2& Image::getSize() const {
@@ -32,11 +67,11 @@ const math::uvec2& Image::getSize() const {
 }
 
 byte* Image::getData() {
-    return m_pixels.data();
+    return m_adoptedPixels ? m_adoptedPixels.get() : m_pixels.data();
 }
 
 const byte* Image::getData() const {
-    return m_pixels.data();
+    return m_adoptedPixels ? m_adoptedPixels.get() : m_pixels.data();
 }
 
 size_t Image::getDataSize() const {
@@ -7,11 +7,23 @@
 #include <System/String.hpp>
 #include <Util/Container/Vector.hpp>
 
+#include <memory>
+
 namespace engine {
 
 class ENGINE_API Image {
 public:
+    using PixelsDeleter = void (*)(void*);
+
     Image();
+    Image(Image&& other) noexcept;
+
+    ~Image();
+
+    Image& operator=(Image&& other) noexcept;
+
+    Image(const Image& other) = delete;
+    Image& operator=(const Image& other) = delete;
 
     bool loadFromFile(const String& filename);
 
@@ -19,6 +31,17 @@ public:
 
     bool loadFromMemory(const Color32* colorMap, uint32 width, uint32 height);
 
+    /**
+     * @brief Take the ownership of an already decoded RGBA buffer
+     *        without copying it
+     *
+     * @param pixels The RGBA pixels, must contain width * height * 4 bytes
+     * @param size The size of the image in pixels
+     * @param deleter Function used to release the pixels once the Image
+     *                is cleared or destroyed
+     */
+    void adopt(byte* pixels, const math::uvec2& size, PixelsDeleter deleter);
+
     void clear();
 
     const math::Vector2<uint32>& getSize() const;
@@ -31,6 +54,7 @@ public:
 private:
     math::Vector2<uint32> m_size;
     Vector<byte> m_pixels;
+    std::unique_ptr<byte, PixelsDeleter> m_adoptedPixels;
 };
 
 }  // namespace engine
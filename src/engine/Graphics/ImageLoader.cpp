@@ -1,9 +1,10 @@
+#include <Graphics/Image.hpp>
 #include <Graphics/ImageLoader.hpp>
 
 #include <System/FileSystem.hpp>
 #include <System/LogManager.hpp>
+#include <System/MappedFile.hpp>
 #include <System/StringView.hpp>
-#include <Util/Container/Vector.hpp>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
@@ -14,43 +15,40 @@ namespace {
 
 const StringView sTag("ImageLoader");
 
+void FreeStbPixels(void* pixels) {
+    stbi_image_free(pixels);
+}
+
+bool AdoptDecodedPixels(byte* data, int width, int height, Image& image) {
+    if (data == nullptr) {
+        LogError(sTag, "STB_Image error: {}", stbi_failure_reason());
+        return false;
+    }
+    image.adopt(data, math::uvec2(static_cast<uint32>(width), static_cast<uint32>(height)), &FreeStbPixels);
+    return true;
+}
+
 }  // namespace
 
 namespace io {
 
-bool ImageLoader::LoadFromFile(const String& filename, Vector<byte>& pixels, math::uvec2& size) {
-    Vector<byte> out;
-    FileSystem& fs = FileSystem::GetInstance();
-    if (fs.loadFileData(filename, &out)) {
-        return LoadFromFileInMemory(out.data(), static_cast<uint32>(out.size()), pixels, size);
+bool ImageLoader::LoadFromFile(const String& filename, Image& image) {
+    // The decoder reads the file directly from the mapping, without
+    // copying it to an intermediate buffer
+    MappedFile file;
+    if (!FileSystem::GetInstance().mapFile(filename, &file, MappedFile::Advice::SEQUENTIAL)) {
+        LogError(sTag, "Error opening image: {}", filename);
+        return false;
     }
-    return false;
+    return LoadFromFileInMemory(file.getData(), static_cast<uint32>(file.getSize()), image);
 }
 
-bool ImageLoader::LoadFromFileInMemory(const byte* buffer, uint32 len, Vector<byte>& pixels, math::uvec2& size) {
+bool ImageLoader::LoadFromFileInMemory(const byte* buffer, uint32 len, Image& image) {
     int width;
     int height;
     int comp;
-
-    byte* data = stbi_load_from_memory(buffer, len, &width, &height, &comp, STBI_rgb_alpha);
-
-    if (data != nullptr) {
-        size_t numPixels = width * height;
-        size_t dataSize = (numPixels * STBI_rgb_alpha);
-        byte* dataEnd = data + dataSize;
-        pixels.assign(data, dataEnd);
-    } else {
-        String error = String("STB_Image error: ") + stbi_failure_reason();
-        LogError(sTag, error);
-        stbi_image_free(data);
-        return false;
-    }
-
-    size.x = static_cast<uint32>(width);
-    size.y = static_cast<uint32>(height);
-
-    stbi_image_free(data);
-    return true;
+    byte* data = stbi_load_from_memory(buffer, static_cast<int>(len), &width, &height, &comp, STBI_rgb_alpha);
+    return AdoptDecodedPixels(data, width, height, image);
 }
 
 }  // namespace io
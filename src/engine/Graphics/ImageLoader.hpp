@@ -2,19 +2,27 @@
 
 #include <Util/Prerequisites.hpp>
 
-#include <Math/Math.hpp>
 #include <System/String.hpp>
-#include <Util/Container/Vector.hpp>
 
 namespace engine {
 
+class Image;
+
 namespace io {
 
 class ENGINE_API ImageLoader {
 public:
-    static bool LoadFromFile(const String& filename, Vector<byte>& pixels, math::uvec2& size);
-
-    static bool LoadFromFileInMemory(const byte* buffer, uint32 len, Vector<byte>& pixels, math::uvec2& size);
+    /**
+     * @brief Decode an image file mapped from the file system, the
+     *        decoded pixels are adopted by the Image
+     */
+    static bool LoadFromFile(const String& filename, Image& image);
+
+    /**
+     * @brief Decode an image from an encoded buffer, the decoded
+     *        pixels are adopted by the Image
+     */
+    static bool LoadFromFileInMemory(const byte* buffer, uint32 len, Image& image);
 };
 
 }  // namespace io
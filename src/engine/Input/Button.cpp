@@ -2,33 +2,50 @@
 
 namespace engine {
 
-Button::Button() : m_isDown(false) {
-    advanceFrame();
+ButtonStates::ButtonStates() = default;
+
+void ButtonStates::advanceFrame() {
+    m_wentDown.reset();
+    m_wentUp.reset();
 }
 
-bool Button::isDown() const {
-    return m_isDown;
+void ButtonStates::update(size_t index, bool down) {
+    if (index >= sButtonCount) {
+        return;
+    }
+    bool isDown = m_isDown[index];
+    if (!isDown && down) {
+        m_wentDown[index] = true;
+    } else if (isDown && !down) {
+        m_wentUp[index] = true;
+    }
+    m_isDown[index] = down;
 }
 
-bool Button::wentDown() const {
-    return m_wentDown;
+bool ButtonStates::isDown(size_t index) const {
+    return index < sButtonCount && m_isDown[index];
 }
 
-bool Button::wentUp() const {
-    return m_wentUp;
+bool ButtonStates::wentDown(size_t index) const {
+    return index < sButtonCount && m_wentDown[index];
 }
 
-void Button::advanceFrame() {
-    m_wentDown = m_wentUp = false;
+bool ButtonStates::wentUp(size_t index) const {
+    return index < sButtonCount && m_wentUp[index];
 }
 
-void Button::update(bool down) {
-    if (!m_isDown && down) {
-        m_wentDown = true;
-    } else if (m_isDown && !down) {
-        m_wentUp = true;
-    }
-    m_isDown = down;
+Button::Button(const ButtonStates& states, size_t index) : m_states(states), m_index(index) {}
+
+bool Button::isDown() const {
+    return m_states.isDown(m_index);
+}
+
+bool Button::wentDown() const {
+    return m_states.wentDown(m_index);
+}
+
+bool Button::wentUp() const {
+    return m_states.wentUp(m_index);
 }
 
 }  // namespace engine
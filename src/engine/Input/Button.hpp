@@ -2,12 +2,14 @@
 
 #include <Util/Prerequisites.hpp>
 
+#include <bitset>
+
 namespace engine {
 
 // This enum extends the SDL_Keycode (an int) which represent all keyboard
 // keys using positive values. Negative values will represent finger / mouse
 // and gamepad buttons.
-// `button_map` bellow maps from one of these values to a Button.
+// ButtonStates bellow stores the state of all of them.
 enum {
     SDLK_POINTER1 = -10,  // Left mouse or first finger down.
     SDLK_POINTER2,        // Right mouse or second finger.
@@ -30,12 +32,63 @@ enum {
 
 class InputManager;
 
+/**
+ * @brief State of all the buttons, stored as bitsets indexed by a
+ *        dense button index
+ *
+ * @details The indices are assigned by the InputManager: first the
+ *          pointer and gamepad buttons, then the keys that produce an
+ *          ASCII character and then the rest of keys by scancode.
+ *          Clearing the per-frame state only clears a few words.
+ */
+class ENGINE_API ButtonStates {
+public:
+    // Pointer and gamepad buttons, the negative values of the enum above
+    static constexpr size_t sSpecialButtonCount = 20;
+    // The keycode of the keys that produce an ASCII character
+    static constexpr size_t sCharacterKeyCount = 128;
+    // Same as SDL_NUM_SCANCODES
+    static constexpr size_t sScancodeKeyCount = 512;
+
+    static constexpr size_t sButtonCount = sSpecialButtonCount + sCharacterKeyCount + sScancodeKeyCount;
+
+    // Index of the buttons that are not tracked, they are never down
+    static constexpr size_t sInvalidIndex = sButtonCount;
+
+    ButtonStates();
+
+    /**
+     * @brief Clear the buttons that went down or up in the last frame
+     */
+    void advanceFrame();
+
+    /**
+     * @brief Set if a button is down
+     *
+     * @param index The button index, it is ignored if invalid
+     * @param down true if the button is down
+     */
+    void update(size_t index, bool down);
+
+    bool isDown(size_t index) const;
+
+    bool wentDown(size_t index) const;
+
+    bool wentUp(size_t index) const;
+
+private:
+    std::bitset<sButtonCount> m_isDown;
+    std::bitset<sButtonCount> m_wentDown;
+    std::bitset<sButtonCount> m_wentUp;
+};
+
+/**
+ * @brief View of the state of a button in the current frame
+ */
 class ENGINE_API Button {
     friend class InputManager;
 
 public:
-    Button();
-
     bool isDown() const;
 
     bool wentDown() const;
@@ -43,13 +96,10 @@ public:
     bool wentUp() const;
 
 private:
-    void advanceFrame();
-
-    void update(bool down);
+    Button(const ButtonStates& states, size_t index);
 
-    bool m_isDown;
-    bool m_wentDown;
-    bool m_wentUp;
+    const ButtonStates& m_states;
+    size_t m_index;
 };
 
 }  // namespace engine
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <Math/Math.hpp>
+
+namespace engine {
+
+/**
+ * @brief Posted when the window is resized, only the last size of the
+ *        consecutive resizes is delivered
+ */
+struct WindowResizedEvent {
+    math::ivec2 size;
+
+    bool coalesce(const WindowResizedEvent& next) {
+        size = next.size;
+        return true;
+    }
+};
+
+struct WindowMinimizedEvent {};
+
+struct WindowRestoredEvent {};
+
+struct AppWillEnterBackgroundEvent {};
+
+struct AppDidEnterBackgroundEvent {};
+
+struct AppWillEnterForegroundEvent {};
+
+struct AppDidEnterForegroundEvent {};
+
+/**
+ * @brief Posted when a key is pressed or released
+ */
+struct KeyEvent {
+    int key;
+    bool pressed;
+};
+
+/**
+ * @brief Posted when a mouse button is pressed or released
+ */
+struct MouseButtonEvent {
+    // Code of the button, SDLK_POINTER1 is the left button
+    int button;
+    math::ivec2 position;
+    bool pressed;
+};
+
+/**
+ * @brief Posted when the mouse moves, the consecutive movements are
+ *        merged into a single event
+ */
+struct MouseMotionEvent {
+    math::ivec2 position;
+    math::ivec2 delta;
+
+    bool coalesce(const MouseMotionEvent& next) {
+        position = next.position;
+        delta += next.delta;
+        return true;
+    }
+};
+
+/**
+ * @brief Posted when the mouse wheel is scrolled, the consecutive
+ *        scrolls are merged into a single event
+ */
+struct MouseWheelEvent {
+    math::ivec2 delta;
+
+    bool coalesce(const MouseWheelEvent& next) {
+        delta += next.delta;
+        return true;
+    }
+};
+
+}  // namespace engine
@@ -26,6 +26,31 @@ int EngineEventFilter(void* userdata, SDL_Event* event) {
     return 1;
 }
 
+static_assert(ButtonStates::sScancodeKeyCount == SDL_NUM_SCANCODES, "The scancodes don't fit in ButtonStates");
+
+size_t GetScancodeIndex(SDL_Scancode scancode) {
+    if (scancode <= SDL_SCANCODE_UNKNOWN || scancode >= SDL_NUM_SCANCODES) {
+        return ButtonStates::sInvalidIndex;
+    }
+    return ButtonStates::sSpecialButtonCount + ButtonStates::sCharacterKeyCount + static_cast<size_t>(scancode);
+}
+
+size_t GetButtonIndex(int button) {
+    if (button < 0) {
+        // The gamepad buttons start at -20 and the pointers end at -1
+        int index = button + static_cast<int>(ButtonStates::sSpecialButtonCount);
+        return (index >= 0) ? static_cast<size_t>(index) : ButtonStates::sInvalidIndex;
+    }
+    if (static_cast<size_t>(button) < ButtonStates::sCharacterKeyCount) {
+        return ButtonStates::sSpecialButtonCount + static_cast<size_t>(button);
+    }
+    if ((button & SDLK_SCANCODE_MASK) != 0) {
+        return GetScancodeIndex(static_cast<SDL_Scancode>(button & ~SDLK_SCANCODE_MASK));
+    }
+    // Keys that produce other characters, depending on the keyboard layout
+    return GetScancodeIndex(SDL_GetScancodeFromKey(button));
+}
+
 }  // namespace
 
 InputManager::InputManager()
@@ -47,21 +72,22 @@ void InputManager::shutdown() {
     SDL_QuitSubSystem(SDL_INIT_GAMECONTROLLER);
 }
 
-Button& InputManager::getButton(int button) {
-    auto it = m_buttonMap.find(button);
-    return it != m_buttonMap.end() ? it->second : (m_buttonMap[button] = Button());
+void InputManager::setTaskRunner(AsyncTaskRunner* taskRunner) {
+    m_eventBus.setTaskRunner(taskRunner);
+}
+
+Button InputManager::getButton(int button) const {
+    return Button(m_buttonStates, GetButtonIndex(button));
 }
 
-Button& InputManager::getPointerButton(int64 pointer) {
+Button InputManager::getPointerButton(int64 pointer) const {
     return getButton(static_cast<int>(pointer + SDLK_POINTER1));
 }
 
 void InputManager::advanceFrame() {
     // Reset our per-frame input state.
     m_mousewheelDelta.x = m_mousewheelDelta.y = 0;
-    for (auto& button : m_buttonMap) {
-        button.second.advanceFrame();
-    }
+    m_buttonStates.advanceFrame();
     for (auto& pointer : m_pointers) {
         pointer.mousedelta.x = pointer.mousedelta.y = 0;
     }
@@ -77,34 +103,33 @@ void InputManager::advanceFrame() {
             case SDL_APP_LOWMEMORY:
                 break;
             case SDL_APP_WILLENTERBACKGROUND: {
-                onAppWillEnterBackground.emit();
+                m_eventBus.post(AppWillEnterBackgroundEvent());
                 break;
             }
             case SDL_APP_DIDENTERBACKGROUND: {
-                onAppDidEnterBackground.emit();
+                m_eventBus.post(AppDidEnterBackgroundEvent());
                 break;
             }
             case SDL_APP_WILLENTERFOREGROUND: {
-                onAppWillEnterForeground.emit();
+                m_eventBus.post(AppWillEnterForegroundEvent());
                 break;
             }
             case SDL_APP_DIDENTERFOREGROUND: {
-                onAppDidEnterForeground.emit();
+                m_eventBus.post(AppDidEnterForegroundEvent());
                 break;
             }
             case SDL_WINDOWEVENT: {
                 switch (event.window.event) {
                     case SDL_WINDOWEVENT_RESIZED: {
-                        math::ivec2 windowSize(event.window.data1, event.window.data2);
-                        onWindowResized.emit(windowSize);
+                        m_eventBus.post(WindowResizedEvent{math::ivec2(event.window.data1, event.window.data2)});
                         break;
                     }
                     case SDL_WINDOWEVENT_MINIMIZED: {
-                        onWindowMinimized.emit();
+                        m_eventBus.post(WindowMinimizedEvent());
                         break;
                     }
                     case SDL_WINDOWEVENT_RESTORED: {
-                        onWindowRestored.emit();
+                        m_eventBus.post(WindowRestoredEvent());
                         break;
                     }
                 }
@@ -114,7 +139,9 @@ void InputManager::advanceFrame() {
                 break;
             case SDL_KEYDOWN:
             case SDL_KEYUP: {
-                getButton(event.key.keysym.sym).update(event.key.state == SDL_PRESSED);
+                bool pressed = event.key.state == SDL_PRESSED;
+                m_buttonStates.update(GetButtonIndex(event.key.keysym.sym), pressed);
+                m_eventBus.post(KeyEvent{event.key.keysym.sym, pressed});
                 break;
             }
             case SDL_TEXTEDITING:
@@ -122,19 +149,26 @@ void InputManager::advanceFrame() {
             case SDL_KEYMAPCHANGED:
                 break;
             case SDL_MOUSEMOTION: {
-                m_pointers[0].mousedelta += math::ivec2(event.motion.xrel, event.motion.yrel);
-                m_pointers[0].mousepos = math::ivec2(event.button.x, event.button.y);
+                math::ivec2 delta(event.motion.xrel, event.motion.yrel);
+                m_pointers[0].mousedelta += delta;
+                m_pointers[0].mousepos = math::ivec2(event.motion.x, event.motion.y);
+                m_eventBus.post(MouseMotionEvent{m_pointers[0].mousepos, delta});
                 break;
             }
             case SDL_MOUSEBUTTONDOWN:
             case SDL_MOUSEBUTTONUP: {
-                getPointerButton(event.button.button - 1).update(event.button.state == SDL_PRESSED);
+                int button = event.button.button - 1 + SDLK_POINTER1;
+                bool pressed = event.button.state == SDL_PRESSED;
+                m_buttonStates.update(GetButtonIndex(button), pressed);
                 m_pointers[0].mousepos = math::ivec2(event.button.x, event.button.y);
                 m_pointers[0].used = true;
+                m_eventBus.post(MouseButtonEvent{button, m_pointers[0].mousepos, pressed});
                 break;
             }
             case SDL_MOUSEWHEEL: {
-                m_mousewheelDelta += math::ivec2(event.wheel.x, event.wheel.y);
+                math::ivec2 delta(event.wheel.x, event.wheel.y);
+                m_mousewheelDelta += delta;
+                m_eventBus.post(MouseWheelEvent{delta});
                 break;
             }
             case SDL_JOYAXISMOTION:
@@ -172,6 +206,9 @@ void InputManager::advanceFrame() {
             }
         }
     }
+
+    // The handlers are called once all the SDL events are processed
+    m_eventBus.dispatch();
 }
 
 }  // namespace engine
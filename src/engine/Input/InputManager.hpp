@@ -3,21 +3,22 @@
 #include <Util/Prerequisites.hpp>
 
 #include <Input/Button.hpp>
+#include <Input/InputEvents.hpp>
 #include <Input/Mouse.hpp>
 #include <Input/Pointer.hpp>
 #include <Math/Math.hpp>
+#include <System/EventBus.hpp>
 #include <Util/Container/Vector.hpp>
 #include <Util/Singleton.hpp>
 
-#include <System/Signal.hpp>
-
-#include <map>
 #include <memory>
 
 union SDL_Event;
 
 namespace engine {
 
+class AsyncTaskRunner;
+
 class ENGINE_API InputManager : public Singleton<InputManager> {
 public:
     // All current touch screens.
@@ -31,11 +32,33 @@ public:
 
     void shutdown();
 
+    /**
+     * @brief Set the workers used to call the thread-safe event handlers
+     *
+     * @param taskRunner The workers, or nullptr to call all the
+     *                   handlers in the main thread
+     */
+    void setTaskRunner(AsyncTaskRunner* taskRunner);
+
+    /**
+     * @brief Process the input received since the last frame
+     *
+     * @details The window, application and input events are posted to
+     *          the event bus while the SDL events are polled, and then
+     *          dispatched together
+     */
     void advanceFrame();
 
-    Button& getButton(int button);
+    /**
+     * @brief Get the state of a button
+     *
+     * @param button The SDL_Keycode of a key, or one of the pointer or
+     *               gamepad buttons declared in Button.hpp
+     * @return The state of the button in the current frame
+     */
+    Button getButton(int button) const;
 
-    Button& getPointerButton(int64 pointer);
+    Button getPointerButton(int64 pointer) const;
 
     Mouse& getMouse() {
         static std::unique_ptr<Mouse> sMouseInstance(new Mouse(m_pointers[0]));
@@ -46,19 +69,18 @@ public:
         return m_exitRequested;
     }
 
-    Signal<const math::ivec2&> onWindowResized;
-    Signal<> onWindowMinimized;
-    Signal<> onWindowRestored;
-
-    Signal<> onAppWillEnterBackground;
-    Signal<> onAppDidEnterBackground;
-    Signal<> onAppWillEnterForeground;
-    Signal<> onAppDidEnterForeground;
+    /**
+     * @brief Get the bus of the events declared in InputEvents.hpp
+     */
+    EventBus& getEventBus() {
+        return m_eventBus;
+    }
 
 private:
     bool m_exitRequested;
+    EventBus m_eventBus;
     Vector<Pointer> m_pointers;
-    std::map<int, Button> m_buttonMap;
+    ButtonStates m_buttonStates;
     math::ivec2 m_mousewheelDelta;
 };
 
@@ -1,5 +1,6 @@
 #include "Renderer/Mesh.hpp"
 
+#include <System/SlabAllocator.hpp>
 #include <System/StringView.hpp>
 #include <Util/Container/Vector.hpp>
 
@@ -9,12 +10,25 @@ namespace {
 
 // const StringView sTag("Mesh");
 
+SlabAllocator& GetMeshAllocator() {
+    static SlabAllocator sMeshAllocator("Mesh", 128);
+    return sMeshAllocator;
+}
+
 }  // namespace
 
 Mesh::Mesh() = default;
 
 Mesh::~Mesh() = default;
 
+void* Mesh::operator new(size_t size) {
+    return GetMeshAllocator().allocate(size);
+}
+
+void Mesh::operator delete(void* pointer, size_t size) {
+    GetMeshAllocator().deallocate(pointer, size);
+}
+
 const Vector<Vertex>& Mesh::getVertices() {
     return m_vertices;
 }
@@ -23,4 +37,8 @@ const Vector<uint32>& Mesh::getIndices() {
     return m_indices;
 }
 
+const MeshTextures& Mesh::getTextures() const {
+    return m_textures;
+}
+
 }  // namespace engine
@@ -3,41 +3,62 @@
 #include <Util/Prerequisites.hpp>
 
 #include <Renderer/RenderWindow.hpp>
+#include <Renderer/Texture2D.hpp>
 #include <Renderer/TextureType.hpp>
 #include <Renderer/Transform.hpp>
 #include <Renderer/Vertex.hpp>
+#include <Util/Container/SmallVector.hpp>
 #include <Util/Container/Vector.hpp>
+#include <Util/Handle.hpp>
 
 #include <map>
 #include <utility>
 
 namespace engine {
 
-class Texture2D;
 class RenderStates;
 
+// A mesh has one texture of each type, so they are always stored inline
+using MeshTextures = SmallVector<std::pair<TextureHandle, TextureType>, 4>;
+
 class ENGINE_API Mesh {
+    friend class ModelManager;
+
 public:
     Mesh();
 
     virtual ~Mesh();
 
-    virtual void loadFromData(Vector<Vertex> vertices,
-                              Vector<uint32> indices,
-                              Vector<std::pair<Texture2D*, TextureType>> textures) = 0;
+    /**
+     * @brief The meshes of all the renderers are allocated from the same
+     *        SlabAllocator, so they are contiguous in memory
+     */
+    static void* operator new(size_t size);
+
+    static void operator delete(void* pointer, size_t size);
+
+    virtual void loadFromData(Vector<Vertex> vertices, Vector<uint32> indices, MeshTextures textures) = 0;
 
     virtual void draw(RenderWindow& target, const RenderStates& states) const = 0;
 
-    void setTexture(TextureType type, Texture2D* texture);
+    void setTexture(TextureType type, TextureHandle texture);
 
     const Vector<Vertex>& getVertices();
     const Vector<uint32>& getIndices();
+    const MeshTextures& getTextures() const;
 
 protected:
     Vector<Vertex> m_vertices;
     Vector<uint32> m_indices;
-    Vector<std::pair<Texture2D*, TextureType>> m_textures;
-    std::map<TextureType, Texture2D*> m_texturesMap;
+    MeshTextures m_textures;
+    std::map<TextureType, TextureHandle> m_texturesMap;
+
+private:
+    // Content hash and number of models sharing the mesh, managed by the ModelManager
+    uint64 m_contentHash = 0;
+    uint32 m_refCount = 0;
 };
 
+using MeshHandle = Handle<Mesh>;
+
 }  // namespace engine
@@ -1,13 +1,15 @@
 #include <Renderer/Model.hpp>
 
 #include <Core/Main.hpp>
+#include <Renderer/ModelManager.hpp>
 #include <Renderer/RenderStates.hpp>
 #include <Renderer/Texture2D.hpp>
 #include <Renderer/TextureManager.hpp>
 #include <System/FileSystem.hpp>
 #include <System/IOStream.hpp>
-#include <System/JSON.hpp>
 #include <System/LogManager.hpp>
+#include <System/MappedFile.hpp>
+#include <System/SlabAllocator.hpp>
 #include <System/StringFormat.hpp>
 #include <System/StringView.hpp>
 #include <Util/Container/Vector.hpp>
@@ -18,10 +20,13 @@
 #include <assimp/IOSystem.hpp>
 #include <assimp/Importer.hpp>
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <utility>
 
+#include <cstring>
+
 namespace engine {
 
 namespace {
@@ -35,15 +40,15 @@ class CustomAssimpIOStream : public Assimp::IOStream {
 
 protected:
     // Constructor protected for private usage by CustomAssimpIOSystem
-    CustomAssimpIOStream(const char* pFile, const char* pMode) {
+    CustomAssimpIOStream(const char* pFile, const char* pMode) : m_position(0) {
+        // Open through the FileSystem so the files inside archives are
+        // found, the files that are only read are mapped
         FileSystem& fs = FileSystem::GetInstance();
-        for (const String& path : fs.getSearchPaths()) {
-            String filePath = fs.join(path, pFile);
-            if (m_file.open(filePath.getData(), pMode)) {
-                break;
-            }
+        bool isReadOnly = std::strpbrk(pMode, "wa+") == nullptr;
+        if (isReadOnly && fs.mapFile(pFile, &m_mappedFile, MappedFile::Advice::SEQUENTIAL)) {
+            return;
         }
-        if (!m_file.isOpen()) {
+        if (!fs.openFile(pFile, pMode, &m_file)) {
             LogError("CustomAssimpIOStream", "Could not open file {}", pFile);
         }
     }
@@ -54,7 +59,16 @@ public:
     }
 
     size_t Read(void* pvBuffer, size_t pSize, size_t pCount) override {
-        return m_file.read(pvBuffer, pSize, pCount);
+        if (!m_mappedFile.isOpen()) {
+            return m_file.read(pvBuffer, pSize, pCount);
+        }
+        if (pSize == 0) {
+            return 0;
+        }
+        size_t count = std::min(pCount, (m_mappedFile.getSize() - m_position) / pSize);
+        std::memcpy(pvBuffer, m_mappedFile.getData() + m_position, count * pSize);
+        m_position += count * pSize;
+        return count;
     }
 
     size_t Write(const void* pvBuffer, size_t pSize, size_t pCount) override {
@@ -62,16 +76,30 @@ public:
     }
 
     aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override {
-        int64 ret = m_file.seek(pOffset, static_cast<engine::IOStream::Origin>(pOrigin));
-        return static_cast<aiReturn>(ret);
+        if (!m_mappedFile.isOpen()) {
+            int64 ret = m_file.seek(pOffset, static_cast<engine::IOStream::Origin>(pOrigin));
+            return static_cast<aiReturn>(ret);
+        }
+        // Negative offsets wrap around, same as the default Assimp stream
+        size_t position = pOffset;
+        if (pOrigin == aiOrigin_CUR) {
+            position = m_position + pOffset;
+        } else if (pOrigin == aiOrigin_END) {
+            position = m_mappedFile.getSize() + pOffset;
+        }
+        if (position > m_mappedFile.getSize()) {
+            return aiReturn_FAILURE;
+        }
+        m_position = position;
+        return aiReturn_SUCCESS;
     }
 
     size_t Tell() const override {
-        return static_cast<size_t>(m_file.tell());
+        return m_mappedFile.isOpen() ? m_position : static_cast<size_t>(m_file.tell());
     }
 
     size_t FileSize() const override {
-        return m_file.getSize();
+        return m_mappedFile.isOpen() ? m_mappedFile.getSize() : m_file.getSize();
     }
 
     void Flush() override {
@@ -80,6 +108,8 @@ public:
 
 private:
     engine::IOStream m_file;
+    MappedFile m_mappedFile;
+    size_t m_position;
 };
 
 class CustomAssimpIOSystem : public Assimp::IOSystem {
@@ -146,27 +176,64 @@ TextureType GetTextureTypeFromAiTextureType(aiTextureType type) {
     }
 }
 
+SlabAllocator& GetModelAllocator() {
+    static SlabAllocator sModelAllocator("Model", 64);
+    return sModelAllocator;
+}
+
 }  // namespace
 
-Model::Model() = default;
+Model::Model() : m_refCount(0) {}
 
-Model::~Model() {
-    for (auto& mesh : m_meshes) {
-        mesh.reset();
-    }
+Model::~Model() = default;
+
+void* Model::operator new(size_t size) {
+    return GetModelAllocator().allocate(size);
+}
+
+void Model::operator delete(void* pointer, size_t size) {
+    GetModelAllocator().deallocate(pointer, size);
 }
 
 void Model::setTransform(const Transform& transform) {
     m_transform = transform;
 }
 
+const ModelHandle& Model::getHandle() const {
+    return m_handle;
+}
+
 void Model::draw(RenderWindow& target, const RenderStates& states) const {
-    for (const auto& mesh : m_meshes) {
-        mesh->draw(target, states);
+    ModelManager& modelManager = ModelManager::GetInstance();
+    for (const MeshHandle& meshHandle : m_meshes) {
+        Mesh* mesh = modelManager.getMesh(meshHandle);
+        if (mesh != nullptr) {
+            mesh->draw(target, states);
+        }
+    }
+}
+
+void Model::requestTextures(float priority) const {
+    ModelManager& modelManager = ModelManager::GetInstance();
+    TextureManager& textureManager = TextureManager::GetInstance();
+    for (const MeshHandle& meshHandle : m_meshes) {
+        Mesh* mesh = modelManager.getMesh(meshHandle);
+        if (mesh == nullptr) {
+            continue;
+        }
+        for (const auto& pair : mesh->getTextures()) {
+            textureManager.touch(textureManager.getTexture2D(pair.first), priority);
+        }
     }
 }
 
 void Model::loadModel(const String& path) {
+    if (importModel(path)) {
+        createMeshes();
+    }
+}
+
+bool Model::importModel(const String& path) {
     Assimp::Importer importer;
 
     FileSystem& fs = FileSystem::GetInstance();
@@ -174,26 +241,27 @@ void Model::loadModel(const String& path) {
 
     String pathNoext = path.subString(0, path.findLastOf("."));
     String jsonFilename = fs.join(sRootModelFolder, "{}.json"_format(pathNoext));
+    m_sourceFilenames = {fs.normalizePath(filename), fs.normalizePath(jsonFilename)};
     if (fs.fileExists(jsonFilename)) {
-        Vector<byte> jsonData;
+        MappedFile jsonData;
+        String error;
 
-        fs.loadFileData(jsonFilename, &jsonData);
-        if (json::accept(jsonData.begin(), jsonData.end())) {
-            m_descriptor = json::parse(jsonData.begin(), jsonData.end());
+        if (!fs.mapFile(jsonFilename, &jsonData, MappedFile::Advice::SEQUENTIAL)) {
+            LogError(sTag, "Error loading file: {}", jsonFilename);
+        } else if (m_descriptor.loadFromMemory(jsonData.getData(), jsonData.getSize(), &error)) {
             LogDebug(sTag, "Loading descriptor: {}", jsonFilename);
+        } else {
+            LogError(sTag, "Error loading descriptor: {} ({})", jsonFilename, error);
         }
     }
 
-    const json& properties = m_descriptor["properties"];
-    if (!m_descriptor.is_null() && !properties.is_null()) {
+    if (m_descriptor.hasProperties) {
         Transform modelMatrix;
-        const json& scale = properties["scale"];
-        const json& rotation = properties["rotation"];
-        if (!scale.is_null()) {
-            modelMatrix.scale(math::vec3(float(scale)));
+        if (m_descriptor.hasScale) {
+            modelMatrix.scale(math::vec3(m_descriptor.scale));
         }
-        if (!rotation.is_null()) {
-            modelMatrix.rotate({float(rotation[0]), float(rotation[1]), float(rotation[2])});
+        if (m_descriptor.hasRotation) {
+            modelMatrix.rotate(m_descriptor.rotation);
         }
         m_transform = modelMatrix;
     }
@@ -204,19 +272,47 @@ void Model::loadModel(const String& path) {
 
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
         LogError("Model", String("ERROR::ASSIMP::") + importer.GetErrorString());
-        return;
+        return false;
     }
 
     m_relativeDirectory = path.subString(0, path.findLastOf("/\\"));
 
     processNode(scene->mRootNode, scene);
+
+    return true;
+}
+
+void Model::createMeshes() {
+    TextureManager& textureManager = TextureManager::GetInstance();
+    ModelManager& modelManager = ModelManager::GetInstance();
+
+    for (MeshData& meshData : m_importedMeshes) {
+        MeshTextures textures;
+
+        for (auto& pair : meshData.textureFilenames) {
+            TextureType type = pair.first;
+            const String& filename = pair.second;
+            Texture2D* texture = textureManager.loadFromFile(filename);
+            textures.emplace_back((texture != nullptr) ? texture->getHandle() : TextureHandle(), type);
+        }
+
+        if (textures.empty()) {
+            TextureHandle texture = textureManager.getTextureHandle(TextureManager::sDefaultTextureId);
+            textures.emplace_back(texture, TextureType::DIFFUSE);
+        }
+
+        m_meshes.push_back(
+            modelManager.addMesh(std::move(meshData.vertices), std::move(meshData.indices), std::move(textures)));
+    }
+
+    m_importedMeshes.clear();
 }
 
 void Model::processNode(aiNode* node, const aiScene* scene) {
     // Process all the node's meshes (if any)
     for (unsigned int i = 0; i < node->mNumMeshes; i++) {
         aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        m_meshes.push_back(processMesh(mesh, scene));
+        m_importedMeshes.push_back(processMesh(mesh, scene));
     }
     // Then do the same for each of its children
     for (unsigned int i = 0; i < node->mNumChildren; i++) {
@@ -224,10 +320,10 @@ void Model::processNode(aiNode* node, const aiScene* scene) {
     }
 }
 
-std::unique_ptr<Mesh> Model::processMesh(aiMesh* mesh, const aiScene* scene) {
-    Vector<Vertex> vertices;
-    Vector<uint32> indices;
-    Vector<std::pair<Texture2D*, TextureType>> textures;
+Model::MeshData Model::processMesh(aiMesh* mesh, const aiScene* scene) {
+    MeshData ret;
+    Vector<Vertex>& vertices = ret.vertices;
+    Vector<uint32>& indices = ret.indices;
 
     // Process vertices
     vertices.reserve(mesh->mNumVertices);
@@ -288,39 +384,32 @@ std::unique_ptr<Mesh> Model::processMesh(aiMesh* mesh, const aiScene* scene) {
 
     FileSystem& fs = FileSystem::GetInstance();
 
-    Vector<std::pair<TextureType, String>> textureFilenames;
+    SmallVector<std::pair<TextureType, String>, 4>& textureFilenames = ret.textureFilenames;
 
-    auto loadTexturesFromMaterial = [&textureFilenames, &fs, this](const json& jsonMaterial) {
-        const json& jsonTextures = jsonMaterial["textures"];
-        for (const json& jsonTexture : jsonTextures) {
-            const json& type = jsonTexture["type"];
-            const json& name = jsonTexture["name"];
-            if (type.is_string() && name.is_string()) {
-                textureFilenames.emplace_back(GetTextureTypeFromString(type),
-                                              fs.join(m_relativeDirectory, name.get<String>()));
-            }
+    auto loadTexturesFromMaterial = [&textureFilenames, &fs, this](const ModelDescriptor::Material& material) {
+        for (const auto& texture : material.textures) {
+            textureFilenames.emplace_back(GetTextureTypeFromString(texture.first),
+                                          fs.join(m_relativeDirectory, texture.second));
         }
     };
 
-    const json& jsonMaterials = m_descriptor["materials"];
-    size_t materialsCount = jsonMaterials.size();
-    if (!m_descriptor.is_null() && !jsonMaterials.is_null()) {
+    const Vector<ModelDescriptor::Material>& materials = m_descriptor.materials;
+    if (m_descriptor.hasMaterials) {
         int32 materialId = -1;
 
-        for (const json& jsonMesh : m_descriptor["meshes"]) {
-            const json& name = jsonMesh["name"];
-            if (name.is_string() && name == mesh->mName.C_Str()) {
-                materialId = jsonMesh["material_id"];
+        for (const ModelDescriptor::Mesh& meshDescriptor : m_descriptor.meshes) {
+            if (meshDescriptor.name == mesh->mName.C_Str()) {
+                materialId = meshDescriptor.materialId;
                 break;
             }
         }
 
-        if (materialsCount == 1 && materialId < 0) {
-            loadTexturesFromMaterial(jsonMaterials[0]);
+        if (materials.size() == 1 && materialId < 0) {
+            loadTexturesFromMaterial(materials[0]);
         } else {
-            for (const json& jsonMaterial : jsonMaterials) {
-                if (jsonMaterial["id"] == materialId) {
-                    loadTexturesFromMaterial(jsonMaterial);
+            for (const ModelDescriptor::Material& materialDescriptor : materials) {
+                if (materialDescriptor.hasId && materialDescriptor.id == materialId) {
+                    loadTexturesFromMaterial(materialDescriptor);
                 }
             }
         }
@@ -337,24 +426,6 @@ std::unique_ptr<Mesh> Model::processMesh(aiMesh* mesh, const aiScene* scene) {
         }
     }
 
-    TextureManager& textureManager = TextureManager::GetInstance();
-
-    for (auto& pair : textureFilenames) {
-        TextureType type = pair.first;
-        const String& filename = pair.second;
-        Texture2D* texture = textureManager.loadFromFile(filename);
-        textures.emplace_back(texture, type);
-    }
-
-    if (textures.empty()) {
-        Texture2D* texture = textureManager.getTexture2D(TextureManager::sDefaultTextureId);
-        textures.emplace_back(texture, TextureType::DIFFUSE);
-    }
-
-    ModelManager& modelManager = ModelManager::GetInstance();
-    std::unique_ptr<Mesh> ret = modelManager.createMesh();
-    ret->loadFromData(vertices, indices, textures);
-
     return ret;
 }
 
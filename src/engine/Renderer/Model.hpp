@@ -3,10 +3,12 @@
 #include <Util/Prerequisites.hpp>
 
 #include <Renderer/Mesh.hpp>
+#include <Renderer/ModelDescriptor.hpp>
 #include <Renderer/Transform.hpp>
-#include <System/JSON.hpp>
 #include <System/String.hpp>
+#include <Util/Container/SmallVector.hpp>
 #include <Util/Container/Vector.hpp>
+#include <Util/Handle.hpp>
 #include <Util/NonCopyable.hpp>
 
 #include <memory>
@@ -27,23 +29,72 @@ public:
 
     virtual ~Model();
 
+    /**
+     * @brief The models are allocated from a SlabAllocator, the slots
+     *        of the unloaded models are reused by the next ones
+     */
+    static void* operator new(size_t size);
+
+    static void operator delete(void* pointer, size_t size);
+
     void setTransform(const Transform& transform);
 
+    const Handle<Model>& getHandle() const;
+
     virtual void draw(RenderWindow& target, const RenderStates& states) const;
 
+    /**
+     * @brief Notify the TextureManager that the textures of this model
+     *        are going to be used in the current frame
+     *
+     * @param priority Streaming priority of the textures
+     */
+    void requestTextures(float priority) const;
+
 private:
+    struct MeshData {
+        Vector<Vertex> vertices;
+        Vector<uint32> indices;
+        SmallVector<std::pair<TextureType, String>, 4> textureFilenames;
+    };
+
     void loadModel(const String& path);
 
+    /**
+     * @brief Read the model file and its descriptor and process its
+     *        meshes, this does not use the Renderer so it can be
+     *        executed in any thread
+     */
+    bool importModel(const String& path);
+
+    /**
+     * @brief Create the Renderer meshes and load the textures of the
+     *        imported data, must be called in the Renderer thread
+     */
+    void createMeshes();
+
     void processNode(aiNode* node, const aiScene* scene);
 
-    std::unique_ptr<Mesh> processMesh(aiMesh* mesh, const aiScene* scene);
+    MeshData processMesh(aiMesh* mesh, const aiScene* scene);
 
-    Vector<std::unique_ptr<Mesh>> m_meshes;
+    Vector<MeshHandle> m_meshes;
+    Vector<MeshData> m_importedMeshes;
     String m_relativeDirectory;
 
+    // Normalized paths of the model file and its descriptor, used to
+    // reload the model when they change
+    Vector<String> m_sourceFilenames;
+
+    // Name, handle and references managed by the ModelManager
+    String m_name;
+    Handle<Model> m_handle;
+    uint32 m_refCount;
+
     Transform m_transform;
 
-    json m_descriptor;
+    ModelDescriptor m_descriptor;
 };
 
+using ModelHandle = Handle<Model>;
+
 }  // namespace engine
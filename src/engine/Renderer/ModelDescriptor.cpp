@@ -0,0 +1,122 @@
+#include <Renderer/ModelDescriptor.hpp>
+
+#include <System/JSONReader.hpp>
+
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+class ModelReader : public JSONReader {
+public:
+    explicit ModelReader(ModelDescriptor& descriptor) : m_descriptor(descriptor) {}
+
+protected:
+    bool onValue(const Value& value) override {
+        if (isAt({})) {
+            return setError("The descriptor must be an object");
+        }
+        if (isAt({"properties", "scale"})) {
+            if (!value.isNumber()) {
+                return setError("The model scale must be a number");
+            }
+            m_descriptor.hasScale = true;
+            m_descriptor.scale = value.asFloat();
+        } else if (isAt({"properties", "rotation", nullptr})) {
+            size_t index = getIndex();
+            if (!value.isNumber() || index >= 3) {
+                return setError("The model rotation must be an array of 3 numbers");
+            }
+            m_descriptor.hasRotation = true;
+            m_descriptor.rotation[index] = value.asFloat();
+        } else if (isAt({"materials"})) {
+            return setError("The materials must be an array");
+        } else if (isAt({"materials", nullptr, "id"})) {
+            if (value.getType() != Value::Type::INTEGER) {
+                return setError("The material id must be an integer");
+            }
+            m_descriptor.materials.back().hasId = true;
+            m_descriptor.materials.back().id = static_cast<int32>(value.asInteger());
+        } else if (isAt({"materials", nullptr, "textures", nullptr, "type"})) {
+            // Textures without type or name are ignored
+            if (value.isString()) {
+                m_texture.first = value.asString();
+            }
+        } else if (isAt({"materials", nullptr, "textures", nullptr, "name"})) {
+            if (value.isString()) {
+                m_texture.second = value.asString();
+            }
+        } else if (isAt({"meshes", nullptr, "name"})) {
+            if (value.isString()) {
+                m_mesh.name = value.asString();
+            }
+        } else if (isAt({"meshes", nullptr, "material_id"})) {
+            if (value.getType() != Value::Type::INTEGER) {
+                return setError("The mesh material_id must be an integer");
+            }
+            m_mesh.materialId = static_cast<int32>(value.asInteger());
+        }
+        return true;
+    }
+
+    bool onStartObject() override {
+        if (isAt({"properties"})) {
+            m_descriptor.hasProperties = true;
+        } else if (isAt({"materials"})) {
+            return setError("The materials must be an array");
+        } else if (isAt({"materials", nullptr})) {
+            m_descriptor.materials.emplace_back();
+        } else if (isAt({"materials", nullptr, "textures", nullptr})) {
+            m_texture = {};
+        } else if (isAt({"meshes", nullptr})) {
+            m_mesh = {};
+        }
+        return true;
+    }
+
+    bool onEndObject() override {
+        if (isAt({"materials", nullptr, "textures", nullptr})) {
+            if (!m_texture.first.isEmpty() && !m_texture.second.isEmpty()) {
+                m_descriptor.materials.back().textures.push_back(std::move(m_texture));
+            }
+        } else if (isAt({"meshes", nullptr})) {
+            if (!m_mesh.name.isEmpty()) {
+                m_descriptor.meshes.push_back(std::move(m_mesh));
+            }
+        }
+        return true;
+    }
+
+    bool onStartArray() override {
+        if (isAt({})) {
+            return setError("The descriptor must be an object");
+        }
+        if (isAt({"materials"})) {
+            m_descriptor.hasMaterials = true;
+        }
+        return true;
+    }
+
+private:
+    ModelDescriptor& m_descriptor;
+    std::pair<String, String> m_texture;
+    ModelDescriptor::Mesh m_mesh;
+};
+
+}  // namespace
+
+bool ModelDescriptor::loadFromMemory(const byte* data, size_t size, String* error) {
+    *this = ModelDescriptor();
+    ModelReader reader(*this);
+    if (!reader.parse(data, size)) {
+        if (error != nullptr) {
+            *error = reader.getError();
+        }
+        *this = ModelDescriptor();
+        return false;
+    }
+    return true;
+}
+
+}  // namespace engine
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <Math/Math.hpp>
+#include <System/String.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <utility>
+
+namespace engine {
+
+/**
+ * @brief Content of the json file that accompanies a model
+ *
+ * @details The descriptor files have the next structure, all the
+ *          members are optional and the unknown ones are ignored:
+ * @code
+ * {
+ *     "properties": {"scale": 1, "rotation": [0, 0, 0]},
+ *     "materials": [
+ *         {"id": 0, "textures": [{"type": "diffuse", "name": "a.png"}]}
+ *     ],
+ *     "meshes": [
+ *         {"name": "mesh", "material_id": 0}
+ *     ]
+ * }
+ * @endcode
+ */
+struct ENGINE_API ModelDescriptor {
+    struct Material {
+        bool hasId = false;
+        int32 id = 0;
+        // Pairs of texture type and filename
+        Vector<std::pair<String, String>> textures;
+    };
+
+    struct Mesh {
+        String name;
+        int32 materialId = -1;
+    };
+
+    bool hasProperties = false;
+    bool hasScale = false;
+    float scale = 1.0f;
+    bool hasRotation = false;
+    math::vec3 rotation = math::vec3(0.0f);
+
+    bool hasMaterials = false;
+    Vector<Material> materials;
+    Vector<Mesh> meshes;
+
+    /**
+     * @brief Parse and validate a descriptor file in a single pass
+     *
+     * @param data The content of the file
+     * @param size The size of the file in bytes
+     * @param error Receives the reason why the file is not valid, can
+     *              be nullptr
+     * @return true if the file is a valid descriptor, false otherwise
+     */
+    bool loadFromMemory(const byte* data, size_t size, String* error = nullptr);
+};
+
+}  // namespace engine
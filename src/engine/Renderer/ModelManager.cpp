@@ -1,9 +1,18 @@
 #include <Renderer/ModelManager.hpp>
 
+#include <Core/Main.hpp>
+#include <Renderer/TextureManager.hpp>
 #include <System/FileSystem.hpp>
 #include <System/LogManager.hpp>
+#include <System/Stopwatch.hpp>
 #include <System/StringFormat.hpp>
 #include <System/StringView.hpp>
+#include <Util/Container/FlatHashSet.hpp>
+#include <Util/Hash.hpp>
+
+#include <algorithm>
+
+#include <cstring>
 
 namespace engine {
 
@@ -11,62 +20,282 @@ namespace {
 
 const StringView sTag("ModelManager");
 
+const StringView sRootModelFolder("models");
+
+uint64 ComputeMeshHash(const Vector<Vertex>& vertices,
+                       const Vector<uint32>& indices,
+                       const MeshTextures& textures) {
+    uint64 hash = Hash64(vertices.data(), vertices.size() * sizeof(Vertex));
+    hash = Hash64(indices.data(), indices.size() * sizeof(uint32), hash);
+    for (const auto& pair : textures) {
+        uint32 values[] = {pair.first.getIndex(), pair.first.getGeneration(), static_cast<uint32>(pair.second)};
+        hash = Hash64(values, sizeof(values), hash);
+    }
+    return hash;
+}
+
+size_t ComputeMeshMemory(const Vector<Vertex>& vertices, const Vector<uint32>& indices) {
+    return vertices.size() * sizeof(Vertex) + indices.size() * sizeof(uint32);
+}
+
 }  // namespace
 
 ModelManager::ModelManager() = default;
 
 ModelManager::~ModelManager() = default;
 
-void ModelManager::initialize() {}
+void ModelManager::initialize() {
+    FileSystem::GetInstance().watchFolder(sRootModelFolder);
+    m_onFilesChangedConnection =
+        FileSystem::GetInstance().onFilesChanged.connect(*this, &ModelManager::onFilesChanged);
+}
 
 void ModelManager::shutdown() {
-    m_nameMap.clear();
-    m_modelRefCount.clear();
+    FileSystem::GetInstance().onFilesChanged.disconnect(m_onFilesChangedConnection);
+    FileSystem::GetInstance().unwatchFolder(sRootModelFolder);
+    m_modelHandles.clear();
     m_models.clear();
+    m_meshContentHandles.clear();
+    m_meshes.clear();
 }
 
 Model* ModelManager::loadFromFile(const String& basename) {
-    auto it = m_nameMap.find(basename);
-    if (it != m_nameMap.end()) {
-        m_modelRefCount[it->second] += 1;
-        return it->second;
+    auto it = m_modelHandles.find(basename);
+    if (it != m_modelHandles.end()) {
+        Model* model = getModel(it->second);
+        model->m_refCount += 1;
+        return model;
     }
 
     LogDebug(sTag, "Loading model: {}", basename);
 
-    m_models.emplace_back(createModel());
-    m_models.back()->loadModel(basename);
-    m_nameMap[basename] = m_models.back().get();
-    m_modelRefCount[m_models.back().get()] = 1;
+    std::unique_ptr<Model> newModel = createModel();
+    newModel->loadModel(basename);
+    Model* model = getModel(addModel(basename, std::move(newModel)));
+    model->m_refCount = 1;
 
-    return m_models.back().get();
+    return model;
 }
 
-void ModelManager::unload(Model* model) {
-    auto& refCount = m_modelRefCount[model];
-    refCount -= 1;
+Vector<Model*> ModelManager::loadFromFiles(const Vector<String>& basenames) {
+    // Create once the models that are not loaded yet
+    Vector<String> newNames;
+    Vector<std::unique_ptr<Model>> newModels;
+    FlatHashSet<StringId> newNamesSet;
+    for (const String& basename : basenames) {
+        if (m_modelHandles.find(basename) == m_modelHandles.end() && newNamesSet.insert(basename).second) {
+            LogDebug(sTag, "Loading model: {}", basename);
+            newNames.push_back(basename);
+            newModels.emplace_back(createModel());
+        }
+    }
+
+    if (!newModels.empty()) {
+        Stopwatch timer;
+        timer.start();
+
+        // 1. Import the model files in parallel
+        Main::GetInstance().executeParallel(
+            newModels.size(), [&newModels, &newNames](size_t i) { newModels[i]->importModel(newNames[i]); });
 
-    if (refCount == 0) {
-        auto foundIt =
-            std::find_if(m_models.begin(), m_models.end(), [&model](auto& val) { return val.get() == model; });
-        auto foundNameIt =
-            std::find_if(m_nameMap.begin(), m_nameMap.end(), [&model](auto& pair) { return pair.second == model; });
+        Time importTime = timer.getElapsedTime();
+        timer.restart();
 
-        foundIt->reset(nullptr);
+        // 2. Decode and upload all the referenced textures together
+        Vector<String> textureNames;
+        for (const auto& model : newModels) {
+            for (const auto& meshData : model->m_importedMeshes) {
+                for (const auto& pair : meshData.textureFilenames) {
+                    textureNames.push_back(pair.second);
+                }
+            }
+        }
+        TextureManager::GetInstance().loadFromFiles(textureNames);
 
-        LogDebug(sTag, "Unloading model: {}", foundNameIt->first);
-        m_nameMap.erase(foundNameIt->first);
-        m_modelRefCount.erase(model);
-        m_models.erase(foundIt);
+        Time texturesTime = timer.getElapsedTime();
+        timer.restart();
+
+        // 3. Upload the meshes
+        for (size_t i = 0; i < newModels.size(); i++) {
+            newModels[i]->createMeshes();
+            addModel(newNames[i], std::move(newModels[i]));
+        }
+
+        Time meshesTime = timer.getElapsedTime();
+
+        LogInfo(sTag, "Loaded {} models (import: {}ms, textures: {}ms, meshes: {}ms)", newNames.size(),
+                importTime.asMilliseconds(), texturesTime.asMilliseconds(), meshesTime.asMilliseconds());
+    }
+
+    return basenames.map([this](const String& basename) {
+        Model* model = getModel(m_modelHandles[basename]);
+        model->m_refCount += 1;
+        return model;
+    });
+}
+
+Model* ModelManager::getModel(const ModelHandle& handle) {
+    std::unique_ptr<Model>* model = m_models.get(handle);
+    return (model != nullptr) ? model->get() : nullptr;
+}
+
+Mesh* ModelManager::getMesh(const MeshHandle& handle) {
+    std::unique_ptr<Mesh>* mesh = m_meshes.get(handle);
+    return (mesh != nullptr) ? mesh->get() : nullptr;
+}
+
+void ModelManager::unload(const ModelHandle& handle) {
+    Model* model = getModel(handle);
+    if (model == nullptr) {
+        LogError(sTag, "Trying to unload a model that is not loaded");
+        return;
+    }
+
+    model->m_refCount -= 1;
+
+    if (model->m_refCount == 0) {
+        LogDebug(sTag, "Unloading model: {}", model->m_name);
+
+        for (const MeshHandle& meshHandle : model->m_meshes) {
+            releaseMesh(meshHandle);
+        }
+        m_modelHandles.erase(model->m_name);
+        m_models.erase(handle);
+    }
+}
+
+void ModelManager::unload(Model* model) {
+    if (model != nullptr) {
+        unload(model->m_handle);
     }
 }
 
 void ModelManager::unloadFromFile(const String& basename) {
-    auto it = m_nameMap.find(basename);
-    if (it == m_nameMap.end()) {
+    auto it = m_modelHandles.find(basename);
+    if (it == m_modelHandles.end()) {
         return;
     }
     unload(it->second);
 }
 
+bool ModelManager::reload(const ModelHandle& handle) {
+    Model* model = getModel(handle);
+    if (model == nullptr) {
+        return false;
+    }
+
+    // Import in a new model so the current one is kept if the file has
+    // errors
+    std::unique_ptr<Model> imported = createModel();
+    if (!imported->importModel(model->m_name)) {
+        LogError(sTag, "Could not reload model: {}", model->m_name);
+        return false;
+    }
+
+    Vector<MeshHandle> previousMeshes = std::move(model->m_meshes);
+    model->m_meshes.clear();
+    model->m_importedMeshes = std::move(imported->m_importedMeshes);
+    model->m_relativeDirectory = std::move(imported->m_relativeDirectory);
+    model->m_sourceFilenames = std::move(imported->m_sourceFilenames);
+    if (imported->m_descriptor.hasProperties) {
+        model->m_transform = imported->m_transform;
+    }
+    model->m_descriptor = std::move(imported->m_descriptor);
+
+    // The new meshes are created before releasing the previous ones so
+    // the unchanged meshes are shared instead of uploaded again
+    model->createMeshes();
+    for (const MeshHandle& meshHandle : previousMeshes) {
+        releaseMesh(meshHandle);
+    }
+
+    LogInfo(sTag, "Reloaded model: {}", model->m_name);
+    return true;
+}
+
+ModelHandle ModelManager::addModel(const String& basename, std::unique_ptr<Model> model) {
+    Model* newModel = model.get();
+    newModel->m_name = basename;
+    newModel->m_handle = m_models.insert(std::move(model));
+    m_modelHandles[basename] = newModel->m_handle;
+    return newModel->m_handle;
+}
+
+MeshMemoryStats ModelManager::getMeshMemoryStats() const {
+    MeshMemoryStats stats;
+    for (const auto& value : m_meshes) {
+        const Mesh* mesh = value.get();
+        size_t meshMemory = ComputeMeshMemory(mesh->m_vertices, mesh->m_indices);
+        stats.meshes++;
+        stats.geometryMemory += meshMemory;
+        if (mesh->m_refCount > 1) {
+            stats.sharedMeshes += mesh->m_refCount - 1;
+            stats.savedMemory += (mesh->m_refCount - 1) * meshMemory;
+        }
+    }
+    return stats;
+}
+
+MeshHandle ModelManager::addMesh(Vector<Vertex> vertices,
+                                 Vector<uint32> indices,
+                                 MeshTextures textures) {
+    uint64 contentHash = ComputeMeshHash(vertices, indices, textures);
+
+    // Share the mesh already loaded with the same content, the data is
+    // compared to discard hash collisions
+    auto contentIt = m_meshContentHandles.find(contentHash);
+    if (contentIt != m_meshContentHandles.end()) {
+        Mesh* mesh = getMesh(contentIt->second);
+        if (mesh != nullptr && mesh->m_vertices.size() == vertices.size() && mesh->m_indices == indices &&
+            mesh->m_textures == textures &&
+            std::memcmp(mesh->m_vertices.data(), vertices.data(), vertices.size() * sizeof(Vertex)) == 0) {
+            mesh->m_refCount += 1;
+            return contentIt->second;
+        }
+    }
+
+    std::unique_ptr<Mesh> newMesh = createMesh();
+    newMesh->loadFromData(std::move(vertices), std::move(indices), std::move(textures));
+    newMesh->m_contentHash = contentHash;
+    newMesh->m_refCount = 1;
+
+    MeshHandle handle = m_meshes.insert(std::move(newMesh));
+    m_meshContentHandles[contentHash] = handle;
+    return handle;
+}
+
+void ModelManager::onFilesChanged(const Vector<String>& filenames) {
+    Vector<ModelHandle> changed;
+    for (const auto& pair : m_modelHandles) {
+        const Model* model = getModel(pair.second);
+        for (const String& filename : model->m_sourceFilenames) {
+            if (std::find(filenames.begin(), filenames.end(), filename) != filenames.end()) {
+                changed.push_back(pair.second);
+                break;
+            }
+        }
+    }
+
+    for (const ModelHandle& handle : changed) {
+        reload(handle);
+    }
+}
+
+void ModelManager::releaseMesh(const MeshHandle& handle) {
+    Mesh* mesh = getMesh(handle);
+    if (mesh == nullptr) {
+        return;
+    }
+
+    mesh->m_refCount -= 1;
+
+    if (mesh->m_refCount == 0) {
+        auto contentIt = m_meshContentHandles.find(mesh->m_contentHash);
+        if (contentIt != m_meshContentHandles.end() && contentIt->second == handle) {
+            m_meshContentHandles.erase(contentIt);
+        }
+        m_meshes.erase(handle);
+    }
+}
+
 }  // namespace engine
@@ -4,17 +4,32 @@
 
 #include <Renderer/Mesh.hpp>
 #include <Renderer/Model.hpp>
+#include <System/SignalConnection.hpp>
+#include <System/StringId.hpp>
+#include <Util/Container/FlatHashMap.hpp>
+#include <Util/Container/SlotMap.hpp>
 #include <Util/Container/Vector.hpp>
 #include <Util/Singleton.hpp>
 
-#include <map>
 #include <memory>
 
 namespace engine {
 
 class Model;
 
+/**
+ * @brief Snapshot of the memory used by the geometry of the loaded meshes
+ */
+struct MeshMemoryStats {
+    uint32 meshes = 0;
+    uint32 sharedMeshes = 0;
+    size_t geometryMemory = 0;
+    size_t savedMemory = 0;
+};
+
 class ENGINE_API ModelManager : public Singleton<ModelManager> {
+    friend class Model;
+
 public:
     ModelManager();
 
@@ -26,17 +41,80 @@ public:
 
     Model* loadFromFile(const String& basename);
 
+    /**
+     * @brief Load multiple models, the model files are imported and
+     *        their textures decoded in parallel, then everything is
+     *        uploaded to the Renderer from the calling thread
+     *
+     * @return The models in the same order of basenames, each returned
+     *         model holds a reference that must be released with unload
+     */
+    Vector<Model*> loadFromFiles(const Vector<String>& basenames);
+
+    /**
+     * @brief Get the model referenced by a handle in O(1)
+     *
+     * @return The Model or nullptr if the handle is stale
+     */
+    Model* getModel(const ModelHandle& handle);
+
+    /**
+     * @brief Get the mesh referenced by a handle in O(1)
+     *
+     * @return The Mesh or nullptr if the handle is stale
+     */
+    Mesh* getMesh(const MeshHandle& handle);
+
+    /**
+     * @brief Release a reference to a model, when no references are
+     *        left the model and its meshes are destroyed and all the
+     *        handles that reference them become stale
+     */
+    void unload(const ModelHandle& handle);
     void unload(Model* model);
     void unloadFromFile(const String& basename);
 
-    virtual std::unique_ptr<Mesh> createMesh() = 0;  // TODO: protected
+    /**
+     * @brief Import again the file of a model into the same Model
+     *
+     * @details The handles and pointers to the model stay valid, its
+     *          meshes are replaced by the new ones only if the file
+     *          could be imported
+     *
+     * @return true if the model was reloaded, false if the handle is
+     *         stale or the file could not be imported
+     */
+    bool reload(const ModelHandle& handle);
+
+    MeshMemoryStats getMeshMemoryStats() const;
 
 protected:
     virtual std::unique_ptr<Model> createModel() = 0;
+    virtual std::unique_ptr<Mesh> createMesh() = 0;
+
+    FlatHashMap<StringId, ModelHandle> m_modelHandles;
+    SlotMap<std::unique_ptr<Model>, Model> m_models;
+    SlotMap<std::unique_ptr<Mesh>, Mesh> m_meshes;
+    FlatHashMap<uint64, MeshHandle> m_meshContentHandles;
+
+private:
+    ModelHandle addModel(const String& basename, std::unique_ptr<Model> model);
+
+    /**
+     * @brief Create a mesh from the given data, if a mesh with the same
+     *        geometry and textures is already loaded it is shared
+     *
+     * @return The handle of the mesh, must be released with releaseMesh
+     */
+    MeshHandle addMesh(Vector<Vertex> vertices,
+                       Vector<uint32> indices,
+                       MeshTextures textures);
+
+    void releaseMesh(const MeshHandle& handle);
+
+    void onFilesChanged(const Vector<String>& filenames);
 
-    std::map<String, Model*> m_nameMap;
-    std::map<Model*, uint32> m_modelRefCount;
-    Vector<std::unique_ptr<Model>> m_models;
+    SignalConnection m_onFilesChangedConnection;
 };
 
 }  // namespace engine
@@ -21,29 +21,28 @@ RenderWindow::RenderWindow()
         m_isFullscreen(false),
         m_isVsyncEnabled(false),
         m_activeCamera(nullptr) {
-    auto& input = InputManager::GetInstance();
+    EventBus& events = InputManager::GetInstance().getEventBus();
 
-    m_onWindowResizeConnection = input.onWindowResized.connect(*this, &RenderWindow::onWindowResizedPriv);
+    m_onWindowResizeConnection = events.subscribe<WindowResizedEvent>(
+        [this](const WindowResizedEvent& event) { onWindowResizedPriv(event.size); });
 
-    m_onAppWillEnterBackgroundConnection =
-        input.onAppWillEnterBackground.connect(*this, &RenderWindow::onAppWillEnterBackgroundPriv);
-    m_onAppDidEnterBackgroundConnection =
-        input.onAppDidEnterBackground.connect(*this, &RenderWindow::onAppDidEnterBackgroundPriv);
-    m_onAppWillEnterForegroundConnection =
-        input.onAppWillEnterForeground.connect(*this, &RenderWindow::onAppWillEnterForegroundPriv);
-    m_onAppDidEnterForegroundConnection =
-        input.onAppDidEnterForeground.connect(*this, &RenderWindow::onAppDidEnterForegroundPriv);
+    m_onAppWillEnterBackgroundConnection = events.subscribe<AppWillEnterBackgroundEvent>(
+        [this](const AppWillEnterBackgroundEvent&) { onAppWillEnterBackgroundPriv(); });
+    m_onAppDidEnterBackgroundConnection = events.subscribe<AppDidEnterBackgroundEvent>(
+        [this](const AppDidEnterBackgroundEvent&) { onAppDidEnterBackgroundPriv(); });
+    m_onAppWillEnterForegroundConnection = events.subscribe<AppWillEnterForegroundEvent>(
+        [this](const AppWillEnterForegroundEvent&) { onAppWillEnterForegroundPriv(); });
+    m_onAppDidEnterForegroundConnection = events.subscribe<AppDidEnterForegroundEvent>(
+        [this](const AppDidEnterForegroundEvent&) { onAppDidEnterForegroundPriv(); });
 }
 
 RenderWindow::~RenderWindow() {
-    auto& input = InputManager::GetInstance();
+    m_onWindowResizeConnection.disconnect();
 
-    input.onWindowResized.disconnect(m_onWindowResizeConnection);
-
-    input.onAppWillEnterBackground.disconnect(m_onAppWillEnterBackgroundConnection);
-    input.onAppDidEnterBackground.disconnect(m_onAppDidEnterBackgroundConnection);
-    input.onAppWillEnterForeground.disconnect(m_onAppWillEnterForegroundConnection);
-    input.onAppDidEnterForeground.disconnect(m_onAppDidEnterForegroundConnection);
+    m_onAppWillEnterBackgroundConnection.disconnect();
+    m_onAppDidEnterBackgroundConnection.disconnect();
+    m_onAppWillEnterForegroundConnection.disconnect();
+    m_onAppDidEnterForegroundConnection.disconnect();
 }
 
 bool RenderWindow::create(const String& name, const math::ivec2& size) {
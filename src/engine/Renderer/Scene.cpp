@@ -1,93 +1,124 @@
 #include <Renderer/Scene.hpp>
 
+#include <Graphics/3D/Camera.hpp>
+#include <Math/Geometric.hpp>
 #include <Renderer/ModelManager.hpp>
 #include <Renderer/RenderStates.hpp>
 #include <Renderer/RenderWindow.hpp>
 #include <System/FileSystem.hpp>
-#include <System/JSON.hpp>
 #include <System/LogManager.hpp>
+#include <System/SlabAllocator.hpp>
+#include <System/Stopwatch.hpp>
 #include <System/StringView.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace engine {
 
 namespace {
 
 const StringView sTag("Scene");
+
+SlabAllocator& GetSceneAllocator() {
+    static SlabAllocator sSceneAllocator("Scene", 4);
+    return sSceneAllocator;
 }
 
-Scene::Scene(json data) : m_data(std::move(data)) {}
+}  // namespace
+
+Scene::Scene(SceneDescriptor descriptor) : m_descriptor(std::move(descriptor)) {}
 
 Scene::~Scene() {
     unload();
 }
 
-bool Scene::load() {
-    if (!m_data.is_object()) {
-        LogError(sTag, "Data must be an object");
-        return false;
-    }
+void* Scene::operator new(size_t size) {
+    return GetSceneAllocator().allocate(size);
+}
 
-    const json& jsonName = m_data["name"];
-    if (jsonName.is_string()) {
-        m_name = jsonName;
-    } else {
+void Scene::operator delete(void* pointer, size_t size) {
+    GetSceneAllocator().deallocate(pointer, size);
+}
+
+bool Scene::load() {
+    m_name = m_descriptor.name;
+    if (m_name.isEmpty()) {
         LogWarning(sTag, "Scene does not contain a name");
     }
 
     auto& fileSystem = FileSystem::GetInstance();
 
-    const json& jsonData = m_data["data"];
-    if (jsonData.is_object()) {
-        const json& jsonObjects = jsonData["objects"];
-        for (const json& jsonObject : jsonObjects) {
-            const json& modelJson = jsonObject["model"];
-            const json& positionJson = jsonObject["position"];
-            const json& rotationJson = jsonObject["rotation"];
-            const json& scaleJson = jsonObject["scale"];
-
-            Transform modelMatrix;
-            if (!scaleJson.is_null()) {
-                modelMatrix.scale(math::vec3(float(scaleJson)));
-            }
-            if (!rotationJson.is_null()) {
-                modelMatrix.rotate({float(rotationJson[0]), float(rotationJson[1]), float(rotationJson[2])});
-            }
-            if (!positionJson.is_null()) {
-                modelMatrix.translate({float(positionJson[0]), float(positionJson[1]), float(positionJson[2])});
-            }
-
-            String normalizedPath = fileSystem.normalizePath(modelJson);
-
-            Model* model = ModelManager::GetInstance().loadFromFile(normalizedPath);
-            auto& transforms = m_models[model];
-            transforms.emplace_back(modelMatrix);
+    Stopwatch timer;
+    timer.start();
 
-            auto foundIt = m_numModelInstance.find(normalizedPath);
-            if (foundIt == m_numModelInstance.end()) {
-                m_numModelInstance.emplace(normalizedPath, 1);
-            } else {
-                foundIt->second += 1;
-            }
-        }
+    // 1. Gather the models referenced by the objects, the descriptor
+    //    already contains each one once
+    Vector<String> modelNames;
+    if (m_descriptor.hasData) {
+        modelNames = m_descriptor.models.map([&fileSystem](const String& model) {
+            return fileSystem.normalizePath(model);
+        });
     } else {
         LogError(sTag, "Scene does not contain data");
     }
 
+    Time gatherTime = timer.getElapsedTime();
+    timer.restart();
+
+    // 2. Load the unique models and their assets in parallel
+    Vector<Model*> models = ModelManager::GetInstance().loadFromFiles(modelNames);
+    m_loadedModels = models.map([](Model* model) { return model->getHandle(); });
+
+    Time loadTime = timer.getElapsedTime();
+
+    // 3. Add the instances of each model
+    size_t objectCount = m_descriptor.hasData ? m_descriptor.getObjectCount() : 0;
+    for (size_t i = 0; i < objectCount; i++) {
+        uint32 modelIndex = m_descriptor.objectModels[i];
+        m_models[m_loadedModels[modelIndex]].push_back(m_descriptor.objectTransforms[i]);
+        m_numModelInstance[modelNames[modelIndex]] += 1;
+    }
+
+    LogInfo(sTag, "Scene '{}' with {} objects loaded (gather: {}ms, load: {}ms)", m_name, objectCount,
+            gatherTime.asMilliseconds(), loadTime.asMilliseconds());
+
     return true;
 }
 
 bool Scene::unload() {
-    for (auto& modelPair : m_models) {
-        Model* model = modelPair.first;
-        std::for_each(modelPair.second.cbegin(), modelPair.second.cend(),
-                      [&model](auto& /*unused*/) { ModelManager::GetInstance().unload(model); });
+    // Each model is referenced once by the scene, independently of the
+    // number of instances
+    for (const ModelHandle& model : m_loadedModels) {
+        ModelManager::GetInstance().unload(model);
     }
+    m_loadedModels.clear();
+    m_models.clear();
+    m_numModelInstance.clear();
     return true;
 }
 
 void Scene::draw(RenderWindow& target) {
+    const Camera* activeCamera = target.getActiveCamera();
+    ModelManager& modelManager = ModelManager::GetInstance();
+
     for (auto& modelPair : m_models) {
-        Model* model = modelPair.first;
+        Model* model = modelManager.getModel(modelPair.first);
+        if (model == nullptr) {
+            continue;
+        }
+
+        // The closest instance defines the streaming priority of the model textures
+        float priority = 1.0F;
+        if (activeCamera != nullptr) {
+            float minDistance = std::numeric_limits<float>::max();
+            for (auto& transform : modelPair.second) {
+                math::vec3 offset = transform.getTranslation() - activeCamera->getPosition();
+                minDistance = std::min(minDistance, math::Length(offset));
+            }
+            priority = 1.0F / (1.0F + minDistance);
+        }
+        model->requestTextures(priority);
 
         RenderStates states;
         for (auto& transform : modelPair.second) {
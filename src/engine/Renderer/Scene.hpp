@@ -3,9 +3,10 @@
 #include <Util/Prerequisites.hpp>
 
 #include <Renderer/Model.hpp>
+#include <Renderer/SceneDescriptor.hpp>
 #include <Renderer/Transform.hpp>
-#include <System/JSON.hpp>
 #include <System/String.hpp>
+#include <Util/Container/FlatHashMap.hpp>
 #include <Util/Container/Vector.hpp>
 #include <Util/NonCopyable.hpp>
 
@@ -19,10 +20,17 @@ class ENGINE_API Scene : NonCopyable {
 public:
     ~Scene();
 
+    /**
+     * @brief The scenes are allocated from a SlabAllocator, see Mesh
+     */
+    static void* operator new(size_t size);
+
+    static void operator delete(void* pointer, size_t size);
+
     void draw(RenderWindow& target);
 
 private:
-    explicit Scene(json data);
+    explicit Scene(SceneDescriptor descriptor);
 
     bool load();
     bool unload();
@@ -30,9 +38,10 @@ private:
     const String& getName();
 
     String m_name;
-    std::map<Model*, Vector<Transform>> m_models;
-    std::map<String, uint32> m_numModelInstance;
-    json m_data;
+    Vector<ModelHandle> m_loadedModels;
+    std::map<ModelHandle, Vector<Transform>> m_models;
+    FlatHashMap<String, uint32> m_numModelInstance;
+    SceneDescriptor m_descriptor;
 };
 
 }  // namespace engine
@@ -0,0 +1,317 @@
+#include <Renderer/SceneDescriptor.hpp>
+
+#include <Math/Math.hpp>
+#include <System/JSONReader.hpp>
+#include <System/StringView.hpp>
+#include <Util/Hash.hpp>
+
+#include <map>
+#include <utility>
+
+#include <cstring>
+
+namespace engine {
+
+namespace {
+
+// "ESCN" in little endian
+const uint32 sSceneMagic(0x4E435345);
+
+const uint32 sSceneVersion(2);
+
+const uint32 sSceneHasData(1 << 0);
+
+struct SceneHeader {
+    uint32 magic;
+    uint32 version;
+    uint64 sourceHash;
+    uint32 flags;
+    uint32 modelCount;
+    uint32 objectCount;
+    // Range of the name in the string table
+    uint32 nameOffset;
+    uint32 nameSize;
+    // Offset and size of each model path in the string table
+    uint32 modelsOffset;
+    uint32 stringsOffset;
+    uint32 stringsSize;
+    // Arrays with an element per object
+    uint32 objectModelsOffset;
+    uint32 positionsOffset;
+    uint32 rotationsOffset;
+    uint32 scalesOffset;
+};
+
+struct StringEntry {
+    uint32 offset;
+    uint32 size;
+};
+
+using PackedVector = math::Vector3Packed<float>;
+
+static_assert(sizeof(PackedVector) == 3 * sizeof(float), "The vectors must be tightly packed");
+
+class SceneReader : public JSONReader {
+public:
+    explicit SceneReader(SceneDescriptor& descriptor) : m_descriptor(descriptor), m_hasModel(false) {}
+
+protected:
+    bool onValue(const Value& value) override {
+        if (isAt({})) {
+            return setError("The scene must be an object");
+        }
+        if (isAt({"name"})) {
+            if (!value.isString()) {
+                return setError("The scene name must be a string");
+            }
+            m_descriptor.name = value.asString();
+        } else if (isAt({"data", "objects", nullptr, "model"})) {
+            if (!value.isString()) {
+                return setError("The object model must be a string");
+            }
+            m_descriptor.objectModels.back() = findModel(value.asString());
+            m_hasModel = true;
+        } else if (isAt({"data", "objects", nullptr, "scale"})) {
+            if (!value.isNumber()) {
+                return setError("The object scale must be a number");
+            }
+            m_descriptor.objectTransforms.back().scale(math::vec3(value.asFloat()));
+        } else if (isAt({"data", "objects", nullptr, "position", nullptr})) {
+            math::vec3 position(0.0f);
+            if (!readComponent(value, &position)) {
+                return setError("The object position must be an array of 3 numbers");
+            }
+            m_descriptor.objectTransforms.back().translate(position);
+        } else if (isAt({"data", "objects", nullptr, "rotation", nullptr})) {
+            math::vec3 rotation(0.0f);
+            if (!readComponent(value, &rotation)) {
+                return setError("The object rotation must be an array of 3 numbers");
+            }
+            m_descriptor.objectTransforms.back().rotate(rotation);
+        }
+        return true;
+    }
+
+    bool onStartObject() override {
+        if (isAt({"data"})) {
+            m_descriptor.hasData = true;
+        } else if (isAt({"data", "objects", nullptr})) {
+            m_descriptor.objectModels.emplace_back(0);
+            m_descriptor.objectTransforms.emplace_back();
+            m_hasModel = false;
+        }
+        return true;
+    }
+
+    bool onEndObject() override {
+        if (isAt({"data", "objects", nullptr}) && !m_hasModel) {
+            return setError("The objects must have a model");
+        }
+        return true;
+    }
+
+    bool onStartArray() override {
+        if (isAt({})) {
+            return setError("The scene must be an object");
+        }
+        return true;
+    }
+
+private:
+    bool readComponent(const Value& value, math::vec3* vector) const {
+        // The transforms are accumulated, so each component is applied
+        // separately as it's read
+        size_t index = getIndex();
+        if (!value.isNumber() || index >= 3) {
+            return false;
+        }
+        (*vector)[index] = value.asFloat();
+        return true;
+    }
+
+    uint32 findModel(String model) {
+        auto it = m_modelIndices.find(model);
+        if (it != m_modelIndices.end()) {
+            return it->second;
+        }
+        uint32 index = static_cast<uint32>(m_descriptor.models.size());
+        m_modelIndices.emplace(model, index);
+        m_descriptor.models.push_back(std::move(model));
+        return index;
+    }
+
+    SceneDescriptor& m_descriptor;
+    std::map<String, uint32> m_modelIndices;
+    bool m_hasModel;
+};
+
+bool IsValidRange(uint64 offset, uint64 size, size_t fileSize) {
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+void AppendData(Vector<byte>* output, const void* data, size_t size) {
+    const auto* bytes = static_cast<const byte*>(data);
+    output->insert(output->end(), bytes, bytes + size);
+}
+
+template <typename T>
+void AlignOutput(Vector<byte>* output) {
+    output->resize((output->size() + alignof(T) - 1) / alignof(T) * alignof(T));
+}
+
+}  // namespace
+
+const StringView SceneDescriptor::sCompiledExtension(".scene");
+
+uint64 SceneDescriptor::ComputeSourceHash(const byte* data, size_t size) {
+    return Hash64(data, size);
+}
+
+size_t SceneDescriptor::getObjectCount() const {
+    return objectModels.size();
+}
+
+bool SceneDescriptor::loadFromMemory(const byte* data, size_t size, String* error) {
+    *this = SceneDescriptor();
+    SceneReader reader(*this);
+    if (!reader.parse(data, size)) {
+        if (error != nullptr) {
+            *error = reader.getError();
+        }
+        return false;
+    }
+    sourceHash = ComputeSourceHash(data, size);
+    return true;
+}
+
+bool SceneDescriptor::loadFromBinary(const byte* data, size_t size, String* error) {
+    *this = SceneDescriptor();
+
+    auto fail = [error](const char* reason) {
+        if (error != nullptr) {
+            *error = reason;
+        }
+        return false;
+    };
+
+    SceneHeader header;
+    if (size < sizeof(header)) {
+        return fail("The file is too small");
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != sSceneMagic || header.version != sSceneVersion) {
+        return fail("The file is not a compiled scene");
+    }
+
+    uint64 objectCount = header.objectCount;
+    uint64 vectorsSize = objectCount * sizeof(PackedVector);
+    if (!IsValidRange(header.stringsOffset, header.stringsSize, size) ||
+        !IsValidRange(header.modelsOffset, uint64(header.modelCount) * sizeof(StringEntry), size) ||
+        !IsValidRange(header.objectModelsOffset, objectCount * sizeof(uint32), size) ||
+        !IsValidRange(header.positionsOffset, vectorsSize, size) ||
+        !IsValidRange(header.rotationsOffset, vectorsSize, size) ||
+        !IsValidRange(header.scalesOffset, vectorsSize, size) ||
+        !IsValidRange(header.nameOffset, header.nameSize, header.stringsSize)) {
+        return fail("Invalid section in the compiled scene");
+    }
+
+    const auto* strings = reinterpret_cast<const char*>(data + header.stringsOffset);
+    name = String(StringView(strings + header.nameOffset, header.nameSize));
+    hasData = (header.flags & sSceneHasData) != 0;
+    sourceHash = header.sourceHash;
+
+    models.reserve(header.modelCount);
+    for (uint32 i = 0; i < header.modelCount; i++) {
+        StringEntry entry;
+        std::memcpy(&entry, data + header.modelsOffset + i * sizeof(StringEntry), sizeof(entry));
+        if (!IsValidRange(entry.offset, entry.size, header.stringsSize)) {
+            *this = SceneDescriptor();
+            return fail("Invalid model path in the compiled scene");
+        }
+        models.emplace_back(StringView(strings + entry.offset, entry.size));
+    }
+
+    objectModels.resize(header.objectCount);
+    std::memcpy(objectModels.data(), data + header.objectModelsOffset, objectModels.size() * sizeof(uint32));
+    for (uint32 model : objectModels) {
+        if (model >= header.modelCount) {
+            *this = SceneDescriptor();
+            return fail("Invalid model index in the compiled scene");
+        }
+    }
+
+    objectTransforms.resize(header.objectCount);
+    for (uint32 i = 0; i < header.objectCount; i++) {
+        PackedVector position;
+        PackedVector rotation;
+        PackedVector scale;
+        std::memcpy(&position, data + header.positionsOffset + i * sizeof(PackedVector), sizeof(PackedVector));
+        std::memcpy(&rotation, data + header.rotationsOffset + i * sizeof(PackedVector), sizeof(PackedVector));
+        std::memcpy(&scale, data + header.scalesOffset + i * sizeof(PackedVector), sizeof(PackedVector));
+
+        Transform& transform = objectTransforms[i];
+        transform.scale(math::vec3(scale.x, scale.y, scale.z));
+        transform.rotate(math::vec3(rotation.x, rotation.y, rotation.z));
+        transform.translate(math::vec3(position.x, position.y, position.z));
+    }
+
+    return true;
+}
+
+void SceneDescriptor::saveToBinary(Vector<byte>* output) const {
+    SceneHeader header = {};
+    header.magic = sSceneMagic;
+    header.version = sSceneVersion;
+    header.flags = hasData ? sSceneHasData : 0;
+    header.modelCount = static_cast<uint32>(models.size());
+    header.objectCount = static_cast<uint32>(getObjectCount());
+    header.sourceHash = sourceHash;
+
+    // Layout: header, model table, object arrays and the string table
+    output->clear();
+    output->resize(sizeof(SceneHeader));
+
+    // The string table is indexed in bytes
+    Vector<StringEntry> modelEntries;
+    modelEntries.reserve(models.size());
+    uint32 stringsSize = static_cast<uint32>(name.getDataSize());
+    for (const String& model : models) {
+        modelEntries.push_back({stringsSize, static_cast<uint32>(model.getDataSize())});
+        stringsSize += static_cast<uint32>(model.getDataSize());
+    }
+    header.nameOffset = 0;
+    header.nameSize = static_cast<uint32>(name.getDataSize());
+
+    AlignOutput<StringEntry>(output);
+    header.modelsOffset = static_cast<uint32>(output->size());
+    AppendData(output, modelEntries.data(), modelEntries.size() * sizeof(StringEntry));
+
+    AlignOutput<uint32>(output);
+    header.objectModelsOffset = static_cast<uint32>(output->size());
+    AppendData(output, objectModels.data(), objectModels.size() * sizeof(uint32));
+
+    auto appendVectors = [this, output](const math::vec3& (Transform::*getter)() const) {
+        AlignOutput<PackedVector>(output);
+        uint32 offset = static_cast<uint32>(output->size());
+        for (const Transform& transform : objectTransforms) {
+            PackedVector vector((transform.*getter)());
+            AppendData(output, &vector, sizeof(vector));
+        }
+        return offset;
+    };
+    header.positionsOffset = appendVectors(&Transform::getTranslation);
+    header.rotationsOffset = appendVectors(&Transform::getRotation);
+    header.scalesOffset = appendVectors(&Transform::getScale);
+
+    header.stringsOffset = static_cast<uint32>(output->size());
+    header.stringsSize = stringsSize;
+    AppendData(output, name.getData(), name.getDataSize());
+    for (const String& model : models) {
+        AppendData(output, model.getData(), model.getDataSize());
+    }
+
+    std::memcpy(output->data(), &header, sizeof(header));
+}
+
+}  // namespace engine
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <Renderer/Transform.hpp>
+#include <System/String.hpp>
+#include <System/StringView.hpp>
+#include <Util/Container/Vector.hpp>
+
+namespace engine {
+
+/**
+ * @brief Content of a scene file
+ *
+ * @details The objects are stored as parallel arrays, each one is an
+ *          instance of one of the unique models of the scene.
+ *
+ *          The json scene files have the next structure, all the
+ *          members are optional and the unknown ones are ignored:
+ * @code
+ * {
+ *     "name": "Scene",
+ *     "data": {
+ *         "objects": [
+ *             {"model": "a.obj", "position": [0, 0, 0], "rotation": [0, 0, 0], "scale": 1}
+ *         ]
+ *     }
+ * }
+ * @endcode
+ *
+ *          The compiled scene files contain the same data in a binary
+ *          format that is loaded without parsing: a string table with
+ *          the name and the model paths followed by the model index,
+ *          position, rotation and scale arrays of the objects. They
+ *          keep the hash of their json file, see ComputeSourceHash.
+ */
+struct ENGINE_API SceneDescriptor {
+    // Extension of the compiled scene files
+    static const StringView sCompiledExtension;
+
+    String name;
+    bool hasData = false;
+    // Unique model paths referenced by the objects
+    Vector<String> models;
+    // Index in models of each object
+    Vector<uint32> objectModels;
+    Vector<Transform> objectTransforms;
+    // Hash of the json file the scene was loaded or compiled from
+    uint64 sourceHash = 0;
+
+    /**
+     * @brief Compute the hash of the content of a json scene file
+     *
+     * @details A compiled scene is outdated when its sourceHash is
+     *          different to the hash of its json file
+     */
+    static uint64 ComputeSourceHash(const byte* data, size_t size);
+
+    /**
+     * @brief Get the number of objects of the scene
+     */
+    size_t getObjectCount() const;
+
+    /**
+     * @brief Parse and validate a json scene file in a single pass
+     *
+     * @param data The content of the file
+     * @param size The size of the file in bytes
+     * @param error Receives the reason why the file is not valid, can
+     *              be nullptr
+     * @return true if the file is a valid scene, false otherwise
+     */
+    bool loadFromMemory(const byte* data, size_t size, String* error = nullptr);
+
+    /**
+     * @brief Load a compiled scene file
+     *
+     * @param data The content of the file
+     * @param size The size of the file in bytes
+     * @param error Receives the reason why the file is not valid, can
+     *              be nullptr
+     * @return true if the file is a valid compiled scene, false
+     *         otherwise
+     */
+    bool loadFromBinary(const byte* data, size_t size, String* error = nullptr);
+
+    /**
+     * @brief Compile the scene to the format read by loadFromBinary
+     *
+     * @param output Receives the content of the compiled file
+     */
+    void saveToBinary(Vector<byte>* output) const;
+};
+
+}  // namespace engine
@@ -4,9 +4,13 @@
 #include <Renderer/Scene.hpp>
 #include <System/FileSystem.hpp>
 #include <System/LogManager.hpp>
+#include <System/MappedFile.hpp>
+#include <System/SlabAllocator.hpp>
 #include <System/StringView.hpp>
 #include <Util/Container/Vector.hpp>
 
+#include <utility>
+
 namespace engine {
 
 namespace {
@@ -36,26 +40,54 @@ void SceneManager::changeActiveScene(const String& sceneNameId) {
 
     String filenameNoext = fs.join(sRootModelFolder, sceneNameId);
 
-    json jsonObject;
+    SceneDescriptor descriptor;
+    bool isValidDescriptor = false;
+    String error;
 
-    String filename = filenameNoext + ".json";
+    // The compiled scenes are preferred over the json ones while they
+    // were compiled from the current json file
+    String filename = filenameNoext + SceneDescriptor::sCompiledExtension;
+    String jsonFilename = filenameNoext + ".json";
+    bool hasJson = fs.fileExists(jsonFilename);
     if (fs.fileExists(filename)) {
-        Vector<byte> jsonData;
+        MappedFile sceneData;
+        if (!fs.mapFile(filename, &sceneData, MappedFile::Advice::SEQUENTIAL)) {
+            error = "could not read the file";
+        } else {
+            isValidDescriptor = descriptor.loadFromBinary(sceneData.getData(), sceneData.getSize(), &error);
+        }
+
+        MappedFile jsonData;
+        if (isValidDescriptor && hasJson && fs.mapFile(jsonFilename, &jsonData, MappedFile::Advice::SEQUENTIAL) &&
+            SceneDescriptor::ComputeSourceHash(jsonData.getData(), jsonData.getSize()) != descriptor.sourceHash) {
+            LogWarning(sTag, "The compiled scene is outdated, loading the json file: {}", filename);
+            isValidDescriptor = false;
+            filename = jsonFilename;
+        }
+    } else if (hasJson) {
+        filename = jsonFilename;
+    }
 
-        fs.loadFileData(filename, &jsonData);
-        if (json::accept(jsonData.begin(), jsonData.end())) {
-            jsonObject = json::parse(jsonData.begin(), jsonData.end());
-            LogInfo(sTag, "Loading scene: {}", filename);
+    if (!isValidDescriptor && filename == jsonFilename) {
+        MappedFile sceneData;
+        if (!fs.mapFile(filename, &sceneData, MappedFile::Advice::SEQUENTIAL)) {
+            error = "could not read the file";
         } else {
-            LogError(sTag, "Error loading model: {}", sceneNameId);
+            isValidDescriptor = descriptor.loadFromMemory(sceneData.getData(), sceneData.getSize(), &error);
         }
     }
 
-    m_scenes.emplace_back(new Scene(jsonObject));
+    if (isValidDescriptor) {
+        LogInfo(sTag, "Loading scene: {}", filename);
+    } else if (fs.fileExists(filename)) {
+        LogError(sTag, "Error loading scene: {} ({})", sceneNameId, error);
+    }
+
+    m_scenes.emplace_back(new Scene(std::move(descriptor)));
 
     Scene* scene = m_scenes.back().get();
 
-    if (scene->load()) {
+    if (isValidDescriptor && scene->load()) {
         const String& sceneName = scene->getName();
         const uint32 sceneIndex = sSceneIndex++;
 
@@ -66,6 +98,16 @@ void SceneManager::changeActiveScene(const String& sceneNameId) {
     }
 
     LogInfo(sTag, "Scene '{}' successfully loaded", filename);
+    // Collecting the stats locks all the allocators, skip it if the
+    // messages are discarded
+    if constexpr (LogPriority::DEBUG >= sMinLogPriority) {
+        if (LogManager::GetInstance().isEnabled(LogPriority::DEBUG, sTag)) {
+            for (const SlabAllocatorStats& stats : SlabAllocator::GetAllStats()) {
+                LogDebug(sTag, "{} pool: {}/{} slots of {} bytes used (peak {})", stats.name, stats.usedCount,
+                         stats.slotCount, stats.slotSize, stats.peakCount);
+            }
+        }
+    }
 
     m_activeScene = scene;
 }
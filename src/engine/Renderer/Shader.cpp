@@ -1,6 +1,7 @@
 #include "Shader.hpp"
 
 #include <System/LogManager.hpp>
+#include <System/SlabAllocator.hpp>
 #include <System/StringFormat.hpp>
 #include <System/StringView.hpp>
 
@@ -10,12 +11,25 @@ namespace {
 
 // const StringView sTag("Shader");
 
+SlabAllocator& GetShaderAllocator() {
+    static SlabAllocator sShaderAllocator("Shader", 16);
+    return sShaderAllocator;
+}
+
 }  // namespace
 
 Shader::Shader() = default;
 
 Shader::~Shader() = default;
 
+void* Shader::operator new(size_t size) {
+    return GetShaderAllocator().allocate(size);
+}
+
+void Shader::operator delete(void* pointer, size_t size) {
+    GetShaderAllocator().deallocate(pointer, size);
+}
+
 UniformBufferObject::DataType Shader::getUboDataTypeFromString(const String& str) {
     if (str == "mat4x4") {
         return UniformBufferObject::DataType::MATRIX4X4;
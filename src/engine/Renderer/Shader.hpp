@@ -4,6 +4,8 @@
 
 #include <Renderer/UniformBufferObject.hpp>
 #include <System/JSON.hpp>
+#include <System/String.hpp>
+#include <Util/Handle.hpp>
 #include <Util/NonCopyable.hpp>
 
 namespace engine {
@@ -23,12 +25,26 @@ public:
     Shader();
     virtual ~Shader();
 
+    /**
+     * @brief The shaders are allocated from a SlabAllocator, see Mesh
+     */
+    static void* operator new(size_t size);
+
+    static void operator delete(void* pointer, size_t size);
+
     virtual bool loadFromMemory(const byte* source, size_t sourceSize, ShaderType type) = 0;
 
 protected:
     virtual void setDescriptor(json&& descriptor) = 0;
 
     UniformBufferObject::DataType getUboDataTypeFromString(const String& str);
+
+private:
+    // Name used to reference the shader in the ShaderManager
+    String m_name;
+    bool m_isLoadedFromFile = false;
 };
 
+using ShaderHandle = Handle<Shader>;
+
 }  // namespace engine
@@ -2,10 +2,12 @@
 
 #include <System/FileSystem.hpp>
 #include <System/LogManager.hpp>
+#include <System/MappedFile.hpp>
 #include <System/StringFormat.hpp>
 #include <System/StringView.hpp>
 #include <Util/Container/Vector.hpp>
 
+#include <algorithm>
 #include <array>
 #include <map>
 #include <memory>
@@ -26,16 +28,47 @@ const std::array<ShaderType, 3> sAvailableShaderTypes = {{
     ShaderType::GEOMETRY,
 }};
 
+const char* GetShaderExtension(ShaderType shaderType) {
+    switch (shaderType) {
+        case ShaderType::VERTEX:
+            return ".vert";
+        case ShaderType::FRAGMENT:
+            return ".frag";
+        case ShaderType::GEOMETRY:
+            return ".geom";
+    }
+    return "";
+}
+
+String GetShaderFilename(const FileSystem& fs,
+                         const StringView& shaderFolder,
+                         const String& basename,
+                         ShaderType shaderType) {
+    return fs.join(fs.join(sRootShaderFolder, shaderFolder), basename + GetShaderExtension(shaderType));
+}
+
+String GetDescriptorFilename(const FileSystem& fs, const String& basename) {
+    return fs.join(fs.join(sRootShaderFolder, sShaderDescriptorFolder), "{}.json"_format(basename));
+}
+
 }  // namespace
 
 ShaderManager::ShaderManager() : m_activeShader(nullptr) {}
 
 ShaderManager::~ShaderManager() = default;
 
-void ShaderManager::initialize() {}
+void ShaderManager::initialize() {
+    FileSystem::GetInstance().watchFolder(sRootShaderFolder);
+    m_onFilesChangedConnection =
+        FileSystem::GetInstance().onFilesChanged.connect(*this, &ShaderManager::onFilesChanged);
+}
 
 void ShaderManager::shutdown() {
+    FileSystem::GetInstance().onFilesChanged.disconnect(m_onFilesChangedConnection);
+    FileSystem::GetInstance().unwatchFolder(sRootShaderFolder);
+    m_shaderHandles.clear();
     m_shaders.clear();
+    m_activeShader = nullptr;
 }
 
 Shader* ShaderManager::loadFromFile(const String& basename) {
@@ -44,69 +77,13 @@ Shader* ShaderManager::loadFromFile(const String& basename) {
         return newShader;
     }
 
-    std::unique_ptr<Shader> shader = createShader();
-
-    FileSystem& fs = FileSystem::GetInstance();
-
-    String shaderFolder = fs.join(sRootShaderFolder, getShaderFolder());
-    String shaderDescriptorFolder = fs.join(sRootShaderFolder, sShaderDescriptorFolder);
-
-    for (auto shaderType : sAvailableShaderTypes) {
-        bool ok = true;
-
-        const char* shaderExtension = "";
-        switch (shaderType) {
-            case ShaderType::VERTEX:
-                shaderExtension = ".vert";
-                break;
-            case ShaderType::FRAGMENT:
-                shaderExtension = ".frag";
-                break;
-            case ShaderType::GEOMETRY:
-                shaderExtension = ".geom";
-                break;
-        }
-
-        String filename = fs.join(shaderFolder, basename + shaderExtension);
-
-        bool filenameExist = fs.fileExists(filename);
-
-        // Vertex and Fragment shaders are completly required
-        if (!filenameExist && (shaderType == ShaderType::VERTEX || shaderType == ShaderType::FRAGMENT)) {
-            LogError(sTag, "Could not find file: {}", filename);
-            ok = false;
-        }
-
-        if (filenameExist) {
-            Vector<byte> filenameData;
-            fs.loadFileData(filename, &filenameData);
-            if (!shader->loadFromMemory(filenameData.data(), filenameData.size(), shaderType)) {
-                LogError(sTag, "Could not load shader: {}", basename);
-                ok = false;
-            }
-        }
-
-        if (!ok) {
-            return nullptr;
-        }
-    }
-
-    String filename = fs.join(shaderDescriptorFolder, "{}.json"_format(basename));
-    Vector<byte> jsonData;
-    fs.loadFileData(filename, &jsonData);
-    bool isValidDescriptor = json::accept(jsonData.begin(), jsonData.end());
-    if (isValidDescriptor) {
-        json j = json::parse(jsonData.begin(), jsonData.end());
-        shader->setDescriptor(std::move(j));
-    } else {
-        LogError(sTag, "Could not load shader descriptor: {}", basename);
+    std::unique_ptr<Shader> shader = createFromFile(basename);
+    if (shader == nullptr) {
         return nullptr;
     }
 
     newShader = shader.get();
-    if (shader != nullptr) {
-        m_shaders[basename] = std::move(shader);
-    }
+    m_shaderHandles[basename] = m_shaders.insert(std::move(shader));
 
     if (m_activeShader == nullptr) {
         m_activeShader = newShader;
@@ -149,13 +126,42 @@ Shader* ShaderManager::loadFromMemory(const String& name, const std::map<ShaderT
         }
     }
 
-    m_shaders[name] = std::move(newShader);
-    return m_shaders[name].get();
+    Shader* shader = newShader.get();
+    shader->m_name = name;
+    m_shaderHandles[name] = m_shaders.insert(std::move(newShader));
+    return shader;
+}
+
+Shader* ShaderManager::getShader(const StringId& name) {
+    auto it = m_shaderHandles.find(name);
+    return (it != m_shaderHandles.end()) ? getShader(it->second) : nullptr;
 }
 
-Shader* ShaderManager::getShader(const String& name) {
-    auto it = m_shaders.find(name);
-    return (it != m_shaders.end()) ? it->second.get() : nullptr;
+Shader* ShaderManager::getShader(const ShaderHandle& handle) {
+    std::unique_ptr<Shader>* shader = m_shaders.get(handle);
+    return (shader != nullptr) ? shader->get() : nullptr;
+}
+
+ShaderHandle ShaderManager::getShaderHandle(const StringId& name) const {
+    auto it = m_shaderHandles.find(name);
+    return (it != m_shaderHandles.end()) ? it->second : ShaderHandle();
+}
+
+bool ShaderManager::unload(const ShaderHandle& handle) {
+    Shader* shader = getShader(handle);
+    if (shader == nullptr) {
+        return false;
+    }
+
+    LogDebug(sTag, "Unloading shader: {}", shader->m_name);
+    m_shaderHandles.erase(shader->m_name);
+
+    if (m_activeShader == shader) {
+        m_activeShader = nullptr;
+    }
+    m_shaders.erase(handle);
+
+    return true;
 }
 
 void ShaderManager::setActiveShader(const String& name) {
@@ -172,4 +178,116 @@ Shader* ShaderManager::getActiveShader() {
     return m_activeShader;
 }
 
+bool ShaderManager::reload(const ShaderHandle& handle) {
+    std::unique_ptr<Shader>* slot = m_shaders.get(handle);
+    if (slot == nullptr || !(*slot)->m_isLoadedFromFile) {
+        return false;
+    }
+
+    Shader* shader = slot->get();
+    if (!isReloadSupported()) {
+        LogWarning(sTag, "The Renderer does not support reloading the shader: {}", shader->m_name);
+        return false;
+    }
+
+    // Keep the current shader if the new files have errors
+    std::unique_ptr<Shader> newShader = createFromFile(shader->m_name);
+    if (newShader == nullptr) {
+        LogError(sTag, "Could not reload shader: {}", shader->m_name);
+        return false;
+    }
+
+    bool isActive = (m_activeShader == shader);
+    *slot = std::move(newShader);
+    if (isActive) {
+        m_activeShader = slot->get();
+        useShader(m_activeShader);
+    }
+
+    LogInfo(sTag, "Reloaded shader: {}", (*slot)->m_name);
+    return true;
+}
+
+bool ShaderManager::isReloadSupported() const {
+    return true;
+}
+
+std::unique_ptr<Shader> ShaderManager::createFromFile(const String& basename) {
+    std::unique_ptr<Shader> shader = createShader();
+
+    FileSystem& fs = FileSystem::GetInstance();
+
+    for (auto shaderType : sAvailableShaderTypes) {
+        String filename = GetShaderFilename(fs, getShaderFolder(), basename, shaderType);
+
+        bool filenameExist = fs.fileExists(filename);
+
+        // Vertex and Fragment shaders are completly required
+        if (!filenameExist && (shaderType == ShaderType::VERTEX || shaderType == ShaderType::FRAGMENT)) {
+            LogError(sTag, "Could not find file: {}", filename);
+            return nullptr;
+        }
+
+        if (filenameExist) {
+            MappedFile filenameData;
+            if (!fs.mapFile(filename, &filenameData, MappedFile::Advice::SEQUENTIAL)) {
+                LogError(sTag, "Error loading file: {}", filename);
+                return nullptr;
+            }
+            if (!shader->loadFromMemory(filenameData.getData(), filenameData.getSize(), shaderType)) {
+                LogError(sTag, "Could not load shader: {}", basename);
+                return nullptr;
+            }
+        }
+    }
+
+    String filename = GetDescriptorFilename(fs, basename);
+    MappedFile jsonData;
+    if (!fs.mapFile(filename, &jsonData, MappedFile::Advice::SEQUENTIAL)) {
+        LogError(sTag, "Error loading file: {}", filename);
+        return nullptr;
+    }
+    // The plugins consume the descriptor as a DOM, it's validated while
+    // it's parsed instead of walking the document twice
+    json descriptor = json::parse(jsonData.begin(), jsonData.end(), nullptr, false);
+    if (descriptor.is_discarded()) {
+        LogError(sTag, "Could not load shader descriptor: {}", basename);
+        return nullptr;
+    }
+    shader->setDescriptor(std::move(descriptor));
+
+    shader->m_name = basename;
+    shader->m_isLoadedFromFile = true;
+    return shader;
+}
+
+void ShaderManager::onFilesChanged(const Vector<String>& filenames) {
+    FileSystem& fs = FileSystem::GetInstance();
+
+    auto isChanged = [&filenames, &fs](const String& filename) {
+        return std::find(filenames.begin(), filenames.end(), fs.normalizePath(filename)) != filenames.end();
+    };
+
+    // Each shader is reloaded once even if several of its files changed
+    Vector<ShaderHandle> changed;
+    for (const auto& pair : m_shaderHandles) {
+        const Shader* shader = getShader(pair.second);
+        if (shader == nullptr || !shader->m_isLoadedFromFile) {
+            continue;
+        }
+        bool isShaderChanged = isChanged(GetDescriptorFilename(fs, shader->m_name));
+        for (auto shaderType : sAvailableShaderTypes) {
+            isShaderChanged =
+                isShaderChanged || isChanged(GetShaderFilename(fs, getShaderFolder(), shader->m_name, shaderType));
+        }
+        if (isShaderChanged) {
+            changed.push_back(pair.second);
+        }
+    }
+
+    for (const ShaderHandle& handle : changed) {
+        reload(handle);
+    }
+}
+
 }  // namespace engine
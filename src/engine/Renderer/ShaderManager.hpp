@@ -3,9 +3,14 @@
 #include <Util/Prerequisites.hpp>
 
 #include <Renderer/Shader.hpp>
+#include <System/SignalConnection.hpp>
 #include <System/String.hpp>
+#include <System/StringId.hpp>
+#include <Util/Container/FlatHashMap.hpp>
+#include <Util/Container/SlotMap.hpp>
 #include <Util/Singleton.hpp>
 
+#include <map>
 #include <memory>
 
 namespace engine {
@@ -45,7 +50,41 @@ public:
      */
     Shader* loadFromMemory(const String& name, const std::map<ShaderType, String*>& shaderDataMap);
 
-    Shader* getShader(const String& name);
+    Shader* getShader(const StringId& name);
+
+    /**
+     * @brief Get the shader referenced by a handle in O(1)
+     *
+     * @return The Shader or nullptr if the handle is stale
+     */
+    Shader* getShader(const ShaderHandle& handle);
+
+    /**
+     * @brief Get the handle of a loaded shader
+     *
+     * @return The handle or an invalid handle if the shader is not loaded
+     */
+    ShaderHandle getShaderHandle(const StringId& name) const;
+
+    /**
+     * @brief Destroy a shader, the handles that reference it become stale
+     *
+     * @return true if the shader was unloaded, false if the handle was stale
+     */
+    bool unload(const ShaderHandle& handle);
+
+    /**
+     * @brief Load again the files of a shader
+     *
+     * @details The new shader replaces the previous one only if it
+     *          compiles, the handles that reference it stay valid but
+     *          the pointers to the previous Shader are destroyed
+     *
+     * @return true if the shader was reloaded, false if the handle is
+     *         stale, the shader was not loaded from files or the new
+     *         files could not be loaded
+     */
+    bool reload(const ShaderHandle& handle);
 
     void setActiveShader(const String& basename);
 
@@ -58,8 +97,21 @@ protected:
 
     virtual const StringView& getShaderFolder() const = 0;
 
+    /**
+     * @brief Check if the Renderer can replace the shaders while running
+     */
+    virtual bool isReloadSupported() const;
+
     Shader* m_activeShader;
-    std::map<String, std::unique_ptr<Shader>> m_shaders;
+    SlotMap<std::unique_ptr<Shader>, Shader> m_shaders;
+    FlatHashMap<StringId, ShaderHandle> m_shaderHandles;
+
+private:
+    std::unique_ptr<Shader> createFromFile(const String& basename);
+
+    void onFilesChanged(const Vector<String>& filenames);
+
+    SignalConnection m_onFilesChangedConnection;
 };
 
 }  // namespace engine
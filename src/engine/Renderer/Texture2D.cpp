@@ -0,0 +1,24 @@
+#include <Renderer/Texture2D.hpp>
+
+#include <System/SlabAllocator.hpp>
+
+namespace engine {
+
+namespace {
+
+SlabAllocator& GetTexture2DAllocator() {
+    static SlabAllocator sTexture2DAllocator("Texture2D", 128);
+    return sTexture2DAllocator;
+}
+
+}  // namespace
+
+void* Texture2D::operator new(size_t size) {
+    return GetTexture2DAllocator().allocate(size);
+}
+
+void Texture2D::operator delete(void* pointer, size_t size) {
+    GetTexture2DAllocator().deallocate(pointer, size);
+}
+
+}  // namespace engine
@@ -1,19 +1,87 @@
 #pragma once
 
 #include <Graphics/Image.hpp>
+#include <System/String.hpp>
+#include <Util/Container/Vector.hpp>
+#include <Util/Handle.hpp>
 #include <Util/NonCopyable.hpp>
 
 namespace engine {
 
 class ENGINE_API Texture2D : NonCopyable {
+    friend class TextureManager;
+
 public:
     Texture2D() = default;
 
     virtual ~Texture2D() = default;
 
+    /**
+     * @brief The textures are allocated from a SlabAllocator, see Mesh
+     */
+    static void* operator new(size_t size);
+
+    static void operator delete(void* pointer, size_t size);
+
     virtual bool loadFromImage(const Image& img) = 0;
 
+    /**
+     * @brief Release the device memory used by the texture
+     *
+     * @details The texture handler stays valid and can be loaded
+     *          again using loadFromImage
+     */
+    virtual void unload() = 0;
+
     virtual void use() = 0;
+
+    /**
+     * @brief Get the handle used to reference the texture in the
+     *        TextureManager
+     */
+    const Handle<Texture2D>& getHandle() const {
+        return m_handle;
+    }
+
+    /**
+     * @brief Check if the texture data is currently loaded in the
+     *        device memory
+     */
+    bool isResident() const {
+        return m_isResident;
+    }
+
+    /**
+     * @brief Get the device memory currently used by the texture
+     *
+     * @return The size in bytes, 0 if the texture is not resident
+     */
+    size_t getMemorySize() const {
+        return m_memorySize;
+    }
+
+private:
+    // Names, handle and content hash used to reference the texture in the
+    // TextureManager, all the names with the same content share the texture
+    Vector<String> m_names;
+    // Source file of each name, empty for the names loaded from an Image
+    Vector<String> m_filenames;
+    Handle<Texture2D> m_handle;
+    uint64 m_contentHash = 0;
+
+    // Residency information managed by the TextureManager, the texture is
+    // streamed from the file of any of its names
+    String m_filename;
+    math::uvec2 m_size;
+    size_t m_memorySize = 0;
+    uint64 m_lastUsedFrame = 0;
+    float m_priority = 0.0F;
+    uint32 m_mipBias = 0;
+    uint32 m_maxMipBias = 0;
+    bool m_isResident = false;
+    bool m_isStreaming = false;
 };
 
+using TextureHandle = Handle<Texture2D>;
+
 }  // namespace engine
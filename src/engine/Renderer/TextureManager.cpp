@@ -3,11 +3,16 @@
 #include <Core/Main.hpp>
 #include <System/FileSystem.hpp>
 #include <System/LogManager.hpp>
+#include <System/Stopwatch.hpp>
 #include <System/StringFormat.hpp>
 #include <System/StringView.hpp>
 #include <Util/Container/Vector.hpp>
+#include <Util/Hash.hpp>
 
+#include <algorithm>
 #include <memory>
+#include <set>
+
 
 namespace engine {
 
@@ -17,11 +22,76 @@ const StringView sTag("TextureManager");
 
 const StringView sRootTextureFolder("textures");
 
+// Smallest size a streamed texture is reduced to
+const uint32 sMinStreamedSize(32);
+
+// Maximum number of mip levels streamed in each frame
+const uint32 sMaxStreamedLevelsPerFrame(4);
+
+size_t ComputeTextureMemory(const math::uvec2& size) {
+    // Size of the base level plus the mip chain
+    size_t baseLevelSize = static_cast<size_t>(size.x) * static_cast<size_t>(size.y) * 4;
+    return baseLevelSize + baseLevelSize / 3;
+}
+
+math::uvec2 GetMipSize(const math::uvec2& size, uint32 mipBias) {
+    return math::uvec2(std::max(size.x >> mipBias, 1U), std::max(size.y >> mipBias, 1U));
+}
+
+uint32 ComputeMaxMipBias(const math::uvec2& size) {
+    uint32 mipBias = 0;
+    while ((size.x >> (mipBias + 1)) >= sMinStreamedSize && (size.y >> (mipBias + 1)) >= sMinStreamedSize) {
+        mipBias++;
+    }
+    return mipBias;
+}
+
+uint64 ComputeImageHash(const Image& image) {
+    // The size is used as seed so images with the same pixels but
+    // different dimensions are not shared
+    math::uvec2 size = image.getSize();
+    uint64 seed = (static_cast<uint64>(size.x) << 32) | size.y;
+    return Hash64(image.getData(), static_cast<size_t>(size.x) * size.y * 4, seed);
+}
+
+void DownscaleImage(Image& image, uint32 mipBias) {
+    for (uint32 level = 0; level < mipBias; level++) {
+        math::uvec2 size = image.getSize();
+        math::uvec2 newSize = GetMipSize(size, 1);
+
+        // 2x2 box filter over the previous level
+        const byte* src = image.getData();
+        Vector<byte> pixels(static_cast<size_t>(newSize.x) * newSize.y * 4);
+        for (uint32 y = 0; y < newSize.y; y++) {
+            uint32 y0 = std::min(y * 2, size.y - 1);
+            uint32 y1 = std::min(y * 2 + 1, size.y - 1);
+            for (uint32 x = 0; x < newSize.x; x++) {
+                uint32 x0 = std::min(x * 2, size.x - 1);
+                uint32 x1 = std::min(x * 2 + 1, size.x - 1);
+                for (uint32 c = 0; c < 4; c++) {
+                    uint32 sum = src[(y0 * size.x + x0) * 4 + c] + src[(y0 * size.x + x1) * 4 + c] +
+                                 src[(y1 * size.x + x0) * 4 + c] + src[(y1 * size.x + x1) * 4 + c];
+                    pixels[(y * newSize.x + x) * 4 + c] = static_cast<byte>(sum / 4);
+                }
+            }
+        }
+
+        image.loadFromMemory(reinterpret_cast<const Color32*>(pixels.data()), newSize.x, newSize.y);
+    }
+}
+
 }  // namespace
 
 const StringView TextureManager::sDefaultTextureId("DEFAULT");
 
-TextureManager::TextureManager() : m_activeTexture(nullptr) {}
+TextureManager::TextureManager()
+      : m_activeTexture(nullptr),
+        m_currentFrame(1),
+        m_memoryBudget(0),
+        m_residentMemory(0),
+        m_totalEvictions(0),
+        m_totalStreamedLevels(0),
+        m_pendingReleasedMemory(0) {}
 
 TextureManager::~TextureManager() = default;
 
@@ -34,13 +104,33 @@ void TextureManager::initialize() {
     defaultImage.loadFromMemory(defaultTextureData.data(), defaultTextureSize.x, defaultTextureSize.y);
 
     loadFromImage(sDefaultTextureId, defaultImage);
+
+    FileSystem::GetInstance().watchFolder(sRootTextureFolder);
+    m_onFilesChangedConnection =
+        FileSystem::GetInstance().onFilesChanged.connect(*this, &TextureManager::onFilesChanged);
 }
 
 void TextureManager::shutdown() {
+    FileSystem::GetInstance().onFilesChanged.disconnect(m_onFilesChangedConnection);
+    FileSystem::GetInstance().unwatchFolder(sRootTextureFolder);
+
+    // The workers keep their own reference to the requests still decoding
+    m_streamRequests.clear();
+    m_pendingReleasedMemory = 0;
+
+    m_textureHandles.clear();
+    m_contentHandles.clear();
     m_textures.clear();
+    m_activeTexture = nullptr;
+    m_residentMemory = 0;
 }
 
 Texture2D* TextureManager::loadFromFile(const String& basename) {
+    Texture2D* texture = getTexture2D(basename);
+    if (texture != nullptr) {
+        return texture;
+    }
+
     FileSystem& fs = FileSystem::GetInstance();
 
     String filename = fs.join(sRootTextureFolder, basename);
@@ -52,17 +142,107 @@ Texture2D* TextureManager::loadFromFile(const String& basename) {
             LogDebug(sTag, "Could create Image from file: {}", basename);
             return nullptr;
         }
-        return loadFromImage(basename, image);
+        return loadFromFileImage(basename, filename, image, ComputeImageHash(image));
     }
     LogError(sTag, "Texture2D not loaded. File '{}' not found.", filename.toUtf8());
     return nullptr;
 }
 
+Vector<Texture2D*> TextureManager::loadFromFiles(const Vector<String>& basenames) {
+    FileSystem& fs = FileSystem::GetInstance();
+
+    // Decode only once the textures that are not loaded yet
+    Vector<String> pending;
+    std::set<String> pendingSet;
+    for (const String& basename : basenames) {
+        if (getTexture2D(basename) == nullptr && pendingSet.insert(basename).second) {
+            pending.push_back(basename);
+        }
+    }
+
+    if (!pending.empty()) {
+        Stopwatch timer;
+        timer.start();
+
+        Vector<String> filenames =
+            pending.map([&fs](const String& basename) { return fs.join(sRootTextureFolder, basename); });
+
+        // Read all the files in a single batch before decoding them
+        Vector<FileReadRequest> requests(pending.size());
+        for (size_t i = 0; i < pending.size(); i++) {
+            requests[i].filename = filenames[i];
+        }
+        Vector<FileReadRequest> files = fs.readFilesAsync(std::move(requests)).get();
+
+        Time readTime = timer.getElapsedTime();
+        timer.restart();
+
+        Vector<Image> images(pending.size());
+        Vector<uint8> decoded(pending.size(), 0);
+        Vector<uint64> contentHashes(pending.size(), 0);
+
+        Main::GetInstance().executeParallel(pending.size(), [&files, &images, &decoded, &contentHashes](size_t i) {
+            FileReadRequest& file = files[i];
+            decoded[i] = file.succeeded && images[i].loadFromFileInMemory(file.data.data(),
+                                                                          static_cast<uint32>(file.data.size()));
+            if (decoded[i]) {
+                contentHashes[i] = ComputeImageHash(images[i]);
+            }
+            file.data = Vector<byte>();
+        });
+
+        Time decodeTime = timer.getElapsedTime();
+        timer.restart();
+
+        for (size_t i = 0; i < pending.size(); i++) {
+            if (decoded[i]) {
+                loadFromFileImage(pending[i], filenames[i], images[i], contentHashes[i]);
+            } else {
+                LogError(sTag, "Texture2D not loaded. Could not decode file '{}'", filenames[i]);
+            }
+            images[i].clear();
+        }
+
+        Time uploadTime = timer.getElapsedTime();
+
+        LogInfo(sTag, "Loaded {} textures (read: {}ms, decode: {}ms, upload: {}ms)", pending.size(),
+                readTime.asMilliseconds(), decodeTime.asMilliseconds(), uploadTime.asMilliseconds());
+    }
+
+    return basenames.map([this](const String& basename) { return getTexture2D(basename); });
+}
+
 Texture2D* TextureManager::loadFromImage(const String& name, const Image& image) {
     Texture2D* texture = getTexture2D(name);
     if (texture != nullptr) {
         return texture;
     }
+    return loadFromImageHash(name, image, ComputeImageHash(image), String());
+}
+
+Texture2D* TextureManager::loadFromImageHash(const String& name,
+                                             const Image& image,
+                                             uint64 contentHash,
+                                             const String& filename) {
+    Texture2D* texture = getTexture2D(name);
+    if (texture != nullptr) {
+        return texture;
+    }
+
+    // Share the texture already loaded with the same content. All the
+    // images are RGBA, so the 64 bits hash of the pixels and the size
+    // identify the content without keeping or decoding the pixels again
+    auto contentIt = m_contentHandles.find(contentHash);
+    if (contentIt != m_contentHandles.end()) {
+        texture = getTexture2D(contentIt->second);
+        if (texture != nullptr && texture->m_size.x == image.getSize().x && texture->m_size.y == image.getSize().y) {
+            LogDebug(sTag, "Texture '{}' shares the content of '{}'", name, texture->m_names.first());
+            texture->m_names.push_back(name);
+            texture->m_filenames.push_back(filename);
+            m_textureHandles[name] = texture->m_handle;
+            return texture;
+        }
+    }
 
     std::unique_ptr<Texture2D> newTexture = createTexture2D();
     if (newTexture != nullptr) {
@@ -77,7 +257,17 @@ Texture2D* TextureManager::loadFromImage(const String& name, const Image& image)
 
     texture = newTexture.get();
     if (newTexture != nullptr) {
-        m_textures[name] = std::move(newTexture);
+        texture->m_size = image.getSize();
+        texture->m_memorySize = ComputeTextureMemory(image.getSize());
+        texture->m_lastUsedFrame = m_currentFrame;
+        texture->m_isResident = true;
+        texture->m_names.push_back(name);
+        texture->m_filenames.push_back(filename);
+        texture->m_contentHash = contentHash;
+        m_residentMemory += texture->m_memorySize;
+        texture->m_handle = m_textures.insert(std::move(newTexture));
+        m_textureHandles[name] = texture->m_handle;
+        m_contentHandles[contentHash] = texture->m_handle;
     }
 
     // TMP
@@ -88,15 +278,188 @@ Texture2D* TextureManager::loadFromImage(const String& name, const Image& image)
     return texture;
 }
 
-Texture2D* TextureManager::getTexture2D(const String& name) {
-    auto it = m_textures.find(name);
-    return (it != m_textures.end()) ? it->second.get() : nullptr;
+Texture2D* TextureManager::getTexture2D(const StringId& name) {
+    auto it = m_textureHandles.find(name);
+    return (it != m_textureHandles.end()) ? getTexture2D(it->second) : nullptr;
+}
+
+Texture2D* TextureManager::getTexture2D(const TextureHandle& handle) {
+    std::unique_ptr<Texture2D>* texture = m_textures.get(handle);
+    return (texture != nullptr) ? texture->get() : nullptr;
+}
+
+TextureHandle TextureManager::getTextureHandle(const StringId& name) const {
+    auto it = m_textureHandles.find(name);
+    return (it != m_textureHandles.end()) ? it->second : TextureHandle();
+}
+
+bool TextureManager::unload(const TextureHandle& handle) {
+    Texture2D* texture = getTexture2D(handle);
+    if (texture == nullptr) {
+        return false;
+    }
+
+    LogDebug(sTag, "Unloading Texture: {}", texture->m_names.first());
+
+    if (texture->m_isStreaming) {
+        cancelStreamRequests(handle);
+    }
+    if (texture->m_isResident) {
+        m_residentMemory -= texture->m_memorySize;
+    }
+    for (const String& name : texture->m_names) {
+        m_textureHandles.erase(name);
+    }
+    auto contentIt = m_contentHandles.find(texture->m_contentHash);
+    if (contentIt != m_contentHandles.end() && contentIt->second == handle) {
+        m_contentHandles.erase(contentIt);
+    }
+
+    if (m_activeTexture == texture) {
+        m_activeTexture = nullptr;
+    }
+    m_textures.erase(handle);
+
+    if (m_activeTexture == nullptr) {
+        m_activeTexture = getTexture2D(sDefaultTextureId);
+    }
+
+    return true;
+}
+
+bool TextureManager::unload(const StringId& name) {
+    auto it = m_textureHandles.find(name);
+    if (it == m_textureHandles.end()) {
+        return false;
+    }
+
+    TextureHandle handle = it->second;
+    Texture2D* texture = getTexture2D(handle);
+    if (texture->m_names.size() <= 1) {
+        return unload(handle);
+    }
+
+    // Other names still share the texture
+    auto nameIt = std::find_if(texture->m_names.begin(), texture->m_names.end(),
+                               [&name](const String& textureName) { return StringId(textureName) == name; });
+    if (nameIt != texture->m_names.end()) {
+        texture->m_filenames.erase(texture->m_filenames.begin() + (nameIt - texture->m_names.begin()));
+        texture->m_names.erase(nameIt);
+        updateSourceFile(texture);
+    }
+    m_textureHandles.erase(it);
+
+    return true;
+}
+
+bool TextureManager::reload(const TextureHandle& handle) {
+    Texture2D* texture = getTexture2D(handle);
+    if (texture == nullptr || texture->m_filename.isEmpty()) {
+        return false;
+    }
+
+    Image image;
+    if (!image.loadFromFile(texture->m_filename)) {
+        LogError(sTag, "Could not reload texture: {}", texture->m_filename);
+        return false;
+    }
+
+    // The levels being decoded have the previous content of the file
+    if (texture->m_isStreaming) {
+        cancelStreamRequests(handle);
+        texture->m_isStreaming = false;
+    }
+
+    // The texture is no longer shared with the textures that have the
+    // previous content
+    uint64 contentHash = ComputeImageHash(image);
+    auto contentIt = m_contentHandles.find(texture->m_contentHash);
+    if (contentIt != m_contentHandles.end() && contentIt->second == handle) {
+        m_contentHandles.erase(contentIt);
+    }
+    m_contentHandles.emplace(contentHash, handle);
+    texture->m_contentHash = contentHash;
+
+    texture->m_size = image.getSize();
+    texture->m_maxMipBias = ComputeMaxMipBias(texture->m_size);
+    texture->m_mipBias = std::min(texture->m_mipBias, texture->m_maxMipBias);
+
+    if (texture->m_isResident) {
+        DownscaleImage(image, texture->m_mipBias);
+        if (!texture->loadFromImage(image)) {
+            LogError(sTag, "Could not upload reloaded texture: {}", texture->m_filename);
+            return false;
+        }
+        m_residentMemory -= texture->m_memorySize;
+        texture->m_memorySize = ComputeTextureMemory(image.getSize());
+        m_residentMemory += texture->m_memorySize;
+    }
+
+    LogInfo(sTag, "Reloaded texture: {}", texture->m_filename);
+    return true;
+}
+
+bool TextureManager::reload(const StringId& name) {
+    auto it = m_textureHandles.find(name);
+    if (it == m_textureHandles.end()) {
+        return false;
+    }
+
+    TextureHandle handle = it->second;
+    Texture2D* texture = getTexture2D(handle);
+    auto nameIt = std::find_if(texture->m_names.begin(), texture->m_names.end(),
+                               [&name](const String& textureName) { return StringId(textureName) == name; });
+    if (nameIt == texture->m_names.end()) {
+        return false;
+    }
+    size_t index = static_cast<size_t>(nameIt - texture->m_names.begin());
+    if (texture->m_filenames[index].isEmpty()) {
+        return false;
+    }
+
+    // The texture is reloaded in place when nobody else needs the
+    // previous content, or when it can't be restored without its file
+    bool hasOtherFile = false;
+    for (size_t i = 0; i < texture->m_filenames.size(); i++) {
+        hasOtherFile |= i != index && !texture->m_filenames[i].isEmpty();
+    }
+    bool isComplete = texture->m_isResident && texture->m_mipBias == 0;
+    if (texture->m_names.size() == 1 || (!hasOtherFile && !isComplete)) {
+        return reload(handle);
+    }
+
+    String basename = *nameIt;
+    String filename = texture->m_filenames[index];
+    Image image;
+    if (!image.loadFromFile(filename)) {
+        LogError(sTag, "Could not reload texture: {}", filename);
+        return false;
+    }
+
+    // The other names keep the previous content, the levels being
+    // decoded from the changed file are discarded
+    if (texture->m_isStreaming && texture->m_filename == filename) {
+        cancelStreamRequests(handle);
+        texture->m_isStreaming = false;
+    }
+    texture->m_names.erase(nameIt);
+    texture->m_filenames.erase(texture->m_filenames.begin() + index);
+    m_textureHandles.erase(it);
+    updateSourceFile(texture);
+
+    if (loadFromFileImage(basename, filename, image, ComputeImageHash(image)) == nullptr) {
+        return false;
+    }
+
+    LogInfo(sTag, "Reloaded texture: {}", filename);
+    return true;
 }
 
 void TextureManager::setActiveTexture2D(const String& basename) {
     Texture2D* foundTexture = getTexture2D(basename);
     if (foundTexture != nullptr) {
         m_activeTexture = foundTexture;
+        touch(m_activeTexture);
         useTexture2D(m_activeTexture);
     } else {
         LogError(sTag, "Could not find a Texture2D named: {}", basename.toUtf8());
@@ -107,4 +470,285 @@ Texture2D* TextureManager::getActiveTexture2D() {
     return m_activeTexture;
 }
 
+void TextureManager::touch(Texture2D* texture, float priority) {
+    if (texture == nullptr) {
+        return;
+    }
+
+    if (texture->m_lastUsedFrame != m_currentFrame) {
+        texture->m_lastUsedFrame = m_currentFrame;
+        texture->m_priority = priority;
+    } else {
+        texture->m_priority = std::max(texture->m_priority, priority);
+    }
+
+    // Bring back evicted textures with its lowest resolution, the higher
+    // mip levels are streamed in on the next frames
+    if (!texture->m_isResident && !texture->m_filename.isEmpty()) {
+        streamTexture(texture, texture->m_maxMipBias);
+    }
+}
+
+void TextureManager::advanceFrame() {
+    uploadStreamedTextures();
+
+    // The memory of the levels being dropped by the workers is already
+    // counted as released
+    size_t residentMemory = m_residentMemory - m_pendingReleasedMemory;
+    if (m_memoryBudget > 0 && residentMemory > m_memoryBudget) {
+        Vector<Texture2D*> candidates;
+        for (auto& value : m_textures) {
+            Texture2D* texture = value.get();
+            if (texture->m_isResident && !texture->m_filename.isEmpty() && texture != m_activeTexture) {
+                candidates.push_back(texture);
+            }
+        }
+
+        // Least recently used textures first, then the ones with lower priority
+        std::sort(candidates.begin(), candidates.end(), [](const Texture2D* left, const Texture2D* right) {
+            if (left->m_lastUsedFrame != right->m_lastUsedFrame) {
+                return left->m_lastUsedFrame < right->m_lastUsedFrame;
+            }
+            return left->m_priority < right->m_priority;
+        });
+
+        // 1. Evict the textures that were not used during this frame
+        for (Texture2D* texture : candidates) {
+            if (m_residentMemory - m_pendingReleasedMemory <= m_memoryBudget) {
+                break;
+            }
+            if (texture->m_lastUsedFrame < m_currentFrame && !texture->m_isStreaming) {
+                evictTexture(texture);
+            }
+        }
+
+        // 2. Drop the top mip levels of the textures still in use
+        for (Texture2D* texture : candidates) {
+            if (m_residentMemory - m_pendingReleasedMemory <= m_memoryBudget) {
+                break;
+            }
+            if (!texture->m_isResident || texture->m_isStreaming || texture->m_mipBias >= texture->m_maxMipBias) {
+                continue;
+            }
+            size_t overflow = m_residentMemory - m_pendingReleasedMemory - m_memoryBudget;
+            uint32 mipBias = texture->m_mipBias + 1;
+            while (mipBias < texture->m_maxMipBias &&
+                   texture->m_memorySize - ComputeTextureMemory(GetMipSize(texture->m_size, mipBias)) < overflow) {
+                mipBias++;
+            }
+            streamTexture(texture, mipBias);
+        }
+    }
+
+    // 3. Stream in the mip levels of the reduced textures used in this frame
+    Vector<Texture2D*> reduced;
+    for (auto& value : m_textures) {
+        Texture2D* texture = value.get();
+        if (texture->m_isResident && !texture->m_isStreaming && texture->m_mipBias > 0 &&
+            texture->m_lastUsedFrame == m_currentFrame) {
+            reduced.push_back(texture);
+        }
+    }
+    std::sort(reduced.begin(), reduced.end(),
+              [](const Texture2D* left, const Texture2D* right) { return left->m_priority > right->m_priority; });
+
+    uint32 streamedLevels = 0;
+    for (Texture2D* texture : reduced) {
+        if (streamedLevels >= sMaxStreamedLevelsPerFrame) {
+            break;
+        }
+        uint32 mipBias = texture->m_mipBias - 1;
+        size_t requiredMemory = ComputeTextureMemory(GetMipSize(texture->m_size, mipBias)) - texture->m_memorySize;
+        if (m_memoryBudget > 0 && m_residentMemory - m_pendingReleasedMemory + requiredMemory > m_memoryBudget) {
+            continue;
+        }
+        if (streamTexture(texture, mipBias)) {
+            streamedLevels++;
+        }
+    }
+
+    m_currentFrame++;
+}
+
+void TextureManager::setMemoryBudget(size_t bytes) {
+    m_memoryBudget = bytes;
+}
+
+size_t TextureManager::getMemoryBudget() const {
+    return m_memoryBudget;
+}
+
+TextureResidencyStats TextureManager::getResidencyStats() const {
+    TextureResidencyStats stats;
+    stats.memoryBudget = m_memoryBudget;
+    stats.residentMemory = m_residentMemory;
+    stats.totalEvictions = m_totalEvictions;
+    stats.totalStreamedLevels = m_totalStreamedLevels;
+    for (const auto& value : m_textures) {
+        const Texture2D* texture = value.get();
+        if (texture->m_names.size() > 1) {
+            size_t sharedCount = texture->m_names.size() - 1;
+            stats.sharedTextures += static_cast<uint32>(sharedCount);
+            stats.savedMemory += sharedCount * ComputeTextureMemory(texture->m_size);
+        }
+        if (!texture->m_isResident) {
+            stats.evictedTextures++;
+        } else {
+            stats.residentTextures++;
+            if (texture->m_mipBias > 0) {
+                stats.reducedTextures++;
+            }
+        }
+    }
+    return stats;
+}
+
+Texture2D* TextureManager::loadFromFileImage(const String& basename,
+                                             const String& filename,
+                                             const Image& image,
+                                             uint64 contentHash) {
+    Texture2D* texture = loadFromImageHash(basename, image, contentHash, filename);
+    if (texture != nullptr && texture->m_filename.isEmpty()) {
+        updateSourceFile(texture);
+    }
+    return texture;
+}
+
+void TextureManager::updateSourceFile(Texture2D* texture) {
+    // All the names have the same content, any of their files can be used.
+    // Only the textures that can be loaded again from a file are streamed
+    auto it = std::find_if(texture->m_filenames.begin(), texture->m_filenames.end(),
+                           [](const String& filename) { return !filename.isEmpty(); });
+    if (it != texture->m_filenames.end()) {
+        texture->m_filename = *it;
+        texture->m_maxMipBias = ComputeMaxMipBias(texture->m_size);
+    } else {
+        texture->m_filename = String();
+        texture->m_maxMipBias = 0;
+    }
+}
+
+bool TextureManager::streamTexture(Texture2D* texture, uint32 mipBias) {
+    if (texture->m_isStreaming) {
+        return false;
+    }
+
+    auto request = std::make_shared<StreamRequest>();
+    request->handle = texture->m_handle;
+    request->filename = texture->m_filename;
+    request->mipBias = mipBias;
+    request->restoresTexture = !texture->m_isResident;
+    if (texture->m_isResident && mipBias > texture->m_mipBias) {
+        request->releasedMemory = texture->m_memorySize - ComputeTextureMemory(GetMipSize(texture->m_size, mipBias));
+        m_pendingReleasedMemory += request->releasedMemory;
+    }
+
+    texture->m_isStreaming = true;
+    m_streamRequests.push_back(request);
+
+    // The worker only touches the request, the texture is uploaded by
+    // the next advanceFrame once the image is decoded
+    auto decode = [request]() {
+        request->decoded = request->image.loadFromFile(request->filename);
+        if (request->decoded) {
+            DownscaleImage(request->image, request->mipBias);
+        }
+        request->completed.store(true, std::memory_order_release);
+    };
+
+    Main* main = Main::GetInstancePtr();
+    if (main != nullptr) {
+        main->executeAsync(std::move(decode));
+    } else {
+        decode();
+    }
+
+    return true;
+}
+
+void TextureManager::uploadStreamedTextures() {
+    auto it = m_streamRequests.begin();
+    while (it != m_streamRequests.end()) {
+        StreamRequest& request = **it;
+        if (!request.completed.load(std::memory_order_acquire)) {
+            ++it;
+            continue;
+        }
+
+        m_pendingReleasedMemory -= request.releasedMemory;
+
+        // Skip the textures unloaded or reloaded while decoding
+        Texture2D* texture = getTexture2D(request.handle);
+        if (texture != nullptr && !request.cancelled) {
+            texture->m_isStreaming = false;
+            if (!request.decoded) {
+                LogError(sTag, "Could not stream texture: {}", request.filename);
+            } else if (texture->m_isResident || request.restoresTexture) {
+                uploadStreamedTexture(texture, request.image, request.mipBias);
+            }
+        }
+
+        it = m_streamRequests.erase(it);
+    }
+}
+
+void TextureManager::cancelStreamRequests(const TextureHandle& handle) {
+    for (auto& request : m_streamRequests) {
+        if (request->handle == handle && !request->cancelled) {
+            request->cancelled = true;
+            m_pendingReleasedMemory -= request->releasedMemory;
+            request->releasedMemory = 0;
+        }
+    }
+}
+
+bool TextureManager::uploadStreamedTexture(Texture2D* texture, const Image& image, uint32 mipBias) {
+    if (!texture->loadFromImage(image)) {
+        LogError(sTag, "Could not upload streamed texture: {}", texture->m_filename);
+        return false;
+    }
+
+    m_residentMemory -= texture->m_memorySize;
+    texture->m_memorySize = ComputeTextureMemory(image.getSize());
+    texture->m_mipBias = mipBias;
+    texture->m_isResident = true;
+    m_residentMemory += texture->m_memorySize;
+    m_totalStreamedLevels++;
+
+    return true;
+}
+
+void TextureManager::onFilesChanged(const Vector<String>& filenames) {
+    FileSystem& fs = FileSystem::GetInstance();
+
+    // Each name is reloaded on its own, the names that share a texture
+    // may come from different files
+    Vector<String> changed;
+    for (auto& value : m_textures) {
+        Texture2D* texture = value.get();
+        for (size_t i = 0; i < texture->m_names.size(); i++) {
+            const String& filename = texture->m_filenames[i];
+            if (!filename.isEmpty() &&
+                std::find(filenames.begin(), filenames.end(), fs.normalizePath(filename)) != filenames.end()) {
+                changed.push_back(texture->m_names[i]);
+            }
+        }
+    }
+
+    for (const String& name : changed) {
+        reload(name);
+    }
+}
+
+void TextureManager::evictTexture(Texture2D* texture) {
+    LogDebug(sTag, "Evicting texture: {}", texture->m_filename);
+
+    texture->unload();
+
+    m_residentMemory -= texture->m_memorySize;
+    texture->m_memorySize = 0;
+    texture->m_isResident = false;
+    m_totalEvictions++;
+}
+
 }  // namespace engine
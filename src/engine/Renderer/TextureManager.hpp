@@ -2,18 +2,39 @@
 
 #include <Util/Prerequisites.hpp>
 
+#include <Graphics/Image.hpp>
 #include <Renderer/Texture2D.hpp>
+#include <System/SignalConnection.hpp>
+#include <System/String.hpp>
+#include <System/StringId.hpp>
+#include <Util/Container/FlatHashMap.hpp>
+#include <Util/Container/SlotMap.hpp>
+#include <Util/Container/Vector.hpp>
 #include <Util/Singleton.hpp>
 
-#include <map>
+#include <atomic>
 #include <memory>
 
 namespace engine {
 
 class Texture2D;
-class Image;
 class String;
 
+/**
+ * @brief Snapshot of the device memory used by the loaded textures
+ */
+struct TextureResidencyStats {
+    size_t memoryBudget = 0;
+    size_t residentMemory = 0;
+    uint32 residentTextures = 0;
+    uint32 reducedTextures = 0;
+    uint32 evictedTextures = 0;
+    uint64 totalEvictions = 0;
+    uint64 totalStreamedLevels = 0;
+    uint32 sharedTextures = 0;
+    size_t savedMemory = 0;
+};
+
 class ENGINE_API TextureManager : public Singleton<TextureManager> {
 public:
     static const StringView sDefaultTextureId;
@@ -33,25 +54,176 @@ public:
      */
     virtual Texture2D* loadFromFile(const String& basename);
 
+    /**
+     * @brief Load multiple textures from the filesystem, the files are
+     *        read and decoded in parallel and then uploaded one by one
+     *        from the calling thread
+     *
+     * @return The Texture2D handlers in the same order of basenames,
+     *         nullptr for the ones that could not be loaded
+     */
+    Vector<Texture2D*> loadFromFiles(const Vector<String>& basenames);
+
     /**
      * @brief Load a texture from a Image
      *
+     * @details If a texture with the same content is already loaded it
+     *          is shared instead of uploading the Image again
+     *
      * @return On success returns the Texture2D handler or nullptr on failure
      */
     virtual Texture2D* loadFromImage(const String& name, const Image& image);
 
-    Texture2D* getTexture2D(const String& name);
+    Texture2D* getTexture2D(const StringId& name);
+
+    /**
+     * @brief Get the texture referenced by a handle in O(1)
+     *
+     * @return The Texture2D or nullptr if the handle is stale
+     */
+    Texture2D* getTexture2D(const TextureHandle& handle);
+
+    /**
+     * @brief Get the handle of a loaded texture
+     *
+     * @return The handle or an invalid handle if the texture is not loaded
+     */
+    TextureHandle getTextureHandle(const StringId& name) const;
+
+    /**
+     * @brief Destroy a texture, the handles that reference it become stale
+     *
+     * @details The texture is destroyed even if it is shared by other names
+     *
+     * @return true if the texture was unloaded, false if the handle was stale
+     */
+    bool unload(const TextureHandle& handle);
+
+    /**
+     * @brief Release the texture loaded with the given name, the texture
+     *        is only destroyed when no other name shares it
+     *
+     * @return true if the name was released, false if it was not loaded
+     */
+    bool unload(const StringId& name);
+
+    /**
+     * @brief Load again the file of a texture into the same Texture2D
+     *
+     * @details The handles and pointers to the texture stay valid. If
+     *          the texture is shared by other names they also see the
+     *          new content, reload(const StringId&) keeps the previous
+     *          content for them. Evicted textures are loaded the next
+     *          time they are used.
+     *
+     * @return true if the texture was reloaded, false if the handle is
+     *         stale, the texture was not loaded from a file or the file
+     *         could not be decoded
+     */
+    bool reload(const TextureHandle& handle);
+
+    /**
+     * @brief Load again the file of the texture loaded with the given name
+     *
+     * @details If the texture is shared by other names they keep the
+     *          previous content, the name is split into its own texture
+     *          or shares the texture that has the new content
+     *
+     * @return true if the name was reloaded, false if it was not loaded
+     *         from a file or the file could not be decoded
+     */
+    bool reload(const StringId& name);
 
     void setActiveTexture2D(const String& basename);
 
     Texture2D* getActiveTexture2D();
 
+    /**
+     * @brief Mark a texture as used in the current frame
+     *
+     * @details If the texture was evicted it is decoded again at its
+     *          lowest resolution in a worker and uploaded by the next
+     *          advanceFrame, higher mip levels are streamed in on the
+     *          following frames according to its priority
+     *
+     * @param texture The texture that is going to be used
+     * @param priority Streaming priority, higher values are streamed
+     *                 in first and reduced last
+     */
+    void touch(Texture2D* texture, float priority = 1.0F);
+
+    /**
+     * @brief Upload the textures decoded by the workers, then stream in
+     *        or evict textures to fit in the memory budget, must be
+     *        called once per frame after drawing
+     */
+    void advanceFrame();
+
+    /**
+     * @brief Set the maximum device memory used by textures loaded from
+     *        files, textures created from an Image are never evicted
+     *
+     * @param bytes The memory budget in bytes, 0 disables the budget
+     */
+    void setMemoryBudget(size_t bytes);
+
+    size_t getMemoryBudget() const;
+
+    TextureResidencyStats getResidencyStats() const;
+
 protected:
     virtual std::unique_ptr<Texture2D> createTexture2D() = 0;
     virtual void useTexture2D(Texture2D* texture) = 0;
 
     Texture2D* m_activeTexture;
-    std::map<String, std::unique_ptr<Texture2D>> m_textures;
+    SlotMap<std::unique_ptr<Texture2D>, Texture2D> m_textures;
+    FlatHashMap<StringId, TextureHandle> m_textureHandles;
+    FlatHashMap<uint64, TextureHandle> m_contentHandles;
+
+private:
+    Texture2D* loadFromImageHash(const String& name, const Image& image, uint64 contentHash, const String& filename);
+    Texture2D* loadFromFileImage(const String& basename,
+                                 const String& filename,
+                                 const Image& image,
+                                 uint64 contentHash);
+
+    /**
+     * @brief Mip level of a texture decoded from its file by a worker
+     */
+    struct StreamRequest {
+        TextureHandle handle;
+        String filename;
+        uint32 mipBias = 0;
+        size_t releasedMemory = 0;
+        bool restoresTexture = false;
+        bool cancelled = false;
+        bool decoded = false;
+        Image image;
+        std::atomic<bool> completed = false;
+    };
+
+    bool streamTexture(Texture2D* texture, uint32 mipBias);
+    void uploadStreamedTextures();
+    // The memory the cancelled requests would release is no longer pending
+    void cancelStreamRequests(const TextureHandle& handle);
+    bool uploadStreamedTexture(Texture2D* texture, const Image& image, uint32 mipBias);
+    void evictTexture(Texture2D* texture);
+
+    // Choose the file the texture is streamed from after its names change
+    void updateSourceFile(Texture2D* texture);
+
+    void onFilesChanged(const Vector<String>& filenames);
+
+    uint64 m_currentFrame;
+    size_t m_memoryBudget;
+    size_t m_residentMemory;
+    uint64 m_totalEvictions;
+    uint64 m_totalStreamedLevels;
+
+    Vector<std::shared_ptr<StreamRequest>> m_streamRequests;
+    size_t m_pendingReleasedMemory;
+
+    SignalConnection m_onFilesChangedConnection;
 };
 
 }  // namespace engine
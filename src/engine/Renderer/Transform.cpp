@@ -29,6 +29,18 @@ math::Matrix4x4<float> Transform::getMatrix() const {
     return math::Translate(m_translate) * math::Scale(m_scale) * math::Rotate(m_rotate);
 }
 
+const math::Vector3<float>& Transform::getScale() const {
+    return m_scale;
+}
+
+const math::Vector3<float>& Transform::getRotation() const {
+    return m_rotate;
+}
+
+const math::Vector3<float>& Transform::getTranslation() const {
+    return m_translate;
+}
+
 void Transform::rotate(const math::Vector3<float>& eulerAngles) {
     m_rotate += eulerAngles;
 }
@@ -23,6 +23,12 @@ public:
 
     math::Matrix4x4<float> getMatrix() const;
 
+    const math::Vector3<float>& getScale() const;
+
+    const math::Vector3<float>& getRotation() const;
+
+    const math::Vector3<float>& getTranslation() const;
+
 private:
     math::Vector3<float> m_scale;
     math::Vector3<float> m_rotate;
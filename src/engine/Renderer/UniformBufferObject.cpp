@@ -2,19 +2,12 @@
 
 #include <System/LogManager.hpp>
 #include <System/StringFormat.hpp>
+#include <System/StringId.hpp>
 #include <System/StringView.hpp>
 #include <Util/Container/Vector.hpp>
 
 namespace engine {
 
-bool operator==(const String& lhs, const UniformBufferObject::Item& rhs) {
-    return lhs == rhs.name;
-}
-
-bool operator==(const UniformBufferObject::Item& lhs, const String& rhs) {
-    return rhs == lhs.name;
-}
-
 namespace {
 
 const StringView sTag("UniformBufferObject");
@@ -74,6 +67,7 @@ UniformBufferObject::~UniformBufferObject() {
 
 void UniformBufferObject::setAttributes(const Vector<Item>& attributes) {
     m_attributesAllignedOffset.clear();
+    m_attributeIds.clear();
 
     size_t currentAllignment = 0;
 
@@ -88,6 +82,7 @@ void UniformBufferObject::setAttributes(const Vector<Item>& attributes) {
         }
 
         m_attributesAllignedOffset.push_back(currentAllignment);
+        m_attributeIds.emplace_back(item.name);
         currentAllignment += attrSize;
     }
 
@@ -133,10 +128,10 @@ void UniformBufferObject::setBufferSize(size_t numUboInstances, size_t minUboAli
     m_bufferSize = bufferSize;
 }
 
-void UniformBufferObject::setAttributeValue(const String& name, const math::mat4& value, size_t offset) {
-    auto it = std::find(m_attributes.begin(), m_attributes.end(), name);
-    if (it != m_attributes.end() && it->type == DataType::MATRIX4X4) {
-        size_t pos = it - m_attributes.begin();
+void UniformBufferObject::setAttributeValue(const StringId& name, const math::mat4& value, size_t offset) {
+    auto it = std::find(m_attributeIds.begin(), m_attributeIds.end(), name);
+    size_t pos = it - m_attributeIds.begin();
+    if (it != m_attributeIds.end() && m_attributes[pos].type == DataType::MATRIX4X4) {
         size_t attributeOffset = m_attributesAllignedOffset[pos];
 
         if (m_layoutType == LayoutType::STD140) {
@@ -153,10 +148,10 @@ void UniformBufferObject::setAttributeValue(const String& name, const math::mat4
     }
 }
 
-void UniformBufferObject::setAttributeValue(const String& name, const math::mat3& value, size_t offset) {
-    auto it = std::find(m_attributes.begin(), m_attributes.end(), name);
-    if (it != m_attributes.end() && it->type == DataType::MATRIX3X3) {
-        size_t pos = it - m_attributes.begin();
+void UniformBufferObject::setAttributeValue(const StringId& name, const math::mat3& value, size_t offset) {
+    auto it = std::find(m_attributeIds.begin(), m_attributeIds.end(), name);
+    size_t pos = it - m_attributeIds.begin();
+    if (it != m_attributeIds.end() && m_attributes[pos].type == DataType::MATRIX3X3) {
         size_t attributeOffset = m_attributesAllignedOffset[pos];
 
         if (m_layoutType == LayoutType::STD140) {
@@ -173,10 +168,10 @@ void UniformBufferObject::setAttributeValue(const String& name, const math::mat3
     }
 }
 
-void UniformBufferObject::setAttributeValue(const String& name, const math::mat2& value, size_t offset) {
-    auto it = std::find(m_attributes.begin(), m_attributes.end(), name);
-    if (it != m_attributes.end() && it->type == DataType::MATRIX2X2) {
-        size_t pos = it - m_attributes.begin();
+void UniformBufferObject::setAttributeValue(const StringId& name, const math::mat2& value, size_t offset) {
+    auto it = std::find(m_attributeIds.begin(), m_attributeIds.end(), name);
+    size_t pos = it - m_attributeIds.begin();
+    if (it != m_attributeIds.end() && m_attributes[pos].type == DataType::MATRIX2X2) {
         size_t attributeOffset = m_attributesAllignedOffset[pos];
 
         if (m_layoutType == LayoutType::STD140) {
@@ -193,10 +188,10 @@ void UniformBufferObject::setAttributeValue(const String& name, const math::mat2
     }
 }
 
-void UniformBufferObject::setAttributeValue(const String& name, const math::vec4& value, size_t offset) {
-    auto it = std::find(m_attributes.begin(), m_attributes.end(), name);
-    if (it != m_attributes.end() && it->type == DataType::VECTOR4) {
-        size_t pos = it - m_attributes.begin();
+void UniformBufferObject::setAttributeValue(const StringId& name, const math::vec4& value, size_t offset) {
+    auto it = std::find(m_attributeIds.begin(), m_attributeIds.end(), name);
+    size_t pos = it - m_attributeIds.begin();
+    if (it != m_attributeIds.end() && m_attributes[pos].type == DataType::VECTOR4) {
         size_t attributeOffset = m_attributesAllignedOffset[pos];
         math::Vector4Packed<float> packedVector(value);
         setDataAtOffset(&packedVector, sizeof(packedVector), offset + attributeOffset);
@@ -205,10 +200,10 @@ void UniformBufferObject::setAttributeValue(const String& name, const math::vec4
     }
 }
 
-void UniformBufferObject::setAttributeValue(const String& name, const math::vec3& value, size_t offset) {
-    auto it = std::find(m_attributes.begin(), m_attributes.end(), name);
-    if (it != m_attributes.end() && it->type == DataType::VECTOR3) {
-        size_t pos = it - m_attributes.begin();
+void UniformBufferObject::setAttributeValue(const StringId& name, const math::vec3& value, size_t offset) {
+    auto it = std::find(m_attributeIds.begin(), m_attributeIds.end(), name);
+    size_t pos = it - m_attributeIds.begin();
+    if (it != m_attributeIds.end() && m_attributes[pos].type == DataType::VECTOR3) {
         size_t attributeOffset = m_attributesAllignedOffset[pos];
         math::Vector3Packed<float> packedVector(value);
         setDataAtOffset(&packedVector, sizeof(packedVector), offset + attributeOffset);
@@ -217,10 +212,10 @@ void UniformBufferObject::setAttributeValue(const String& name, const math::vec3
     }
 }
 
-void UniformBufferObject::setAttributeValue(const String& name, const math::vec2& value, size_t offset) {
-    auto it = std::find(m_attributes.begin(), m_attributes.end(), name);
-    if (it != m_attributes.end() && it->type == DataType::VECTOR2) {
-        size_t pos = it - m_attributes.begin();
+void UniformBufferObject::setAttributeValue(const StringId& name, const math::vec2& value, size_t offset) {
+    auto it = std::find(m_attributeIds.begin(), m_attributeIds.end(), name);
+    size_t pos = it - m_attributeIds.begin();
+    if (it != m_attributeIds.end() && m_attributes[pos].type == DataType::VECTOR2) {
         size_t attributeOffset = m_attributesAllignedOffset[pos];
         math::Vector2Packed<float> packedVector(value);
         setDataAtOffset(&packedVector, sizeof(packedVector), offset + attributeOffset);
@@ -229,22 +224,14 @@ void UniformBufferObject::setAttributeValue(const String& name, const math::vec2
     }
 }
 
-void UniformBufferObject::setAttributeValue(const String& name, const void* value, size_t offset) {
-    size_t bufferOffset = 0;
-    auto it = std::find_if(m_attributes.begin(), m_attributes.end(), [this, &name, &bufferOffset](Item& item) {
-        if (item.name == name) {
-            return true;
-        }
-        bufferOffset += getTypeSize(item.type);
-        return false;
-    });
-
-    if (it != m_attributes.end()) {
-        size_t valueSize = getTypeSize(it->type);
+void UniformBufferObject::setAttributeValue(const StringId& name, const void* value, size_t offset) {
+    auto it = std::find(m_attributeIds.begin(), m_attributeIds.end(), name);
+    if (it != m_attributeIds.end()) {
+        size_t valueSize = getTypeSize(m_attributes[it - m_attributeIds.begin()].type);
         ENGINE_UNUSED(value);
         ENGINE_UNUSED(offset);
         ENGINE_UNUSED(valueSize);
-        LogError(sTag, "SetAttributeValue(const String&, const void*) not implemented yet");
+        LogError(sTag, "SetAttributeValue(const StringId&, const void*) not implemented yet");
     } else {
         LogError(sTag, "Not a valid UBO attribute name: {}", name);
     }
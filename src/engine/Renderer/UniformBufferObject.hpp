@@ -4,6 +4,7 @@
 
 #include <Math/Math.hpp>
 #include <System/String.hpp>
+#include <System/StringId.hpp>
 #include <Util/Container/Vector.hpp>
 
 namespace engine {
@@ -37,12 +38,12 @@ public:
 
     void setAttributes(const Vector<Item>& attributes);
 
-    void setAttributeValue(const String& name, const math::mat4& value, size_t offset = 0);
-    void setAttributeValue(const String& name, const math::mat3& value, size_t offset = 0);
-    void setAttributeValue(const String& name, const math::mat2& value, size_t offset = 0);
-    void setAttributeValue(const String& name, const math::vec4& value, size_t offset = 0);
-    void setAttributeValue(const String& name, const math::vec3& value, size_t offset = 0);
-    void setAttributeValue(const String& name, const math::vec2& value, size_t offset = 0);
+    void setAttributeValue(const StringId& name, const math::mat4& value, size_t offset = 0);
+    void setAttributeValue(const StringId& name, const math::mat3& value, size_t offset = 0);
+    void setAttributeValue(const StringId& name, const math::mat2& value, size_t offset = 0);
+    void setAttributeValue(const StringId& name, const math::vec4& value, size_t offset = 0);
+    void setAttributeValue(const StringId& name, const math::vec3& value, size_t offset = 0);
+    void setAttributeValue(const StringId& name, const math::vec2& value, size_t offset = 0);
 
     size_t getSize() const;
     size_t getDynamicAlignment() const;
@@ -54,7 +55,7 @@ public:
 private:
     explicit UniformBufferObject(const Vector<Item>& attributes);
 
-    void setAttributeValue(const String& name, const void* value, size_t offset = 0);
+    void setAttributeValue(const StringId& name, const void* value, size_t offset = 0);
 
     void setDataAtOffset(const void* data, size_t size, size_t offset);
 
@@ -71,6 +72,7 @@ private:
     bool m_bufferChanged;
 
     Vector<Item> m_attributes;
+    Vector<StringId> m_attributeIds;
     Vector<size_t> m_attributesAllignedOffset;
 };
 
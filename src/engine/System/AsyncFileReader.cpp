@@ -0,0 +1,468 @@
+#include <System/AsyncFileReader.hpp>
+
+#include <System/IOStream.hpp>
+#include <System/PackFile.hpp>
+#include <Util/AsyncTaskRunner.hpp>
+
+#if PLATFORM_IS(PLATFORM_LINUX) && __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/syscall.h>
+    #include <sys/uio.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+        #define ENGINE_HAS_IO_URING
+    #endif
+#endif
+
+#include <utility>
+
+#include <cerrno>
+#include <cstring>
+
+namespace engine {
+
+namespace {
+
+// Maximum number of reads in flight for each batch
+const uint32 sIoUringEntries(64);
+
+// Compute the bytes to read and the buffer that will receive them
+bool PrepareRead(FileReadRequest& request, uint64 fileSize, byte** destination, size_t* size) {
+    if (request.offset > fileSize) {
+        return false;
+    }
+    *size = (request.size != 0) ? request.size : static_cast<size_t>(fileSize - request.offset);
+    if (request.destination != nullptr) {
+        *destination = request.destination;
+    } else {
+        request.data.resize(*size);
+        *destination = request.data.data();
+    }
+    return true;
+}
+
+}  // namespace
+
+#if defined(ENGINE_HAS_IO_URING)
+
+/**
+ * @brief Minimal io_uring wrapper that uses the raw system calls
+ */
+class AsyncFileReader::IoUring : NonCopyable {
+public:
+    IoUring()
+          : m_fd(-1),
+            m_sqRing(MAP_FAILED),
+            m_sqRingSize(0),
+            m_cqRing(MAP_FAILED),
+            m_cqRingSize(0),
+            m_sqes(static_cast<io_uring_sqe*>(MAP_FAILED)),
+            m_sqesSize(0),
+            m_sqHead(nullptr),
+            m_sqTail(nullptr),
+            m_sqMask(nullptr),
+            m_sqArray(nullptr),
+            m_sqEntries(0),
+            m_sqeTail(0),
+            m_cqHead(nullptr),
+            m_cqTail(nullptr),
+            m_cqMask(nullptr),
+            m_cqes(nullptr) {}
+
+    ~IoUring() {
+        if (m_sqes != MAP_FAILED) {
+            munmap(m_sqes, m_sqesSize);
+        }
+        if (m_cqRing != MAP_FAILED) {
+            munmap(m_cqRing, m_cqRingSize);
+        }
+        if (m_sqRing != MAP_FAILED) {
+            munmap(m_sqRing, m_sqRingSize);
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    bool initialize(uint32 entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (m_fd < 0) {
+            // Not supported by the kernel or blocked by the sandbox
+            return false;
+        }
+
+        m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32);
+        m_sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                        IORING_OFF_SQ_RING);
+        m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        m_cqRing = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                        IORING_OFF_CQ_RING);
+        m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        m_sqes = static_cast<io_uring_sqe*>(
+            mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES));
+        if (m_sqRing == MAP_FAILED || m_cqRing == MAP_FAILED || m_sqes == MAP_FAILED) {
+            return false;
+        }
+
+        auto* sqRing = static_cast<byte*>(m_sqRing);
+        m_sqHead = reinterpret_cast<uint32*>(sqRing + params.sq_off.head);
+        m_sqTail = reinterpret_cast<uint32*>(sqRing + params.sq_off.tail);
+        m_sqMask = reinterpret_cast<uint32*>(sqRing + params.sq_off.ring_mask);
+        m_sqArray = reinterpret_cast<uint32*>(sqRing + params.sq_off.array);
+        m_sqEntries = params.sq_entries;
+        m_sqeTail = *m_sqTail;
+
+        auto* cqRing = static_cast<byte*>(m_cqRing);
+        m_cqHead = reinterpret_cast<uint32*>(cqRing + params.cq_off.head);
+        m_cqTail = reinterpret_cast<uint32*>(cqRing + params.cq_off.tail);
+        m_cqMask = reinterpret_cast<uint32*>(cqRing + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+        return true;
+    }
+
+    uint32 getEntries() const {
+        return m_sqEntries;
+    }
+
+    io_uring_sqe* getSqe() {
+        uint32 head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+        if (m_sqeTail - head >= m_sqEntries) {
+            return nullptr;
+        }
+        uint32 index = m_sqeTail & *m_sqMask;
+        m_sqArray[index] = index;
+        m_sqeTail++;
+        io_uring_sqe* sqe = &m_sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    /**
+     * @brief Submit the prepared entries and wait for completions
+     *
+     * @return false if the ring can't be used anymore
+     */
+    bool submitAndWait(uint32 waitCount) {
+        uint32 toSubmit = m_sqeTail - *m_sqTail;
+        __atomic_store_n(m_sqTail, m_sqeTail, __ATOMIC_RELEASE);
+        while (true) {
+            int ret = static_cast<int>(
+                syscall(__NR_io_uring_enter, m_fd, toSubmit, waitCount, IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (ret < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            if (static_cast<uint32>(ret) >= toSubmit) {
+                return true;
+            }
+            if (ret == 0) {
+                return false;
+            }
+            toSubmit -= static_cast<uint32>(ret);
+        }
+    }
+
+    /**
+     * @brief Wait for a completion without submitting more entries
+     *
+     * @return false if the ring can't be used anymore
+     */
+    bool waitCompletion() {
+        while (syscall(__NR_io_uring_enter, m_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0) {
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Number of prepared entries that the kernel has not consumed, they
+    // are never submitted if only completions are waited
+    uint32 getUnsubmittedCount() const {
+        return m_sqeTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    }
+
+    bool popCompletion(uint64* userData, int32* result) {
+        // The head is only written by this thread
+        uint32 head = *m_cqHead;
+        if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        const io_uring_cqe& cqe = m_cqes[head & *m_cqMask];
+        *userData = cqe.user_data;
+        *result = cqe.res;
+        __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+private:
+    int m_fd;
+
+    void* m_sqRing;
+    size_t m_sqRingSize;
+    void* m_cqRing;
+    size_t m_cqRingSize;
+    io_uring_sqe* m_sqes;
+    size_t m_sqesSize;
+
+    uint32* m_sqHead;
+    uint32* m_sqTail;
+    uint32* m_sqMask;
+    uint32* m_sqArray;
+    uint32 m_sqEntries;
+    uint32 m_sqeTail;
+
+    uint32* m_cqHead;
+    uint32* m_cqTail;
+    uint32* m_cqMask;
+    io_uring_cqe* m_cqes;
+};
+
+#else
+
+class AsyncFileReader::IoUring {};
+
+#endif
+
+AsyncFileReader::AsyncFileReader(AsyncTaskRunner* taskRunner) : m_taskRunner(taskRunner), m_isRunning(true) {
+#if defined(ENGINE_HAS_IO_URING)
+    m_ioUring = std::make_unique<IoUring>();
+    if (!m_ioUring->initialize(sIoUringEntries)) {
+        m_ioUring.reset();
+    }
+#endif
+    m_thread = std::thread(&AsyncFileReader::run, this);
+}
+
+AsyncFileReader::~AsyncFileReader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isRunning = false;
+    }
+    m_signaler.notify_all();
+    m_thread.join();
+}
+
+void AsyncFileReader::submit(Vector<FileReadRequest>&& requests,
+                             Vector<Source>&& sources,
+                             FileReadCallback&& callback) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_batches.push_back({std::move(requests), std::move(sources), std::move(callback)});
+    }
+    m_signaler.notify_one();
+}
+
+bool AsyncFileReader::isUsingIoUring() const {
+    return m_ioUring != nullptr;
+}
+
+void AsyncFileReader::run() {
+    while (true) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_signaler.wait(lock, [this]() { return !m_batches.empty() || !m_isRunning; });
+        // The queued batches are completed before stopping
+        if (m_batches.empty()) {
+            break;
+        }
+        Batch batch = std::move(m_batches.front());
+        m_batches.pop_front();
+        lock.unlock();
+
+        processBatch(batch);
+    }
+}
+
+void AsyncFileReader::processBatch(Batch& batch) {
+    Vector<size_t> fileIndices;
+    for (size_t i = 0; i < batch.requests.size(); i++) {
+        FileReadRequest& request = batch.requests[i];
+        const Source& source = batch.sources[i];
+        request.bytesRead = 0;
+        request.succeeded = false;
+
+        if (source.archive != nullptr) {
+            // The archives are already mapped, the data is copied or
+            // decompressed directly
+            size_t fileSize = 0;
+            byte* destination = nullptr;
+            size_t size = 0;
+            if (source.archive->getFileSize(source.path, &fileSize) &&
+                PrepareRead(request, fileSize, &destination, &size) &&
+                source.archive->read(source.path, request.offset, size, destination, m_taskRunner)) {
+                request.bytesRead = size;
+                request.succeeded = true;
+            }
+        } else if (!source.path.isEmpty()) {
+            fileIndices.push_back(i);
+        }
+    }
+
+    if (!fileIndices.empty()) {
+        if (m_ioUring != nullptr) {
+            readWithIoUring(batch, fileIndices);
+        } else {
+            readWithWorkers(batch, fileIndices);
+        }
+    }
+
+    if (batch.callback) {
+        batch.callback(batch.requests);
+    }
+}
+
+void AsyncFileReader::readWithIoUring(Batch& batch, const Vector<size_t>& indices) {
+#if defined(ENGINE_HAS_IO_URING)
+    struct ReadState {
+        int fd = -1;
+        byte* destination = nullptr;
+        size_t size = 0;
+        size_t bytesRead = 0;
+        iovec buffer;
+    };
+
+    Vector<ReadState> states(indices.size());
+
+    auto finishRead = [&batch, &indices, &states](size_t k) {
+        ReadState& state = states[k];
+        FileReadRequest& request = batch.requests[indices[k]];
+        if (state.fd >= 0) {
+            ::close(state.fd);
+            state.fd = -1;
+        }
+        request.bytesRead = state.bytesRead;
+        request.succeeded = state.destination != nullptr && state.bytesRead == state.size;
+    };
+
+    // The reads are resubmitted until they complete, the reads to the
+    // regular files can be short when they cross the end of the file
+    Vector<size_t> pending;
+    pending.reserve(indices.size());
+    for (size_t k = indices.size(); k > 0; k--) {
+        pending.push_back(k - 1);
+    }
+
+    uint32 inFlight = 0;
+    while (!pending.empty() || inFlight > 0) {
+        while (!pending.empty() && inFlight < m_ioUring->getEntries()) {
+            size_t k = pending.back();
+            ReadState& state = states[k];
+            FileReadRequest& request = batch.requests[indices[k]];
+
+            // Open the files when their first read is submitted to not
+            // run out of descriptors with big batches
+            if (state.fd < 0) {
+                state.fd = ::open(batch.sources[indices[k]].path.getData(), O_RDONLY | O_CLOEXEC);
+                struct stat fileStat;
+                if (state.fd < 0 || fstat(state.fd, &fileStat) != 0 ||
+                    !PrepareRead(request, static_cast<uint64>(fileStat.st_size), &state.destination, &state.size)) {
+                    pending.pop_back();
+                    finishRead(k);
+                    continue;
+                }
+            }
+            if (state.bytesRead == state.size) {
+                pending.pop_back();
+                finishRead(k);
+                continue;
+            }
+
+            io_uring_sqe* sqe = m_ioUring->getSqe();
+            if (sqe == nullptr) {
+                break;
+            }
+            pending.pop_back();
+
+            state.buffer.iov_base = state.destination + state.bytesRead;
+            state.buffer.iov_len = state.size - state.bytesRead;
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = state.fd;
+            sqe->off = request.offset + state.bytesRead;
+            sqe->addr = reinterpret_cast<uint64>(&state.buffer);
+            sqe->len = 1;
+            sqe->user_data = k;
+            inFlight++;
+        }
+
+        if (inFlight == 0) {
+            continue;
+        }
+
+        uint64 userData = 0;
+        int32 result = 0;
+        if (!m_ioUring->submitAndWait(1)) {
+            // The ring is broken, the reads that were not completed fail
+            // and the next batches use the workers. The kernel still
+            // writes to the buffers of the submitted reads, so they are
+            // waited before the buffers are returned to the caller
+            inFlight -= m_ioUring->getUnsubmittedCount();
+            while (inFlight > 0) {
+                while (m_ioUring->popCompletion(&userData, &result)) {
+                    inFlight--;
+                }
+                if (inFlight > 0 && !m_ioUring->waitCompletion()) {
+                    break;
+                }
+            }
+            for (size_t k = 0; k < states.size(); k++) {
+                if (states[k].fd >= 0) {
+                    finishRead(k);
+                    batch.requests[indices[k]].succeeded = false;
+                }
+            }
+            m_ioUring.reset();
+            return;
+        }
+
+        while (m_ioUring->popCompletion(&userData, &result)) {
+            inFlight--;
+            auto k = static_cast<size_t>(userData);
+            if (result == -EINTR || result == -EAGAIN) {
+                pending.push_back(k);
+            } else if (result > 0 && states[k].bytesRead + static_cast<size_t>(result) < states[k].size) {
+                states[k].bytesRead += static_cast<size_t>(result);
+                pending.push_back(k);
+            } else {
+                if (result > 0) {
+                    states[k].bytesRead += static_cast<size_t>(result);
+                }
+                finishRead(k);
+            }
+        }
+    }
+#else
+    readWithWorkers(batch, indices);
+#endif
+}
+
+void AsyncFileReader::readWithWorkers(Batch& batch, const Vector<size_t>& indices) {
+    if (m_workers == nullptr) {
+        m_workers = std::make_unique<AsyncTaskRunner>();
+    }
+
+    m_workers->parallelFor(indices.size(), [&batch, &indices](size_t k) {
+        FileReadRequest& request = batch.requests[indices[k]];
+        IOStream file;
+        if (!file.open(batch.sources[indices[k]].path, "rb")) {
+            return;
+        }
+        byte* destination = nullptr;
+        size_t size = 0;
+        if (!PrepareRead(request, file.getSize(), &destination, &size)) {
+            return;
+        }
+        file.seek(static_cast<size_t>(request.offset), IOStream::Origin::SET);
+        request.bytesRead = file.read(destination, 1, size);
+        request.succeeded = request.bytesRead == size;
+    });
+}
+
+}  // namespace engine
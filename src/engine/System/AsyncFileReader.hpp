@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <System/String.hpp>
+#include <Util/Container/Vector.hpp>
+#include <Util/Function.hpp>
+#include <Util/NonCopyable.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace engine {
+
+class AsyncTaskRunner;
+class PackFile;
+
+/**
+ * @brief Read operation of a batch submitted to FileSystem::readFilesAsync
+ */
+struct FileReadRequest {
+    String filename;
+    uint64 offset = 0;
+    // Number of bytes to read, 0 reads until the end of the file
+    size_t size = 0;
+    // Buffer of at least size bytes, if nullptr the data is read to data
+    byte* destination = nullptr;
+
+    Vector<byte> data;
+    size_t bytesRead = 0;
+    bool succeeded = false;
+};
+
+using FileReadCallback = Function<void(Vector<FileReadRequest>&)>;
+
+/**
+ * @brief Background reader that processes batches of file reads
+ *
+ * @details The reads of each batch are submitted together to io_uring
+ *          on Linux, so the kernel can keep the device queue full. If
+ *          io_uring is not available the reads are distributed between
+ *          a pool of workers that use blocking reads.
+ */
+class ENGINE_API AsyncFileReader : NonCopyable {
+public:
+    /**
+     * @brief Source of a request resolved by the FileSystem
+     */
+    struct Source {
+        // Path of the file in the OS file system or inside the archive
+        String path;
+        // Kept alive until the read completes
+        std::shared_ptr<const PackFile> archive;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param taskRunner The workers used to decompress the files inside
+     *                   the archives, can be nullptr
+     */
+    explicit AsyncFileReader(AsyncTaskRunner* taskRunner = nullptr);
+
+    ~AsyncFileReader();
+
+    /**
+     * @brief Queue a batch of reads
+     *
+     * @param requests The reads to perform
+     * @param sources The resolved source of each request
+     * @param callback Called from the reader thread once all the
+     *                 requests of the batch have completed
+     */
+    void submit(Vector<FileReadRequest>&& requests, Vector<Source>&& sources, FileReadCallback&& callback);
+
+    /**
+     * @brief Check if the reads are submitted to io_uring
+     */
+    bool isUsingIoUring() const;
+
+private:
+    struct Batch {
+        Vector<FileReadRequest> requests;
+        Vector<Source> sources;
+        FileReadCallback callback;
+    };
+
+    class IoUring;
+
+    void run();
+
+    void processBatch(Batch& batch);
+
+    void readWithIoUring(Batch& batch, const Vector<size_t>& indices);
+
+    void readWithWorkers(Batch& batch, const Vector<size_t>& indices);
+
+    std::unique_ptr<IoUring> m_ioUring;
+    std::unique_ptr<AsyncTaskRunner> m_workers;
+    AsyncTaskRunner* m_taskRunner;
+
+    bool m_isRunning;
+    std::deque<Batch> m_batches;
+    std::mutex m_mutex;
+    std::condition_variable m_signaler;
+    std::thread m_thread;
+};
+
+}  // namespace engine
@@ -0,0 +1,87 @@
+#include <System/EventBus.hpp>
+
+#include <System/String.hpp>
+#include <Util/Container/FlatHashMap.hpp>
+
+#include <exception>
+#include <utility>
+
+namespace engine {
+
+EventBus::EventBus() : m_taskRunner(nullptr) {}
+
+EventBus::~EventBus() = default;
+
+void EventBus::setTaskRunner(AsyncTaskRunner* taskRunner) {
+    m_taskRunner = taskRunner;
+}
+
+void EventBus::dispatch() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dispatchedQueues.clear();
+        for (auto& queue : m_queues) {
+            if (queue != nullptr && queue->takePending()) {
+                m_dispatchedQueues.push_back(queue.get());
+            }
+        }
+        std::swap(m_pendingRuns, m_dispatchedRuns);
+        m_pendingRuns.clear();
+    }
+
+    try {
+        Vector<internal::EventQueueBase*> workerQueues;
+        for (internal::EventQueueBase* queue : m_dispatchedQueues) {
+            if (queue->hasWorkerHandlers()) {
+                workerQueues.push_back(queue);
+            }
+        }
+        if (m_taskRunner != nullptr) {
+            // The calling thread also takes queues, so the dispatch never
+            // waits behind the other tasks of the runner
+            std::mutex errorMutex;
+            std::exception_ptr error;
+            m_taskRunner->parallelFor(workerQueues.size(), [&](size_t i) {
+                try {
+                    workerQueues[i]->dispatchToWorkers();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            });
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        } else {
+            for (internal::EventQueueBase* queue : workerQueues) {
+                queue->dispatchToWorkers();
+            }
+        }
+
+        for (const EventRun& run : m_dispatchedRuns) {
+            run.queue->dispatchToHandlers(run.count);
+        }
+    } catch (...) {
+        finishDispatch();
+        throw;
+    }
+    finishDispatch();
+}
+
+void EventBus::finishDispatch() {
+    for (internal::EventQueueBase* queue : m_dispatchedQueues) {
+        queue->finishDispatch();
+    }
+    m_dispatchedRuns.clear();
+}
+
+size_t EventBus::RegisterEventType(const char* name) {
+    static std::mutex sMutex;
+    static FlatHashMap<String, size_t> sEventTypes;
+    std::lock_guard<std::mutex> lock(sMutex);
+    return sEventTypes.tryEmplace(String(name), sEventTypes.getSize()).first->second;
+}
+
+}  // namespace engine
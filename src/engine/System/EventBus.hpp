@@ -0,0 +1,228 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <System/Signal.hpp>
+#include <System/SignalConnection.hpp>
+#include <Util/Container/Vector.hpp>
+#include <Util/NonCopyable.hpp>
+
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace engine {
+
+class AsyncTaskRunner;
+
+/**
+ * @brief Thread where the handlers of an EventBus event are called
+ */
+enum class EventDispatch {
+    CALLING_THREAD,  ///< The thread that calls EventBus::dispatch
+    WORKER_THREAD    ///< Any worker or the calling thread before the other handlers, must be thread-safe
+};
+
+namespace internal {
+
+template <typename T, typename = void>
+struct is_coalescable : std::false_type {};
+
+template <typename T>
+struct is_coalescable<T, std::void_t<decltype(std::declval<T&>().coalesce(std::declval<const T&>()))>>
+      : std::is_same<decltype(std::declval<T&>().coalesce(std::declval<const T&>())), bool> {};
+
+class ENGINE_API EventQueueBase : NonCopyable {
+public:
+    virtual ~EventQueueBase() = default;
+
+    /**
+     * @brief Take the posted events to dispatch them
+     *
+     * @return true if there is any event to dispatch
+     */
+    virtual bool takePending() = 0;
+
+    virtual bool hasWorkerHandlers() const = 0;
+
+    /**
+     * @brief Call the worker handlers with all the dispatched events
+     */
+    virtual void dispatchToWorkers() = 0;
+
+    /**
+     * @brief Call the handlers with the next dispatched events
+     *
+     * @param count The number of events to deliver
+     */
+    virtual void dispatchToHandlers(size_t count) = 0;
+
+    /**
+     * @brief Release the dispatched events
+     */
+    virtual void finishDispatch() = 0;
+};
+
+template <typename Event>
+class EventQueue : public EventQueueBase {
+public:
+    using HandlerType = typename Signal<const Event&>::SlotType;
+
+    /**
+     * @brief Queue an event
+     *
+     * @param event The event to queue
+     * @param canCoalesce Whether the event can be merged into the last
+     *                    queued one
+     * @return true if the event was queued, false if it was merged
+     */
+    bool post(const Event& event, bool canCoalesce);
+
+    SignalConnection& subscribe(const HandlerType& handler, EventDispatch dispatch);
+
+    bool takePending() override;
+
+    bool hasWorkerHandlers() const override;
+
+    void dispatchToWorkers() override;
+
+    void dispatchToHandlers(size_t count) override;
+
+    void finishDispatch() override;
+
+private:
+    // Events are stored by type, each queue is a contiguous array
+    Vector<Event> m_pending;
+    Vector<Event> m_dispatched;
+    // Index of the next dispatched event delivered to the handlers
+    size_t m_nextEvent = 0;
+    Signal<const Event&> m_handlers;
+    Signal<const Event&> m_workerHandlers;
+};
+
+}  // namespace internal
+
+/**
+ * @brief Queue of typed events that are delivered in batches
+ *
+ * @details Posting an event only appends it to the queue of its type,
+ *          the handlers are called later when dispatch() is called,
+ *          so the code that produces the events is never stalled by
+ *          them. An event type can be any copyable struct.
+ *
+ *          The events are delivered in the order they were posted,
+ *          the consecutive events of a type are delivered as a batch.
+ *          If the type has a `bool coalesce(const Event& next)` method,
+ *          it is called to merge a new event into the last queued one
+ *          when no event of another type was posted after it, the new
+ *          event is discarded when it returns true. This is used for
+ *          high-rate events like the mouse motion.
+ *
+ *          The handlers subscribed with EventDispatch::WORKER_THREAD
+ *          are called first with all the events of their type, since
+ *          they can't follow the order of the other types. The event
+ *          types are spread between the task runner and the thread
+ *          that dispatches, and dispatch waits for all of them before
+ *          calling the other handlers, they never run at the same time.
+ *
+ * Example:
+ * @code
+ * struct ResizedEvent {
+ *     math::ivec2 size;
+ * };
+ * EventBus bus;
+ * bus.subscribe<ResizedEvent>([](const ResizedEvent& event) { ... });
+ * bus.post(ResizedEvent{math::ivec2(800, 600)});
+ * bus.dispatch();
+ * @endcode
+ */
+class ENGINE_API EventBus : NonCopyable {
+public:
+    EventBus();
+
+    ~EventBus();
+
+    /**
+     * @brief Set the workers used to call the thread-safe handlers
+     *
+     * @param taskRunner The workers, or nullptr to call all the
+     *                   handlers in the thread that dispatches
+     */
+    void setTaskRunner(AsyncTaskRunner* taskRunner);
+
+    /**
+     * @brief Queue an event until the next dispatch
+     *
+     * @details Can be called from any thread, including the handlers,
+     *          the events posted while dispatching are delivered by
+     *          the next dispatch
+     *
+     * @param event The event to queue
+     */
+    template <typename Event>
+    void post(const Event& event);
+
+    /**
+     * @brief Subscribe a function to an event type
+     *
+     * @param handler The function called with each event
+     * @param dispatch The thread where the function is called
+     * @return The connection, disconnect it to unsubscribe
+     */
+    template <typename Event>
+    SignalConnection& subscribe(const typename internal::EventQueue<Event>::HandlerType& handler,
+                                EventDispatch dispatch = EventDispatch::CALLING_THREAD);
+
+    /**
+     * @brief Subscribe a member function to an event type
+     *
+     * @param instance Reference to the instance object
+     * @param func Member function called with each event
+     * @param dispatch The thread where the function is called
+     * @return The connection, disconnect it to unsubscribe
+     */
+    template <typename Event, typename InstanceType, typename MFInstanceType>
+    SignalConnection& subscribe(InstanceType& instance, void (MFInstanceType::*func)(const Event&),
+                                EventDispatch dispatch = EventDispatch::CALLING_THREAD);
+
+    /**
+     * @brief Deliver the events posted since the last dispatch
+     *
+     * @details Must be called from a single thread, usually once per
+     *          frame from the main thread, and never from a handler.
+     *          An exception thrown by a handler is rethrown once the
+     *          worker handlers finish, and the events are released.
+     */
+    void dispatch();
+
+private:
+    template <typename Event>
+    internal::EventQueue<Event>& getQueue();
+
+    template <typename Event>
+    static size_t GetEventType();
+
+    // The types are registered by name, so the engine and the plugins
+    // agree on them even if each module instantiates GetEventType
+    static size_t RegisterEventType(const char* name);
+
+    void finishDispatch();
+
+    // Consecutive events of the same type in the posting order
+    struct EventRun {
+        internal::EventQueueBase* queue;
+        size_t count;
+    };
+
+    AsyncTaskRunner* m_taskRunner;
+    // Indexed by the event type
+    Vector<std::unique_ptr<internal::EventQueueBase>> m_queues;
+    Vector<internal::EventQueueBase*> m_dispatchedQueues;
+    Vector<EventRun> m_pendingRuns;
+    Vector<EventRun> m_dispatchedRuns;
+    std::mutex m_mutex;
+};
+
+}  // namespace engine
+
+#include <System/EventBus.inl>
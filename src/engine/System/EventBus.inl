@@ -0,0 +1,117 @@
+#pragma once
+
+#include <Util/AsyncTaskRunner.hpp>
+
+#include <algorithm>
+#include <typeinfo>
+
+namespace engine {
+
+namespace internal {
+
+template <typename Event>
+bool EventQueue<Event>::post(const Event& event, bool canCoalesce) {
+    if constexpr (is_coalescable<Event>::value) {
+        if (canCoalesce && !m_pending.empty() && m_pending.back().coalesce(event)) {
+            return false;
+        }
+    } else {
+        ENGINE_UNUSED(canCoalesce);
+    }
+    m_pending.push_back(event);
+    return true;
+}
+
+template <typename Event>
+SignalConnection& EventQueue<Event>::subscribe(const HandlerType& handler, EventDispatch dispatch) {
+    if (dispatch == EventDispatch::WORKER_THREAD) {
+        return m_workerHandlers.connect(handler);
+    }
+    return m_handlers.connect(handler);
+}
+
+template <typename Event>
+bool EventQueue<Event>::takePending() {
+    // Swap the arrays so both keep their memory between frames
+    std::swap(m_pending, m_dispatched);
+    return !m_dispatched.empty();
+}
+
+template <typename Event>
+bool EventQueue<Event>::hasWorkerHandlers() const {
+    return !m_workerHandlers.isEmpty();
+}
+
+template <typename Event>
+void EventQueue<Event>::dispatchToWorkers() {
+    for (const Event& event : m_dispatched) {
+        m_workerHandlers.emit(event);
+    }
+}
+
+template <typename Event>
+void EventQueue<Event>::dispatchToHandlers(size_t count) {
+    size_t end = std::min(m_nextEvent + count, m_dispatched.size());
+    for (; m_nextEvent < end; m_nextEvent++) {
+        m_handlers.emit(m_dispatched[m_nextEvent]);
+    }
+}
+
+template <typename Event>
+void EventQueue<Event>::finishDispatch() {
+    m_dispatched.clear();
+    m_nextEvent = 0;
+}
+
+}  // namespace internal
+
+template <typename Event>
+void EventBus::post(const Event& event) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    internal::EventQueue<Event>& queue = getQueue<Event>();
+    // Merging into an event followed by other types would reorder it
+    bool isLastRun = !m_pendingRuns.empty() && m_pendingRuns.back().queue == &queue;
+    if (queue.post(event, isLastRun)) {
+        if (isLastRun) {
+            m_pendingRuns.back().count++;
+        } else {
+            m_pendingRuns.push_back({&queue, 1});
+        }
+    }
+}
+
+template <typename Event>
+SignalConnection& EventBus::subscribe(const typename internal::EventQueue<Event>::HandlerType& handler,
+                                      EventDispatch dispatch) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return getQueue<Event>().subscribe(handler, dispatch);
+}
+
+template <typename Event, typename InstanceType, typename MFInstanceType>
+SignalConnection& EventBus::subscribe(InstanceType& instance, void (MFInstanceType::*func)(const Event&),
+                                      EventDispatch dispatch) {
+    static_assert(!std::is_pointer<InstanceType>::value, "Instance cannot be a pointer, it must be a reference");
+    static_assert(std::is_base_of<MFInstanceType, InstanceType>::value, "Instance is not base of member function");
+    return subscribe<Event>([&instance, func](const Event& event) { (instance.*func)(event); }, dispatch);
+}
+
+template <typename Event>
+internal::EventQueue<Event>& EventBus::getQueue() {
+    size_t type = GetEventType<Event>();
+    if (type >= m_queues.size()) {
+        m_queues.resize(type + 1);
+    }
+    if (m_queues[type] == nullptr) {
+        m_queues[type] = std::make_unique<internal::EventQueue<Event>>();
+    }
+    return static_cast<internal::EventQueue<Event>&>(*m_queues[type]);
+}
+
+template <typename Event>
+size_t EventBus::GetEventType() {
+    static_assert(std::is_same_v<Event, std::decay_t<Event>>, "The event type must not be a reference or const");
+    static const size_t sType = RegisterEventType(typeid(Event).name());
+    return sType;
+}
+
+}  // namespace engine
@@ -1,7 +1,10 @@
 #include <System/FileSystem.hpp>
 
+#include <System/FileWatcher.hpp>
 #include <System/IOStream.hpp>
 #include <System/LogManager.hpp>
+#include <System/PackFile.hpp>
+#include <System/StringBuilder.hpp>
 #include <System/StringView.hpp>
 #include <Util/Container/Vector.hpp>
 
@@ -13,6 +16,8 @@
     #include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include <cstring>
@@ -26,16 +31,34 @@ namespace {
 StringView sTag("FileSystem");
 String sExecutableDirectory;
 
+// Search path index of the files that could not be found
+const size_t sPathNotFound = std::numeric_limits<size_t>::max();
+
+std::unique_ptr<PackFile> OpenSearchArchive(const String& path, bool* isDirectory) {
+    // The search path can be the archive itself or a directory that
+    // has been packed in an archive with the same name
+    auto archive = std::make_unique<PackFile>();
+    *isDirectory = !archive->open(path);
+    if (!*isDirectory || archive->open(path + PackFile::sExtension)) {
+        return archive;
+    }
+    return nullptr;
+}
+
+bool IsReadOnlyMode(const char* mode) {
+    return std::strpbrk(mode, "wa+") == nullptr;
+}
+
 }  // namespace
 
-FileSystem::FileSystem() {
-    m_searchPaths = {
+FileSystem::FileSystem() : m_pathCacheGeneration(0), m_taskRunner(nullptr) {
+    setSearchPaths({
 #if PLATFORM_IS(PLATFORM_ANDROID)
         ""
 #else
         "data"
 #endif
-    };
+    });
 }
 
 FileSystem::~FileSystem() = default;
@@ -50,23 +73,25 @@ void FileSystem::initialize() {
     }
 }
 
-void FileSystem::shutdown() {}
+void FileSystem::shutdown() {
+    setTaskRunner(nullptr);
+    setFileWatchingEnabled(false);
+}
+
+void FileSystem::setTaskRunner(AsyncTaskRunner* taskRunner) {
+    // Complete the pending reads before changing the workers
+    std::lock_guard<std::mutex> lock(m_fileReaderMutex);
+    m_fileReader.reset();
+    m_taskRunner = taskRunner;
+}
 
 bool FileSystem::fileExists(const StringView& filename) const {
-    IOStream file;
     if (isAbsolutePath(filename)) {
-        if (file.open(filename, "r")) {
-            return true;
-        }
-    } else {
-        for (const String& path : m_searchPaths) {
-            String filePath = join(path, filename);
-            if (file.open(filePath, "r")) {
-                return true;
-            }
-        }
+        IOStream file;
+        return file.open(filename, "r");
     }
-    return false;
+    ResolvedPath resolved;
+    return resolvePath(getPathCacheKey(filename), &resolved);
 }
 
 bool FileSystem::loadFileData(const String& filename, String* dest) const {
@@ -80,19 +105,20 @@ bool FileSystem::loadFileData(const String& filename, String* dest) const {
 }
 
 bool FileSystem::loadFileData(const String& filename, Vector<byte>* dest) const {
-    IOStream file;
-
-    auto filenameCpy = filename;
-    filenameCpy.replace('\\', getOsSeparator());
-    filenameCpy.replace('/', getOsSeparator());
-
-    for (const String& path : m_searchPaths) {
-        String filePath = join(path, filenameCpy);
-        if (file.open(filePath, "rb")) {
-            break;
+    // The files inside the archives are copied or decompressed directly
+    // to the destination
+    String key = getPathCacheKey(filename);
+    ResolvedPath resolved;
+    if (!isAbsolutePath(key) && resolvePath(key, &resolved) && resolved.isInArchive) {
+        if (!readArchiveFile(*resolved.getArchive(), resolved.path, dest)) {
+            LogError(sTag, "Error loading file: {}", filename);
+            return false;
         }
+        return !dest->empty();
     }
-    if (!file.isOpen()) {
+
+    IOStream file;
+    if (!openFile(filename, "rb", &file)) {
         LogError(sTag, "Error loading file: {}", filename);
         return false;
     }
@@ -103,6 +129,96 @@ bool FileSystem::loadFileData(const String& filename, Vector<byte>* dest) const
     return len == rlen && len > 0;
 }
 
+bool FileSystem::openFile(const StringView& filename, const char* mode, IOStream* file) const {
+    String key = getPathCacheKey(filename);
+
+    if (isAbsolutePath(key)) {
+        return file->open(key, mode);
+    }
+
+    if (!IsReadOnlyMode(mode)) {
+        // Archives can only be read, the file may be created so its
+        // cached resolution is no longer valid
+        std::shared_ptr<const SearchPathList> searchPaths = getSearchPathList();
+        for (const SearchPath& searchPath : *searchPaths) {
+            if (!searchPath.isDirectory) {
+                continue;
+            }
+            String filePath = join(searchPath.path, key);
+            if (file->open(filePath, mode)) {
+                removeCachedPath(key);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    ResolvedPath resolved;
+    if (!resolvePath(key, &resolved)) {
+        return false;
+    }
+    if (openResolvedPath(resolved, mode, file)) {
+        return true;
+    }
+
+    // The file was removed after its path was cached
+    removeCachedPath(key);
+    return resolvePath(key, &resolved) && openResolvedPath(resolved, mode, file);
+}
+
+bool FileSystem::mapFile(const StringView& filename, MappedFile* file, MappedFile::Advice advice) const {
+    String key = getPathCacheKey(filename);
+
+    bool mapped = false;
+    if (isAbsolutePath(key)) {
+        mapped = file->open(key);
+    } else {
+        ResolvedPath resolved;
+        if (resolvePath(key, &resolved)) {
+            mapped = mapResolvedPath(resolved, file);
+            if (!mapped) {
+                // The file was removed after its path was cached
+                removeCachedPath(key);
+                mapped = resolvePath(key, &resolved) && mapResolvedPath(resolved, file);
+            }
+        }
+    }
+
+    if (mapped) {
+        file->advise(advice);
+    }
+    return mapped;
+}
+
+void FileSystem::readFilesAsync(Vector<FileReadRequest> requests, FileReadCallback&& callback) const {
+    // Resolve the paths in the calling thread, the cache makes it cheap
+    Vector<AsyncFileReader::Source> sources(requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        String key = getPathCacheKey(requests[i].filename);
+        AsyncFileReader::Source& source = sources[i];
+        if (isAbsolutePath(key)) {
+            source.path = std::move(key);
+            continue;
+        }
+        ResolvedPath resolved;
+        if (!resolvePath(key, &resolved)) {
+            continue;
+        }
+        source.archive = resolved.getArchive();
+        source.path = std::move(resolved.path);
+    }
+
+    getFileReader().submit(std::move(requests), std::move(sources), std::move(callback));
+}
+
+std::future<Vector<FileReadRequest>> FileSystem::readFilesAsync(Vector<FileReadRequest> requests) const {
+    auto promise = std::make_shared<std::promise<Vector<FileReadRequest>>>();
+    std::future<Vector<FileReadRequest>> future = promise->get_future();
+    readFilesAsync(std::move(requests),
+                   [promise](Vector<FileReadRequest>& completed) { promise->set_value(std::move(completed)); });
+    return future;
+}
+
 char FileSystem::getOsSeparator() const {
 #if PLATFORM_IS(PLATFORM_WINDOWS)
     return '\\';
@@ -166,61 +282,81 @@ String FileSystem::absolutePath(const String& /*path*/) const {
 }
 
 String FileSystem::normalizePath(const String& path) const {
+    InlineString<256> result;
+    return String(normalizePathInto(path, &result));
+}
+
+StringView FileSystem::normalizePathInto(const StringView& path, StringBuilder* result) const {
     bool isAbsolute = isAbsolutePath(path);
-    Vector<std::pair<const char*, const char*>> pathComps;
+    const char* pathData = path.getData();
+    char separator = getOsSeparator();
 
-    auto addPathComponent = [&pathComps, isAbsolute](const char* begin, const char* end) {
+    result->clear();
+
+    // Get the path component without the drive on Windows
+    size_t beginOffset = 0;
+    if (isAbsolute) {
+#if PLATFORM_IS(PLATFORM_WINDOWS)
+        result->append(StringView(pathData, 2)).append('\\');
+        beginOffset = 2;
+#else
+        result->append('/');
+#endif
+    }
+
+    // The components are written directly to the result, the .. directories
+    // remove the last written component
+    const size_t prefixSize = result->getDataSize();
+    size_t numComponents = 0;
+    auto addPathComponent = [&](const char* begin, const char* end) {
         size_t seqSize = end - begin;
 
         // Ignore the component if the . directories
-        if (seqSize == 1 && std::memcmp(begin, ".", 1) == 0) {
+        if (seqSize == 1 && *begin == '.') {
             return;
         }
 
         // If the component is a .. directory
         if (seqSize == 2 && std::memcmp(begin, "..", 2) == 0) {
-            // Check if the path_comps is empty
-            if (!pathComps.empty()) {
-                // If the last element is a .. directory, append another one
-                // if not just pop_back the last component
-                auto& last = pathComps.back();
-                if (!isAbsolute && (last.second - last.first) == 2 && std::memcmp(last.first, "..", 2) == 0) {
-                    pathComps.emplace_back(begin, end);
-                } else {
-                    pathComps.pop_back();
+            if (numComponents > 0) {
+                // If the last component is a .. directory, append another one
+                // if not just remove the last component
+                const char* data = result->getData();
+                size_t lastBegin = result->getDataSize();
+                while (lastBegin > prefixSize && data[lastBegin - 1] != separator) {
+                    lastBegin--;
                 }
+                size_t lastSize = result->getDataSize() - lastBegin;
+                if (isAbsolute || lastSize != 2 || std::memcmp(data + lastBegin, "..", 2) != 0) {
+                    result->truncate((lastBegin > prefixSize) ? lastBegin - 1 : prefixSize);
+                    numComponents--;
+                    return;
+                }
+            } else if (isAbsolute) {
+                // Only add .. directories if the path is not absolute
+                return;
             }
-            // Only add .. directories if the path is not absolute
-            else if (!isAbsolute) {
-                pathComps.emplace_back(begin, end);
-            }
-            return;
         }
 
         // Add the path component
-        pathComps.emplace_back(begin, end);
+        if (numComponents > 0) {
+            result->append(separator);
+        }
+        result->append(StringView(begin, seqSize));
+        numComponents++;
     };
 
-    const auto& internal = path.toUtf8();
-
-    // Get the path component without the drive on Windows
-    size_t beginOffset = 0;
-#if PLATFORM_IS(PLATFORM_WINDOWS)
-    if (isAbsolute) {
-        beginOffset = 2;
-    }
-#endif
-
     // Split the string by the separator
-    const char* pathcStart = internal.data() + beginOffset;
+    const char* pathcStart = pathData + beginOffset;
     const char* pathcEnd = pathcStart;
-    while (*pathcEnd != 0) {
+    const char* pathEnd = pathData + path.getDataSize();
+    while (pathcEnd != pathEnd) {
         // Get the path component from the start and end iterators
-        if (*pathcEnd == getOsSeparator() && pathcEnd > pathcStart) {
+        if (*pathcEnd == separator && pathcEnd > pathcStart) {
             addPathComponent(pathcStart, pathcEnd);
             pathcStart = pathcEnd;
         }
-        if (*pathcStart == getOsSeparator()) {
+        if (*pathcStart == separator) {
             pathcStart++;
         }
         pathcEnd++;
@@ -231,33 +367,16 @@ String FileSystem::normalizePath(const String& path) const {
         addPathComponent(pathcStart, pathcEnd);
     }
 
-    // Create the result normalized path
-    String ret;
-    if (isAbsolute) {
-#if PLATFORM_IS(PLATFORM_WINDOWS)
-        auto it = internal.cbegin();
-        ret += String::FromUtf8(it, it + 2) + '\\';
-#else
-        ret += '/';
-#endif
-    }
-    if (!isAbsolute & pathComps.empty()) {
-        ret += '.';
-    } else {
-        for (size_t i = 0; i < pathComps.size(); i++) {
-            if (i) {
-                ret += getOsSeparator();
-            }
-            ret += String::FromUtf8(pathComps[i].first, pathComps[i].second);
-        }
+    if (!isAbsolute && numComponents == 0) {
+        result->append('.');
     }
 
 #if PLATFORM_IS(PLATFORM_WINDOWS)
     // Fix separators on Windows
-    ret.replace('/', '\\');
+    std::replace(result->getData(), result->getData() + result->getDataSize(), '/', '\\');
 #endif
 
-    return ret;
+    return result->getView();
 }
 
 bool FileSystem::isAbsolutePath(const StringView& path) const {
@@ -275,30 +394,34 @@ bool FileSystem::isAbsolutePath(const StringView& path) const {
 }
 
 String FileSystem::join(const StringView& left, const StringView& right) const {
+    InlineString<256> result;
+    return String(joinInto(left, right, &result));
+}
+
+StringView FileSystem::joinInto(const StringView& left, const StringView& right, StringBuilder* result) const {
+    result->clear();
     if (right.isEmpty()) {
-        return String::FromUtf8(left.cbegin(), left.cend());
+        return result->append(left).getView();
     }
-    if (left.isEmpty()) {
-        return String::FromUtf8(right.cbegin(), right.cend());
+    if (left.isEmpty() || isAbsolutePath(right)) {
+        return result->append(right).getView();
     }
 
-    if (isAbsolutePath(right)) {
-        return String::FromUtf8(right.cbegin(), right.cend());
+    result->append(left);
+    if (left.getData()[left.getDataSize() - 1] != getOsSeparator()) {
+        result->append(getOsSeparator());
     }
-
-    String ret;
-    const auto& internal = left.getData();
-    char lastCharacter = internal[left.getSize() - 1];
-    if (lastCharacter == getOsSeparator()) {
-        ret = "{}{}"_format(left, right);
-    } else {
-        ret = "{}{}{}"_format(left, getOsSeparator(), right);
-    }
-    return ret;
+    return result->append(right).getView();
 }
 
 void FileSystem::setSearchPaths(Vector<String> searchPaths) {
+    auto searchPathList = std::make_shared<SearchPathList>();
+    for (const String& path : searchPaths) {
+        searchPathList->push_back(MountSearchPath(path));
+    }
     m_searchPaths = std::move(searchPaths);
+    setSearchPathList(std::move(searchPathList));
+    watchSearchPaths();
 }
 
 const Vector<String>& FileSystem::getSearchPaths() const {
@@ -306,7 +429,274 @@ const Vector<String>& FileSystem::getSearchPaths() const {
 }
 
 void FileSystem::addSearchPath(const String& path) {
+    // The missing files may be found in the new search path
+    auto searchPathList = std::make_shared<SearchPathList>(*getSearchPathList());
+    searchPathList->push_back(MountSearchPath(path));
     m_searchPaths.push_back(path);
+    setSearchPathList(std::move(searchPathList));
+    watchSearchPaths();
+}
+
+void FileSystem::invalidatePathCache(const StringView& filename) {
+    removeCachedPath(getPathCacheKey(filename));
+}
+
+void FileSystem::invalidatePathCache() {
+    std::lock_guard<std::mutex> lock(m_pathCacheMutex);
+    m_pathCache.clear();
+    m_pathCacheGeneration++;
+}
+
+bool FileSystem::setFileWatchingEnabled(bool enabled) {
+    if (!enabled) {
+        m_fileWatcher.reset();
+        return true;
+    }
+    if (m_fileWatcher == nullptr) {
+        m_fileWatcher = std::make_unique<FileWatcher>();
+        if (!m_fileWatcher->isSupported()) {
+            m_fileWatcher.reset();
+            return false;
+        }
+        watchSearchPaths();
+    }
+    return true;
+}
+
+bool FileSystem::isFileWatchingEnabled() const {
+    return m_fileWatcher != nullptr;
+}
+
+void FileSystem::watchFolder(const StringView& folder) {
+    String normalizedFolder = normalizePath(folder);
+    if (std::find(m_watchedFolders.begin(), m_watchedFolders.end(), normalizedFolder) == m_watchedFolders.end()) {
+        m_watchedFolders.push_back(std::move(normalizedFolder));
+        watchSearchPaths();
+    }
+}
+
+void FileSystem::unwatchFolder(const StringView& folder) {
+    auto it = std::find(m_watchedFolders.begin(), m_watchedFolders.end(), normalizePath(folder));
+    if (it != m_watchedFolders.end()) {
+        m_watchedFolders.erase(it);
+        watchSearchPaths();
+    }
+}
+
+void FileSystem::pollFileChanges() {
+    if (m_fileWatcher == nullptr) {
+        return;
+    }
+
+    Vector<FileWatcher::Change> changes;
+    if (!m_fileWatcher->poll(&changes)) {
+        LogWarning(sTag, "Some file changes were lost, invalidating all the cached paths");
+        invalidatePathCache();
+    }
+    if (changes.empty()) {
+        return;
+    }
+
+    Vector<String> filenames;
+    filenames.reserve(changes.size());
+    for (const auto& change : changes) {
+        const WatchedDirectory& watched = m_watchedDirectories[change.directory];
+        String key = getPathCacheKey(join(watched.folder, change.path));
+        removeCachedPath(key);
+
+        // The file loaded from a previous search path, or from the archive
+        // of the same one, is still the same
+        ResolvedPath resolved;
+        if (resolvePath(key, &resolved) && (resolved.searchPath < watched.searchPath ||
+                                            (resolved.searchPath == watched.searchPath && resolved.isInArchive))) {
+            continue;
+        }
+
+        // The same file may change in several search paths
+        if (std::find(filenames.begin(), filenames.end(), key) == filenames.end()) {
+            filenames.push_back(std::move(key));
+        }
+    }
+
+    if (!filenames.empty()) {
+        onFilesChanged.emit(filenames);
+    }
+}
+
+PathCacheStats FileSystem::getPathCacheStats() const {
+    std::lock_guard<std::mutex> lock(m_pathCacheMutex);
+    PathCacheStats stats = m_pathCacheStats;
+    stats.entries = static_cast<uint32>(m_pathCache.size());
+    for (const auto& it : m_pathCache) {
+        if (it.second.searchPath == sPathNotFound) {
+            stats.missingEntries++;
+        }
+    }
+    return stats;
+}
+
+String FileSystem::getPathCacheKey(const StringView& filename) const {
+    String key(filename);
+    key.replace('\\', getOsSeparator());
+    key.replace('/', getOsSeparator());
+    return normalizePath(key);
+}
+
+FileSystem::SearchPath FileSystem::MountSearchPath(const String& path) {
+    SearchPath searchPath{path, nullptr, true};
+    searchPath.archive = OpenSearchArchive(path, &searchPath.isDirectory);
+    return searchPath;
+}
+
+std::shared_ptr<const FileSystem::SearchPathList> FileSystem::getSearchPathList() const {
+    std::lock_guard<std::mutex> lock(m_pathCacheMutex);
+    return m_searchPathList;
+}
+
+void FileSystem::setSearchPathList(std::shared_ptr<const SearchPathList> searchPaths) {
+    // The cached resolutions are indices of the previous search paths
+    std::lock_guard<std::mutex> lock(m_pathCacheMutex);
+    m_searchPathList = std::move(searchPaths);
+    m_pathCache.clear();
+    m_pathCacheGeneration++;
+}
+
+bool FileSystem::resolvePath(const String& key, ResolvedPath* resolved) const {
+    uint64 generation = 0;
+    std::shared_ptr<const SearchPathList> searchPaths;
+    {
+        std::lock_guard<std::mutex> lock(m_pathCacheMutex);
+        auto it = m_pathCache.find(key);
+        if (it != m_pathCache.end()) {
+            if (it->second.searchPath == sPathNotFound) {
+                m_pathCacheStats.missingHits++;
+                return false;
+            }
+            m_pathCacheStats.hits++;
+            *resolved = it->second;
+            return true;
+        }
+        m_pathCacheStats.misses++;
+        generation = m_pathCacheGeneration;
+        searchPaths = m_searchPathList;
+    }
+
+    // The search paths are walked without holding the lock so other
+    // threads can use the cache meanwhile
+    ResolvedPath result{sPathNotFound, String(), searchPaths, false};
+    for (size_t i = 0; i < searchPaths->size(); i++) {
+        // The archive of a search path shadows its loose files
+        const SearchPath& searchPath = (*searchPaths)[i];
+        if (searchPath.archive != nullptr && searchPath.archive->contains(key)) {
+            result = {i, key, searchPaths, true};
+            break;
+        }
+        if (!searchPath.isDirectory) {
+            continue;
+        }
+        String filePath = join(searchPath.path, key);
+        IOStream file;
+        if (file.open(filePath, "rb")) {
+            result = {i, std::move(filePath), searchPaths, false};
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_pathCacheMutex);
+    // Don't cache the result if the cache was invalidated during the walk
+    if (generation == m_pathCacheGeneration) {
+        m_pathCache[key] = result;
+    }
+    *resolved = std::move(result);
+    return resolved->searchPath != sPathNotFound;
+}
+
+bool FileSystem::openResolvedPath(const ResolvedPath& resolved, const char* mode, IOStream* file) const {
+    if (resolved.searchPaths == nullptr || resolved.searchPath >= resolved.searchPaths->size()) {
+        return false;
+    }
+    const auto& archive = resolved.getArchive();
+    if (archive != nullptr) {
+        size_t size = 0;
+        const byte* data = archive->find(resolved.path, &size);
+        if (data != nullptr) {
+            return file->open(data, size);
+        }
+        Vector<byte> buffer;
+        return readArchiveFile(*archive, resolved.path, &buffer) && file->open(std::move(buffer));
+    }
+    return file->open(resolved.path, mode);
+}
+
+bool FileSystem::mapResolvedPath(const ResolvedPath& resolved, MappedFile* file) const {
+    if (resolved.searchPaths == nullptr || resolved.searchPath >= resolved.searchPaths->size()) {
+        return false;
+    }
+    const auto& archive = resolved.getArchive();
+    if (archive != nullptr) {
+        size_t size = 0;
+        const byte* data = archive->find(resolved.path, &size);
+        if (data != nullptr) {
+            file->openView(data, size, archive);
+            return true;
+        }
+        Vector<byte> buffer;
+        if (!readArchiveFile(*archive, resolved.path, &buffer)) {
+            return false;
+        }
+        file->openBuffer(std::move(buffer));
+        return true;
+    }
+    return file->open(resolved.path);
+}
+
+bool FileSystem::readArchiveFile(const PackFile& archive, const String& path, Vector<byte>* dest) const {
+    size_t size = 0;
+    if (!archive.getFileSize(path, &size)) {
+        return false;
+    }
+    dest->resize(size);
+    return archive.read(path, 0, size, dest->data(), m_taskRunner);
+}
+
+AsyncFileReader& FileSystem::getFileReader() const {
+    std::lock_guard<std::mutex> lock(m_fileReaderMutex);
+    if (m_fileReader == nullptr) {
+        m_fileReader = std::make_unique<AsyncFileReader>(m_taskRunner);
+    }
+    return *m_fileReader;
+}
+
+void FileSystem::removeCachedPath(const String& key) const {
+    std::lock_guard<std::mutex> lock(m_pathCacheMutex);
+    m_pathCache.erase(key);
+    m_pathCacheGeneration++;
+}
+
+void FileSystem::watchSearchPaths() {
+    if (m_fileWatcher == nullptr) {
+        return;
+    }
+
+    // The archives can't change while they are mounted, only the loose
+    // files are watched
+    m_fileWatcher->removeAll();
+    m_watchedDirectories.clear();
+    std::shared_ptr<const SearchPathList> searchPaths = getSearchPathList();
+    for (size_t i = 0; i < searchPaths->size(); i++) {
+        const SearchPath& searchPath = (*searchPaths)[i];
+        if (!searchPath.isDirectory) {
+            continue;
+        }
+        for (const String& folder : m_watchedFolders) {
+            String directory = join(searchPath.path, folder);
+            if (m_fileWatcher->addDirectory(directory)) {
+                m_watchedDirectories.push_back({i, folder});
+            } else {
+                LogDebug(sTag, "Could not watch folder: {}", directory);
+            }
+        }
+    }
 }
 
 }  // namespace engine
@@ -2,15 +2,44 @@
 
 #include <Util/Prerequisites.hpp>
 
+#include <System/AsyncFileReader.hpp>
+#include <System/MappedFile.hpp>
+#include <System/Signal.hpp>
 #include <System/String.hpp>
+#include <System/StringBuilder.hpp>
 #include <System/StringView.hpp>
 #include <Util/Container/Vector.hpp>
 #include <Util/Singleton.hpp>
 
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+
 namespace engine {
 
+class AsyncTaskRunner;
+class FileWatcher;
+class IOStream;
+class PackFile;
+
+struct PathCacheStats {
+    uint32 entries = 0;
+    uint32 missingEntries = 0;
+    uint64 hits = 0;
+    uint64 missingHits = 0;
+    uint64 misses = 0;
+};
+
 /**
  * @brief Class to manage file system of the current OS
+ *
+ * @details The relative paths resolved in the search paths are cached
+ *          together with the ones that could not be found, so checking
+ *          and opening the same file multiple times only walks the
+ *          search paths once. Files created or removed outside of the
+ *          FileSystem must be notified with invalidatePathCache,
+ *          unless the file watching is enabled.
  */
 class ENGINE_API FileSystem : public Singleton<FileSystem> {
 public:
@@ -22,6 +51,15 @@ public:
 
     void shutdown();
 
+    /**
+     * @brief Set the workers used to decompress the files inside the
+     *        archives
+     *
+     * @param taskRunner The workers, or nullptr to decompress the files
+     *                   in the calling thread
+     */
+    void setTaskRunner(AsyncTaskRunner* taskRunner);
+
     /**
      * @brief Checks if a file exist
      *
@@ -49,6 +87,56 @@ public:
      */
     bool loadFileData(const String& filename, Vector<byte>* dest) const;
 
+    /**
+     * @brief Open a file located in one of the search paths
+     *
+     * @param filename The file to open
+     * @param mode The mode used to open the file, same as fopen
+     * @param file The stream that will hold the opened file
+     * @return true if the file could be opened, false
+     *         otherwise
+     */
+    bool openFile(const StringView& filename, const char* mode, IOStream* file) const;
+
+    /**
+     * @brief Map a file located in one of the search paths
+     *
+     * @details The files inside the archives reference the memory of
+     *          the archive, which is already mapped. The mapped file
+     *          keeps the archive open, so it stays valid after the
+     *          search paths change
+     *
+     * @param filename The file to map
+     * @param file The object that will hold the mapped file
+     * @param advice Hint about how the data is going to be accessed
+     * @return true if the file could be mapped, false otherwise
+     */
+    bool mapFile(const StringView& filename,
+                 MappedFile* file,
+                 MappedFile::Advice advice = MappedFile::Advice::NORMAL) const;
+
+    /**
+     * @brief Read a batch of files in the background
+     *
+     * @details The files are located in the search paths and all the
+     *          reads of the batch are submitted at once, so reading many
+     *          small files doesn't wait for each one to complete
+     *
+     * @param requests The reads to perform, the filename of each request
+     *                 follows the same rules as openFile
+     * @param callback Called from the reader thread with the completed
+     *                 requests, succeeded tells if each read completed
+     */
+    void readFilesAsync(Vector<FileReadRequest> requests, FileReadCallback&& callback) const;
+
+    /**
+     * @brief Read a batch of files in the background
+     *
+     * @param requests The reads to perform
+     * @return Future that receives the completed requests
+     */
+    std::future<Vector<FileReadRequest>> readFilesAsync(Vector<FileReadRequest> requests) const;
+
     /**
      * @brief Get the OS specific path separator
      *
@@ -93,6 +181,19 @@ public:
      */
     String normalizePath(const String& path) const;
 
+    /**
+     * @brief Normalize a pathname without allocating a String
+     *
+     * @param path The path to normalize, must not point to the
+     *             content of result
+     * @param result The builder where the normalized path is written,
+     *               its previous content is removed
+     * @return View of the normalized path inside result
+     *
+     * @see normalizePath
+     */
+    StringView normalizePathInto(const StringView& path, StringBuilder* result) const;
+
     /**
      * @brief Check if a path is absolute
      *
@@ -112,6 +213,20 @@ public:
      */
     String join(const StringView& left, const StringView& right) const;
 
+    /**
+     * @brief Join two path components without allocating a String
+     *
+     * @param left The first path to join
+     * @param right The second path to join
+     * @param result The builder where the joined path is written, its
+     *               previous content is removed. The paths must not
+     *               point to its content.
+     * @return View of the joined path inside result
+     *
+     * @see join
+     */
+    StringView joinInto(const StringView& left, const StringView& right, StringBuilder* result) const;
+
     /**
      * @brief Variadic version of the Join function that
      *        accepts multiple path components as arguments.
@@ -130,6 +245,12 @@ public:
     /**
      * @brief Change the search paths used to open files
      *
+     * @details Each search path can be a directory or a PackFile
+     *          archive. If an archive with the name of the search path
+     *          and the PackFile extension exists it is mounted along
+     *          with the directory, the files are looked up in the
+     *          archive first and then in the directory
+     *
      * @param searchPaths Vector of new search paths
      */
     void setSearchPaths(Vector<String> searchPaths);
@@ -151,8 +272,149 @@ public:
      */
     void addSearchPath(const String& path);
 
+    /**
+     * @brief Remove the cached resolution of a relative path
+     *
+     * @param filename The relative path that has been created,
+     *                 modified or removed
+     */
+    void invalidatePathCache(const StringView& filename);
+
+    /**
+     * @brief Remove all the cached path resolutions
+     */
+    void invalidatePathCache();
+
+    PathCacheStats getPathCacheStats() const;
+
+    /**
+     * @brief Enable or disable the detection of the files changed in
+     *        the watched folders of the directory search paths
+     *
+     * @param enabled true to watch the folders, false to stop
+     * @return true if the changes can be detected in this platform,
+     *         false otherwise
+     */
+    bool setFileWatchingEnabled(bool enabled);
+
+    bool isFileWatchingEnabled() const;
+
+    /**
+     * @brief Watch a folder inside each directory search path
+     *
+     * @details Only the watched folders are monitored, never the whole
+     *          search paths, which may contain a lot of unrelated files
+     *
+     * @param folder Path of the folder relative to the search paths
+     */
+    void watchFolder(const StringView& folder);
+
+    /**
+     * @brief Stop watching a folder added with watchFolder
+     */
+    void unwatchFolder(const StringView& folder);
+
+    /**
+     * @brief Process the file changes detected since the last call
+     *
+     * @details The cached resolutions of the changed files are removed
+     *          and onFilesChanged is emitted once with all of them, so
+     *          the bursts of events received during a frame are
+     *          coalesced. The changes shadowed by a file with the same
+     *          path in a previous search path are not reported. Must be
+     *          called once per frame from the main thread.
+     */
+    void pollFileChanges();
+
+    /**
+     * @brief Emitted by pollFileChanges with the changed files
+     *
+     * @details The paths are relative to the search paths, normalized
+     *          with normalizePath and each one is reported only once
+     */
+    Signal<const Vector<String>&> onFilesChanged;
+
 private:
+    struct SearchPath {
+        String path;
+        // Archive mounted in the search path, nullptr if there is none
+        std::shared_ptr<const PackFile> archive;
+        // False when the search path is the archive itself
+        bool isDirectory;
+    };
+
+    // The search paths are replaced as a whole so the workers can keep
+    // using the ones they resolved a file with
+    using SearchPathList = Vector<SearchPath>;
+
+    struct ResolvedPath {
+        // Index of the search path that contains the file
+        size_t searchPath;
+        // Path of the file, relative to the root of the archive if
+        // the file is inside the archive of the search path
+        String path;
+        // Search paths used to resolve the file
+        std::shared_ptr<const SearchPathList> searchPaths;
+        bool isInArchive;
+
+        const SearchPath& getSearchPath() const {
+            return (*searchPaths)[searchPath];
+        }
+
+        const std::shared_ptr<const PackFile>& getArchive() const {
+            static const std::shared_ptr<const PackFile> sNoArchive;
+            return isInArchive ? getSearchPath().archive : sNoArchive;
+        }
+    };
+
+    String getPathCacheKey(const StringView& filename) const;
+
+    static SearchPath MountSearchPath(const String& path);
+
+    std::shared_ptr<const SearchPathList> getSearchPathList() const;
+
+    void setSearchPathList(std::shared_ptr<const SearchPathList> searchPaths);
+
+    bool resolvePath(const String& key, ResolvedPath* resolved) const;
+
+    bool openResolvedPath(const ResolvedPath& resolved, const char* mode, IOStream* file) const;
+
+    bool mapResolvedPath(const ResolvedPath& resolved, MappedFile* file) const;
+
+    bool readArchiveFile(const PackFile& archive, const String& path, Vector<byte>* dest) const;
+
+    AsyncFileReader& getFileReader() const;
+
+    void removeCachedPath(const String& key) const;
+
+    void watchSearchPaths();
+
+    // Only used from the main thread
     Vector<String> m_searchPaths;
+
+    // Guards the search path list and the path cache
+    mutable std::mutex m_pathCacheMutex;
+    std::shared_ptr<const SearchPathList> m_searchPathList;
+    mutable std::map<String, ResolvedPath> m_pathCache;
+    mutable PathCacheStats m_pathCacheStats;
+    mutable uint64 m_pathCacheGeneration;
+
+    AsyncTaskRunner* m_taskRunner;
+
+    struct WatchedDirectory {
+        size_t searchPath;
+        String folder;
+    };
+
+    // Created when the file watching is enabled
+    std::unique_ptr<FileWatcher> m_fileWatcher;
+    Vector<String> m_watchedFolders;
+    // Search path and folder of each directory of the FileWatcher
+    Vector<WatchedDirectory> m_watchedDirectories;
+
+    // Created on the first asynchronous read
+    mutable std::mutex m_fileReaderMutex;
+    mutable std::unique_ptr<AsyncFileReader> m_fileReader;
 };
 
 }  // namespace engine
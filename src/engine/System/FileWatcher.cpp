@@ -0,0 +1,175 @@
+#include <System/FileWatcher.hpp>
+
+#include <System/LogManager.hpp>
+#include <System/StringView.hpp>
+
+#if PLATFORM_IS(PLATFORM_LINUX)
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+#include <filesystem>
+#include <set>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <cerrno>
+
+namespace engine {
+
+namespace {
+
+const StringView sTag("FileWatcher");
+
+#if PLATFORM_IS(PLATFORM_LINUX)
+// Files are reported once they are closed after being written, so a
+// file is not reloaded while it's still being saved
+const uint32_t sWatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_ONLYDIR;
+#endif
+
+String JoinWatchPath(const String& left, const String& right) {
+    if (left.isEmpty()) {
+        return right;
+    }
+    return left + "/" + right;
+}
+
+}  // namespace
+
+FileWatcher::FileWatcher() : m_fd(-1) {
+#if PLATFORM_IS(PLATFORM_LINUX)
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        LogWarning(sTag, "Could not initialize inotify, the file changes will not be detected");
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#if PLATFORM_IS(PLATFORM_LINUX)
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+}
+
+bool FileWatcher::isSupported() const {
+    return m_fd >= 0;
+}
+
+bool FileWatcher::addDirectory(const String& directory) {
+    if (!isSupported()) {
+        return false;
+    }
+
+    size_t index = m_directories.size();
+    m_directories.push_back(directory.isEmpty() ? String(".") : directory);
+    if (!addWatch(index, "")) {
+        m_directories.pop_back();
+        return false;
+    }
+    return true;
+}
+
+void FileWatcher::removeAll() {
+#if PLATFORM_IS(PLATFORM_LINUX)
+    for (const auto& pair : m_watches) {
+        inotify_rm_watch(m_fd, pair.first);
+    }
+#endif
+    m_watches.clear();
+    m_directories.clear();
+}
+
+size_t FileWatcher::getDirectoryCount() const {
+    return m_directories.size();
+}
+
+bool FileWatcher::poll(Vector<Change>* changes) {
+    bool isComplete = true;
+#if PLATFORM_IS(PLATFORM_LINUX)
+    if (!isSupported()) {
+        return true;
+    }
+
+    std::set<std::pair<size_t, String>> changedFiles;
+    alignas(struct inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t length = ::read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            if (length < 0 && errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        for (char* it = buffer; it < buffer + length;) {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(it);
+            it += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                isComplete = false;
+                continue;
+            }
+
+            auto watchIt = m_watches.find(event->wd);
+            if (watchIt == m_watches.end()) {
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                // The watched directory was removed
+                m_watches.erase(watchIt);
+                continue;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+
+            Watch watch = watchIt->second;
+            String path = JoinWatchPath(watch.path, event->name);
+            if (event->mask & IN_ISDIR) {
+                // New subdirectories are watched too
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    addWatch(watch.directory, path);
+                }
+            } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE)) {
+                changedFiles.emplace(watch.directory, std::move(path));
+            }
+        }
+    }
+
+    for (const auto& changedFile : changedFiles) {
+        changes->push_back({changedFile.first, changedFile.second});
+    }
+#else
+    ENGINE_UNUSED(changes);
+#endif
+    return isComplete;
+}
+
+bool FileWatcher::addWatch(size_t directory, const String& path) {
+#if PLATFORM_IS(PLATFORM_LINUX)
+    String fullPath = JoinWatchPath(m_directories[directory], path);
+    int wd = inotify_add_watch(m_fd, fullPath.getData(), sWatchMask);
+    if (wd < 0) {
+        return false;
+    }
+    m_watches[wd] = {directory, path};
+
+    // inotify is not recursive, each subdirectory has its own watch
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(fullPath.toUtf8(), error)) {
+        if (entry.is_directory(error)) {
+            addWatch(directory, JoinWatchPath(path, String(entry.path().filename().string())));
+        }
+    }
+    return true;
+#else
+    ENGINE_UNUSED(directory);
+    ENGINE_UNUSED(path);
+    return false;
+#endif
+}
+
+}  // namespace engine
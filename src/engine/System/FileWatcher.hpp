@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <System/String.hpp>
+#include <Util/Container/Vector.hpp>
+#include <Util/NonCopyable.hpp>
+
+#include <map>
+
+namespace engine {
+
+/**
+ * @brief Watches directories to detect the files that change on disk
+ *
+ * @details The changes are detected with inotify on Linux, the events
+ *          are queued by the kernel and collected without blocking when
+ *          poll is called. On the other platforms no changes are
+ *          reported.
+ */
+class ENGINE_API FileWatcher : NonCopyable {
+public:
+    /**
+     * @brief File that was modified, created, moved or removed
+     */
+    struct Change {
+        // Index of the watched directory that contains the file
+        size_t directory;
+        // Path of the file relative to the watched directory
+        String path;
+    };
+
+    FileWatcher();
+
+    ~FileWatcher();
+
+    /**
+     * @brief Check if the changes can be detected in this platform
+     */
+    bool isSupported() const;
+
+    /**
+     * @brief Watch a directory and all its subdirectories
+     *
+     * @param directory The path of the directory, an empty path watches
+     *                  the current working directory
+     * @return true if the directory is being watched, false otherwise
+     */
+    bool addDirectory(const String& directory);
+
+    /**
+     * @brief Stop watching all the directories
+     */
+    void removeAll();
+
+    size_t getDirectoryCount() const;
+
+    /**
+     * @brief Collect the changes detected since the last call
+     *
+     * @details Each file is reported once even if it received multiple
+     *          events, so bursts of writes are coalesced
+     *
+     * @param changes Receives the changed files
+     * @return false if the kernel queue overflowed and some changes
+     *         were lost, true otherwise
+     */
+    bool poll(Vector<Change>* changes);
+
+private:
+    struct Watch {
+        size_t directory;
+        // Path of the watched subdirectory relative to the directory
+        String path;
+    };
+
+    bool addWatch(size_t directory, const String& path);
+
+    int m_fd;
+    Vector<String> m_directories;
+    std::map<int, Watch> m_watches;
+};
+
+}  // namespace engine
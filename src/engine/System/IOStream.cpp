@@ -3,11 +3,54 @@
 
 #include <SDL2.h>
 
+#include <limits>
+
 namespace engine {
 
+namespace {
+
+// SDL_RWFromConstMem rejects the empty buffers, the empty files are
+// opened as a stream without anything to read
+SDL_RWops* CreateEmptyStream() {
+    SDL_RWops* stream = SDL_AllocRW();
+    if (stream == nullptr) {
+        return nullptr;
+    }
+    stream->type = SDL_RWOPS_UNKNOWN;
+    stream->size = [](SDL_RWops* /*context*/) -> Sint64 { return 0; };
+    stream->seek = [](SDL_RWops* /*context*/, Sint64 /*offset*/, int /*whence*/) -> Sint64 { return 0; };
+    stream->read = [](SDL_RWops* /*context*/, void* /*ptr*/, size_t /*size*/, size_t /*count*/) -> size_t {
+        return 0;
+    };
+    stream->write = [](SDL_RWops* /*context*/, const void* /*ptr*/, size_t /*size*/, size_t /*count*/) -> size_t {
+        return 0;
+    };
+    stream->close = [](SDL_RWops* context) -> int {
+        SDL_FreeRW(context);
+        return 0;
+    };
+    return stream;
+}
+
+SDL_RWops* CreateMemoryStream(const void* data, size_t size) {
+    if (size == 0) {
+        return CreateEmptyStream();
+    }
+    // SDL takes the size of the buffer as an int
+    if (size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        return nullptr;
+    }
+    return SDL_RWFromConstMem(data, static_cast<int>(size));
+}
+
+}  // namespace
+
 IOStream::IOStream() : m_file(nullptr) {}
 
-IOStream::IOStream(IOStream&& other) noexcept : m_file(other.m_file), m_lastError(std::move(other.m_lastError)) {
+IOStream::IOStream(IOStream&& other) noexcept
+      : m_file(other.m_file),
+        m_buffer(std::move(other.m_buffer)),
+        m_lastError(std::move(other.m_lastError)) {
     other.m_file = nullptr;
     other.m_lastError.clear();
 }
@@ -35,9 +78,28 @@ bool IOStream::open(const StringView& filename, const char* mode) {
     return m_file != nullptr;
 }
 
+bool IOStream::open(const void* data, size_t size) {
+    if (m_file) {
+        close();
+    }
+    m_file = CreateMemoryStream(data, size);
+    return m_file != nullptr;
+}
+
+bool IOStream::open(Vector<byte>&& buffer) {
+    if (m_file) {
+        close();
+    }
+    // The data of the vector is not moved when the stream is moved
+    m_buffer = std::move(buffer);
+    m_file = CreateMemoryStream(m_buffer.data(), m_buffer.size());
+    return m_file != nullptr;
+}
+
 void IOStream::close() {
     SDL_RWclose(m_file);
     m_file = nullptr;
+    m_buffer = Vector<byte>();
 }
 
 size_t IOStream::read(void* buffer, size_t size, size_t count) {
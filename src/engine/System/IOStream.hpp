@@ -4,6 +4,7 @@
 
 #include <System/String.hpp>
 #include <System/StringView.hpp>
+#include <Util/Container/Vector.hpp>
 #include <Util/NonCopyable.hpp>
 
 struct SDL_RWops;
@@ -27,6 +28,18 @@ public:
 
     bool open(const StringView& filename, const char* mode);
 
+    /**
+     * @brief Open a read-only stream over a memory buffer
+     *
+     * @warning The buffer must outlive the stream
+     */
+    bool open(const void* data, size_t size);
+
+    /**
+     * @brief Open a read-only stream that owns a memory buffer
+     */
+    bool open(Vector<byte>&& buffer);
+
     void close();
 
     size_t read(void* buffer, size_t size, size_t count);
@@ -45,6 +58,7 @@ public:
 
 private:
     SDL_RWops* m_file;
+    Vector<byte> m_buffer;
     String m_lastError;
 };
 
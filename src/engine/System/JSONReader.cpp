@@ -0,0 +1,199 @@
+#include <System/JSONReader.hpp>
+
+#include <System/StringFormat.hpp>
+
+#include <utility>
+
+namespace engine {
+
+JSONReader::Value::Type JSONReader::Value::getType() const {
+    return m_type;
+}
+
+bool JSONReader::Value::isNumber() const {
+    return m_type == Type::INTEGER || m_type == Type::FLOAT;
+}
+
+bool JSONReader::Value::isString() const {
+    return m_type == Type::STRING;
+}
+
+bool JSONReader::Value::asBoolean() const {
+    return m_boolean;
+}
+
+int64 JSONReader::Value::asInteger() const {
+    return (m_type == Type::FLOAT) ? static_cast<int64>(m_float) : m_integer;
+}
+
+float JSONReader::Value::asFloat() const {
+    return (m_type == Type::FLOAT) ? static_cast<float>(m_float) : static_cast<float>(m_integer);
+}
+
+String JSONReader::Value::asString() const {
+    return (m_string != nullptr) ? String(*m_string) : String();
+}
+
+JSONReader::JSONReader() : m_depth(0) {}
+
+JSONReader::~JSONReader() = default;
+
+bool JSONReader::parse(const byte* data, size_t size) {
+    // The scopes are kept between documents to reuse their keys memory
+    m_depth = 0;
+    m_error.clear();
+    bool isValid = json::sax_parse(data, data + size, this);
+    if (!isValid && m_error.isEmpty()) {
+        m_error = "Invalid document";
+    }
+    return isValid;
+}
+
+const String& JSONReader::getError() const {
+    return m_error;
+}
+
+bool JSONReader::null() {
+    Value value;
+    return reportValue(value);
+}
+
+bool JSONReader::boolean(bool val) {
+    Value value;
+    value.m_type = Value::Type::BOOLEAN;
+    value.m_boolean = val;
+    return reportValue(value);
+}
+
+bool JSONReader::number_integer(number_integer_t val) {
+    Value value;
+    value.m_type = Value::Type::INTEGER;
+    value.m_integer = val;
+    return reportValue(value);
+}
+
+bool JSONReader::number_unsigned(number_unsigned_t val) {
+    Value value;
+    value.m_type = Value::Type::INTEGER;
+    value.m_integer = static_cast<int64>(val);
+    return reportValue(value);
+}
+
+bool JSONReader::number_float(number_float_t val, const string_t& /*s*/) {
+    Value value;
+    value.m_type = Value::Type::FLOAT;
+    value.m_float = val;
+    return reportValue(value);
+}
+
+bool JSONReader::string(string_t& val) {
+    Value value;
+    value.m_type = Value::Type::STRING;
+    value.m_string = &val;
+    return reportValue(value);
+}
+
+bool JSONReader::binary(binary_t& /*val*/) {
+    // Binary values only exist in the binary formats
+    return setError("Unexpected binary value");
+}
+
+bool JSONReader::start_object(std::size_t /*elements*/) {
+    return onStartObject() && pushScope(false);
+}
+
+bool JSONReader::key(string_t& val) {
+    m_scopes[m_depth - 1].key.swap(val);
+    return true;
+}
+
+bool JSONReader::end_object() {
+    m_depth--;
+    bool result = onEndObject();
+    advance();
+    return result;
+}
+
+bool JSONReader::start_array(std::size_t /*elements*/) {
+    return onStartArray() && pushScope(true);
+}
+
+bool JSONReader::end_array() {
+    m_depth--;
+    bool result = onEndArray();
+    advance();
+    return result;
+}
+
+bool JSONReader::parse_error(std::size_t position,
+                             const std::string& /*lastToken*/,
+                             const nlohmann::detail::exception& ex) {
+    if (m_error.isEmpty()) {
+        m_error = "Syntax error at byte {}: {}"_format(position, ex.what());
+    }
+    return false;
+}
+
+bool JSONReader::onStartObject() {
+    return true;
+}
+
+bool JSONReader::onEndObject() {
+    return true;
+}
+
+bool JSONReader::onStartArray() {
+    return true;
+}
+
+bool JSONReader::onEndArray() {
+    return true;
+}
+
+bool JSONReader::isAt(std::initializer_list<const char*> path) const {
+    if (path.size() != m_depth) {
+        return false;
+    }
+    size_t i = 0;
+    for (const char* key : path) {
+        const Scope& scope = m_scopes[i++];
+        if (scope.isArray ? key != nullptr : (key == nullptr || scope.key != key)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t JSONReader::getIndex() const {
+    return m_scopes[m_depth - 1].index;
+}
+
+bool JSONReader::setError(String error) {
+    m_error = std::move(error);
+    return false;
+}
+
+bool JSONReader::reportValue(Value& value) {
+    bool result = onValue(value);
+    advance();
+    return result;
+}
+
+bool JSONReader::pushScope(bool isArray) {
+    if (m_depth == m_scopes.size()) {
+        m_scopes.emplace_back();
+    }
+    Scope& scope = m_scopes[m_depth++];
+    scope.isArray = isArray;
+    scope.key.clear();
+    scope.index = 0;
+    return true;
+}
+
+void JSONReader::advance() {
+    if (m_depth > 0 && m_scopes[m_depth - 1].isArray) {
+        m_scopes[m_depth - 1].index++;
+    }
+}
+
+}  // namespace engine
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <System/JSON.hpp>
+#include <System/String.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <initializer_list>
+#include <string>
+
+namespace engine {
+
+/**
+ * @brief Base class of the readers that extract typed data from a JSON
+ *        document in a single pass
+ *
+ * @details The document is validated while it's parsed and the values
+ *          are reported to the derived class together with their path,
+ *          so the data can be stored directly in its final structures
+ *          without building a json DOM. The derived classes can stop
+ *          the parsing returning false from any handler.
+ */
+class ENGINE_API JSONReader : public nlohmann::json_sax<json> {
+public:
+    /**
+     * @brief Scalar value reported to the onValue handler
+     */
+    class ENGINE_API Value {
+    public:
+        enum class Type {
+            NONE,
+            BOOLEAN,
+            INTEGER,
+            FLOAT,
+            STRING,
+        };
+
+        Type getType() const;
+
+        bool isNumber() const;
+
+        bool isString() const;
+
+        bool asBoolean() const;
+
+        int64 asInteger() const;
+
+        float asFloat() const;
+
+        String asString() const;
+
+    private:
+        friend class JSONReader;
+
+        Type m_type = Type::NONE;
+        bool m_boolean = false;
+        int64 m_integer = 0;
+        double m_float = 0.0;
+        const std::string* m_string = nullptr;
+    };
+
+    JSONReader();
+
+    ~JSONReader() override;
+
+    /**
+     * @brief Parse a document reporting its values to the handlers
+     *
+     * @param data The document data encoded in UTF-8
+     * @param size The size of the document in bytes
+     * @return true if the document is valid and all the handlers
+     *         succeeded, false otherwise
+     */
+    bool parse(const byte* data, size_t size);
+
+    /**
+     * @brief Get the reason why the last parse failed
+     */
+    const String& getError() const;
+
+    // json_sax interface
+    bool null() final;
+    bool boolean(bool val) final;
+    bool number_integer(number_integer_t val) final;
+    bool number_unsigned(number_unsigned_t val) final;
+    bool number_float(number_float_t val, const string_t& s) final;
+    bool string(string_t& val) final;
+    bool binary(binary_t& val) final;
+    bool start_object(std::size_t elements) final;
+    bool key(string_t& val) final;
+    bool end_object() final;
+    bool start_array(std::size_t elements) final;
+    bool end_array() final;
+    bool parse_error(std::size_t position, const std::string& lastToken, const nlohmann::detail::exception& ex) final;
+
+protected:
+    /**
+     * @brief Called for each scalar value of the document
+     */
+    virtual bool onValue(const Value& value) = 0;
+
+    /**
+     * @brief Called when an object starts, the path is the one of the
+     *        object itself
+     */
+    virtual bool onStartObject();
+
+    /**
+     * @brief Called when an object ends, the path is the one of the
+     *        object itself
+     */
+    virtual bool onEndObject();
+
+    virtual bool onStartArray();
+
+    virtual bool onEndArray();
+
+    /**
+     * @brief Check the path of the value being reported
+     *
+     * @param path The keys of the objects that contain the value, each
+     *             nullptr matches any element of an array
+     * @return true if the path matches exactly, false otherwise
+     */
+    bool isAt(std::initializer_list<const char*> path) const;
+
+    /**
+     * @brief Get the index of the current element in its array
+     *
+     * @details Only valid if the value being reported is inside an array
+     */
+    size_t getIndex() const;
+
+    /**
+     * @brief Stop the parsing with an error
+     *
+     * @return false so it can be returned from the handlers
+     */
+    bool setError(String error);
+
+private:
+    struct Scope {
+        bool isArray;
+        // Key of the current member if the scope is an object
+        std::string key;
+        // Index of the current element if the scope is an array
+        size_t index;
+    };
+
+    bool reportValue(Value& value);
+
+    bool pushScope(bool isArray);
+
+    void advance();
+
+    Vector<Scope> m_scopes;
+    size_t m_depth;
+    String m_error;
+};
+
+}  // namespace engine
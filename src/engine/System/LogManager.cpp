@@ -1,12 +1,20 @@
 #include <System/LogManager.hpp>
 
+#include <System/Stopwatch.hpp>
 #include <System/String.hpp>
 #include <System/StringView.hpp>
+#include <System/Time.hpp>
 
 #include <SDL2.h>
 
+#include <chrono>
 #include <utility>
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
 #if PLATFORM_IS(PLATFORM_ANDROID)
     #include <android/log.h>
 #endif
@@ -29,39 +37,118 @@ android_LogPriority sAndroidLogPriorities[] = {ANDROID_LOG_UNKNOWN, ANDROID_LOG_
 
 const char* sLogPriorityNames[] = {nullptr, "VERBOSE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
 
-String DefaultLogCallback(LogPriority priority, const StringView& tag, const StringView& message) {
+String DefaultLogCallback(LogPriority priority, const StringView& tag, const StringView& message, std::time_t t) {
     const char* priorityName = sLogPriorityNames[static_cast<int>(priority)];
 
-    // Get the current system hour
-    std::time_t t = std::time(nullptr);
-    std::tm* tm = std::localtime(&t);
+    // Get the system hour of the message, the messages are formatted by
+    // several threads so the reentrant version is used
+    std::tm tm = {};
+#if PLATFORM_IS(PLATFORM_WINDOWS)
+    localtime_s(&tm, &t);
+#else
+    localtime_r(&t, &tm);
+#endif
 
     // Format the log message
-    fmt::string_view tagView(tag.getData(), tag.getSize());
-    fmt::string_view messageView(message.getData(), message.getSize());
-    return "[{:02d}:{:02d}:{:02d}] [{}/{}] : {}"_format(tm->tm_hour, tm->tm_min, tm->tm_sec, tagView,
-                                                        priorityName, messageView);
+    fmt::string_view tagView(tag.getData(), tag.getDataSize());
+    fmt::string_view messageView(message.getData(), message.getDataSize());
+    return "[{:02d}:{:02d}:{:02d}] [{}/{}] : {}"_format(tm.tm_hour, tm.tm_min, tm.tm_sec, tagView, priorityName,
+                                                        messageView);
 }
 
 }  // namespace
 
-LogManager::LogManager()
-      : m_appName("Engine"),
-        m_logFile("engine.log"),
-        m_fileLoggingEnable(true),
-        m_consoleLoggingEnable(true) {}
+const size_t LogManager::sDefaultBufferCapacity(4096);
+
+LogManager::LogManager() : LogManager("Engine", "engine.log") {}
 
 LogManager::LogManager(String appName, String logFile)
       : m_appName(std::move(appName)),
         m_logFile(std::move(logFile)),
         m_fileLoggingEnable(true),
-        m_consoleLoggingEnable(true) {}
+        m_consoleLoggingEnable(true),
+        m_minPriority(sMinLogPriority),
+        m_hasTagPriorities(false),
+        m_isBinaryLoggingEnabled(false),
+        m_file(nullptr),
+        m_bufferCapacity(sDefaultBufferCapacity),
+        m_overflowPolicy(LogOverflowPolicy::DROP),
+        m_isWriterRunning(false),
+        m_isWriterWaiting(false),
+        m_pushedRecords(0),
+        m_writtenRecords(0),
+        m_droppedRecords(0),
+        m_recordsPerSecond(0),
+        m_bytesPerSecond(0) {}
+
+LogManager::~LogManager() {
+    shutdown();
+    if (m_file != nullptr) {
+        SDL_RWclose(m_file);
+    }
+}
+
+void LogManager::initialize() {
+    if (m_writerThread.joinable()) {
+        return;
+    }
+    m_records = std::make_unique<MPSCRingBuffer<LogRecord>>(m_bufferCapacity);
+    m_pushedRecords = 0;
+    m_writtenRecords = 0;
+    m_isWriterRunning = true;
+    m_writerThread = std::thread(&LogManager::runWriter, this);
+}
+
+void LogManager::shutdown() {
+    if (!m_writerThread.joinable()) {
+        return;
+    }
+    m_isWriterRunning = false;
+    wakeWriter();
+    m_writerThread.join();
+
+    // Write the messages pushed while the writer was stopping
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    LogRecord record;
+    while (m_records->tryPop(&record)) {
+        writeRecord(record);
+    }
+    flushOutputs();
+}
+
+void LogManager::flush() {
+    if (!m_isWriterRunning) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        flushOutputs();
+        return;
+    }
+
+    uint64 target = m_pushedRecords.load();
+    wakeWriter();
+    {
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        m_flushSignaler.wait(lock, [this, target]() { return m_writtenRecords >= target || !m_isWriterRunning; });
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    flushOutputs();
+}
 
-LogManager::~LogManager() = default;
+void LogManager::setBufferCapacity(size_t capacity) {
+    m_bufferCapacity = capacity;
+}
 
-void LogManager::initialize() {}
+void LogManager::setOverflowPolicy(LogOverflowPolicy policy) {
+    m_overflowPolicy = policy;
+}
 
-void LogManager::shutdown() {}
+LogManager::Statistics LogManager::getStatistics() const {
+    Statistics statistics;
+    statistics.recordsPerSecond = m_recordsPerSecond.load(std::memory_order_relaxed);
+    statistics.bytesPerSecond = m_bytesPerSecond.load(std::memory_order_relaxed);
+    statistics.droppedRecords = m_droppedRecords.load(std::memory_order_relaxed);
+    return statistics;
+}
 
 void LogManager::verbose(const StringView& tag, const StringView& message) {
     logMessage(LogPriority::VERBOSE, tag, message);
@@ -88,50 +175,246 @@ void LogManager::fatal(const StringView& tag, const StringView& message) {
 }
 
 void LogManager::logMessage(LogPriority priority, const StringView& tag, const StringView& message) {
-    if (!m_fileLoggingEnable && !m_consoleLoggingEnable) {
+    if (!isEnabled(priority, tag)) {
         return;
     }
 
-#ifndef ENGINE_DEBUG
-    if (priority == LogPriority::DEBUG) {
+    LogRecord record;
+    record.priority = priority;
+    record.message = DefaultLogCallback(priority, tag, message, std::time(nullptr));
+    submitRecord(std::move(record));
+}
+
+void LogManager::logDeferred(LogPriority priority,
+                             const StringView& tag,
+                             std::unique_ptr<internal::DeferredLogMessage>&& message) {
+    if (!isEnabled(priority, tag)) {
         return;
     }
-#endif
 
-    String logMessage = DefaultLogCallback(priority, tag, message);
+    LogRecord record;
+    record.priority = priority;
+    record.time = std::time(nullptr);
+    if (m_isWriterRunning.load(std::memory_order_acquire)) {
+        record.tag.assign(tag.getData(), tag.getDataSize());
+        record.deferred = std::move(message);
+    } else {
+        // Nothing would format the message later
+        std::string formatted = message->format();
+        record.message = DefaultLogCallback(priority, tag, StringView(formatted.data(), formatted.size()), record.time);
+    }
+    submitRecord(std::move(record));
+}
+
+bool LogManager::isEnabled(LogPriority priority, const StringView& tag) const {
+    if (!m_fileLoggingEnable && !m_consoleLoggingEnable) {
+        return false;
+    }
+
+    if (m_hasTagPriorities.load(std::memory_order_acquire)) {
+        std::shared_lock<std::shared_mutex> lock(m_tagPrioritiesMutex);
+        auto it = m_tagPriorities.find(tag);
+        if (it != m_tagPriorities.end()) {
+            return priority >= it->second;
+        }
+    }
+    return priority >= m_minPriority.load(std::memory_order_relaxed);
+}
+
+void LogManager::setMinPriority(LogPriority priority) {
+    m_minPriority = priority;
+}
+
+void LogManager::setTagPriority(const StringView& tag, LogPriority priority) {
+    std::unique_lock<std::shared_mutex> lock(m_tagPrioritiesMutex);
+    auto it = m_tagPriorities.find(tag);
+    if (it != m_tagPriorities.end()) {
+        it->second = priority;
+    } else {
+        m_tagPriorities.emplace(String(tag), priority);
+    }
+    m_hasTagPriorities = true;
+}
+
+void LogManager::clearTagPriorities() {
+    std::unique_lock<std::shared_mutex> lock(m_tagPrioritiesMutex);
+    m_tagPriorities.clear();
+    m_hasTagPriorities = false;
+}
+
+void LogManager::enableBinaryLogging(bool enable) {
+    m_isBinaryLoggingEnabled = enable;
+}
+
+bool LogManager::isBinaryLoggingEnabled() const {
+    return m_isBinaryLoggingEnabled.load(std::memory_order_relaxed);
+}
+
+void LogManager::enableFileLogging(bool enable) {
+    m_fileLoggingEnable = enable;
+}
+
+void LogManager::enableConsoleLogging(bool enable) {
+    m_consoleLoggingEnable = enable;
+}
+
+void LogManager::submitRecord(LogRecord&& record) {
+    LogPriority priority = record.priority;
+
+    if (m_isWriterRunning.load(std::memory_order_acquire)) {
+        pushRecord(std::move(record));
+    } else {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        writeRecord(record);
+    }
+
+    if (priority == LogPriority::FATAL) {
+        // Make sure the reason of the exit reaches the outputs
+        flush();
+        std::exit(1);  // TMP
+    }
+}
+
+void LogManager::pushRecord(LogRecord&& record) {
+    while (!m_records->tryPush(std::move(record))) {
+        // The fatal records always wait, they contain the reason of the exit
+        if (m_overflowPolicy == LogOverflowPolicy::DROP && record.priority != LogPriority::FATAL) {
+            m_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (!m_isWriterRunning) {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            writeRecord(record);
+            return;
+        }
+        wakeWriter();
+        std::this_thread::yield();
+    }
+
+    // Both flags are sequentially consistent so either the writer sees
+    // the new record before waiting or the producer sees it waiting
+    m_pushedRecords.fetch_add(1);
+    if (m_isWriterWaiting) {
+        wakeWriter();
+    }
+}
+
+void LogManager::writeRecord(LogRecord& record) {
+    if (record.deferred) {
+        std::string message = record.deferred->format();
+        record.message = DefaultLogCallback(record.priority, StringView(record.tag.data(), record.tag.size()),
+                                            StringView(message.data(), message.size()), record.time);
+        record.deferred.reset();
+    }
 
-    // Write the log to the file
     if (m_fileLoggingEnable) {
-        if (SDL_RWops* pfile = SDL_RWFromFile(m_logFile.getData(), "ab")) {
-            const auto& str = logMessage.toUtf8();
-            SDL_RWwrite(pfile, str.data(), 1, str.size());
-            SDL_RWwrite(pfile, sLineEnding, 1, strlen(sLineEnding));
-            SDL_RWclose(pfile);
+        if (m_file == nullptr) {
+            m_file = SDL_RWFromFile(m_logFile.getData(), "ab");
+        }
+        if (m_file != nullptr) {
+            SDL_RWwrite(m_file, record.message.getData(), 1, record.message.getDataSize());
+            SDL_RWwrite(m_file, sLineEnding, 1, std::strlen(sLineEnding));
         }
     }
 
-    // Write the log to console
     if (m_consoleLoggingEnable) {
 #if PLATFORM_IS(PLATFORM_ANDROID)
-        __android_log_write(sAndroidLogPriorities[static_cast<int>(priority)], m_appName.getData(),
-                            log_message.getData());
+        __android_log_write(sAndroidLogPriorities[static_cast<int>(record.priority)], m_appName.getData(),
+                            record.message.getData());
 #else
-        fputs(logMessage.getData(), stdout);
-        fputs("\n", stdout);
+        std::fputs(record.message.getData(), stdout);
+        std::fputs("\n", stdout);
 #endif
     }
+}
 
-    if (priority == LogPriority::FATAL) {
-        std::exit(1);  // TMP
+void LogManager::flushOutputs() {
+    if (m_file != nullptr) {
+        // SDL has no flush, reopening the file writes the buffered data
+        SDL_RWclose(m_file);
+        m_file = nullptr;
+    }
+    if (m_consoleLoggingEnable) {
+        std::fflush(stdout);
     }
 }
 
-void LogManager::enableFileLogging(bool enable) {
-    m_fileLoggingEnable = enable;
+void LogManager::wakeWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+    }
+    m_writerSignaler.notify_one();
 }
 
-void LogManager::enableConsoleLogging(bool enable) {
-    m_consoleLoggingEnable = enable;
+void LogManager::runWriter() {
+    uint64 written = 0;
+    uint64 windowRecords = 0;
+    uint64 windowBytes = 0;
+    uint64 reportedDrops = 0;
+    Stopwatch window;
+    window.start();
+
+    LogRecord record;
+    while (true) {
+        bool isRunning = m_isWriterRunning;
+
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            while (m_records->tryPop(&record)) {
+                writeRecord(record);
+                written++;
+                windowRecords++;
+                windowBytes += record.message.getDataSize();
+            }
+
+            // Report the messages lost since the last window
+            uint64 dropped = m_droppedRecords.load(std::memory_order_relaxed);
+            if (dropped != reportedDrops) {
+                LogRecord dropRecord;
+                dropRecord.priority = LogPriority::WARN;
+                dropRecord.message = DefaultLogCallback(LogPriority::WARN, "LogManager",
+                                                        "{} messages dropped"_format(dropped - reportedDrops),
+                                                        std::time(nullptr));
+                writeRecord(dropRecord);
+                reportedDrops = dropped;
+            }
+
+            if (m_consoleLoggingEnable) {
+                std::fflush(stdout);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            m_writtenRecords = written;
+        }
+        m_flushSignaler.notify_all();
+
+        Time elapsed = window.getElapsedTime();
+        if (elapsed.asMilliseconds() >= 1000) {
+            float seconds = elapsed.asSeconds();
+            m_recordsPerSecond.store(static_cast<uint64>(windowRecords / seconds), std::memory_order_relaxed);
+            m_bytesPerSecond.store(static_cast<uint64>(windowBytes / seconds), std::memory_order_relaxed);
+            windowRecords = 0;
+            windowBytes = 0;
+            window.restart();
+        }
+
+        if (!isRunning) {
+            break;
+        }
+
+        // Wake up at least once per second to update the throughput
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        m_isWriterWaiting = true;
+        m_writerSignaler.wait_for(lock, std::chrono::seconds(1), [this, written]() {
+            return m_pushedRecords != written || !m_isWriterRunning;
+        });
+        m_isWriterWaiting = false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    flushOutputs();
 }
 
 }  // namespace engine
@@ -5,13 +5,30 @@
 #include <System/String.hpp>
 #include <System/StringFormat.hpp>
 #include <System/StringView.hpp>
+#include <Util/Container/MPSCRingBuffer.hpp>
 #include <Util/Singleton.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 // On Windows undefine this anoying macro defined by windows.h
 #if PLATFORM_IS(PLATFORM_WINDOWS)
     #undef ERROR
 #endif
 
+struct SDL_RWops;
+
 namespace engine {
 
 enum class LogPriority {
@@ -23,16 +40,165 @@ enum class LogPriority {
     FATAL,
 };
 
+/**
+ * @brief Minimum priority of the messages compiled in the binary, the
+ *        Log* calls with a lower priority are removed by the compiler
+ */
+constexpr LogPriority sMinLogPriority = static_cast<LogPriority>(ENGINE_LOG_MIN_PRIORITY);
+
+namespace internal {
+
+/**
+ * @brief Message whose formatting is deferred to the writer thread
+ */
+class ENGINE_API DeferredLogMessage {
+public:
+    virtual ~DeferredLogMessage() = default;
+
+    virtual std::string format() const = 0;
+};
+
+// The arguments are stored by value, the strings that are not owned
+// are copied so they can be formatted after the call returns
+template <typename T>
+struct DeferredLogArgument {
+    using type = T;
+
+    template <typename U>
+    static U&& Convert(U&& value) {
+        return std::forward<U>(value);
+    }
+};
+
+template <>
+struct DeferredLogArgument<const char*> {
+    using type = std::string;
+
+    static std::string Convert(const char* value) {
+        return std::string(value);
+    }
+};
+
+template <>
+struct DeferredLogArgument<char*> : DeferredLogArgument<const char*> {};
+
+template <>
+struct DeferredLogArgument<StringView> {
+    using type = std::string;
+
+    static std::string Convert(const StringView& value) {
+        return std::string(reinterpret_cast<const char*>(value.getData()), value.getDataSize());
+    }
+};
+
+template <>
+struct DeferredLogArgument<std::string_view> {
+    using type = std::string;
+
+    static std::string Convert(std::string_view value) {
+        return std::string(value);
+    }
+};
+
+template <typename T>
+using DeferredLogArgumentType = typename DeferredLogArgument<std::decay_t<T>>::type;
+
+template <typename T>
+decltype(auto) ToDeferredLogArgument(T&& value) {
+    return DeferredLogArgument<std::decay_t<T>>::Convert(std::forward<T>(value));
+}
+
+template <typename... Args>
+class DeferredLogMessageImpl final : public DeferredLogMessage {
+public:
+    template <typename... Values>
+    explicit DeferredLogMessageImpl(const StringView& format, Values&&... values)
+          : m_format(format.getData(), format.getDataSize()),
+            m_args(std::forward<Values>(values)...) {}
+
+    std::string format() const override {
+        try {
+            return std::apply([this](const auto&... args) { return fmt::format(fmt::string_view(m_format), args...); },
+                              m_args);
+        } catch (const fmt::format_error& error) {
+            // The writer thread can't report the error to the caller
+            return fmt::format("Invalid log format \"{}\": {}", m_format, error.what());
+        }
+    }
+
+private:
+    // Copied, an array may be a buffer of the caller and not a literal
+    std::string m_format;
+    std::tuple<Args...> m_args;
+};
+
+}  // namespace internal
+
+/**
+ * @brief What to do with the messages logged while the buffer of the
+ *        writer thread is full
+ */
+enum class LogOverflowPolicy {
+    // Discard the message, the number of dropped messages is reported.
+    // The fatal messages are never discarded
+    DROP,
+    // Wait until the writer thread makes space for the message
+    BLOCK,
+};
+
+/**
+ * @brief Formats the log messages and writes them to the console and to
+ *        the log file
+ *
+ * @details Once initialized the messages are queued in a lock-free ring
+ *          buffer and written by a background thread that keeps the log
+ *          file open, so logging never waits for the disk. Before that
+ *          and after the shutdown the messages are written synchronously.
+ */
 class ENGINE_API LogManager : public Singleton<LogManager> {
 public:
+    /**
+     * @brief Throughput of the writer thread measured each second
+     */
+    struct Statistics {
+        uint64 recordsPerSecond = 0;
+        uint64 bytesPerSecond = 0;
+        uint64 droppedRecords = 0;
+    };
+
+    static const size_t sDefaultBufferCapacity;
+
     LogManager();
     LogManager(String appName, String logFile);
 
     ~LogManager();
 
+    /**
+     * @brief Start the writer thread
+     */
     void initialize();
+
+    /**
+     * @brief Write the queued messages and stop the writer thread
+     */
     void shutdown();
 
+    /**
+     * @brief Wait until all the messages logged before the call are
+     *        written
+     */
+    void flush();
+
+    /**
+     * @brief Set the maximum number of messages waiting to be written,
+     *        applied on the next initialize
+     */
+    void setBufferCapacity(size_t capacity);
+
+    void setOverflowPolicy(LogOverflowPolicy policy);
+
+    Statistics getStatistics() const;
+
     void verbose(const StringView& tag, const StringView& message);
     void debug(const StringView& tag, const StringView& message);
     void info(const StringView& tag, const StringView& message);
@@ -42,80 +208,167 @@ public:
 
     void logMessage(LogPriority priority, const StringView& tag, const StringView& message);
 
+    /**
+     * @brief Log a message that is formatted by the writer thread
+     *
+     * @details Used by the Log* functions when the binary logging is
+     *          enabled, the message is formatted immediately if the
+     *          writer thread is not running.
+     */
+    void logDeferred(LogPriority priority,
+                     const StringView& tag,
+                     std::unique_ptr<internal::DeferredLogMessage>&& message);
+
+    /**
+     * @brief Check if the messages of a tag and priority are written
+     *
+     * @details Called by the Log* functions before formatting anything
+     */
+    bool isEnabled(LogPriority priority, const StringView& tag) const;
+
+    /**
+     * @brief Set the minimum priority of the messages of all the tags
+     *        without a specific one
+     */
+    void setMinPriority(LogPriority priority);
+
+    /**
+     * @brief Set the minimum priority of the messages of a tag
+     */
+    void setTagPriority(const StringView& tag, LogPriority priority);
+
+    void clearTagPriorities();
+
+    /**
+     * @brief Enable the binary logging
+     *
+     * @details The Log* calls with arguments store a copy of the format
+     *          string and of the raw arguments, and the text is
+     *          formatted later by the writer thread. A message with an
+     *          invalid format is replaced by a line reporting the error.
+     */
+    void enableBinaryLogging(bool enable);
+
+    bool isBinaryLoggingEnabled() const;
+
     void enableFileLogging(bool enable);
     void enableConsoleLogging(bool enable);
 
 private:
+    struct LogRecord {
+        LogPriority priority = LogPriority::INFO;
+        String message;
+
+        // Data of the deferred messages, formatted by the writer
+        std::time_t time = 0;
+        std::string tag;
+        std::unique_ptr<internal::DeferredLogMessage> deferred;
+    };
+
+    void submitRecord(LogRecord&& record);
+
+    void pushRecord(LogRecord&& record);
+
+    void writeRecord(LogRecord& record);
+
+    void flushOutputs();
+
+    void wakeWriter();
+
+    void runWriter();
+
     String m_appName;
     String m_logFile;
-    bool m_fileLoggingEnable;
-    bool m_consoleLoggingEnable;
-};
+    std::atomic<bool> m_fileLoggingEnable;
+    std::atomic<bool> m_consoleLoggingEnable;
 
-inline void LogVerbose(const StringView& tag, const StringView& message) {
-    LogManager::GetInstance().verbose(tag, message);
-}
+    std::atomic<LogPriority> m_minPriority;
+    std::atomic<bool> m_hasTagPriorities;
+    std::atomic<bool> m_isBinaryLoggingEnabled;
+    std::map<String, LogPriority, std::less<>> m_tagPriorities;
+    mutable std::shared_mutex m_tagPrioritiesMutex;
 
-template <typename... Args>
-inline void LogVerbose(const StringView& tag, const StringView& message, Args&&... args) {
-    auto internalStringView = fmt::string_view(reinterpret_cast<const char*>(message.getData()), message.getSize());
-    auto formated = fmt::format(internalStringView, std::forward<Args>(args)...);
-    LogVerbose(tag, StringView(formated.data()));
-}
+    // The file is kept open between messages, guarded by m_writeMutex
+    SDL_RWops* m_file;
+    std::mutex m_writeMutex;
 
-inline void LogDebug(const StringView& tag, const StringView& message) {
-    LogManager::GetInstance().debug(tag, message);
-}
+    size_t m_bufferCapacity;
+    std::atomic<LogOverflowPolicy> m_overflowPolicy;
+    std::unique_ptr<MPSCRingBuffer<LogRecord>> m_records;
+    std::atomic<bool> m_isWriterRunning;
+    std::atomic<bool> m_isWriterWaiting;
+    std::atomic<uint64> m_pushedRecords;
+    std::atomic<uint64> m_writtenRecords;
+    std::atomic<uint64> m_droppedRecords;
+    std::atomic<uint64> m_recordsPerSecond;
+    std::atomic<uint64> m_bytesPerSecond;
+    std::mutex m_writerMutex;
+    std::condition_variable m_writerSignaler;
+    std::condition_variable m_flushSignaler;
+    std::thread m_writerThread;
+};
 
-template <typename... Args>
-inline void LogDebug(const StringView& tag, const StringView& message, Args&&... args) {
-    auto internalStringView = fmt::string_view(reinterpret_cast<const char*>(message.getData()), message.getSize());
-    auto formated = fmt::format(internalStringView, std::forward<Args>(args)...);
-    LogDebug(tag, StringView(formated.data()));
-}
+namespace internal {
 
-inline void LogInfo(const StringView& tag, const StringView& message) {
-    LogManager::GetInstance().info(tag, message);
+template <LogPriority Priority, typename Format, typename... Args>
+inline void Log(const StringView& tag, const Format& message, Args&&... args) {
+    if constexpr (Priority >= sMinLogPriority) {
+        LogManager& logManager = LogManager::GetInstance();
+        if constexpr (sizeof...(Args) == 0) {
+            logManager.logMessage(Priority, tag, StringView(message));
+        } else {
+            if (!logManager.isEnabled(Priority, tag)) {
+                return;
+            }
+            StringView format(message);
+            if (logManager.isBinaryLoggingEnabled()) {
+                using Message = DeferredLogMessageImpl<DeferredLogArgumentType<Args>...>;
+                auto deferred = std::make_unique<Message>(format, ToDeferredLogArgument(std::forward<Args>(args))...);
+                logManager.logDeferred(Priority, tag, std::move(deferred));
+                return;
+            }
+            auto internalStringView =
+                  fmt::string_view(reinterpret_cast<const char*>(format.getData()), format.getDataSize());
+            auto formated = fmt::format(internalStringView, std::forward<Args>(args)...);
+            logManager.logMessage(Priority, tag, StringView(formated.data(), formated.size()));
+        }
+    } else {
+        ENGINE_UNUSED(tag);
+        ENGINE_UNUSED(message);
+        (ENGINE_UNUSED(args), ...);
+    }
 }
 
-template <typename... Args>
-inline void LogInfo(const StringView& tag, const StringView& message, Args&&... args) {
-    auto internalStringView = fmt::string_view(reinterpret_cast<const char*>(message.getData()), message.getSize());
-    auto formated = fmt::format(internalStringView, std::forward<Args>(args)...);
-    LogInfo(tag, StringView(formated.data()));
-}
+}  // namespace internal
 
-inline void LogWarning(const StringView& tag, const StringView& message) {
-    LogManager::GetInstance().warning(tag, message);
+template <typename Format, typename... Args>
+inline void LogVerbose(const StringView& tag, const Format& message, Args&&... args) {
+    internal::Log<LogPriority::VERBOSE>(tag, message, std::forward<Args>(args)...);
 }
 
-template <typename... Args>
-inline void LogWarning(const StringView& tag, const StringView& message, Args&&... args) {
-    auto internalStringView = fmt::string_view(reinterpret_cast<const char*>(message.getData()), message.getSize());
-    auto formated = fmt::format(internalStringView, std::forward<Args>(args)...);
-    LogWarning(tag, StringView(formated.data()));
+template <typename Format, typename... Args>
+inline void LogDebug(const StringView& tag, const Format& message, Args&&... args) {
+    internal::Log<LogPriority::DEBUG>(tag, message, std::forward<Args>(args)...);
 }
 
-inline void LogError(const StringView& tag, const StringView& message) {
-    LogManager::GetInstance().error(tag, message);
+template <typename Format, typename... Args>
+inline void LogInfo(const StringView& tag, const Format& message, Args&&... args) {
+    internal::Log<LogPriority::INFO>(tag, message, std::forward<Args>(args)...);
 }
 
-template <typename... Args>
-inline void LogError(const StringView& tag, const StringView& message, Args&&... args) {
-    auto internalStringView = fmt::string_view(reinterpret_cast<const char*>(message.getData()), message.getSize());
-    auto formated = fmt::format(internalStringView, std::forward<Args>(args)...);
-    LogError(tag, StringView(formated.data()));
+template <typename Format, typename... Args>
+inline void LogWarning(const StringView& tag, const Format& message, Args&&... args) {
+    internal::Log<LogPriority::WARN>(tag, message, std::forward<Args>(args)...);
 }
 
-inline void LogFatal(const StringView& tag, const StringView& message) {
-    LogManager::GetInstance().fatal(tag, message);
+template <typename Format, typename... Args>
+inline void LogError(const StringView& tag, const Format& message, Args&&... args) {
+    internal::Log<LogPriority::ERROR>(tag, message, std::forward<Args>(args)...);
 }
 
-template <typename... Args>
-inline void LogFatal(const StringView& tag, const StringView& message, Args&&... args) {
-    auto internalStringView = fmt::string_view(reinterpret_cast<const char*>(message.getData()), message.getSize());
-    auto formated = fmt::format(internalStringView, std::forward<Args>(args)...);
-    LogFatal(tag, StringView(formated.data()));
+template <typename Format, typename... Args>
+inline void LogFatal(const StringView& tag, const Format& message, Args&&... args) {
+    internal::Log<LogPriority::FATAL>(tag, message, std::forward<Args>(args)...);
 }
 
 }  // namespace engine
@@ -0,0 +1,222 @@
+#include <System/MappedFile.hpp>
+
+#include <System/PackFile.hpp>
+#include <System/String.hpp>
+
+#if PLATFORM_IS(PLATFORM_WINDOWS)
+    #include <windows.h>
+#elif PLATFORM_IS(PLATFORM_LINUX | PLATFORM_MACOS | PLATFORM_IOS | PLATFORM_ANDROID)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+// Data of the empty files, they are open with a non null pointer
+const byte sEmptyData[1] = {0};
+
+}  // namespace
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_mapping(nullptr), m_isView(false) {}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+      : m_data(other.m_data),
+        m_size(other.m_size),
+        m_mapping(other.m_mapping),
+        m_isView(other.m_isView),
+        m_buffer(std::move(other.m_buffer)),
+        m_archive(std::move(other.m_archive)) {
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_mapping = nullptr;
+    other.m_isView = false;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_mapping, other.m_mapping);
+        std::swap(m_isView, other.m_isView);
+        std::swap(m_buffer, other.m_buffer);
+        std::swap(m_archive, other.m_archive);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const StringView& filename) {
+    close();
+
+#if PLATFORM_IS(PLATFORM_WINDOWS)
+    auto wideFilename = String(filename).toWide();
+    HANDLE file = CreateFileW(reinterpret_cast<LPCWSTR>(wideFilename.data()), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    if (fileSize.QuadPart == 0) {
+        // Empty files can't be mapped
+        CloseHandle(file);
+        openView(sEmptyData, 0, nullptr);
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_data = static_cast<const byte*>(data);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    m_mapping = mapping;
+    return true;
+#elif PLATFORM_IS(PLATFORM_LINUX | PLATFORM_MACOS | PLATFORM_IOS | PLATFORM_ANDROID)
+    // The view may not be null terminated
+    String path(filename);
+    int fd = ::open(path.getData(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    if (fileStat.st_size == 0) {
+        // Empty files can't be mapped
+        ::close(fd);
+        openView(sEmptyData, 0, nullptr);
+        return true;
+    }
+
+    // The mapping keeps a reference to the file, so it can be closed
+    void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<const byte*>(data);
+    m_size = static_cast<size_t>(fileStat.st_size);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MappedFile::close() {
+    if (m_data == nullptr) {
+        return;
+    }
+    if (!m_isView) {
+#if PLATFORM_IS(PLATFORM_WINDOWS)
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+#elif PLATFORM_IS(PLATFORM_LINUX | PLATFORM_MACOS | PLATFORM_IOS | PLATFORM_ANDROID)
+        munmap(const_cast<byte*>(m_data), m_size);
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+    m_isView = false;
+    m_buffer = Vector<byte>();
+    m_archive.reset();
+}
+
+void MappedFile::advise(Advice advice) const {
+    // The decompressed buffers are already in memory
+    if (m_data == nullptr || !m_buffer.empty()) {
+        return;
+    }
+#if PLATFORM_IS(PLATFORM_LINUX | PLATFORM_MACOS | PLATFORM_IOS | PLATFORM_ANDROID)
+    int posixAdvice = MADV_NORMAL;
+    switch (advice) {
+        case Advice::NORMAL:
+            posixAdvice = MADV_NORMAL;
+            break;
+        case Advice::SEQUENTIAL:
+            posixAdvice = MADV_SEQUENTIAL;
+            break;
+        case Advice::RANDOM:
+            posixAdvice = MADV_RANDOM;
+            break;
+        case Advice::WILL_NEED:
+            posixAdvice = MADV_WILLNEED;
+            break;
+    }
+
+    // madvise requires an address aligned to the page size, the views
+    // may start in the middle of a page
+    auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    auto address = reinterpret_cast<uintptr_t>(m_data);
+    uintptr_t alignedAddress = address - address % pageSize;
+    madvise(reinterpret_cast<void*>(alignedAddress), m_size + (address - alignedAddress), posixAdvice);
+#else
+    (void)advice;
+#endif
+}
+
+const byte* MappedFile::getData() const {
+    return m_data;
+}
+
+size_t MappedFile::getSize() const {
+    return m_size;
+}
+
+bool MappedFile::isOpen() const {
+    return m_data != nullptr;
+}
+
+const byte* MappedFile::begin() const {
+    return m_data;
+}
+
+const byte* MappedFile::end() const {
+    return m_data + m_size;
+}
+
+void MappedFile::openView(const byte* data, size_t size, std::shared_ptr<const PackFile> archive) {
+    close();
+    m_data = data;
+    m_size = size;
+    m_isView = true;
+    m_archive = std::move(archive);
+}
+
+void MappedFile::openBuffer(Vector<byte>&& buffer) {
+    close();
+    m_buffer = std::move(buffer);
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    m_isView = true;
+}
+
+}  // namespace engine
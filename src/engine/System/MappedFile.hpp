@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <System/StringView.hpp>
+#include <Util/Container/Vector.hpp>
+#include <Util/NonCopyable.hpp>
+
+#include <memory>
+
+namespace engine {
+
+class PackFile;
+
+/**
+ * @brief Read-only view of a file mapped in the process memory
+ *
+ * @details The file is unmapped when the object is destroyed, the
+ *          pages are loaded by the OS on demand when they are accessed
+ */
+class ENGINE_API MappedFile : NonCopyable {
+    friend class FileSystem;
+
+public:
+    /**
+     * @brief Hint about how the mapped data is going to be accessed
+     */
+    enum class Advice {
+        NORMAL,
+        SEQUENTIAL,  // Read ahead aggressively and drop the pages once read
+        RANDOM,      // Don't read ahead
+        WILL_NEED,   // Start loading all the pages in the background
+    };
+
+    MappedFile();
+    MappedFile(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map a whole file in memory
+     *
+     * @details The empty files are open with a size of 0
+     *
+     * @param filename The path of the file to map
+     * @return true if the file could be mapped, false otherwise
+     */
+    bool open(const StringView& filename);
+
+    void close();
+
+    /**
+     * @brief Tell the OS how the data is going to be accessed
+     *
+     * @details The advice is only a hint, it's ignored on the
+     *          platforms that don't support it
+     */
+    void advise(Advice advice) const;
+
+    const byte* getData() const;
+
+    size_t getSize() const;
+
+    bool isOpen() const;
+
+    const byte* begin() const;
+
+    const byte* end() const;
+
+private:
+    // Reference data mapped by someone else, used for the files inside
+    // the archives that are already mapped. The archive is kept alive
+    // until the view is closed
+    void openView(const byte* data, size_t size, std::shared_ptr<const PackFile> archive);
+
+    // Own data that has been decompressed to memory, used for the
+    // compressed files inside the archives
+    void openBuffer(Vector<byte>&& buffer);
+
+    const byte* m_data;
+    size_t m_size;
+    void* m_mapping;  // Handle of the file mapping, only used on Windows
+    bool m_isView;
+    Vector<byte> m_buffer;
+    std::shared_ptr<const PackFile> m_archive;
+};
+
+}  // namespace engine
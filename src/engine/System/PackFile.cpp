@@ -0,0 +1,466 @@
+#include <System/PackFile.hpp>
+
+#include <System/IOStream.hpp>
+#include <System/LogManager.hpp>
+#include <Util/AsyncTaskRunner.hpp>
+#include <Util/Hash.hpp>
+#include <Util/LZ4.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <string>
+
+#include <cstring>
+
+namespace engine {
+
+namespace {
+
+const StringView sTag("PackFile");
+
+// "EPAK" in little endian
+const uint32 sPackMagic(0x4B415045);
+
+// Version 2 added the compressed entries
+const uint32 sPackVersion(2);
+
+// Alignment of the data of each file inside the archive
+const uint32 sPackAlignment(4096);
+
+struct PackHeader {
+    uint32 magic;
+    uint32 version;
+    uint32 entryCount;
+    uint32 alignment;
+    uint64 entriesOffset;
+    uint64 pathsOffset;
+    uint64 pathsSize;
+};
+
+uint64 AlignOffset(uint64 offset, uint64 alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+// The paths are stored with '/' separators and relative to the root
+std::string NormalizeArchivePath(const StringView& path) {
+    std::string ret(path.getData(), path.getDataSize());
+    std::replace(ret.begin(), ret.end(), '\\', '/');
+    size_t start = 0;
+    while (start < ret.size()) {
+        if (ret[start] == '/') {
+            start += 1;
+        } else if (ret.compare(start, 2, "./") == 0) {
+            start += 2;
+        } else {
+            break;
+        }
+    }
+    return ret.substr(start);
+}
+
+// Check that [offset, offset + length) is inside [0, size)
+bool FitsInRange(uint64 offset, uint64 length, uint64 size) {
+    return offset <= size && length <= size - offset;
+}
+
+uint64 ReadUint64(const byte* data) {
+    uint64 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Compress the data in independent blocks, the result starts with a
+// table with the offset where each block starts followed by the end of
+// the last one. The blocks that can't be compressed are stored as is.
+bool CompressBlocks(const Vector<byte>& data, uint32 blockSize, Vector<byte>* output) {
+    size_t blockCount = (data.size() + blockSize - 1) / blockSize;
+    size_t tableSize = (blockCount + 1) * sizeof(uint64);
+    output->resize(tableSize);
+
+    Vector<byte> buffer(lz4::GetCompressBound(blockSize));
+    for (size_t i = 0; i < blockCount; i++) {
+        uint64 blockOffset = output->size();
+        std::memcpy(output->data() + i * sizeof(uint64), &blockOffset, sizeof(uint64));
+
+        const byte* block = data.data() + i * blockSize;
+        size_t blockLength = std::min<size_t>(blockSize, data.size() - i * blockSize);
+        size_t compressedSize = lz4::Compress(block, blockLength, buffer.data(), buffer.size());
+        if (compressedSize == 0 || compressedSize >= blockLength) {
+            output->insert(output->end(), block, block + blockLength);
+        } else {
+            output->insert(output->end(), buffer.data(), buffer.data() + compressedSize);
+        }
+    }
+    uint64 endOffset = output->size();
+    std::memcpy(output->data() + blockCount * sizeof(uint64), &endOffset, sizeof(uint64));
+
+    return output->size() < data.size();
+}
+
+bool WritePadding(IOStream& stream, uint64 size) {
+    static const std::array<byte, 512> sZeros = {};
+    while (size > 0) {
+        size_t count = static_cast<size_t>(std::min<uint64>(size, sZeros.size()));
+        if (stream.write(sZeros.data(), 1, count) != count) {
+            return false;
+        }
+        size -= count;
+    }
+    return true;
+}
+
+}  // namespace
+
+struct PackFile::Entry {
+    uint64 pathHash;
+    uint64 offset;
+    // Size of the file and size that it uses inside the archive
+    uint64 size;
+    uint64 storedSize;
+    uint32 pathOffset;
+    uint32 pathSize;
+    Codec codec;
+    uint32 blockSize;
+};
+
+const StringView PackFile::sExtension(".pak");
+
+const uint32 PackFile::sDefaultBlockSize(64 * 1024);
+
+PackFile::PackFile() : m_entries(nullptr), m_entryCount(0), m_paths(nullptr), m_pathsSize(0) {}
+
+PackFile::~PackFile() = default;
+
+bool PackFile::open(const StringView& filename) {
+    close();
+
+    if (!m_file.open(filename)) {
+        return false;
+    }
+
+    const byte* data = m_file.getData();
+    size_t size = m_file.getSize();
+
+    PackHeader header;
+    if (size < sizeof(header)) {
+        m_file.close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != sPackMagic || header.version != sPackVersion) {
+        m_file.close();
+        return false;
+    }
+
+    // The sums are compared as subtractions so corrupted offsets can't
+    // overflow them
+    uint64 entriesSize = static_cast<uint64>(header.entryCount) * sizeof(Entry);
+    if (header.entriesOffset % alignof(Entry) != 0 || !FitsInRange(header.entriesOffset, entriesSize, size) ||
+        !FitsInRange(header.pathsOffset, header.pathsSize, size)) {
+        LogError(sTag, "Invalid table of contents in archive: {}", filename);
+        m_file.close();
+        return false;
+    }
+
+    const auto* entries = reinterpret_cast<const Entry*>(data + header.entriesOffset);
+    for (uint32 i = 0; i < header.entryCount; i++) {
+        const Entry& entry = entries[i];
+        bool isValid = FitsInRange(entry.offset, entry.storedSize, size) &&
+                       FitsInRange(entry.pathOffset, entry.pathSize, header.pathsSize);
+        if (entry.codec == Codec::NONE) {
+            isValid = isValid && entry.storedSize == entry.size;
+        } else if (entry.codec == Codec::LZ4) {
+            // The block table must fit in the stored data
+            isValid = isValid && entry.blockSize > 0 && entry.offset % alignof(uint64) == 0 &&
+                      entry.size / entry.blockSize + 2 <= entry.storedSize / sizeof(uint64);
+        } else {
+            isValid = false;
+        }
+        if (!isValid) {
+            LogError(sTag, "Invalid entry in archive: {}", filename);
+            m_file.close();
+            return false;
+        }
+    }
+
+    m_entries = entries;
+    m_entryCount = header.entryCount;
+    m_paths = reinterpret_cast<const char*>(data + header.pathsOffset);
+    m_pathsSize = static_cast<size_t>(header.pathsSize);
+
+    return true;
+}
+
+void PackFile::close() {
+    m_file.close();
+    m_entries = nullptr;
+    m_entryCount = 0;
+    m_paths = nullptr;
+    m_pathsSize = 0;
+}
+
+bool PackFile::isOpen() const {
+    return m_file.isOpen();
+}
+
+const byte* PackFile::find(const StringView& path, size_t* size) const {
+    const Entry* entry = findEntry(path);
+    if (entry == nullptr || entry->codec != Codec::NONE) {
+        return nullptr;
+    }
+    if (size != nullptr) {
+        *size = static_cast<size_t>(entry->size);
+    }
+    return m_file.getData() + entry->offset;
+}
+
+bool PackFile::getFileSize(const StringView& path, size_t* size) const {
+    const Entry* entry = findEntry(path);
+    if (entry == nullptr) {
+        return false;
+    }
+    *size = static_cast<size_t>(entry->size);
+    return true;
+}
+
+bool PackFile::read(const StringView& path,
+                    uint64 offset,
+                    size_t size,
+                    byte* destination,
+                    AsyncTaskRunner* taskRunner) const {
+    const Entry* entry = findEntry(path);
+    if (entry == nullptr || offset > entry->size || size > entry->size - offset) {
+        return false;
+    }
+
+    const byte* data = m_file.getData() + entry->offset;
+    if (entry->codec == Codec::NONE) {
+        std::memcpy(destination, data + offset, size);
+        return true;
+    }
+    if (size == 0) {
+        return true;
+    }
+
+    struct BlockReader {
+        const Entry* entry;
+        const byte* data;
+        uint64 offset;
+        size_t size;
+        byte* destination;
+        size_t firstBlock;
+        std::atomic<bool> succeeded;
+
+        void read(size_t block) {
+            uint64 blockStart = block * static_cast<uint64>(entry->blockSize);
+            auto blockLength = static_cast<size_t>(std::min<uint64>(entry->blockSize, entry->size - blockStart));
+            uint64 begin = ReadUint64(data + block * sizeof(uint64));
+            uint64 end = ReadUint64(data + (block + 1) * sizeof(uint64));
+            if (begin > end || end > entry->storedSize) {
+                succeeded = false;
+                return;
+            }
+
+            // Decompress the blocks completely inside the range straight
+            // into the destination and the partial ones to a buffer
+            uint64 rangeStart = std::max(offset, blockStart);
+            uint64 rangeEnd = std::min(offset + size, blockStart + blockLength);
+            byte* output = destination + (rangeStart - offset);
+            Vector<byte> buffer;
+            if (rangeStart != blockStart || rangeEnd != blockStart + blockLength) {
+                buffer.resize(blockLength);
+                output = buffer.data();
+            }
+
+            auto compressedSize = static_cast<size_t>(end - begin);
+            if (compressedSize == blockLength) {
+                std::memcpy(output, data + begin, blockLength);
+            } else if (!lz4::Decompress(data + begin, compressedSize, output, blockLength)) {
+                succeeded = false;
+                return;
+            }
+
+            if (!buffer.empty()) {
+                std::memcpy(destination + (rangeStart - offset), buffer.data() + (rangeStart - blockStart),
+                            static_cast<size_t>(rangeEnd - rangeStart));
+            }
+        }
+    };
+
+    BlockReader reader;
+    reader.entry = entry;
+    reader.data = data;
+    reader.offset = offset;
+    reader.size = size;
+    reader.destination = destination;
+    reader.firstBlock = static_cast<size_t>(offset / entry->blockSize);
+    reader.succeeded = true;
+
+    auto lastBlock = static_cast<size_t>((offset + size - 1) / entry->blockSize);
+    size_t blockCount = lastBlock - reader.firstBlock + 1;
+    if (taskRunner != nullptr && blockCount > 1) {
+        taskRunner->parallelFor(blockCount, [&reader](size_t i) { reader.read(reader.firstBlock + i); });
+    } else {
+        for (size_t i = 0; i < blockCount; i++) {
+            reader.read(reader.firstBlock + i);
+        }
+    }
+
+    return reader.succeeded;
+}
+
+bool PackFile::contains(const StringView& path) const {
+    return findEntry(path) != nullptr;
+}
+
+size_t PackFile::getEntryCount() const {
+    return m_entryCount;
+}
+
+bool PackFile::Create(const StringView& filename,
+                      const Vector<std::pair<String, String>>& files,
+                      Codec codec,
+                      uint32 blockSize) {
+    if (codec != Codec::NONE && blockSize == 0) {
+        LogError(sTag, "Invalid block size to create archive: {}", filename);
+        return false;
+    }
+
+    struct PendingEntry {
+        std::string path;
+        const String* source;
+        Entry entry;
+    };
+
+    Vector<PendingEntry> pending;
+    pending.reserve(files.size());
+    for (const auto& file : files) {
+        IOStream stream;
+        if (!stream.open(file.second, "rb")) {
+            LogError(sTag, "Could not open file: {}", file.second);
+            return false;
+        }
+        PendingEntry& newEntry = pending.emplace_back();
+        newEntry.path = NormalizeArchivePath(file.first);
+        newEntry.source = &file.second;
+        newEntry.entry.pathHash = Hash64(newEntry.path.data(), newEntry.path.size());
+        newEntry.entry.size = stream.getSize();
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const PendingEntry& left, const PendingEntry& right) {
+        if (left.entry.pathHash != right.entry.pathHash) {
+            return left.entry.pathHash < right.entry.pathHash;
+        }
+        return left.path < right.path;
+    });
+
+    for (size_t i = 1; i < pending.size(); i++) {
+        if (pending[i].path == pending[i - 1].path) {
+            LogError(sTag, "Duplicated file in archive: {}", pending[i].path);
+            return false;
+        }
+    }
+
+    // Layout: header, table of contents, paths and the aligned file data
+    PackHeader header;
+    header.magic = sPackMagic;
+    header.version = sPackVersion;
+    header.entryCount = static_cast<uint32>(pending.size());
+    header.alignment = sPackAlignment;
+    header.entriesOffset = sizeof(PackHeader);
+    header.pathsOffset = header.entriesOffset + pending.size() * sizeof(Entry);
+    header.pathsSize = 0;
+    for (PendingEntry& pendingEntry : pending) {
+        pendingEntry.entry.pathOffset = static_cast<uint32>(header.pathsSize);
+        pendingEntry.entry.pathSize = static_cast<uint32>(pendingEntry.path.size());
+        header.pathsSize += pendingEntry.path.size();
+    }
+
+    IOStream output;
+    if (!output.open(filename, "wb")) {
+        LogError(sTag, "Could not create archive: {}", filename);
+        return false;
+    }
+
+    // The data of the files is written first because the size of the
+    // compressed files is not known, the table of contents is written
+    // at the end in the space reserved after the header
+    uint64 position = header.pathsOffset + header.pathsSize;
+    bool ok = WritePadding(output, position);
+
+    Vector<byte> content;
+    Vector<byte> compressed;
+    for (PendingEntry& pendingEntry : pending) {
+        if (!ok) {
+            break;
+        }
+
+        Entry& entry = pendingEntry.entry;
+        entry.offset = AlignOffset(position, sPackAlignment);
+        ok = WritePadding(output, entry.offset - position);
+        position = entry.offset;
+
+        IOStream input;
+        if (!input.open(*pendingEntry.source, "rb")) {
+            LogError(sTag, "Could not open file: {}", *pendingEntry.source);
+            return false;
+        }
+        content.resize(static_cast<size_t>(entry.size));
+        ok = ok && input.read(content.data(), 1, content.size()) == content.size();
+
+        // Each file is only compressed if its size can be reduced
+        const Vector<byte>* stored = &content;
+        entry.codec = Codec::NONE;
+        entry.blockSize = 0;
+        if (codec == Codec::LZ4 && !content.empty() && CompressBlocks(content, blockSize, &compressed)) {
+            stored = &compressed;
+            entry.codec = codec;
+            entry.blockSize = blockSize;
+        }
+        entry.storedSize = stored->size();
+
+        ok = ok && output.write(stored->data(), 1, stored->size()) == stored->size();
+        position += entry.storedSize;
+    }
+
+    ok = ok && output.seek(0, IOStream::Origin::SET) == 0;
+    ok = ok && output.write(&header, sizeof(header), 1) == 1;
+    for (const PendingEntry& pendingEntry : pending) {
+        ok = ok && output.write(&pendingEntry.entry, sizeof(Entry), 1) == 1;
+    }
+    for (const PendingEntry& pendingEntry : pending) {
+        ok = ok && output.write(pendingEntry.path.data(), 1, pendingEntry.path.size()) == pendingEntry.path.size();
+    }
+
+    if (!ok) {
+        LogError(sTag, "Could not write archive: {}", filename);
+    }
+    return ok;
+}
+
+const PackFile::Entry* PackFile::findEntry(const StringView& path) const {
+    if (m_entryCount == 0) {
+        return nullptr;
+    }
+
+    std::string normalizedPath = NormalizeArchivePath(path);
+    uint64 pathHash = Hash64(normalizedPath.data(), normalizedPath.size());
+
+    // The entries are sorted by hash, the paths are compared to
+    // resolve the collisions
+    const Entry* end = m_entries + m_entryCount;
+    const Entry* it = std::lower_bound(m_entries, end, pathHash,
+                                       [](const Entry& entry, uint64 hash) { return entry.pathHash < hash; });
+    for (; it != end && it->pathHash == pathHash; ++it) {
+        if (it->pathSize == normalizedPath.size() &&
+            std::memcmp(m_paths + it->pathOffset, normalizedPath.data(), normalizedPath.size()) == 0) {
+            return it;
+        }
+    }
+
+    return nullptr;
+}
+
+}  // namespace engine
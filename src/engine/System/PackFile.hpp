@@ -0,0 +1,136 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <System/MappedFile.hpp>
+#include <System/String.hpp>
+#include <System/StringView.hpp>
+#include <Util/Container/Vector.hpp>
+#include <Util/NonCopyable.hpp>
+
+#include <utility>
+
+namespace engine {
+
+class AsyncTaskRunner;
+
+/**
+ * @brief Read-only archive that packs multiple files in a single one
+ *
+ * @details The archive is mapped in memory once, its table of contents
+ *          is sorted by the hash of the paths so the files can be found
+ *          without accessing the OS file system. The data of each file
+ *          is aligned to the page size so it can be mapped or read
+ *          directly from the archive.
+ *
+ *          Each file can be compressed with a different codec. The
+ *          compressed files are split in blocks that are compressed
+ *          independently, so they can be decompressed in parallel and
+ *          the ranges of a file can be read without decompressing it
+ *          completely.
+ */
+class ENGINE_API PackFile : NonCopyable {
+public:
+    enum class Codec : uint32 {
+        NONE = 0,
+        LZ4 = 1,
+    };
+
+    static const StringView sExtension;
+
+    static const uint32 sDefaultBlockSize;
+
+    PackFile();
+
+    ~PackFile();
+
+    /**
+     * @brief Open and map an archive
+     *
+     * @param filename The path of the archive
+     * @return true if the archive is valid and could be mapped, false
+     *         otherwise
+     */
+    bool open(const StringView& filename);
+
+    void close();
+
+    bool isOpen() const;
+
+    /**
+     * @brief Find a file inside the archive
+     *
+     * @param path The path of the file relative to the archive root,
+     *             both '/' and '\' are accepted as separators
+     * @param size Returns the size of the file in bytes
+     * @return Pointer to the file data inside the mapped archive, or
+     *         nullptr if the file does not exist or it's compressed
+     */
+    const byte* find(const StringView& path, size_t* size) const;
+
+    /**
+     * @brief Get the size of a file inside the archive
+     *
+     * @param path The path of the file relative to the archive root
+     * @param size Returns the decompressed size of the file in bytes
+     * @return true if the file exists, false otherwise
+     */
+    bool getFileSize(const StringView& path, size_t* size) const;
+
+    /**
+     * @brief Read a range of a file inside the archive
+     *
+     * @details The compressed blocks are decompressed directly into the
+     *          destination, in parallel if a task runner is provided
+     *
+     * @param path The path of the file relative to the archive root
+     * @param offset The position of the file where the read starts
+     * @param size The number of bytes to read
+     * @param destination Buffer of at least size bytes
+     * @param taskRunner The workers used to decompress the blocks, or
+     *                   nullptr to decompress them in the calling thread
+     * @return true if the range could be read, false if the file does
+     *         not exist, the range is out of the file or the data is
+     *         corrupted
+     */
+    bool read(const StringView& path,
+              uint64 offset,
+              size_t size,
+              byte* destination,
+              AsyncTaskRunner* taskRunner = nullptr) const;
+
+    bool contains(const StringView& path) const;
+
+    size_t getEntryCount() const;
+
+    /**
+     * @brief Create an archive from a list of files
+     *
+     * @details The files that can't be reduced with the codec are
+     *          stored without compression
+     *
+     * @param filename The path of the archive to create
+     * @param files Pairs with the path of each file inside the archive
+     *              and the path of the file to read its data from
+     * @param codec The codec used to compress the files
+     * @param blockSize The size of the blocks compressed independently
+     * @return true if the archive could be created, false otherwise
+     */
+    static bool Create(const StringView& filename,
+                       const Vector<std::pair<String, String>>& files,
+                       Codec codec = Codec::NONE,
+                       uint32 blockSize = sDefaultBlockSize);
+
+private:
+    struct Entry;
+
+    const Entry* findEntry(const StringView& path) const;
+
+    MappedFile m_file;
+    const Entry* m_entries;
+    uint32 m_entryCount;
+    const char* m_paths;
+    size_t m_pathsSize;
+};
+
+}  // namespace engine
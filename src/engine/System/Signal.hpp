@@ -3,9 +3,12 @@
 #include <Util/Prerequisites.hpp>
 
 #include <System/SignalConnection.hpp>
+#include <Util/Container/Vector.hpp>
 #include <Util/Function.hpp>
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <utility>
 
@@ -30,6 +33,17 @@ namespace engine {
  * sig1.emit(2, 3);
  * @endcode
  *
+ * The slots are stored in an immutable array that is replaced on
+ * every connect or disconnect, so emit() never locks and only
+ * iterates a contiguous array. A slot may connect or disconnect
+ * slots while the signal is being emitted, the changes are seen
+ * by the next emission.
+ *
+ * Disconnecting doesn't wait for the emissions in progress, an
+ * emission started before on another thread may still call the
+ * disconnected slot. The owner of the slot must synchronize with
+ * the emitting threads before destroying what the slot uses.
+ *
  * @tparam Args The propagated parameters when this signal is emmited
  */
 template <typename... Args>
@@ -112,25 +126,61 @@ public:
     /**
      * @brief Disconnects a previously connected function
      *
+     * @details Returns without waiting for the emissions in progress
+     *          on other threads, which may still call the function
+     *
      * @param connection The signal connection to disconnect
      */
     void disconnect(SignalConnection& connection);
 
     /**
      * @brief Disconnects all previously connected functions
+     *
+     * @details Like disconnect, doesn't wait for the emissions in
+     *          progress on other threads
      */
     void disconnectAll();
 
+    /**
+     * @brief Check if no function is connected to this Signal
+     */
+    bool isEmpty() const;
+
     /**
      * @brief Calls all connected functions
      *
+     * @details Calls the slots connected when the emission started,
+     *          without taking any lock
+     *
      * @param args The arguments to propagate to the connected functions
      */
     void emit(Args&&... args);
 
 private:
+    using SlotArray = Vector<std::pair<SignalConnection::IdType, SlotType>>;
+
+    /**
+     * @brief Replace the slot array read by emit()
+     *
+     * @details The previous array is released once no emission is
+     *          using it. Must be called with m_slotsMutex locked.
+     */
+    void publishSlots(std::unique_ptr<const SlotArray> slots);
+
+    /**
+     * @brief Release the retired arrays if no emission is in progress
+     *
+     * @details Must be called with m_slotsMutex locked
+     */
+    void releaseRetiredSlots();
+
     SignalConnection::IdType m_currentId;
-    std::map<SignalConnection::IdType, std::pair<SignalConnection, SlotType>> m_slots;
+    // Node based, connect() returns references to the connections
+    std::map<SignalConnection::IdType, SignalConnection> m_connections;
+    std::atomic<const SlotArray*> m_slots;
+    std::atomic<size_t> m_emitCount;
+    Vector<std::unique_ptr<const SlotArray>> m_retiredSlots;
+    std::atomic<bool> m_hasRetiredSlots;
     mutable std::mutex m_slotsMutex;
 };
 
@@ -1,21 +1,28 @@
 namespace engine {
 
 template <typename... Args>
-Signal<Args...>::Signal() : m_currentId(0) {}
+Signal<Args...>::Signal() : m_currentId(0), m_slots(nullptr), m_emitCount(0), m_hasRetiredSlots(false) {}
 
 template <typename... Args>
-Signal<Args...>::Signal(const Signal<Args...>& other) : m_currentId(0) {
+Signal<Args...>::Signal(const Signal<Args...>& other) : Signal() {
     std::lock_guard<std::mutex> lock(other.m_slotsMutex);
-    for (auto& pair : other.m_slots) {
-        SlotType slot = pair.second.second;
-        connect(slot);
+    const SlotArray* slots = other.m_slots.load();
+    if (slots != nullptr) {
+        for (auto& pair : *slots) {
+            connect(pair.second);
+        }
     }
 }
 
 template <typename... Args>
-Signal<Args...>::Signal(Signal<Args...>&& other) noexcept : m_currentId(other.m_currentId) {
+Signal<Args...>::Signal(Signal<Args...>&& other) noexcept : Signal() {
     std::lock_guard<std::mutex> lock(other.m_slotsMutex);
-    m_slots = std::move(other.m_slots);
+    m_currentId = other.m_currentId;
+    m_connections = std::move(other.m_connections);
+    m_slots.store(other.m_slots.exchange(nullptr));
+    m_retiredSlots = std::move(other.m_retiredSlots);
+    m_hasRetiredSlots = !m_retiredSlots.empty();
+    other.m_hasRetiredSlots = false;
 }
 
 template <typename... Args>
@@ -25,13 +32,34 @@ Signal<Args...>::~Signal() {
 
 template <typename... Args>
 Signal<Args...>& Signal<Args...>::operator=(const Signal<Args...>& other) {
-    new (this) Signal<Args...>(other);
+    if (this != &other) {
+        disconnectAll();
+        std::lock_guard<std::mutex> lock(other.m_slotsMutex);
+        const SlotArray* slots = other.m_slots.load();
+        if (slots != nullptr) {
+            for (auto& pair : *slots) {
+                connect(pair.second);
+            }
+        }
+    }
     return *this;
 }
 
 template <typename... Args>
 Signal<Args...>& Signal<Args...>::operator=(Signal<Args...>&& other) noexcept {
-    new (this) Signal<Args...>(std::move(other));
+    if (this != &other) {
+        disconnectAll();
+        std::scoped_lock lock(m_slotsMutex, other.m_slotsMutex);
+        m_currentId = other.m_currentId;
+        m_connections = std::move(other.m_connections);
+        // The arrays may still be used by the emissions of this signal
+        for (auto& retired : other.m_retiredSlots) {
+            m_retiredSlots.push_back(std::move(retired));
+        }
+        other.m_retiredSlots.clear();
+        other.m_hasRetiredSlots = false;
+        publishSlots(std::unique_ptr<const SlotArray>(other.m_slots.exchange(nullptr)));
+    }
     return *this;
 }
 
@@ -60,31 +88,97 @@ SignalConnection& Signal<Args...>::connect(const typename Signal<Args...>::SlotT
     std::lock_guard<std::mutex> lock(m_slotsMutex);
     SignalConnection::IdType id = ++m_currentId;
     SignalConnection connection(id, [this](SignalConnection& connection) { this->disconnect(connection); });
-    auto pair = m_slots.emplace(id, std::make_pair(std::move(connection), slot));
-    return pair.first->second.first;
+    auto pair = m_connections.emplace(id, std::move(connection));
+
+    const SlotArray* slots = m_slots.load();
+    auto newSlots = std::make_unique<SlotArray>();
+    newSlots->reserve((slots != nullptr ? slots->size() : 0) + 1);
+    if (slots != nullptr) {
+        newSlots->insert(newSlots->end(), slots->begin(), slots->end());
+    }
+    newSlots->emplace_back(id, slot);
+    publishSlots(std::move(newSlots));
+
+    return pair.first->second;
 }
 
 template <typename... Args>
 void Signal<Args...>::disconnect(SignalConnection& connection) {
     std::lock_guard<std::mutex> lock(m_slotsMutex);
+    SignalConnection::IdType id = connection.getId();
     connection.disconnectWithoutCallback();
-    m_slots.erase(connection.getId());
+    if (m_connections.erase(id) == 0) {
+        return;
+    }
+
+    const SlotArray* slots = m_slots.load();
+    auto newSlots = std::make_unique<SlotArray>();
+    newSlots->reserve(slots->size() - 1);
+    for (auto& pair : *slots) {
+        if (pair.first != id) {
+            newSlots->push_back(pair);
+        }
+    }
+    publishSlots(newSlots->empty() ? nullptr : std::move(newSlots));
 }
 
 template <typename... Args>
 void Signal<Args...>::disconnectAll() {
     std::lock_guard<std::mutex> lock(m_slotsMutex);
-    for (auto& pair : m_slots) {
-        pair.second.first.disconnectWithoutCallback();
+    for (auto& pair : m_connections) {
+        pair.second.disconnectWithoutCallback();
     }
-    m_slots.clear();
+    m_connections.clear();
+    publishSlots(nullptr);
+}
+
+template <typename... Args>
+bool Signal<Args...>::isEmpty() const {
+    return m_slots.load() == nullptr;
 }
 
 template <typename... Args>
 void Signal<Args...>::emit(Args&&... args) {
-    std::lock_guard<std::mutex> lock(m_slotsMutex);
-    for (auto& pair : m_slots) {
-        pair.second.second(std::forward<Args>(args)...);
+    if (m_slots.load(std::memory_order_relaxed) == nullptr) {
+        return;
+    }
+
+    // The count is increased before loading the array, so a writer
+    // that sees no emission in progress can release the old arrays
+    m_emitCount.fetch_add(1);
+    const SlotArray* slots = m_slots.load();
+    if (slots != nullptr) {
+        for (auto& pair : *slots) {
+            pair.second(std::forward<Args>(args)...);
+        }
+    }
+    if (m_emitCount.fetch_sub(1) == 1 && m_hasRetiredSlots.load()) {
+        // The last emission releases the arrays retired while it was
+        // running. It doesn't wait for a writer holding the lock, the
+        // next emission or change releases them then
+        std::unique_lock<std::mutex> lock(m_slotsMutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            releaseRetiredSlots();
+        }
+    }
+}
+
+template <typename... Args>
+void Signal<Args...>::publishSlots(std::unique_ptr<const SlotArray> slots) {
+    const SlotArray* previous = m_slots.exchange(slots.release());
+    if (previous != nullptr) {
+        m_retiredSlots.emplace_back(previous);
+        m_hasRetiredSlots = true;
+    }
+    releaseRetiredSlots();
+}
+
+template <typename... Args>
+void Signal<Args...>::releaseRetiredSlots() {
+    // The emissions that start now load the current array
+    if (m_emitCount.load() == 0) {
+        m_retiredSlots.clear();
+        m_hasRetiredSlots = false;
     }
 }
 
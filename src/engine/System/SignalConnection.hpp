@@ -58,7 +58,9 @@ public:
     /**
      * @brief Disconnects this signal
      *
-     * After disconnected this signal connection becomes invalid
+     * After disconnected this signal connection becomes invalid. An
+     * emission in progress on another thread may still call the slot,
+     * see Signal::disconnect
      */
     void disconnect();
 
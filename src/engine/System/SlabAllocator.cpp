@@ -0,0 +1,125 @@
+#include <System/SlabAllocator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+
+namespace engine {
+
+namespace {
+
+struct AllocatorRegistry {
+    std::mutex mutex;
+    Vector<const SlabAllocator*> allocators;
+};
+
+AllocatorRegistry& GetAllocatorRegistry() {
+    static AllocatorRegistry sAllocatorRegistry;
+    return sAllocatorRegistry;
+}
+
+// The slots keep the alignment of the memory returned by operator new
+constexpr size_t sSlotAlignment = alignof(std::max_align_t);
+
+size_t GetSlotSize(size_t size) {
+    return (std::max(size, sizeof(void*)) + sSlotAlignment - 1) & ~(sSlotAlignment - 1);
+}
+
+}  // namespace
+
+SlabAllocator::SlabAllocator(const StringView& name, size_t slotsPerSlab)
+      : m_name(name),
+        m_slotsPerSlab(std::max<size_t>(slotsPerSlab, 1)) {
+    AllocatorRegistry& registry = GetAllocatorRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.allocators.push_back(this);
+}
+
+SlabAllocator::~SlabAllocator() {
+    AllocatorRegistry& registry = GetAllocatorRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.allocators.erase(std::find(registry.allocators.begin(), registry.allocators.end(), this));
+}
+
+void* SlabAllocator::allocate(size_t size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SizeClass& sizeClass = getSizeClass(GetSlotSize(size));
+    if (sizeClass.freeSlots == nullptr) {
+        allocateSlab(sizeClass);
+    }
+
+    FreeSlot* slot = sizeClass.freeSlots;
+    sizeClass.freeSlots = slot->next;
+    sizeClass.usedCount++;
+    sizeClass.peakCount = std::max(sizeClass.peakCount, sizeClass.usedCount);
+    return slot;
+}
+
+void SlabAllocator::deallocate(void* pointer, size_t size) {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SizeClass& sizeClass = getSizeClass(GetSlotSize(size));
+    // The freed slot is the first one reused, it is probably still in the cache
+    FreeSlot* slot = static_cast<FreeSlot*>(pointer);
+    slot->next = sizeClass.freeSlots;
+    sizeClass.freeSlots = slot;
+    sizeClass.usedCount--;
+}
+
+const String& SlabAllocator::getName() const {
+    return m_name;
+}
+
+Vector<SlabAllocatorStats> SlabAllocator::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_sizeClasses.map([this](const SizeClass& sizeClass) {
+        return SlabAllocatorStats{
+            m_name,
+            sizeClass.slotSize,
+            sizeClass.slabs.size(),
+            sizeClass.slabs.size() * m_slotsPerSlab,
+            sizeClass.usedCount,
+            sizeClass.peakCount,
+        };
+    });
+}
+
+Vector<SlabAllocatorStats> SlabAllocator::GetAllStats() {
+    AllocatorRegistry& registry = GetAllocatorRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    Vector<SlabAllocatorStats> stats;
+    for (const SlabAllocator* allocator : registry.allocators) {
+        Vector<SlabAllocatorStats> allocatorStats = allocator->getStats();
+        stats.insert(stats.end(), allocatorStats.begin(), allocatorStats.end());
+    }
+    return stats;
+}
+
+SlabAllocator::SizeClass& SlabAllocator::getSizeClass(size_t slotSize) {
+    // There is usually a single size, a linear search is enough
+    for (SizeClass& sizeClass : m_sizeClasses) {
+        if (sizeClass.slotSize == slotSize) {
+            return sizeClass;
+        }
+    }
+    m_sizeClasses.push_back({slotSize, {}, nullptr, 0, 0});
+    return m_sizeClasses.back();
+}
+
+void SlabAllocator::allocateSlab(SizeClass& sizeClass) {
+    std::unique_ptr<byte[]> slab(new byte[sizeClass.slotSize * m_slotsPerSlab]);
+
+    // Link the slots in order so consecutive allocations are contiguous
+    byte* data = slab.get();
+    for (size_t i = m_slotsPerSlab; i > 0; i--) {
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(data + (i - 1) * sizeClass.slotSize);
+        slot->next = sizeClass.freeSlots;
+        sizeClass.freeSlots = slot;
+    }
+    sizeClass.slabs.push_back(std::move(slab));
+}
+
+}  // namespace engine
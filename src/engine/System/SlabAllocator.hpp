@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <System/String.hpp>
+#include <System/StringView.hpp>
+#include <Util/Container/Vector.hpp>
+#include <Util/NonCopyable.hpp>
+
+#include <memory>
+#include <mutex>
+
+namespace engine {
+
+/**
+ * @brief Occupancy of the slots of one size in a SlabAllocator
+ */
+struct SlabAllocatorStats {
+    String name;
+    size_t slotSize;
+    size_t slabCount;
+    size_t slotCount;
+    size_t usedCount;
+    size_t peakCount;
+};
+
+/**
+ * @brief Allocator of objects of the same kind, packed in big blocks
+ *        of memory (slabs) instead of individual heap allocations
+ *
+ * @details The slabs are never moved or released until the allocator
+ *          is destroyed, so the objects have stable addresses and the
+ *          freed slots are reused by the next allocations. Each
+ *          allocation size has its own slabs, usually a type only has
+ *          one size but the derived classes of a polymorphic type can
+ *          share the allocator.
+ *
+ *          The engine objects use it through their class operator new,
+ *          see Mesh for example. It is thread-safe.
+ */
+class ENGINE_API SlabAllocator : NonCopyable {
+public:
+    /**
+     * @param name Name shown in the stats, usually the type
+     * @param slotsPerSlab The number of slots allocated at once
+     */
+    explicit SlabAllocator(const StringView& name, size_t slotsPerSlab = 32);
+
+    ~SlabAllocator();
+
+    /**
+     * @brief Get a slot of the given size, aligned like the memory
+     *        returned by operator new
+     */
+    void* allocate(size_t size);
+
+    /**
+     * @brief Free a slot obtained from allocate with the same size
+     */
+    void deallocate(void* pointer, size_t size);
+
+    const String& getName() const;
+
+    /**
+     * @brief Get the occupancy of each allocation size
+     */
+    Vector<SlabAllocatorStats> getStats() const;
+
+    /**
+     * @brief Get the occupancy of all the existing allocators
+     */
+    static Vector<SlabAllocatorStats> GetAllStats();
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    struct SizeClass {
+        size_t slotSize;
+        Vector<std::unique_ptr<byte[]>> slabs;
+        FreeSlot* freeSlots;
+        size_t usedCount;
+        size_t peakCount;
+    };
+
+    SizeClass& getSizeClass(size_t slotSize);
+
+    void allocateSlab(SizeClass& sizeClass);
+
+    String m_name;
+    size_t m_slotsPerSlab;
+    Vector<SizeClass> m_sizeClasses;
+    mutable std::mutex m_mutex;
+};
+
+}  // namespace engine
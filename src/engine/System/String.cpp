@@ -32,35 +32,82 @@
 
 namespace engine {
 
+namespace {
+
+inline bool IsContinuation(char value) {
+    return (static_cast<uint8>(value) & 0xC0) == 0x80;
+}
+
+// Get the end of the valid prefix of an UTF-16 string
+const char16* FindInvalidUtf16(const char16* begin, const char16* end) {
+    for (const char16* it = begin; it < end; it++) {
+        bool isHighSurrogate = *it >= 0xD800 && *it <= 0xDBFF;
+        if (isHighSurrogate && it + 1 < end && it[1] >= 0xDC00 && it[1] <= 0xDFFF) {
+            it++;
+        } else if (*it >= 0xD800 && *it <= 0xDFFF) {
+            return it;
+        }
+    }
+    return end;
+}
+
+// Get the end of the valid prefix of an UTF-32 string
+const char32* FindInvalidUtf32(const char32* begin, const char32* end) {
+    return std::find_if(begin, end, [](char32 codePoint) {
+        return codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF);
+    });
+}
+
+// The invalid strings keep the code points before the first error
+void AppendUtf16(const char16* begin, const char16* end, std::basic_string<char>* result) {
+    if (!utf::Utf16ToUtf8(begin, end, result)) {
+        utf::Utf16ToUtf8(begin, FindInvalidUtf16(begin, end), result);
+    }
+}
+
+void AppendUtf32(const char32* begin, const char32* end, std::basic_string<char>* result) {
+    if (!utf::Utf32ToUtf8(begin, end, result)) {
+        utf::Utf32ToUtf8(begin, FindInvalidUtf32(begin, end), result);
+    }
+}
+
+}  // namespace
+
 const String::size_type String::sInvalidPos = std::basic_string<char>::npos;
 
+const String::size_type String::sBreadcrumbStride(64);
+
 String::String() = default;
 
 String::String(char asciiChar) {
     m_string += asciiChar;
+    updateIndex();
 }
 
 String::String(char16 utf16Char) {
     char16* ptr = &utf16Char;
     utf::UtfToUtf<utf::UTF_16, utf::UTF_8>(ptr, ptr + 1, &m_string);
+    updateIndex();
 }
 
 String::String(char32 utf32Char) {
     char32* ptr = &utf32Char;
     utf::UtfToUtf<utf::UTF_32, utf::UTF_8>(ptr, ptr + 1, &m_string);
+    updateIndex();
 }
 
 String::String(const char* utf8String) {
     if (utf8String && utf8String[0] != 0) {
         size_type length = std::strlen(utf8String);
         if (length > 0) {
-            if (utf::IsValid<utf::UTF_8>(utf8String, utf8String + length)) {
+            if (utf::IsValidUtf8(utf8String, utf8String + length)) {
                 m_string.assign(utf8String);
             } else {
                 ENGINE_THROW(std::runtime_error("invalid utf8 convertion."));
             }
         };
     }
+    updateIndex();
 }
 
 String::String(const char8* utf8String) : String(reinterpret_cast<const char*>(utf8String)) {}
@@ -70,8 +117,9 @@ String::String(const char16* utf16String) {
         // Find the lenght
         const char16* utf16StringEnd = utf16String;
         while (*(++utf16StringEnd) != 0) {}
-        utf::UtfToUtf<utf::UTF_16, utf::UTF_8>(utf16String, utf16StringEnd, &m_string);
+        AppendUtf16(utf16String, utf16StringEnd, &m_string);
     }
+    updateIndex();
 }
 
 String::String(const char32* utf32String) {
@@ -79,8 +127,9 @@ String::String(const char32* utf32String) {
         // Find the lenght
         const char32* utf32StringEnd = utf32String;
         while (*(++utf32StringEnd) != 0) {}
-        utf::UtfToUtf<utf::UTF_32, utf::UTF_8>(utf32String, utf32StringEnd, &m_string);
+        AppendUtf32(utf32String, utf32StringEnd, &m_string);
     }
+    updateIndex();
 }
 
 String::String(const wchar* wideString) {
@@ -88,71 +137,91 @@ String::String(const wchar* wideString) {
         const wchar* wideStringEnd = wideString;
         while (*(++wideStringEnd) != 0) {}
 #if PLATFORM_IS(PLATFORM_WINDOWS)
-        utf::UtfToUtf<utf::UTF_16, utf::UTF_8>(wideString, wideStringEnd, &m_string);
+        AppendUtf16(reinterpret_cast<const char16*>(wideString), reinterpret_cast<const char16*>(wideStringEnd),
+                    &m_string);
 #else
-        utf::UtfToUtf<utf::UTF_32, utf::UTF_8>(wideString, wideStringEnd, &m_string);
+        AppendUtf32(reinterpret_cast<const char32*>(wideString), reinterpret_cast<const char32*>(wideStringEnd),
+                    &m_string);
 #endif
     }
+    updateIndex();
 }
 
 String::String(const std::basic_string<char>& utf8String) {
     if (!utf8String.empty()) {
-        if (utf::IsValid<utf::UTF_8>(utf8String.cbegin(), utf8String.cend())) {
+        if (utf::IsValidUtf8(utf8String.data(), utf8String.data() + utf8String.size())) {
             m_string.assign(utf8String);
         } else {
             ENGINE_THROW(std::runtime_error("invalid utf8 convertion."));
         }
     };
+    updateIndex();
 }
 
 String::String(std::basic_string<char>&& utf8String) {
     if (!utf8String.empty()) {
-        if (utf::IsValid<utf::UTF_8>(utf8String.cbegin(), utf8String.cend())) {
+        if (utf::IsValidUtf8(utf8String.data(), utf8String.data() + utf8String.size())) {
             m_string = std::move(utf8String);
         } else {
             ENGINE_THROW(std::runtime_error("invalid utf8 convertion."));
         }
     };
+    updateIndex();
 }
 
 String::String(const std::basic_string<char8>& utf8String) {
     if (!utf8String.empty()) {
-        if (utf::IsValid<utf::UTF_8>(utf8String.cbegin(), utf8String.cend())) {
+        const auto* begin = reinterpret_cast<const char*>(utf8String.data());
+        if (utf::IsValidUtf8(begin, begin + utf8String.size())) {
             m_string.assign(reinterpret_cast<const char*>(utf8String.data()), utf8String.size());
         } else {
             ENGINE_THROW(std::runtime_error("invalid utf8 convertion."));
         }
     };
+    updateIndex();
 }
 
 String::String(const std::basic_string<char16>& utf16String) {
-    utf::UtfToUtf<utf::UTF_16, utf::UTF_8>(utf16String.cbegin(), utf16String.cend(), &m_string);
+    AppendUtf16(utf16String.data(), utf16String.data() + utf16String.size(), &m_string);
+    updateIndex();
 }
 
 String::String(const std::basic_string<char32>& utf32String) {
-    utf::UtfToUtf<utf::UTF_32, utf::UTF_8>(utf32String.cbegin(), utf32String.cend(), &m_string);
+    AppendUtf32(utf32String.data(), utf32String.data() + utf32String.size(), &m_string);
+    updateIndex();
 }
 
 String::String(const std::basic_string<wchar>& wideString) {
 #if PLATFORM_IS(PLATFORM_WINDOWS)
-    utf::UtfToUtf<utf::UTF_16, utf::UTF_8>(wideString.cbegin(), wideString.cend(), &m_string);
+    const auto* begin = reinterpret_cast<const char16*>(wideString.data());
+    AppendUtf16(begin, begin + wideString.size(), &m_string);
 #else
-    utf::UtfToUtf<utf::UTF_32, utf::UTF_8>(wideString.cbegin(), wideString.cend(), &m_string);
+    const auto* begin = reinterpret_cast<const char32*>(wideString.data());
+    AppendUtf32(begin, begin + wideString.size(), &m_string);
 #endif
+    updateIndex();
 }
 
-String::String(const StringView& stringView) : m_string(stringView.getData(), stringView.getDataSize()) {}
+String::String(const StringView& stringView) : m_string(stringView.getData(), stringView.getDataSize()) {
+    updateIndex();
+}
 
 String::String(const String& other) = default;
 
-String::String(String&& other) noexcept : m_string(std::move(other.m_string)) {}
+String::String(String&& other) noexcept
+      : m_string(std::move(other.m_string)),
+        m_size(other.m_size),
+        m_breadcrumbs(std::move(other.m_breadcrumbs)) {
+    other.clear();
+}
 
 String::~String() = default;
 
 String String::FromUtf8(const char* begin, const char* end) {
     String string;
-    if (utf::IsValid<utf::UTF_8>(begin, end)) {
+    if (utf::IsValidUtf8(begin, end)) {
         string.m_string.assign(begin, end);
+        string.updateIndex();
     } else {
         ENGINE_THROW(std::runtime_error("invalid utf8 convertion."));
     }
@@ -165,13 +234,15 @@ String String::FromUtf8(iterator begin, iterator end) {
 
 String String::FromUtf16(const char16* begin, const char16* end) {
     String string;
-    utf::UtfToUtf<utf::UTF_16, utf::UTF_8>(begin, end, &string.m_string);
+    AppendUtf16(begin, end, &string.m_string);
+    string.updateIndex();
     return string;
 }
 
 String String::FromUtf32(const char32* begin, const char32* end) {
     String string;
-    utf::UtfToUtf<utf::UTF_32, utf::UTF_8>(begin, end, &string.m_string);
+    AppendUtf32(begin, end, &string.m_string);
+    string.updateIndex();
     return string;
 }
 
@@ -205,85 +276,108 @@ const std::basic_string<char>& String::toUtf8() const {
 
 std::basic_string<char16> String::toUtf16() const {
     std::basic_string<char16> output;
-    utf::UtfToUtf<utf::UTF_8, utf::UTF_16>(m_string.cbegin(), m_string.cend(), &output);
+    utf::Utf8ToUtf16(m_string.data(), m_string.data() + m_string.size(), &output);
     return output;
 }
 
 std::basic_string<char32> String::toUtf32() const {
     std::basic_string<char32> output;
-    utf::UtfToUtf<utf::UTF_8, utf::UTF_32>(m_string.cbegin(), m_string.cend(), &output);
+    utf::Utf8ToUtf32(m_string.data(), m_string.data() + m_string.size(), &output);
     return output;
 }
 
 std::basic_string<wchar> String::toWide() const {
-    std::basic_string<wchar> output;
 #if PLATFORM_IS(PLATFORM_WINDOWS)
-    utf::UtfToUtf<utf::UTF_8, utf::UTF_16>(m_string.cbegin(), m_string.cend(), &output);
+    std::basic_string<char16> output = toUtf16();
 #else
-    utf::UtfToUtf<utf::UTF_8, utf::UTF_32>(m_string.cbegin(), m_string.cend(), &output);
+    std::basic_string<char32> output = toUtf32();
 #endif
-    return output;
+    return std::basic_string<wchar>(output.cbegin(), output.cend());
 }
 
 String& String::operator=(const String& right) = default;
 
 String& String::operator=(const char* right) {
     m_string = right;
+    updateIndex();
     return *this;
 }
 
 String& String::operator=(String&& right) noexcept {
-    m_string = std::move(right.m_string);
+    if (this != &right) {
+        m_string = std::move(right.m_string);
+        m_size = right.m_size;
+        m_breadcrumbs = std::move(right.m_breadcrumbs);
+        right.clear();
+    }
     return *this;
 }
 
 String& String::operator+=(const String& right) {
+    size_type dataOffset = m_string.size();
     m_string += right.m_string;
+    updateIndex(m_size, dataOffset);
     return *this;
 }
 
 String& String::operator+=(const char* right) {
+    size_type dataOffset = m_string.size();
     m_string += right;
+    updateIndex(m_size, dataOffset);
     return *this;
 }
 
 String& String::operator+=(const char8* right) {
+    size_type dataOffset = m_string.size();
     m_string += reinterpret_cast<const char*>(right);
+    updateIndex(m_size, dataOffset);
     return *this;
 }
 
 String& String::operator+=(char right) {
     if (right >= 0) {
         m_string += right;
+        updateIndex(m_size, m_string.size() - 1);
     }
     return *this;
 }
 
 String& String::operator+=(char32 right) {
+    size_type dataOffset = m_string.size();
     utf::UtfToUtf<utf::UTF_32, utf::UTF_8>(&right, &right + 1, &m_string);
+    updateIndex(m_size, dataOffset);
     return *this;
 }
 
 String& String::operator+=(const utf::CodeUnit<utf::UTF_8>& right) {
     // TODO: Missing test
+    size_type dataOffset = m_string.size();
     m_string.reserve(m_string.size() + right.getSize());
     for (auto data : right) {
         m_string.push_back(static_cast<char>(data));
     }
+    updateIndex(m_size, dataOffset);
     return *this;
 }
 
 utf::CodeUnit<utf::UTF_8> String::operator[](size_type index) const {
     // TODO: throw error
-    return (cbegin() + index)->get();
+    const char* begin = getCodePointData(index);
+    return utf::CodeUnit<utf::UTF_8>(begin, utf::Next<utf::UTF_8>(begin, m_string.data() + m_string.size()));
 }
 
 void String::clear() {
     m_string.clear();
+    m_size = 0;
+    m_breadcrumbs.clear();
 }
 
 String::size_type String::getSize() const {
-    return utf::GetSize<utf::UTF_8>(m_string.begin(), m_string.end());
+    return m_size;
+}
+
+bool String::isAscii() const {
+    return m_size == m_string.size();
 }
 
 bool String::isEmpty() const {
@@ -291,96 +385,90 @@ bool String::isEmpty() const {
 }
 
 void String::erase(size_type position, size_type count) {
-    size_type utf8StrSize = getSize();
-    if ((position + count) > utf8StrSize) {
+    if ((position + count) > m_size) {
         ENGINE_THROW(std::out_of_range("the specified position is out of the string range"));
     }
 
-    // Iterate to the start and end codepoint
-    auto startIt = begin() + position;
-    auto endIt = startIt + count;
+    // Find the start and end codepoint
+    const char* start = getCodePointData(position);
+    const char* end = getCodePointData(position + count);
 
-    // Iterate to the end codepoint
-    auto erasePos = startIt.getPtr() - m_string.data();
-    auto eraseCount = endIt.getPtr() - startIt.getPtr();
+    auto erasePos = static_cast<size_type>(start - m_string.data());
+    auto eraseCount = static_cast<size_type>(end - start);
     m_string.erase(erasePos, eraseCount);
+    updateIndex(position, erasePos);
 }
 
 void String::insert(size_type position, const StringView& str) {
-    size_type utf8StrSize = getSize();
-    if (position >= utf8StrSize) {
+    if (position >= m_size) {
         ENGINE_THROW(std::out_of_range("the specified position is out of the string range"));
     }
 
-    // Iterate to the start codepoint
-    auto startIt = begin() + position;
-
     // Insert the data in the correct position
-    auto insertPos = startIt.getPtr() - m_string.data();
+    auto insertPos = static_cast<size_type>(getCodePointData(position) - m_string.data());
     m_string.insert(insertPos, str.getData(), str.getDataSize());
+    updateIndex(position, insertPos);
 }
 
 String::size_type String::find(const StringView& str, size_type start) const {
     // Check the size is not past the max code units
-    if (start >= getSize()) {
+    if (start >= m_size) {
         return sInvalidPos;
     }
-    // Find the string
-    auto findIt = std::search(cbegin() + start, cend(), str.cbegin(), str.cend());
-    return (findIt == cend()) ? sInvalidPos : (findIt - cbegin());
+    // The UTF-8 sequences can only match at the start of a codepoint
+    auto startPos = static_cast<size_type>(getCodePointData(start) - m_string.data());
+    size_type found = m_string.find(str.getData(), startPos, str.getDataSize());
+    return (found == std::basic_string<char>::npos) ? sInvalidPos : getCodePointPosition(found);
 }
 
 String::size_type String::findFirstOf(const StringView& str, size_type pos) const {
-    if (pos >= getSize()) {
+    if (pos >= m_size) {
         return sInvalidPos;
     }
 
     // Find one of the UTF-8 codepoints
-    for (auto it = cbegin() + pos; it != cend(); ++it) {
+    auto maxRange = std::make_pair(m_string.data(), m_string.data() + m_string.size());
+    for (auto it = const_iterator(maxRange, getCodePointData(pos)); it != cend(); ++it) {
         auto found = std::find(str.cbegin(), str.cend(), *it);
         if (found != str.cend()) {
-            return it - cbegin();
+            return getCodePointPosition(static_cast<size_type>(it.getPtr() - m_string.data()));
         }
     }
     return sInvalidPos;
 }
 
 String::size_type String::findLastOf(const StringView& str, size_type pos) const {
-    size_type utf8StrSize = getSize();
-    if (pos != sInvalidPos && pos >= utf8StrSize) {
+    if (m_size == 0 || (pos != sInvalidPos && pos >= m_size)) {
         return sInvalidPos;
     }
 
-    // Iterate to the start codepoint
-    auto startIt = crbegin();
-    if (pos != sInvalidPos) {
-        startIt += (utf8StrSize - pos - 1);
-    }
+    // Find the start codepoint
+    auto maxRange = std::make_pair(m_string.data(), m_string.data() + m_string.size());
+    auto startIt = const_reverse_iterator(maxRange, getCodePointData((pos != sInvalidPos) ? pos : m_size - 1));
 
     // Find one of the UTF-8 codepoints
     for (auto it = startIt; it != crend(); ++it) {
         auto found = std::find(str.cbegin(), str.cend(), *it);
         if (found != str.cend()) {
-            return crend() - it;
+            return getCodePointPosition(static_cast<size_type>(it.getPtr() - m_string.data()));
         }
     }
     return sInvalidPos;
 }
 
 void String::replace(size_type position, size_type length, const StringView& replaceWith) {
-    size_type utf8StrSize = getSize();
-    if ((position + length) > utf8StrSize) {
+    if ((position + length) > m_size) {
         ENGINE_THROW(std::out_of_range("the specified position is out of the string range"));
     }
 
-    // Iterate to the start and end codepoint
-    auto startIt = cbegin() + position;
-    auto endIt = startIt + length;
+    // Find the start and end codepoint
+    const char* start = getCodePointData(position);
+    const char* end = getCodePointData(position + length);
 
-    // Iterate to the end codepoint
-    auto replacePos = startIt.getPtr() - m_string.data();
-    auto replaceCount = endIt.getPtr() - startIt.getPtr();
+    auto replacePos = static_cast<size_type>(start - m_string.data());
+    auto replaceCount = static_cast<size_type>(end - start);
     m_string.replace(replacePos, replaceCount, replaceWith.getData(), replaceWith.getDataSize());
+    updateIndex(position, replacePos);
 }
 
 void String::replace(uint32 searchFor, uint32 replaceWith) {
@@ -388,6 +476,7 @@ void String::replace(uint32 searchFor, uint32 replaceWith) {
         return;
     }
     if (searchFor <= 0x7F && replaceWith <= 0x7F) {
+        // The size of the codepoints doesn't change
         for (auto& ch : m_string) {
             if (ch == static_cast<char>(searchFor)) {
                 ch = static_cast<char>(replaceWith);
@@ -401,37 +490,40 @@ void String::replace(uint32 searchFor, uint32 replaceWith) {
 }
 
 void String::replace(const StringView& searchFor, const StringView& replaceWith) {
-    size_type step = replaceWith.getSize();
-    // Start the iterator at the beginning of the sequence
-    size_t findItPos = 0;
-    // Replace each occurrence of search
-    while (true) {
-        // Search the existence of the string searchFor in the range [begin() + find_it_pos, end())
-        auto findIt = std::search(begin() + findItPos, end(), searchFor.cbegin(), searchFor.cend());
-        // Check if we reach the end of the string
-        if (findIt == end()) {
-            return;
-        }
-        // Replace all the range between [find_it, find_it + len) with the string in replaceWith
-        auto stringPos = findIt.getPtr() - m_string.data();
-        m_string.replace(stringPos, searchFor.getDataSize(), replaceWith.getData(), replaceWith.getDataSize());
-        // Add an additional step to continue the search
-        findItPos += step;
+    if (searchFor.getDataSize() == 0) {
+        return;
     }
+
+    // The UTF-8 sequences can only match at the start of a codepoint
+    size_type found = m_string.find(searchFor.getData(), 0, searchFor.getDataSize());
+    if (found == std::basic_string<char>::npos) {
+        return;
+    }
+    size_type firstPosition = getCodePointPosition(found);
+    size_type firstPos = found;
+
+    // Replace each occurrence of search and continue after the replacement
+    while (found != std::basic_string<char>::npos) {
+        m_string.replace(found, searchFor.getDataSize(), replaceWith.getData(), replaceWith.getDataSize());
+        found = m_string.find(searchFor.getData(), found + replaceWith.getDataSize(), searchFor.getDataSize());
+    }
+    updateIndex(firstPosition, firstPos);
 }
 
 String String::subString(size_type position, size_type length) const {
-    size_type utf8StrSize = getSize();
-    if ((position + length) > utf8StrSize) {
+    if ((position + length) > m_size) {
         ENGINE_THROW(std::out_of_range("the specified position is out of the string range"));
     }
 
-    // Iterate to the start and end codepoint
-    auto startIt = cbegin() + position;
-    auto endIt = startIt + length;
+    // Find the start and end codepoint
+    const char* start = getCodePointData(position);
+    const char* end = getCodePointData(position + length);
 
-    // Create a new string with given range
-    return String::FromUtf8(startIt.getPtr(), endIt.getPtr());
+    // The range is already valid UTF-8
+    String string;
+    string.m_string.assign(start, end);
+    string.updateIndex();
+    return string;
 }
 
 const char* String::getData() const {
@@ -486,6 +578,78 @@ String::const_reverse_iterator String::crend() const {
     return const_reverse_iterator(maxRange, end);
 }
 
+void String::updateIndex(size_type position, size_type dataOffset) {
+    const char* data = m_string.data();
+    size_type dataSize = m_string.size();
+
+    // Keep the breadcrumbs of the codepoints before the position
+    m_size = position;
+    m_breadcrumbs.resize(std::min(m_breadcrumbs.size(), (position > 0) ? (position - 1) / sBreadcrumbStride : 0));
+
+    if (m_size == dataOffset) {
+        // The ASCII strings don't need breadcrumbs
+        auto asciiEnd = static_cast<size_type>(utf::FindNonAscii(data + dataOffset, data + dataSize) - data);
+        if (asciiEnd == dataSize) {
+            m_size = dataSize;
+            m_breadcrumbs.clear();
+            return;
+        }
+
+        // The offsets of the ASCII prefix are their positions
+        m_breadcrumbs.clear();
+        for (size_type i = sBreadcrumbStride; i < asciiEnd; i += sBreadcrumbStride) {
+            m_breadcrumbs.push_back(i);
+        }
+        m_size = asciiEnd;
+        dataOffset = asciiEnd;
+    }
+
+    for (size_type i = dataOffset; i < dataSize; i++) {
+        if (!IsContinuation(data[i])) {
+            if (m_size > 0 && m_size % sBreadcrumbStride == 0) {
+                m_breadcrumbs.push_back(i);
+            }
+            m_size++;
+        }
+    }
+}
+
+const char* String::getCodePointData(size_type position) const {
+    const char* data = m_string.data();
+    if (isAscii()) {
+        return data + position;
+    }
+
+    // Start from the closest breadcrumb and skip the rest of codepoints
+    size_type breadcrumb = std::min(position / sBreadcrumbStride, m_breadcrumbs.size());
+    const char* it = data + ((breadcrumb > 0) ? m_breadcrumbs[breadcrumb - 1] : 0);
+    const char* end = data + m_string.size();
+    for (size_type remaining = position - breadcrumb * sBreadcrumbStride; remaining > 0; remaining--) {
+        do {
+            it++;
+        } while (it < end && IsContinuation(*it));
+    }
+    return it;
+}
+
+String::size_type String::getCodePointPosition(size_type dataOffset) const {
+    if (isAscii()) {
+        return dataOffset;
+    }
+
+    // Count the codepoints from the last breadcrumb before the offset
+    auto breadcrumb = static_cast<size_type>(std::upper_bound(m_breadcrumbs.begin(), m_breadcrumbs.end(), dataOffset) -
+                                             m_breadcrumbs.begin());
+    size_type position = breadcrumb * sBreadcrumbStride;
+    const char* data = m_string.data();
+    for (size_type i = (breadcrumb > 0) ? m_breadcrumbs[breadcrumb - 1] : 0; i < dataOffset; i++) {
+        if (!IsContinuation(data[i])) {
+            position++;
+        }
+    }
+    return position;
+}
+
 bool operator==(const String& left, const String& right) {
     return StringView(left) == StringView(right);
 }
@@ -29,6 +29,7 @@
 #include <Util/Prerequisites.hpp>
 
 #include <System/StringView.hpp>
+#include <Util/Container/Vector.hpp>
 #include <Util/UTF.hpp>
 
 #include <compare>
@@ -80,7 +81,8 @@ public:
     ////////////////////////////////////////////////////////////
     // Static member data
     ////////////////////////////////////////////////////////////
-    static const size_type sInvalidPos;  ///< Represents an invalid position in the string
+    static const size_type sInvalidPos;       ///< Represents an invalid position in the string
+    static const size_type sBreadcrumbStride;  ///< Codepoints between the offsets indexed in non ASCII strings
 
     /**
      * @brief Default constructor
@@ -127,6 +129,8 @@ public:
     /**
      * @brief Construct from a null-terminated (value 0) UTF-16 string
      *
+     * An invalid string keeps the code points before the first error
+     *
      * @param utf16String UTF-8 string to assign
      */
     String(const char16* utf16String);
@@ -134,6 +138,8 @@ public:
     /**
      * @brief Construct from a null-terminated (value 0) UTF-32 string
      *
+     * An invalid string keeps the code points before the first error
+     *
      * @param utf32String UTF-8 string to assign
      */
     String(const char32* utf32String);
@@ -263,6 +269,8 @@ public:
     /**
      * @brief Create a new String from a UTF-16 encoded string
      *
+     * An invalid string keeps the code points before the first error
+     *
      * @param begin Pointer to the beginning of the UTF-16 sequence
      * @param end   Pointer to the end of the UTF-16 sequence
      *
@@ -308,6 +316,8 @@ public:
     /**
      * @brief Create a new String from a UTF-32 encoded string
      *
+     * An invalid string keeps the code points before the first error
+     *
      * @param begin Pointer to the beginning of the UTF-32 sequence
      * @param end   Pointer to the end of the UTF-32 sequence
      *
@@ -562,12 +572,25 @@ public:
     /**
      * @brief Get the size of the string
      *
+     * @details The number of codepoints is kept up to date by the
+     *          operations that modify the string, so this is O(1)
+     *
      * @return Number of UTF-8 codepoints in the string
      *
      * @see isEmpty
      */
     size_type getSize() const;
 
+    /**
+     * @brief Check whether all the characters of the string are ASCII
+     *
+     * @details The characters of the ASCII strings are accessed
+     *          directly by their position
+     *
+     * @return True if the string only contains ASCII characters
+     */
+    bool isAscii() const;
+
     /**
      * @brief Check whether the string is empty or not
      *
@@ -816,10 +839,36 @@ public:
     const_reverse_iterator crend() const;
 
 private:
+    /**
+     * @brief Update the codepoint index after modifying the string
+     *
+     * @param position Position of the first modified codepoint, the
+     *                 index of the previous ones is kept
+     * @param dataOffset Offset in bytes of the codepoint at `position`
+     */
+    void updateIndex(size_type position = 0, size_type dataOffset = 0);
+
+    /**
+     * @brief Get a pointer to the start of a codepoint
+     *
+     * @param position Position of the codepoint, can be the size of
+     *                 the string to get the end
+     */
+    const char* getCodePointData(size_type position) const;
+
+    /**
+     * @brief Get the position of the codepoint that starts at an offset
+     *
+     * @param dataOffset Offset in bytes of the codepoint
+     */
+    size_type getCodePointPosition(size_type dataOffset) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     std::basic_string<char> m_string;  ///< Internal string of UTF-8 characters
+    size_type m_size = 0;              ///< Number of UTF-8 codepoints
+    Vector<size_type> m_breadcrumbs;   ///< Offsets of every sBreadcrumbStride codepoints of non ASCII strings
 };
 
 /**
@@ -0,0 +1,92 @@
+#include <System/StringBuilder.hpp>
+
+#include <algorithm>
+
+#include <cassert>
+#include <cstring>
+
+namespace engine {
+
+StringBuilder::StringBuilder(char* storage, size_type capacity) : m_data(storage), m_size(0), m_capacity(capacity) {
+    m_data[0] = '\0';
+}
+
+StringBuilder::~StringBuilder() = default;
+
+StringBuilder& StringBuilder::append(const StringView& str) {
+    size_type size = str.getDataSize();
+    reserve(m_size + size);
+    std::memcpy(m_data + m_size, str.getData(), size);
+    m_size += size;
+    m_data[m_size] = '\0';
+    return *this;
+}
+
+StringBuilder& StringBuilder::append(char character) {
+    reserve(m_size + 1);
+    m_data[m_size++] = character;
+    m_data[m_size] = '\0';
+    return *this;
+}
+
+void StringBuilder::clear() {
+    truncate(0);
+}
+
+void StringBuilder::truncate(size_type size) {
+    assert(size <= m_size);
+    m_size = size;
+    m_data[m_size] = '\0';
+}
+
+void StringBuilder::reserve(size_type capacity) {
+    if (capacity < m_capacity) {
+        return;
+    }
+
+    // Grow geometrically so appending char by char is amortized O(1)
+    size_type newCapacity = std::max(capacity + 1, m_capacity * 2);
+    std::unique_ptr<char[]> newData(new char[newCapacity]);
+    std::memcpy(newData.get(), m_data, m_size + 1);
+    m_heapData = std::move(newData);
+    m_data = m_heapData.get();
+    m_capacity = newCapacity;
+}
+
+bool StringBuilder::isEmpty() const {
+    return m_size == 0;
+}
+
+bool StringBuilder::isInline() const {
+    return m_heapData == nullptr;
+}
+
+char* StringBuilder::getData() {
+    return m_data;
+}
+
+const char* StringBuilder::getData() const {
+    return m_data;
+}
+
+StringBuilder::size_type StringBuilder::getDataSize() const {
+    return m_size;
+}
+
+StringBuilder::size_type StringBuilder::getCapacity() const {
+    return m_capacity - 1;
+}
+
+StringView StringBuilder::getView() const {
+    return StringView(m_data, m_size);
+}
+
+StringBuilder::operator StringView() const {
+    return getView();
+}
+
+String StringBuilder::toString() const {
+    return String(getView());
+}
+
+}  // namespace engine
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <System/String.hpp>
+#include <System/StringView.hpp>
+#include <Util/NonCopyable.hpp>
+
+#include <memory>
+
+namespace engine {
+
+/**
+ * @brief Buffer used to build UTF-8 strings without temporary Strings
+ *
+ * @details The characters are written to the storage provided by the
+ *          derived class, usually an InlineString on the stack. Only
+ *          when the content doesn't fit the builder moves it to the
+ *          heap. The content is always null-terminated.
+ *
+ * @warning The views returned by the builder are invalidated when it
+ *          is modified
+ */
+class ENGINE_API StringBuilder : NonCopyable {
+public:
+    using size_type = size_t;  ///< Size type
+
+    ~StringBuilder();
+
+    /**
+     * @brief Append a UTF-8 string
+     *
+     * @param str The string to append
+     * @return A reference to the builder
+     */
+    StringBuilder& append(const StringView& str);
+
+    /**
+     * @brief Append a single ASCII character
+     *
+     * @param character The character to append
+     * @return A reference to the builder
+     */
+    StringBuilder& append(char character);
+
+    /**
+     * @brief Append the arguments formatted with a fmt format string
+     *
+     * @param format The format string
+     * @param args The arguments of the format string
+     * @return A reference to the builder
+     */
+    template <typename... Args>
+    StringBuilder& format(const StringView& format, Args&&... args);
+
+    /**
+     * @brief Remove all the characters, the capacity is kept
+     */
+    void clear();
+
+    /**
+     * @brief Remove the characters after the given size
+     *
+     * @param size The new size in bytes, must not be greater than the
+     *             current size
+     */
+    void truncate(size_type size);
+
+    /**
+     * @brief Make sure the builder can hold a number of bytes without
+     *        allocating memory
+     *
+     * @param capacity The number of bytes without the null terminator
+     */
+    void reserve(size_type capacity);
+
+    bool isEmpty() const;
+
+    /**
+     * @brief Check if the content is still in the inline storage
+     */
+    bool isInline() const;
+
+    char* getData();
+
+    const char* getData() const;
+
+    size_type getDataSize() const;
+
+    size_type getCapacity() const;
+
+    StringView getView() const;
+
+    operator StringView() const;
+
+    String toString() const;
+
+protected:
+    /**
+     * @brief Construct a builder that writes to the given storage
+     *
+     * @param storage The storage, must outlive the builder
+     * @param capacity The size of the storage in bytes, including the
+     *                 null terminator
+     */
+    StringBuilder(char* storage, size_type capacity);
+
+private:
+    char* m_data;
+    size_type m_size;
+    size_type m_capacity;
+    std::unique_ptr<char[]> m_heapData;
+};
+
+/**
+ * @brief StringBuilder with inline storage of N bytes
+ *
+ * @details Strings of less than N bytes are built without allocating
+ *          memory, like the paths or the uniform names that are built
+ *          each frame
+ */
+template <size_t N>
+class InlineString : public StringBuilder {
+public:
+    static_assert(N > 0, "The storage must hold at least the null terminator");
+
+    InlineString() : StringBuilder(m_storage, N) {}
+
+    explicit InlineString(const StringView& str) : InlineString() {
+        append(str);
+    }
+
+private:
+    char m_storage[N];
+};
+
+}  // namespace engine
+
+#include <System/StringBuilder.inl>
@@ -0,0 +1,22 @@
+#include <System/StringFormat.hpp>
+
+namespace engine {
+
+template <typename... Args>
+StringBuilder& StringBuilder::format(const StringView& format, Args&&... args) {
+    fmt::string_view formatView(format.getData(), format.getDataSize());
+
+    // Format in place and only if it doesn't fit format it again after
+    // growing the buffer
+    size_type available = m_capacity - m_size - 1;
+    auto result = fmt::format_to_n(m_data + m_size, available, formatView, args...);
+    if (result.size > available) {
+        reserve(m_size + result.size);
+        fmt::format_to_n(m_data + m_size, result.size, formatView, args...);
+    }
+    m_size += result.size;
+    m_data[m_size] = '\0';
+    return *this;
+}
+
+}  // namespace engine
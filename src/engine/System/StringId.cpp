@@ -0,0 +1,75 @@
+#include <System/StringId.hpp>
+
+#include <System/String.hpp>
+
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace engine {
+
+namespace {
+
+struct InternTable {
+    std::shared_mutex mutex;
+    std::unordered_map<uint64, String> strings;
+};
+
+InternTable& GetInternTable() {
+    static InternTable sInternTable;
+    return sInternTable;
+}
+
+// Two strings with the same identifier would be taken as the same one
+// by every lookup, so a collision can't be ignored
+void CheckCollision(const String& interned, const StringView& str) {
+    if (interned != str) {
+        ENGINE_THROW(std::runtime_error("two interned strings have the same identifier"));
+    }
+}
+
+void Intern(uint64 id, const StringView& str) {
+    InternTable& table = GetInternTable();
+    {
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        auto it = table.strings.find(id);
+        if (it != table.strings.end()) {
+            CheckCollision(it->second, str);
+            return;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(table.mutex);
+    auto result = table.strings.emplace(id, String(str));
+    if (!result.second) {
+        // Another thread interned the identifier meanwhile
+        CheckCollision(result.first->second, str);
+    }
+}
+
+}  // namespace
+
+StringId::StringId(const StringView& str) : m_id(HashString64(str.getData(), str.getDataSize())) {
+    Intern(m_id, str);
+}
+
+StringId::StringId(const String& str) : StringId(StringView(str)) {}
+
+StringView StringId::getString() const {
+    InternTable& table = GetInternTable();
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+    auto it = table.strings.find(m_id);
+    return (it != table.strings.end()) ? StringView(it->second) : StringView();
+}
+
+std::ostream& operator<<(std::ostream& os, const StringId& id) {
+    StringView str = id.getString();
+    if (!str.isEmpty() || id == StringId("")) {
+        return os << str;
+    }
+    return os << '#' << std::hex << id.getValue() << std::dec;
+}
+
+}  // namespace engine
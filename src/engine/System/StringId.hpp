@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <System/StringView.hpp>
+#include <Util/Hash.hpp>
+
+#include <compare>
+#include <functional>
+#include <iosfwd>
+
+namespace engine {
+
+class String;
+
+/**
+ * @brief Identifier of an interned string
+ *
+ * @details The identifier is the 64 bits hash of the string, so the
+ *          lookups by name become integer compares. The identifiers of
+ *          the string literals are computed at compile time, the ones
+ *          created from a String or a StringView are also added to a
+ *          global thread-safe table, so their string can be retrieved
+ *          to show it in the logs. Interning two different strings with
+ *          the same identifier throws a std::runtime_error.
+ */
+class StringId {
+public:
+    /**
+     * @brief Default constructor
+     *
+     * Creates an invalid identifier that doesn't match any string
+     */
+    constexpr StringId() : m_id(0) {}
+
+    /**
+     * @brief Construct the identifier of a string literal at compile time
+     *
+     * @param literal The string literal
+     */
+    template <size_t N>
+    consteval StringId(const char (&literal)[N]) : m_id(HashString64(literal, N - 1)) {}
+
+    /**
+     * @brief Construct the identifier of a string and intern it
+     *
+     * @param str The string
+     */
+    ENGINE_API StringId(const StringView& str);
+
+    /**
+     * @brief Construct the identifier of a string and intern it
+     *
+     * @param str The string
+     */
+    ENGINE_API StringId(const String& str);
+
+    /**
+     * @brief Get the hash of the string
+     */
+    constexpr uint64 getValue() const {
+        return m_id;
+    }
+
+    /**
+     * @brief Check if the identifier was created from a string
+     */
+    constexpr bool isValid() const {
+        return m_id != 0;
+    }
+
+    /**
+     * @brief Get the interned string of the identifier
+     *
+     * @return The string or an empty StringView if no String or
+     *         StringView with this identifier was created
+     */
+    ENGINE_API StringView getString() const;
+
+    constexpr bool operator==(const StringId& other) const = default;
+
+    constexpr std::strong_ordering operator<=>(const StringId& other) const = default;
+
+private:
+    uint64 m_id;
+};
+
+/**
+ * @relates StringId
+ * @brief Overload of << operator to write the interned string of the
+ *        identifier, or its hash if the string is unknown
+ *
+ * @param os A std::ostream
+ * @param id A StringId
+ *
+ * @return Returns os
+ */
+ENGINE_API std::ostream& operator<<(std::ostream& os, const StringId& id);
+
+}  // namespace engine
+
+namespace std {
+
+template <>
+struct hash<engine::StringId> {
+    size_t operator()(const engine::StringId& id) const {
+        return static_cast<size_t>(id.getValue());
+    }
+};
+
+}  // namespace std
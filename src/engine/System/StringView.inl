@@ -166,7 +166,8 @@ constexpr StringView::const_reverse_iterator StringView::crend() const {
 }
 
 inline bool operator==(const StringView& left, const StringView& right) {
-    return std::equal(left.getData(), left.getData() + left.getDataSize(), right.getData());
+    return std::equal(left.getData(), left.getData() + left.getDataSize(), right.getData(),
+                      right.getData() + right.getDataSize());
 }
 
 inline std::strong_ordering operator<=>(const StringView& left, const StringView& right) {
@@ -2,6 +2,9 @@
 
 #include <Util/AsyncTaskRunner.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -41,8 +44,63 @@ AsyncTaskRunner::~AsyncTaskRunner() {
 }
 
 void AsyncTaskRunner::execute(Task&& f) {
-    m_workQueue.push(std::move(f));
+    {
+        // Hold the workers lock so the notification can't be lost between
+        // the empty check and the wait of a worker
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_workQueue.push(std::move(f));
+    }
     m_signaler.notify_one();
 }
 
+void AsyncTaskRunner::parallelFor(size_t count, const IndexedTask& task) {
+    if (count == 0) {
+        return;
+    }
+
+    struct ParallelForState {
+        const IndexedTask* task;
+        size_t count;
+        std::atomic<size_t> nextIndex;
+        size_t completed;
+        std::mutex mutex;
+        std::condition_variable finished;
+
+        void run() {
+            size_t processed = 0;
+            for (size_t i = nextIndex++; i < count; i = nextIndex++) {
+                (*task)(size_t(i));
+                processed++;
+            }
+            if (processed > 0) {
+                std::lock_guard<std::mutex> lk(mutex);
+                completed += processed;
+                if (completed == count) {
+                    finished.notify_one();
+                }
+            }
+        }
+    };
+
+    // The state is shared with the workers because they can start after
+    // all the indices have been processed. Only the indices are awaited,
+    // so calling parallelFor from a worker can't wait for itself
+    auto state = std::make_shared<ParallelForState>();
+    state->task = &task;
+    state->count = count;
+    state->nextIndex = 0;
+    state->completed = 0;
+
+    size_t helpers = std::min(count - 1, m_workers.size());
+    for (size_t i = 0; i < helpers; i++) {
+        execute([state]() { state->run(); });
+    }
+
+    // The calling thread also processes indices while waiting
+    state->run();
+
+    std::unique_lock<std::mutex> lk(state->mutex);
+    state->finished.wait(lk, [&state]() { return state->completed == state->count; });
+}
+
 }  // namespace engine
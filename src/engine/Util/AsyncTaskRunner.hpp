@@ -16,6 +16,7 @@ namespace engine {
 class ENGINE_API AsyncTaskRunner {
 public:
     using Task = Function<void()>;
+    using IndexedTask = Function<void(size_t)>;
 
     AsyncTaskRunner();
 
@@ -23,6 +24,19 @@ public:
 
     void execute(Task&& f);
 
+    /**
+     * @brief Execute a task for each index in [0, count) distributing
+     *        them between the workers and the calling thread
+     *
+     * @details This function blocks until all the indices have been
+     *          processed, the task must be safe to call concurrently.
+     *          It can be called from the tasks executed by the workers
+     *
+     * @param count The number of indices to process
+     * @param task The task to execute for each index
+     */
+    void parallelFor(size_t count, const IndexedTask& task);
+
 private:
     bool m_isRunning;
     SafeQueue<Task> m_workQueue;
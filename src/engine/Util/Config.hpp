@@ -34,6 +34,17 @@
     #define ENGINE_DEBUG
 #endif
 
+// Minimum priority of the log messages compiled in the binary, from 1
+// (VERBOSE) to 6 (FATAL). The calls with a lower priority are removed,
+// the release builds keep from INFO so VERBOSE is dropped along DEBUG
+#ifndef ENGINE_LOG_MIN_PRIORITY
+    #ifdef ENGINE_DEBUG
+        #define ENGINE_LOG_MIN_PRIORITY 1
+    #else
+        #define ENGINE_LOG_MIN_PRIORITY 3
+    #endif
+#endif
+
 // Disable warning for not using CRT secure functions
 #ifdef _MSC_VER
     #define _CRT_SECURE_NO_WARNINGS
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <Util/Container/FlatHashTable.hpp>
+
+#include <functional>
+#include <new>
+#include <utility>
+
+namespace engine {
+
+namespace internal {
+
+template <typename K, typename V>
+struct FlatHashMapPolicy {
+    using key_type = K;
+    using mapped_type = V;
+    // The key is not const so the elements can be moved when the table
+    // grows, it must not be modified through the iterators
+    using value_type = std::pair<K, V>;
+
+    static const K& GetKey(const value_type& value) {
+        return value.first;
+    }
+
+    static void Transfer(value_type* destination, value_type* source) {
+        new (destination) value_type(std::move(*source));
+        source->~value_type();
+    }
+};
+
+}  // namespace internal
+
+/**
+ * @brief Hash map that stores its elements in a flat array
+ *
+ * @details Lookups are faster than std::map and std::unordered_map
+ *          because there are no nodes to follow, see FlatHashTable.
+ *          Maps with String keys can be looked up with a StringView.
+ *
+ * @warning Pointers and iterators to the elements are invalidated
+ *          when the map grows, erasing only invalidates the erased
+ *          element
+ */
+template <typename K, typename V, typename Hash = FlatHash<K>, typename KeyEqual = std::equal_to<>>
+class FlatHashMap : public internal::FlatHashTable<internal::FlatHashMapPolicy<K, V>, Hash, KeyEqual> {
+public:
+    using Base = internal::FlatHashTable<internal::FlatHashMapPolicy<K, V>, Hash, KeyEqual>;
+    using mapped_type = V;
+    using typename Base::iterator;
+    using typename Base::key_type;
+
+    using Base::Base;
+
+    /**
+     * @brief Construct the value of a key if the key is not in the map
+     *
+     * @details Unlike emplace, nothing is constructed if the key is
+     *          already in the map
+     *
+     * @return The element with the key and true if it was inserted
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> tryEmplace(const key_type& key, Args&&... args);
+
+    template <typename... Args>
+    std::pair<iterator, bool> tryEmplace(key_type&& key, Args&&... args);
+
+    /**
+     * @brief Get the value of a key, it is default constructed if the
+     *        key is not in the map
+     */
+    V& operator[](const key_type& key);
+
+    V& operator[](key_type&& key);
+};
+
+}  // namespace engine
+
+#include <Util/Container/FlatHashMap.inl>
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <tuple>
+#include <utility>
+
+namespace engine {
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::pair<typename FlatHashMap<K, V, Hash, KeyEqual>::iterator, bool> FlatHashMap<K, V, Hash, KeyEqual>::tryEmplace(
+    const key_type& key, Args&&... args) {
+    auto result = this->findOrPrepareInsert(key);
+    if (result.second) {
+        this->constructAt(result.first, std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    return std::make_pair(this->getIterator(result.first), result.second);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::pair<typename FlatHashMap<K, V, Hash, KeyEqual>::iterator, bool> FlatHashMap<K, V, Hash, KeyEqual>::tryEmplace(
+    key_type&& key, Args&&... args) {
+    auto result = this->findOrPrepareInsert(key);
+    if (result.second) {
+        this->constructAt(result.first, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    return std::make_pair(this->getIterator(result.first), result.second);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+V& FlatHashMap<K, V, Hash, KeyEqual>::operator[](const key_type& key) {
+    return tryEmplace(key).first->second;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+V& FlatHashMap<K, V, Hash, KeyEqual>::operator[](key_type&& key) {
+    return tryEmplace(std::move(key)).first->second;
+}
+
+}  // namespace engine
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <Util/Container/FlatHashTable.hpp>
+
+#include <functional>
+#include <new>
+#include <utility>
+
+namespace engine {
+
+namespace internal {
+
+template <typename K>
+struct FlatHashSetPolicy {
+    using key_type = K;
+    using value_type = K;
+
+    static const K& GetKey(const value_type& value) {
+        return value;
+    }
+
+    static void Transfer(value_type* destination, value_type* source) {
+        new (destination) value_type(std::move(*source));
+        source->~value_type();
+    }
+};
+
+}  // namespace internal
+
+/**
+ * @brief Hash set that stores its elements in a flat array, see
+ *        FlatHashMap
+ *
+ * @warning The elements must not be modified through the iterators
+ */
+template <typename K, typename Hash = FlatHash<K>, typename KeyEqual = std::equal_to<>>
+class FlatHashSet : public internal::FlatHashTable<internal::FlatHashSetPolicy<K>, Hash, KeyEqual> {
+public:
+    using Base = internal::FlatHashTable<internal::FlatHashSetPolicy<K>, Hash, KeyEqual>;
+
+    using Base::Base;
+};
+
+}  // namespace engine
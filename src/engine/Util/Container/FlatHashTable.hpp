@@ -0,0 +1,419 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <Util/Hash.hpp>
+#include <Util/TypeTraits.hpp>
+
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ENGINE_FLAT_HASH_SSE2 1
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define ENGINE_FLAT_HASH_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace engine {
+
+/**
+ * @brief Default hash of the flat hash containers
+ *
+ * @details The UTF-8 strings (String, StringView, ...) are hashed by
+ *          their bytes, so a container with String keys can be looked
+ *          up with a StringView without creating a String. The rest of
+ *          types use std::hash.
+ */
+template <typename T, typename = void>
+struct FlatHash : std::hash<T> {};
+
+template <typename T>
+struct FlatHash<T, std::enable_if_t<type::is_contiguous_string_v<T>>> {
+    using is_transparent = void;
+
+    template <typename U, typename = std::enable_if_t<type::is_contiguous_string_v<U>>>
+    size_t operator()(const U& str) const {
+        return static_cast<size_t>(Hash64(str.getData(), str.getDataSize()));
+    }
+};
+
+namespace internal {
+
+/**
+ * @brief Control byte of each slot of a FlatHashTable, the full slots
+ *        store the 7 lowest bits of the hash of their key
+ */
+enum FlatHashControl : int8 {
+    EMPTY = -128,
+    DELETED = -2,
+};
+
+/**
+ * @brief Positions of the slots of a group that matched a query, can be
+ *        iterated to get each position
+ */
+template <typename T, int Shift>
+class FlatHashBitMask {
+public:
+    explicit FlatHashBitMask(T mask) : m_mask(mask) {}
+
+    explicit operator bool() const {
+        return m_mask != 0;
+    }
+
+    uint32 operator*() const {
+        return static_cast<uint32>(std::countr_zero(m_mask)) >> Shift;
+    }
+
+    FlatHashBitMask& operator++() {
+        m_mask &= m_mask - 1;
+        return *this;
+    }
+
+    FlatHashBitMask begin() const {
+        return *this;
+    }
+
+    FlatHashBitMask end() const {
+        return FlatHashBitMask(0);
+    }
+
+    bool operator!=(const FlatHashBitMask& other) const {
+        return m_mask != other.m_mask;
+    }
+
+private:
+    T m_mask;
+};
+
+#if defined(ENGINE_FLAT_HASH_SSE2)
+
+/**
+ * @brief Control bytes of 16 consecutive slots compared at once
+ */
+class FlatHashGroup {
+public:
+    static constexpr size_t sWidth = 16;
+
+    explicit FlatHashGroup(const int8* control)
+          : m_control(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control))) {}
+
+    FlatHashBitMask<uint32, 0> match(int8 hash) const {
+        return FlatHashBitMask<uint32, 0>(static_cast<uint32>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(m_control, _mm_set1_epi8(static_cast<char>(hash))))));
+    }
+
+    FlatHashBitMask<uint32, 0> matchEmpty() const {
+        return match(EMPTY);
+    }
+
+    FlatHashBitMask<uint32, 0> matchEmptyOrDeleted() const {
+        // The full slots are the only ones without the sign bit
+        return FlatHashBitMask<uint32, 0>(static_cast<uint32>(_mm_movemask_epi8(m_control)));
+    }
+
+private:
+    __m128i m_control;
+};
+
+#else
+
+/**
+ * @brief Control bytes of 8 consecutive slots compared at once, the
+ *        result has the highest bit of each matching byte set
+ */
+class FlatHashGroup {
+public:
+    static constexpr size_t sWidth = 8;
+
+    explicit FlatHashGroup(const int8* control) {
+        // The engine platforms are little-endian, so the first slot is
+        // in the lowest byte
+        std::memcpy(&m_control, control, sizeof(m_control));
+    }
+
+    FlatHashBitMask<uint64, 3> match(int8 hash) const {
+    #if defined(ENGINE_FLAT_HASH_NEON)
+        uint8x8_t equal = vceq_u8(vcreate_u8(m_control), vdup_n_u8(static_cast<uint8>(hash)));
+        return FlatHashBitMask<uint64, 3>(vget_lane_u64(vreinterpret_u64_u8(equal), 0) & sMsbs);
+    #else
+        // Can report false positives after a real match, the keys are
+        // compared anyway
+        uint64 x = m_control ^ (sLsbs * static_cast<uint8>(hash));
+        return FlatHashBitMask<uint64, 3>((x - sLsbs) & ~x & sMsbs);
+    #endif
+    }
+
+    FlatHashBitMask<uint64, 3> matchEmpty() const {
+        // Only the empty bytes have the highest bit set and the second
+        // lowest bit cleared
+        return FlatHashBitMask<uint64, 3>(m_control & (~m_control << 6) & sMsbs);
+    }
+
+    FlatHashBitMask<uint64, 3> matchEmptyOrDeleted() const {
+        return FlatHashBitMask<uint64, 3>(m_control & sMsbs);
+    }
+
+private:
+    static constexpr uint64 sLsbs = 0x0101010101010101ULL;
+    static constexpr uint64 sMsbs = 0x8080808080808080ULL;
+
+    uint64 m_control;
+};
+
+#endif
+
+/**
+ * @brief Open addressing hash table shared by FlatHashMap and FlatHashSet
+ *
+ * @details The table follows the SwissTable design. Each slot has a
+ *          control byte with 7 bits of the hash of its key, the control
+ *          bytes of a group of slots are compared at once with SIMD
+ *          instructions and only the slots that match are compared with
+ *          the key. The control bytes of the first group are cloned
+ *          after the last slot so any group can be loaded without
+ *          wrapping around.
+ *
+ * @tparam Policy Defines the stored value and how to get its key
+ * @tparam Hash Hash of the keys, if it has a is_transparent member the
+ *              table can be looked up with other types of keys
+ * @tparam KeyEqual Comparison of the keys
+ */
+template <typename Policy, typename Hash, typename KeyEqual>
+class FlatHashTable {
+public:
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    /**
+     * @brief Check if a type can be used to look up the table without
+     *        converting it to key_type
+     */
+    template <typename K>
+    static constexpr bool IsLookupKey() {
+        if constexpr (type::is_transparent_v<Hash> && type::is_transparent_v<KeyEqual>) {
+            return std::is_invocable_v<const Hash&, const K&> && !std::is_same_v<K, key_type>;
+        } else {
+            return false;
+        }
+    }
+
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        Iterator() : m_control(nullptr), m_controlEnd(nullptr), m_slot(nullptr) {}
+
+        operator Iterator<true>() const {
+            return Iterator<true>(m_control, m_controlEnd, m_slot);
+        }
+
+        reference operator*() const {
+            return *m_slot;
+        }
+
+        pointer operator->() const {
+            return m_slot;
+        }
+
+        Iterator& operator++() {
+            ++m_control;
+            ++m_slot;
+            skipEmptySlots();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator it = *this;
+            ++(*this);
+            return it;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return m_control == other.m_control;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return m_control != other.m_control;
+        }
+
+    private:
+        friend class FlatHashTable;
+        friend class Iterator<!IsConst>;
+
+        Iterator(const int8* control, const int8* controlEnd, pointer slot)
+              : m_control(control),
+                m_controlEnd(controlEnd),
+                m_slot(slot) {}
+
+        void skipEmptySlots() {
+            while (m_control != m_controlEnd && *m_control < 0) {
+                ++m_control;
+                ++m_slot;
+            }
+        }
+
+        const int8* m_control;
+        const int8* m_controlEnd;
+        pointer m_slot;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashTable();
+
+    FlatHashTable(const FlatHashTable& other);
+
+    FlatHashTable(FlatHashTable&& other) noexcept;
+
+    ~FlatHashTable();
+
+    FlatHashTable& operator=(const FlatHashTable& other);
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept;
+
+    iterator begin();
+    const_iterator begin() const;
+
+    iterator end();
+    const_iterator end() const;
+
+    bool isEmpty() const;
+
+    size_type getSize() const;
+
+    /**
+     * @brief Get the number of slots, the table grows when 7/8 of them
+     *        are used
+     */
+    size_type getCapacity() const;
+
+    void clear();
+
+    /**
+     * @brief Make sure the table can hold a number of elements without
+     *        growing
+     */
+    void reserve(size_type count);
+
+    std::pair<iterator, bool> insert(const value_type& value);
+
+    std::pair<iterator, bool> insert(value_type&& value);
+
+    /**
+     * @brief Construct an element if its key is not in the table
+     *
+     * @return The element with the key and true if it was inserted
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+
+    iterator find(const key_type& key);
+
+    const_iterator find(const key_type& key) const;
+
+    template <typename K, typename = std::enable_if_t<IsLookupKey<K>()>>
+    iterator find(const K& key);
+
+    template <typename K, typename = std::enable_if_t<IsLookupKey<K>()>>
+    const_iterator find(const K& key) const;
+
+    bool contains(const key_type& key) const;
+
+    template <typename K, typename = std::enable_if_t<IsLookupKey<K>()>>
+    bool contains(const K& key) const;
+
+    /**
+     * @brief Remove the element with the key
+     *
+     * @return The number of elements removed
+     */
+    size_type erase(const key_type& key);
+
+    template <typename K, typename = std::enable_if_t<IsLookupKey<K>()>>
+    size_type erase(const K& key);
+
+    /**
+     * @brief Remove the element referenced by the iterator
+     *
+     * @details Only the iterators to the removed element are invalidated
+     */
+    void erase(const_iterator position);
+
+protected:
+    /**
+     * @brief Find the slot of a key or reserve a new one for it
+     *
+     * @return The index of the slot and true if the slot is new, in
+     *         that case the caller must construct the element in it
+     */
+    template <typename K>
+    std::pair<size_type, bool> findOrPrepareInsert(const K& key);
+
+    template <typename... Args>
+    void constructAt(size_type index, Args&&... args);
+
+    iterator getIterator(size_type index);
+
+private:
+    struct alignas(value_type) SlotStorage {
+        byte data[sizeof(value_type)];
+    };
+
+    static constexpr size_type sInvalidIndex = ~size_type(0);
+
+    static size_type GetMaxLoad(size_type capacity);
+
+    static int8 GetControlHash(uint64 hash);
+
+    template <typename K>
+    uint64 computeHash(const K& key) const;
+
+    template <typename K>
+    size_type findIndex(const K& key, uint64 hash) const;
+
+    size_type findFirstNonFull(uint64 hash) const;
+
+    size_type prepareInsert(uint64 hash);
+
+    void setControl(size_type index, int8 control);
+
+    value_type* getSlot(size_type index) const;
+
+    void eraseAt(size_type index);
+
+    void resize(size_type capacity);
+
+    void destroyAll();
+
+    std::unique_ptr<int8[]> m_control;
+    std::unique_ptr<SlotStorage[]> m_slots;
+    size_type m_size;
+    size_type m_capacity;
+    size_type m_growthLeft;
+    Hash m_hash;
+    KeyEqual m_equal;
+};
+
+}  // namespace internal
+
+}  // namespace engine
+
+#include <Util/Container/FlatHashTable.inl>
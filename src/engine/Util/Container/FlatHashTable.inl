@@ -0,0 +1,414 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace engine {
+
+namespace internal {
+
+template <typename Policy, typename Hash, typename KeyEqual>
+FlatHashTable<Policy, Hash, KeyEqual>::FlatHashTable() : m_size(0), m_capacity(0), m_growthLeft(0) {}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+FlatHashTable<Policy, Hash, KeyEqual>::FlatHashTable(const FlatHashTable& other)
+      : m_size(0),
+        m_capacity(0),
+        m_growthLeft(0),
+        m_hash(other.m_hash),
+        m_equal(other.m_equal) {
+    reserve(other.m_size);
+    for (const value_type& value : other) {
+        insert(value);
+    }
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+FlatHashTable<Policy, Hash, KeyEqual>::FlatHashTable(FlatHashTable&& other) noexcept
+      : m_control(std::move(other.m_control)),
+        m_slots(std::move(other.m_slots)),
+        m_size(other.m_size),
+        m_capacity(other.m_capacity),
+        m_growthLeft(other.m_growthLeft),
+        m_hash(std::move(other.m_hash)),
+        m_equal(std::move(other.m_equal)) {
+    other.m_size = 0;
+    other.m_capacity = 0;
+    other.m_growthLeft = 0;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+FlatHashTable<Policy, Hash, KeyEqual>::~FlatHashTable() {
+    destroyAll();
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+FlatHashTable<Policy, Hash, KeyEqual>& FlatHashTable<Policy, Hash, KeyEqual>::operator=(const FlatHashTable& other) {
+    if (this != &other) {
+        FlatHashTable copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+FlatHashTable<Policy, Hash, KeyEqual>& FlatHashTable<Policy, Hash, KeyEqual>::operator=(
+    FlatHashTable&& other) noexcept {
+    if (this != &other) {
+        destroyAll();
+        m_control = std::move(other.m_control);
+        m_slots = std::move(other.m_slots);
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        m_growthLeft = other.m_growthLeft;
+        m_hash = std::move(other.m_hash);
+        m_equal = std::move(other.m_equal);
+        other.m_size = 0;
+        other.m_capacity = 0;
+        other.m_growthLeft = 0;
+    }
+    return *this;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::iterator FlatHashTable<Policy, Hash, KeyEqual>::begin() {
+    return getIterator(0);
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::const_iterator FlatHashTable<Policy, Hash, KeyEqual>::begin() const {
+    return const_cast<FlatHashTable*>(this)->begin();
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::iterator FlatHashTable<Policy, Hash, KeyEqual>::end() {
+    return iterator(m_control.get() + m_capacity, m_control.get() + m_capacity, getSlot(m_capacity));
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::const_iterator FlatHashTable<Policy, Hash, KeyEqual>::end() const {
+    return const_cast<FlatHashTable*>(this)->end();
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+bool FlatHashTable<Policy, Hash, KeyEqual>::isEmpty() const {
+    return m_size == 0;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::size_type FlatHashTable<Policy, Hash, KeyEqual>::getSize() const {
+    return m_size;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::size_type FlatHashTable<Policy, Hash, KeyEqual>::getCapacity() const {
+    return m_capacity;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+void FlatHashTable<Policy, Hash, KeyEqual>::clear() {
+    if (m_capacity == 0) {
+        return;
+    }
+    for (size_type i = 0; i < m_capacity; i++) {
+        if (m_control[i] >= 0) {
+            getSlot(i)->~value_type();
+        }
+    }
+    std::memset(m_control.get(), EMPTY, m_capacity + FlatHashGroup::sWidth);
+    m_size = 0;
+    m_growthLeft = GetMaxLoad(m_capacity);
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+void FlatHashTable<Policy, Hash, KeyEqual>::reserve(size_type count) {
+    size_type capacity = std::max(m_capacity, FlatHashGroup::sWidth);
+    while (GetMaxLoad(capacity) < count) {
+        capacity *= 2;
+    }
+    if (capacity > m_capacity) {
+        resize(capacity);
+    }
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+std::pair<typename FlatHashTable<Policy, Hash, KeyEqual>::iterator, bool> FlatHashTable<Policy, Hash, KeyEqual>::insert(
+    const value_type& value) {
+    auto result = findOrPrepareInsert(Policy::GetKey(value));
+    if (result.second) {
+        constructAt(result.first, value);
+    }
+    return std::make_pair(getIterator(result.first), result.second);
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+std::pair<typename FlatHashTable<Policy, Hash, KeyEqual>::iterator, bool> FlatHashTable<Policy, Hash, KeyEqual>::insert(
+    value_type&& value) {
+    auto result = findOrPrepareInsert(Policy::GetKey(value));
+    if (result.second) {
+        constructAt(result.first, std::move(value));
+    }
+    return std::make_pair(getIterator(result.first), result.second);
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::pair<typename FlatHashTable<Policy, Hash, KeyEqual>::iterator, bool>
+FlatHashTable<Policy, Hash, KeyEqual>::emplace(Args&&... args) {
+    // The key is needed before choosing the slot, so the element is
+    // constructed first and moved to its slot
+    return insert(value_type(std::forward<Args>(args)...));
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::iterator FlatHashTable<Policy, Hash, KeyEqual>::find(
+    const key_type& key) {
+    size_type index = findIndex(key, computeHash(key));
+    return (index != sInvalidIndex) ? iterator(m_control.get() + index, m_control.get() + m_capacity, getSlot(index))
+                                    : end();
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::const_iterator FlatHashTable<Policy, Hash, KeyEqual>::find(
+    const key_type& key) const {
+    return const_cast<FlatHashTable*>(this)->find(key);
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+template <typename K, typename>
+typename FlatHashTable<Policy, Hash, KeyEqual>::iterator FlatHashTable<Policy, Hash, KeyEqual>::find(const K& key) {
+    size_type index = findIndex(key, computeHash(key));
+    return (index != sInvalidIndex) ? iterator(m_control.get() + index, m_control.get() + m_capacity, getSlot(index))
+                                    : end();
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+template <typename K, typename>
+typename FlatHashTable<Policy, Hash, KeyEqual>::const_iterator FlatHashTable<Policy, Hash, KeyEqual>::find(
+    const K& key) const {
+    return const_cast<FlatHashTable*>(this)->find(key);
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+bool FlatHashTable<Policy, Hash, KeyEqual>::contains(const key_type& key) const {
+    return findIndex(key, computeHash(key)) != sInvalidIndex;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+template <typename K, typename>
+bool FlatHashTable<Policy, Hash, KeyEqual>::contains(const K& key) const {
+    return findIndex(key, computeHash(key)) != sInvalidIndex;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::size_type FlatHashTable<Policy, Hash, KeyEqual>::erase(
+    const key_type& key) {
+    size_type index = findIndex(key, computeHash(key));
+    if (index == sInvalidIndex) {
+        return 0;
+    }
+    eraseAt(index);
+    return 1;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+template <typename K, typename>
+typename FlatHashTable<Policy, Hash, KeyEqual>::size_type FlatHashTable<Policy, Hash, KeyEqual>::erase(const K& key) {
+    size_type index = findIndex(key, computeHash(key));
+    if (index == sInvalidIndex) {
+        return 0;
+    }
+    eraseAt(index);
+    return 1;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+void FlatHashTable<Policy, Hash, KeyEqual>::erase(const_iterator position) {
+    eraseAt(static_cast<size_type>(position.m_control - m_control.get()));
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+template <typename K>
+std::pair<typename FlatHashTable<Policy, Hash, KeyEqual>::size_type, bool>
+FlatHashTable<Policy, Hash, KeyEqual>::findOrPrepareInsert(const K& key) {
+    uint64 hash = computeHash(key);
+    size_type index = findIndex(key, hash);
+    if (index != sInvalidIndex) {
+        return std::make_pair(index, false);
+    }
+    return std::make_pair(prepareInsert(hash), true);
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+template <typename... Args>
+void FlatHashTable<Policy, Hash, KeyEqual>::constructAt(size_type index, Args&&... args) {
+    new (getSlot(index)) value_type(std::forward<Args>(args)...);
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::iterator FlatHashTable<Policy, Hash, KeyEqual>::getIterator(
+    size_type index) {
+    iterator it(m_control.get() + index, m_control.get() + m_capacity, getSlot(index));
+    it.skipEmptySlots();
+    return it;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::size_type FlatHashTable<Policy, Hash, KeyEqual>::GetMaxLoad(
+    size_type capacity) {
+    return capacity - capacity / 8;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+int8 FlatHashTable<Policy, Hash, KeyEqual>::GetControlHash(uint64 hash) {
+    return static_cast<int8>(hash & 0x7F);
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+template <typename K>
+uint64 FlatHashTable<Policy, Hash, KeyEqual>::computeHash(const K& key) const {
+    // Mix the bits, std::hash of the integers is usually the identity
+    // and both the high and the low bits of the hash are used
+    uint64 hash = static_cast<uint64>(m_hash(key));
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+template <typename K>
+typename FlatHashTable<Policy, Hash, KeyEqual>::size_type FlatHashTable<Policy, Hash, KeyEqual>::findIndex(
+    const K& key, uint64 hash) const {
+    if (m_capacity == 0) {
+        return sInvalidIndex;
+    }
+
+    // Probe the groups with a triangular sequence, it visits all the
+    // groups because the capacity is a power of two
+    size_type mask = m_capacity - 1;
+    size_type offset = static_cast<size_type>(hash >> 7) & mask;
+    int8 controlHash = GetControlHash(hash);
+    for (size_type step = FlatHashGroup::sWidth;; step += FlatHashGroup::sWidth) {
+        FlatHashGroup group(m_control.get() + offset);
+        for (uint32 i : group.match(controlHash)) {
+            size_type index = (offset + i) & mask;
+            if (m_equal(Policy::GetKey(*getSlot(index)), key)) {
+                return index;
+            }
+        }
+        if (group.matchEmpty()) {
+            return sInvalidIndex;
+        }
+        offset = (offset + step) & mask;
+    }
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::size_type FlatHashTable<Policy, Hash, KeyEqual>::findFirstNonFull(
+    uint64 hash) const {
+    size_type mask = m_capacity - 1;
+    size_type offset = static_cast<size_type>(hash >> 7) & mask;
+    for (size_type step = FlatHashGroup::sWidth;; step += FlatHashGroup::sWidth) {
+        auto available = FlatHashGroup(m_control.get() + offset).matchEmptyOrDeleted();
+        if (available) {
+            return (offset + *available) & mask;
+        }
+        offset = (offset + step) & mask;
+    }
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::size_type FlatHashTable<Policy, Hash, KeyEqual>::prepareInsert(
+    uint64 hash) {
+    if (m_capacity == 0) {
+        resize(FlatHashGroup::sWidth);
+    }
+
+    size_type index = findFirstNonFull(hash);
+    if (m_growthLeft == 0 && m_control[index] != DELETED) {
+        // Drop the deleted slots if they are a big part of the table,
+        // grow it otherwise
+        resize((m_size <= GetMaxLoad(m_capacity) / 2) ? m_capacity : m_capacity * 2);
+        index = findFirstNonFull(hash);
+    }
+
+    if (m_control[index] == EMPTY) {
+        m_growthLeft--;
+    }
+    setControl(index, GetControlHash(hash));
+    m_size++;
+    return index;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+void FlatHashTable<Policy, Hash, KeyEqual>::setControl(size_type index, int8 control) {
+    m_control[index] = control;
+    if (index < FlatHashGroup::sWidth) {
+        m_control[m_capacity + index] = control;
+    }
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+typename FlatHashTable<Policy, Hash, KeyEqual>::value_type* FlatHashTable<Policy, Hash, KeyEqual>::getSlot(
+    size_type index) const {
+    return std::launder(reinterpret_cast<value_type*>(m_slots.get() + index));
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+void FlatHashTable<Policy, Hash, KeyEqual>::eraseAt(size_type index) {
+    getSlot(index)->~value_type();
+    // The slot can't be marked as empty, the probe sequences of other
+    // keys could go through it
+    setControl(index, DELETED);
+    m_size--;
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+void FlatHashTable<Policy, Hash, KeyEqual>::resize(size_type capacity) {
+    std::unique_ptr<int8[]> oldControl = std::move(m_control);
+    std::unique_ptr<SlotStorage[]> oldSlots = std::move(m_slots);
+    size_type oldCapacity = m_capacity;
+
+    m_control.reset(new int8[capacity + FlatHashGroup::sWidth]);
+    m_slots.reset(new SlotStorage[capacity]);
+    m_capacity = capacity;
+    m_growthLeft = GetMaxLoad(capacity) - m_size;
+    std::memset(m_control.get(), EMPTY, capacity + FlatHashGroup::sWidth);
+
+    // The keys are unique so they are moved to the first available
+    // slot without comparing them
+    for (size_type i = 0; i < oldCapacity; i++) {
+        if (oldControl[i] >= 0) {
+            value_type* slot = std::launder(reinterpret_cast<value_type*>(oldSlots.get() + i));
+            uint64 hash = computeHash(Policy::GetKey(*slot));
+            size_type index = findFirstNonFull(hash);
+            setControl(index, GetControlHash(hash));
+            Policy::Transfer(getSlot(index), slot);
+        }
+    }
+}
+
+template <typename Policy, typename Hash, typename KeyEqual>
+void FlatHashTable<Policy, Hash, KeyEqual>::destroyAll() {
+    if (!std::is_trivially_destructible_v<value_type>) {
+        for (size_type i = 0; i < m_capacity; i++) {
+            if (m_control[i] >= 0) {
+                getSlot(i)->~value_type();
+            }
+        }
+    }
+    m_control.reset();
+    m_slots.reset();
+    m_size = 0;
+    m_capacity = 0;
+    m_growthLeft = 0;
+}
+
+}  // namespace internal
+
+}  // namespace engine
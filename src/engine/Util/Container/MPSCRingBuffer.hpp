@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <Util/NonCopyable.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace engine {
+
+/**
+ * @brief Bounded lock-free queue with multiple producers and a single
+ *        consumer
+ *
+ * @details The elements are stored in a ring of cells allocated once,
+ *          each cell has a sequence number that tells the producers and
+ *          the consumer if it's free or contains an element, so pushing
+ *          only takes a compare and swap on the write position.
+ *
+ * @warning Only one thread can pop at the same time
+ */
+template <typename T>
+class MPSCRingBuffer : NonCopyable {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param capacity The maximum number of elements, rounded up to the
+     *                 next power of two with a minimum of 2
+     */
+    explicit MPSCRingBuffer(size_t capacity);
+
+    /**
+     * @brief Add an element if there is space for it
+     *
+     * @return true if the element was added, false if the buffer is full
+     *         in which case the value is not moved
+     */
+    bool tryPush(T&& value);
+
+    /**
+     * @brief Remove the oldest element
+     *
+     * @return true if an element was removed, false if the buffer is
+     *         empty
+     */
+    bool tryPop(T* value);
+
+    size_t getCapacity() const;
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    // Keep the positions in different cache lines so the producers
+    // don't invalidate the consumer position
+    static constexpr size_t sCacheLineSize = 64;
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+    alignas(sCacheLineSize) std::atomic<size_t> m_writePosition;
+    alignas(sCacheLineSize) size_t m_readPosition;
+};
+
+}  // namespace engine
+
+#include <Util/Container/MPSCRingBuffer.inl>
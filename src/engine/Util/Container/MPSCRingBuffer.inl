@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <utility>
+
+namespace engine {
+
+template <typename T>
+MPSCRingBuffer<T>::MPSCRingBuffer(size_t capacity) : m_writePosition(0), m_readPosition(0) {
+    // A single cell can't tell a full buffer from an empty one
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    m_cells = std::make_unique<Cell[]>(size);
+    m_mask = size - 1;
+    for (size_t i = 0; i < size; i++) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool MPSCRingBuffer<T>::tryPush(T&& value) {
+    size_t position = m_writePosition.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = m_cells[position & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (difference == 0) {
+            // The cell is free, try to reserve it
+            if (m_writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.value = std::move(value);
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            // The cell still contains the element of the previous lap
+            return false;
+        } else {
+            position = m_writePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+bool MPSCRingBuffer<T>::tryPop(T* value) {
+    Cell& cell = m_cells[m_readPosition & m_mask];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != m_readPosition + 1) {
+        return false;
+    }
+    *value = std::move(cell.value);
+    // Release the cell for the producers of the next lap
+    cell.sequence.store(m_readPosition + m_mask + 1, std::memory_order_release);
+    m_readPosition++;
+    return true;
+}
+
+template <typename T>
+size_t MPSCRingBuffer<T>::getCapacity() const {
+    return m_mask + 1;
+}
+
+}  // namespace engine
@@ -33,7 +33,7 @@ void SafeQueue<T>::push(const T& value) {
 template <typename T>
 void SafeQueue<T>::push(T&& value) {
     std::lock_guard<std::mutex> lk(m_mutex);
-    return m_impl.push_back(value);
+    return m_impl.push_back(std::move(value));
 }
 
 template <typename T>
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <Util/Container/Vector.hpp>
+#include <Util/Handle.hpp>
+
+#include <limits>
+
+namespace engine {
+
+/**
+ * @brief Container that stores its elements contiguously and gives
+ *        generational handles to access them
+ *
+ * @details Insertion, lookup and removal are O(1). The elements are
+ *          kept packed so they can be iterated like a Vector, removing
+ *          an element moves the last one to its place.
+ *
+ * @warning Pointers and iterators to the elements are invalidated
+ *          on insertion and removal, store handles instead
+ */
+template <typename T, typename Tag = T>
+class SlotMap {
+public:
+    using HandleType = Handle<Tag>;
+    using iterator = typename Vector<T>::iterator;
+    using const_iterator = typename Vector<T>::const_iterator;
+
+    SlotMap();
+
+    HandleType insert(const T& value);
+
+    HandleType insert(T&& value);
+
+    template <class... Args>
+    HandleType emplace(Args&&... args);
+
+    /**
+     * @brief Remove the element referenced by the handle
+     *
+     * @return true if the element was removed, false if the handle
+     *         was stale
+     */
+    bool erase(const HandleType& handle);
+
+    bool contains(const HandleType& handle) const;
+
+    /**
+     * @brief Get the element referenced by the handle
+     *
+     * @return The element or nullptr if the handle is stale
+     */
+    T* get(const HandleType& handle);
+
+    const T* get(const HandleType& handle) const;
+
+    /**
+     * @brief Get the handle of the element in the given packed position
+     */
+    HandleType getHandle(size_t position) const;
+
+    bool isEmpty() const;
+
+    size_t getSize() const;
+
+    void reserve(size_t capacity);
+
+    void clear();
+
+    iterator begin();
+    const_iterator begin() const;
+
+    iterator end();
+    const_iterator end() const;
+
+private:
+    struct Slot {
+        // Position of the element in m_values or next free slot
+        uint32 position;
+        uint32 generation;
+    };
+
+    static constexpr uint32 sEndOfList = std::numeric_limits<uint32>::max();
+
+    HandleType allocateSlot();
+
+    const Slot* findSlot(const HandleType& handle) const;
+
+    Vector<T> m_values;
+    Vector<uint32> m_valueSlots;
+    Vector<Slot> m_slots;
+    uint32 m_freeSlot;
+};
+
+}  // namespace engine
+
+#include <Util/Container/SlotMap.inl>
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <limits>
+#include <utility>
+
+namespace engine {
+
+template <typename T, typename Tag>
+SlotMap<T, Tag>::SlotMap() : m_freeSlot(sEndOfList) {}
+
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::HandleType SlotMap<T, Tag>::insert(const T& value) {
+    return emplace(value);
+}
+
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::HandleType SlotMap<T, Tag>::insert(T&& value) {
+    return emplace(std::move(value));
+}
+
+template <typename T, typename Tag>
+template <class... Args>
+typename SlotMap<T, Tag>::HandleType SlotMap<T, Tag>::emplace(Args&&... args) {
+    m_values.emplace_back(std::forward<Args>(args)...);
+    return allocateSlot();
+}
+
+template <typename T, typename Tag>
+bool SlotMap<T, Tag>::erase(const HandleType& handle) {
+    const Slot* slot = findSlot(handle);
+    if (slot == nullptr) {
+        return false;
+    }
+
+    // The handle may be owned by the removed element
+    uint32 index = handle.getIndex();
+
+    // Fill the gap with the last element to keep the values packed
+    uint32 position = slot->position;
+    uint32 lastPosition = static_cast<uint32>(m_values.size() - 1);
+    if (position != lastPosition) {
+        m_values[position] = std::move(m_values[lastPosition]);
+        m_valueSlots[position] = m_valueSlots[lastPosition];
+        m_slots[m_valueSlots[position]].position = position;
+    }
+    m_values.pop_back();
+    m_valueSlots.pop_back();
+
+    // Invalidate the handles that reference the slot, the generation 0
+    // is skipped because it's used by the default handles
+    Slot& freedSlot = m_slots[index];
+    freedSlot.generation = (freedSlot.generation == std::numeric_limits<uint32>::max()) ? 1 : freedSlot.generation + 1;
+    freedSlot.position = m_freeSlot;
+    m_freeSlot = index;
+
+    return true;
+}
+
+template <typename T, typename Tag>
+bool SlotMap<T, Tag>::contains(const HandleType& handle) const {
+    return findSlot(handle) != nullptr;
+}
+
+template <typename T, typename Tag>
+T* SlotMap<T, Tag>::get(const HandleType& handle) {
+    const Slot* slot = findSlot(handle);
+    return (slot != nullptr) ? &m_values[slot->position] : nullptr;
+}
+
+template <typename T, typename Tag>
+const T* SlotMap<T, Tag>::get(const HandleType& handle) const {
+    const Slot* slot = findSlot(handle);
+    return (slot != nullptr) ? &m_values[slot->position] : nullptr;
+}
+
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::HandleType SlotMap<T, Tag>::getHandle(size_t position) const {
+    uint32 index = m_valueSlots[position];
+    return HandleType(index, m_slots[index].generation);
+}
+
+template <typename T, typename Tag>
+bool SlotMap<T, Tag>::isEmpty() const {
+    return m_values.empty();
+}
+
+template <typename T, typename Tag>
+size_t SlotMap<T, Tag>::getSize() const {
+    return m_values.size();
+}
+
+template <typename T, typename Tag>
+void SlotMap<T, Tag>::reserve(size_t capacity) {
+    m_values.reserve(capacity);
+    m_valueSlots.reserve(capacity);
+    m_slots.reserve(capacity);
+}
+
+template <typename T, typename Tag>
+void SlotMap<T, Tag>::clear() {
+    // Release all the slots so the outstanding handles become stale
+    for (size_t i = 0; i < m_values.size(); i++) {
+        uint32 index = m_valueSlots[i];
+        Slot& slot = m_slots[index];
+        slot.generation = (slot.generation == std::numeric_limits<uint32>::max()) ? 1 : slot.generation + 1;
+        slot.position = m_freeSlot;
+        m_freeSlot = index;
+    }
+    m_values.clear();
+    m_valueSlots.clear();
+}
+
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::iterator SlotMap<T, Tag>::begin() {
+    return m_values.begin();
+}
+
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::const_iterator SlotMap<T, Tag>::begin() const {
+    return m_values.begin();
+}
+
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::iterator SlotMap<T, Tag>::end() {
+    return m_values.end();
+}
+
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::const_iterator SlotMap<T, Tag>::end() const {
+    return m_values.end();
+}
+
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::HandleType SlotMap<T, Tag>::allocateSlot() {
+    uint32 position = static_cast<uint32>(m_values.size() - 1);
+
+    uint32 index;
+    if (m_freeSlot != sEndOfList) {
+        index = m_freeSlot;
+        m_freeSlot = m_slots[index].position;
+        m_slots[index].position = position;
+    } else {
+        index = static_cast<uint32>(m_slots.size());
+        m_slots.push_back({position, 1});
+    }
+    m_valueSlots.push_back(index);
+
+    return HandleType(index, m_slots[index].generation);
+}
+
+template <typename T, typename Tag>
+const typename SlotMap<T, Tag>::Slot* SlotMap<T, Tag>::findSlot(const HandleType& handle) const {
+    if (handle.getIndex() >= m_slots.size()) {
+        return nullptr;
+    }
+    const Slot& slot = m_slots[handle.getIndex()];
+    // Free slots may have the same generation but never point to a
+    // value that references them back
+    if (slot.generation != handle.getGeneration() || slot.position >= m_values.size() ||
+        m_valueSlots[slot.position] != handle.getIndex()) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+}  // namespace engine
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+
+namespace engine {
+
+/**
+ * @brief Vector that stores up to N elements inline, without allocating
+ *
+ * @details Meant for the small and short-lived arrays of the engine,
+ *          like the textures of a mesh. It has the same interface of
+ *          Vector, including its functional helpers, and only
+ *          allocates when it grows over N elements.
+ *
+ * @warning Moving a SmallVector that stores its elements inline moves
+ *          each element, so pointers and iterators are invalidated
+ */
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs an inline capacity");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    SmallVector();
+
+    explicit SmallVector(size_type count);
+
+    SmallVector(size_type count, const T& value);
+
+    template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+    SmallVector(InputIt first, InputIt last);
+
+    SmallVector(std::initializer_list<T> values);
+
+    SmallVector(const SmallVector& other);
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    ~SmallVector();
+
+    SmallVector& operator=(const SmallVector& other);
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    SmallVector& operator=(std::initializer_list<T> values);
+
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const;
+
+    reverse_iterator rbegin();
+    const_reverse_iterator rbegin() const;
+
+    reverse_iterator rend();
+    const_reverse_iterator rend() const;
+
+    T& operator[](size_type index);
+    const T& operator[](size_type index) const;
+
+    T& front();
+    const T& front() const;
+
+    T& back();
+    const T& back() const;
+
+    T* data();
+    const T* data() const;
+
+    bool empty() const;
+
+    size_type size() const;
+
+    size_type capacity() const;
+
+    /**
+     * @brief Check if the elements are stored inline, that is, the
+     *        vector never grew over its inline capacity
+     */
+    bool isInline() const;
+
+    void reserve(size_type capacity);
+
+    void resize(size_type count);
+
+    void resize(size_type count, const T& value);
+
+    void clear();
+
+    void push_back(const T& value);
+
+    void push_back(T&& value);
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
+    void pop_back();
+
+    iterator insert(const_iterator position, const T& value);
+
+    iterator insert(const_iterator position, T&& value);
+
+    template <typename... Args>
+    iterator emplace(const_iterator position, Args&&... args);
+
+    iterator erase(const_iterator position);
+
+    iterator erase(const_iterator first, const_iterator last);
+
+    template <typename Func>
+    auto map(Func transform) const -> SmallVector<std::invoke_result_t<decltype(transform), const T&>, N>;
+
+    template <typename Func>
+    auto mapIndexed(Func transform) const
+        -> SmallVector<std::invoke_result_t<decltype(transform), size_t, const T&>, N>;
+
+    template <typename Func>
+    auto filter(Func predicate) const -> SmallVector<T, N>;
+
+    template <typename Func>
+    auto filterIndexed(Func predicate) const -> SmallVector<T, N>;
+
+    template <typename Func>
+    auto find(Func predicate) -> T*;
+
+    template <typename Func>
+    auto find(Func predicate) const -> const T*;
+
+    template <typename Func>
+    auto forEach(Func predicate);
+
+    template <typename Func>
+    auto forEach(Func predicate) const;
+
+    template <typename Func>
+    auto forEachIndexed(Func predicate);
+
+    template <typename Func>
+    auto forEachIndexed(Func predicate) const;
+
+    auto first() -> T&;
+
+    auto first() const -> const T&;
+
+    template <typename Func>
+    auto first(Func predicate) -> T&;
+
+    template <typename Func>
+    auto first(Func predicate) const -> const T&;
+
+    auto firstOrNull() -> T*;
+
+    auto firstOrNull() const -> const T*;
+
+    template <typename Func>
+    auto firstOrNull(Func predicate) -> T*;
+
+    template <typename Func>
+    auto firstOrNull(Func predicate) const -> const T*;
+
+private:
+    T* getInlineData();
+
+    void reallocate(size_type capacity);
+
+    /**
+     * @brief Move the elements to a new heap buffer and release the
+     *        current one
+     */
+    void replaceBuffer(T* data, size_type capacity);
+
+    void deallocate();
+
+    T* m_data;
+    size_type m_size;
+    size_type m_capacity;
+    alignas(T) byte m_storage[N * sizeof(T)];
+};
+
+template <typename T, size_t N>
+bool operator==(const SmallVector<T, N>& left, const SmallVector<T, N>& right);
+
+}  // namespace engine
+
+#include <Util/Container/SmallVector.inl>
@@ -0,0 +1,498 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace engine {
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector() : m_data(getInlineData()), m_size(0), m_capacity(N) {}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(size_type count) : SmallVector() {
+    resize(count);
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(size_type count, const T& value) : SmallVector() {
+    resize(count, value);
+}
+
+template <typename T, size_t N>
+template <typename InputIt, typename>
+SmallVector<T, N>::SmallVector(InputIt first, InputIt last) : SmallVector() {
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<InputIt>::iterator_category>) {
+        reserve(static_cast<size_type>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(std::initializer_list<T> values) : SmallVector(values.begin(), values.end()) {}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector& other) : SmallVector(other.begin(), other.end()) {}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+      : SmallVector() {
+    *this = std::move(other);
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::~SmallVector() {
+    clear();
+    deallocate();
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector& other) {
+    if (this != &other) {
+        clear();
+        reserve(other.m_size);
+        std::uninitialized_copy(other.begin(), other.end(), m_data);
+        m_size = other.m_size;
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(SmallVector&& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+    if (this == &other) {
+        return *this;
+    }
+
+    clear();
+    if (!other.isInline()) {
+        // The heap buffer is taken as is
+        deallocate();
+        m_data = other.m_data;
+        m_capacity = other.m_capacity;
+        m_size = other.m_size;
+        other.m_data = other.getInlineData();
+        other.m_capacity = N;
+        other.m_size = 0;
+    } else {
+        std::uninitialized_move(other.begin(), other.end(), m_data);
+        m_size = other.m_size;
+        other.clear();
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(std::initializer_list<T> values) {
+    clear();
+    reserve(values.size());
+    std::uninitialized_copy(values.begin(), values.end(), m_data);
+    m_size = values.size();
+    return *this;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::begin() {
+    return m_data;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::const_iterator SmallVector<T, N>::begin() const {
+    return m_data;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::const_iterator SmallVector<T, N>::cbegin() const {
+    return m_data;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::end() {
+    return m_data + m_size;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::const_iterator SmallVector<T, N>::end() const {
+    return m_data + m_size;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::const_iterator SmallVector<T, N>::cend() const {
+    return m_data + m_size;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::reverse_iterator SmallVector<T, N>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::const_reverse_iterator SmallVector<T, N>::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::reverse_iterator SmallVector<T, N>::rend() {
+    return reverse_iterator(begin());
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::const_reverse_iterator SmallVector<T, N>::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, size_t N>
+T& SmallVector<T, N>::operator[](size_type index) {
+    return m_data[index];
+}
+
+template <typename T, size_t N>
+const T& SmallVector<T, N>::operator[](size_type index) const {
+    return m_data[index];
+}
+
+template <typename T, size_t N>
+T& SmallVector<T, N>::front() {
+    return m_data[0];
+}
+
+template <typename T, size_t N>
+const T& SmallVector<T, N>::front() const {
+    return m_data[0];
+}
+
+template <typename T, size_t N>
+T& SmallVector<T, N>::back() {
+    return m_data[m_size - 1];
+}
+
+template <typename T, size_t N>
+const T& SmallVector<T, N>::back() const {
+    return m_data[m_size - 1];
+}
+
+template <typename T, size_t N>
+T* SmallVector<T, N>::data() {
+    return m_data;
+}
+
+template <typename T, size_t N>
+const T* SmallVector<T, N>::data() const {
+    return m_data;
+}
+
+template <typename T, size_t N>
+bool SmallVector<T, N>::empty() const {
+    return m_size == 0;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::size_type SmallVector<T, N>::size() const {
+    return m_size;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::size_type SmallVector<T, N>::capacity() const {
+    return m_capacity;
+}
+
+template <typename T, size_t N>
+bool SmallVector<T, N>::isInline() const {
+    return m_data == const_cast<SmallVector*>(this)->getInlineData();
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::reserve(size_type capacity) {
+    if (capacity > m_capacity) {
+        reallocate(capacity);
+    }
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::resize(size_type count) {
+    if (count < m_size) {
+        std::destroy(m_data + count, m_data + m_size);
+    } else {
+        reserve(count);
+        std::uninitialized_value_construct(m_data + m_size, m_data + count);
+    }
+    m_size = count;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::resize(size_type count, const T& value) {
+    if (count < m_size) {
+        std::destroy(m_data + count, m_data + m_size);
+    } else {
+        while (m_size < count) {
+            emplace_back(value);
+        }
+    }
+    m_size = count;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::clear() {
+    std::destroy(m_data, m_data + m_size);
+    m_size = 0;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::push_back(const T& value) {
+    emplace_back(value);
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::push_back(T&& value) {
+    emplace_back(std::move(value));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+T& SmallVector<T, N>::emplace_back(Args&&... args) {
+    if (m_size == m_capacity) {
+        // The new element is constructed before moving the others, the
+        // arguments can reference them
+        size_type capacity = m_capacity * 2;
+        T* data = std::allocator<T>().allocate(capacity);
+        new (data + m_size) T(std::forward<Args>(args)...);
+        replaceBuffer(data, capacity);
+    } else {
+        new (m_data + m_size) T(std::forward<Args>(args)...);
+    }
+    return m_data[m_size++];
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::pop_back() {
+    m_size--;
+    m_data[m_size].~T();
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::insert(const_iterator position, const T& value) {
+    return emplace(position, value);
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::insert(const_iterator position, T&& value) {
+    return emplace(position, std::move(value));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::emplace(const_iterator position, Args&&... args) {
+    size_type index = static_cast<size_type>(position - m_data);
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(m_data + index, m_data + m_size - 1, m_data + m_size);
+    return m_data + index;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::erase(const_iterator position) {
+    return erase(position, position + 1);
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::erase(const_iterator first, const_iterator last) {
+    iterator begin = m_data + (first - m_data);
+    iterator end = m_data + (last - m_data);
+    if (begin != end) {
+        iterator newEnd = std::move(end, this->end(), begin);
+        std::destroy(newEnd, this->end());
+        m_size = static_cast<size_type>(newEnd - m_data);
+    }
+    return begin;
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::map(Func transform) const
+    -> SmallVector<std::invoke_result_t<decltype(transform), const T&>, N> {
+    SmallVector<std::invoke_result_t<decltype(transform), const T&>, N> newVec;
+    newVec.reserve(m_size);
+    for (const auto& element : *this) {
+        newVec.push_back(transform(element));
+    }
+    return newVec;
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::mapIndexed(Func transform) const
+    -> SmallVector<std::invoke_result_t<decltype(transform), size_t, const T&>, N> {
+    SmallVector<std::invoke_result_t<decltype(transform), size_t, const T&>, N> newVec;
+    newVec.reserve(m_size);
+    for (size_type i = 0; i < m_size; i++) {
+        newVec.push_back(transform(i, m_data[i]));
+    }
+    return newVec;
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::filter(Func predicate) const -> SmallVector<T, N> {
+    SmallVector<T, N> newVec;
+    for (const auto& element : *this) {
+        if (predicate(element)) {
+            newVec.push_back(element);
+        }
+    }
+    return newVec;
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::filterIndexed(Func predicate) const -> SmallVector<T, N> {
+    SmallVector<T, N> newVec;
+    for (size_type i = 0; i < m_size; i++) {
+        if (predicate(i, m_data[i])) {
+            newVec.push_back(m_data[i]);
+        }
+    }
+    return newVec;
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::find(Func predicate) -> T* {
+    auto it = std::find_if(begin(), end(), predicate);
+    return (it != end()) ? it : nullptr;
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::find(Func predicate) const -> const T* {
+    return const_cast<SmallVector*>(this)->find(predicate);
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::forEach(Func predicate) {
+    for (auto& element : *this) {
+        predicate(element);
+    }
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::forEach(Func predicate) const {
+    for (const auto& element : *this) {
+        predicate(element);
+    }
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::forEachIndexed(Func predicate) {
+    for (size_type i = 0; i < m_size; i++) {
+        predicate(i, m_data[i]);
+    }
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::forEachIndexed(Func predicate) const {
+    for (size_type i = 0; i < m_size; i++) {
+        predicate(i, static_cast<const T&>(m_data[i]));
+    }
+}
+
+template <typename T, size_t N>
+auto SmallVector<T, N>::first() -> T& {
+    if (m_size > 0) {
+        return m_data[0];
+    }
+    ENGINE_THROW(std::out_of_range("No such element in SmallVector"));
+}
+
+template <typename T, size_t N>
+auto SmallVector<T, N>::first() const -> const T& {
+    return const_cast<SmallVector*>(this)->first();
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::first(Func predicate) -> T& {
+    for (auto& element : *this) {
+        if (predicate(static_cast<const T&>(element))) {
+            return element;
+        }
+    }
+    ENGINE_THROW(std::out_of_range("No such element in SmallVector"));
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::first(Func predicate) const -> const T& {
+    return const_cast<SmallVector*>(this)->first(predicate);
+}
+
+template <typename T, size_t N>
+auto SmallVector<T, N>::firstOrNull() -> T* {
+    return (m_size > 0) ? m_data : nullptr;
+}
+
+template <typename T, size_t N>
+auto SmallVector<T, N>::firstOrNull() const -> const T* {
+    return (m_size > 0) ? m_data : nullptr;
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::firstOrNull(Func predicate) -> T* {
+    for (auto& element : *this) {
+        if (predicate(static_cast<const T&>(element))) {
+            return &element;
+        }
+    }
+    return nullptr;
+}
+
+template <typename T, size_t N>
+template <typename Func>
+auto SmallVector<T, N>::firstOrNull(Func predicate) const -> const T* {
+    return const_cast<SmallVector*>(this)->firstOrNull(predicate);
+}
+
+template <typename T, size_t N>
+T* SmallVector<T, N>::getInlineData() {
+    return std::launder(reinterpret_cast<T*>(m_storage));
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::reallocate(size_type capacity) {
+    replaceBuffer(std::allocator<T>().allocate(capacity), capacity);
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::replaceBuffer(T* data, size_type capacity) {
+    std::uninitialized_move(m_data, m_data + m_size, data);
+    std::destroy(m_data, m_data + m_size);
+    deallocate();
+    m_data = data;
+    m_capacity = capacity;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::deallocate() {
+    if (!isInline()) {
+        std::allocator<T>().deallocate(m_data, m_capacity);
+        m_data = getInlineData();
+        m_capacity = N;
+    }
+}
+
+template <typename T, size_t N>
+bool operator==(const SmallVector<T, N>& left, const SmallVector<T, N>& right) {
+    return std::equal(left.begin(), left.end(), right.begin(), right.end());
+}
+
+}  // namespace engine
@@ -2,6 +2,7 @@
 
 #include <Util/Prerequisites.hpp>
 
+#include <algorithm>
 #include <optional>
 #include <stdexcept>
 
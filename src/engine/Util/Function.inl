@@ -67,13 +67,13 @@ Function<Ret(Args...), MaxSize>::~Function() {
 
 template <typename Ret, typename... Args, size_t MaxSize>
 Function<Ret(Args...), MaxSize>& Function<Ret(Args...), MaxSize>::operator=(const Function& other) {
-    Function(other).Swap(*this);
+    Function(other).swap(*this);
     return *this;
 }
 
 template <typename Ret, typename... Args, size_t MaxSize>
 Function<Ret(Args...), MaxSize>& Function<Ret(Args...), MaxSize>::operator=(Function&& other) noexcept {
-    Function(std::move(other)).Swap(*this);
+    Function(std::move(other)).swap(*this);
     return *this;
 }
 
@@ -90,14 +90,14 @@ Function<Ret(Args...), MaxSize>& Function<Ret(Args...), MaxSize>::operator=(std:
 template <typename Ret, typename... Args, size_t MaxSize>
 template <typename T>
 Function<Ret(Args...), MaxSize>& Function<Ret(Args...), MaxSize>::operator=(T&& other) {
-    Function(std::forward<T>(other)).Swap(*this);
+    Function(std::forward<T>(other)).swap(*this);
     return *this;
 }
 
 template <typename Ret, typename... Args, size_t MaxSize>
 template <typename T>
 Function<Ret(Args...), MaxSize>& Function<Ret(Args...), MaxSize>::operator=(std::reference_wrapper<T> other) {
-    Function(other).Swap(*this);
+    Function(other).swap(*this);
     return *this;
 }
 
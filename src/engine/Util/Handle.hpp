@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <functional>
+
+namespace engine {
+
+/**
+ * @brief Generational reference to an element stored in a SlotMap
+ *
+ * @details A handle is composed by the index of the slot and the
+ *          generation the slot had when the element was inserted.
+ *          When the element is removed the generation of the slot is
+ *          increased, so the old handles are detected as stale instead
+ *          of pointing to a different element.
+ */
+template <typename T>
+class Handle {
+public:
+    Handle() : m_index(0), m_generation(0) {}
+
+    Handle(uint32 index, uint32 generation) : m_index(index), m_generation(generation) {}
+
+    /**
+     * @brief Check if the handle was ever assigned to an element
+     *
+     * @warning A valid handle can still be stale, use the SlotMap that
+     *          created it to check if the element still exists
+     */
+    bool isValid() const {
+        return m_generation != 0;
+    }
+
+    uint32 getIndex() const {
+        return m_index;
+    }
+
+    uint32 getGeneration() const {
+        return m_generation;
+    }
+
+    bool operator==(const Handle& other) const {
+        return m_index == other.m_index && m_generation == other.m_generation;
+    }
+
+    bool operator!=(const Handle& other) const {
+        return !(*this == other);
+    }
+
+    bool operator<(const Handle& other) const {
+        return (m_index != other.m_index) ? m_index < other.m_index : m_generation < other.m_generation;
+    }
+
+private:
+    uint32 m_index;
+    uint32 m_generation;
+};
+
+}  // namespace engine
+
+namespace std {
+
+template <typename T>
+struct hash<engine::Handle<T>> {
+    size_t operator()(const engine::Handle<T>& handle) const {
+        return hash<engine::uint64>()((static_cast<engine::uint64>(handle.getGeneration()) << 32) |
+                                      handle.getIndex());
+    }
+};
+
+}  // namespace std
@@ -0,0 +1,102 @@
+#include <Util/Hash.hpp>
+
+#include <cstring>
+
+namespace engine {
+
+namespace {
+
+const uint64 sPrime1(0x9E3779B185EBCA87ULL);
+const uint64 sPrime2(0xC2B2AE3D27D4EB4FULL);
+const uint64 sPrime3(0x165667B19E3779F9ULL);
+const uint64 sPrime4(0x85EBCA77C2B2AE63ULL);
+const uint64 sPrime5(0x27D4EB2F165667C5ULL);
+
+inline uint64 RotateLeft(uint64 value, uint32 bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64 Read64(const byte* data) {
+    uint64 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint32 Read32(const byte* data) {
+    uint32 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint64 Round(uint64 accumulator, uint64 input) {
+    accumulator += input * sPrime2;
+    accumulator = RotateLeft(accumulator, 31);
+    return accumulator * sPrime1;
+}
+
+inline uint64 MergeRound(uint64 accumulator, uint64 value) {
+    accumulator ^= Round(0, value);
+    return accumulator * sPrime1 + sPrime4;
+}
+
+}  // namespace
+
+uint64 Hash64(const void* data, size_t size, uint64 seed) {
+    const byte* it = static_cast<const byte*>(data);
+    const byte* end = it + size;
+
+    uint64 hash;
+    if (size >= 32) {
+        // Process stripes of 32 bytes in four independent lanes
+        uint64 v1 = seed + sPrime1 + sPrime2;
+        uint64 v2 = seed + sPrime2;
+        uint64 v3 = seed;
+        uint64 v4 = seed - sPrime1;
+        const byte* limit = end - 32;
+        do {
+            v1 = Round(v1, Read64(it));
+            v2 = Round(v2, Read64(it + 8));
+            v3 = Round(v3, Read64(it + 16));
+            v4 = Round(v4, Read64(it + 24));
+            it += 32;
+        } while (it <= limit);
+
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    } else {
+        hash = seed + sPrime5;
+    }
+
+    hash += static_cast<uint64>(size);
+
+    // Consume the remaining bytes
+    while (it + 8 <= end) {
+        hash ^= Round(0, Read64(it));
+        hash = RotateLeft(hash, 27) * sPrime1 + sPrime4;
+        it += 8;
+    }
+    if (it + 4 <= end) {
+        hash ^= static_cast<uint64>(Read32(it)) * sPrime1;
+        hash = RotateLeft(hash, 23) * sPrime2 + sPrime3;
+        it += 4;
+    }
+    while (it < end) {
+        hash ^= static_cast<uint64>(*it) * sPrime5;
+        hash = RotateLeft(hash, 11) * sPrime1;
+        it++;
+    }
+
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= sPrime2;
+    hash ^= hash >> 29;
+    hash *= sPrime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+}  // namespace engine
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+namespace engine {
+
+/**
+ * @brief Compute a 64 bits hash of a block of memory
+ *
+ * @details Uses the XXH64 algorithm, it is not suitable for
+ *          cryptographic use but it is fast enough to hash the content
+ *          of images and meshes while they are being loaded
+ *
+ * @param data Pointer to the data to hash
+ * @param size Size in bytes of the data
+ * @param seed Value used to initialize the hash, can be used to
+ *             combine several hashes
+ *
+ * @return The hash of the data
+ */
+ENGINE_API uint64 Hash64(const void* data, size_t size, uint64 seed = 0);
+
+/**
+ * @brief Compute a 64 bits hash of a string
+ *
+ * @details Uses the FNV-1a algorithm, it is slower than Hash64 for
+ *          large blocks of memory but it can be evaluated at compile
+ *          time, so the hashes of the string literals are constants
+ *
+ * @param data Pointer to the characters to hash
+ * @param size Number of characters to hash
+ *
+ * @return The hash of the string
+ */
+constexpr uint64 HashString64(const char* data, size_t size) {
+    uint64 hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<uint64>(static_cast<uint8>(data[i]));
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+}  // namespace engine
@@ -0,0 +1,201 @@
+#include <Util/LZ4.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include <cstring>
+
+namespace engine {
+
+namespace lz4 {
+
+namespace {
+
+const size_t sMinMatch(4);
+
+// The last match must start at least 12 bytes before the end of the
+// block and the last 5 bytes are always literals
+const size_t sMatchFindLimit(12);
+const size_t sLastLiterals(5);
+
+const size_t sMaxOffset(65535);
+
+const uint32 sHashLog(12);
+
+uint32 Read32(const byte* data) {
+    uint32 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint32 HashSequence(uint32 sequence) {
+    return (sequence * 2654435761U) >> (32 - sHashLog);
+}
+
+byte* WriteLength(byte* output, size_t length) {
+    while (length >= 255) {
+        *output++ = 255;
+        length -= 255;
+    }
+    *output++ = static_cast<byte>(length);
+    return output;
+}
+
+bool ReadLength(const byte* source, size_t sourceSize, size_t* position, size_t* length) {
+    byte value;
+    do {
+        if (*position >= sourceSize) {
+            return false;
+        }
+        value = source[(*position)++];
+        *length += value;
+    } while (value == 255);
+    return true;
+}
+
+}  // namespace
+
+size_t GetCompressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t Compress(const byte* source, size_t sourceSize, byte* destination, size_t destinationCapacity) {
+    // Positions of the last sequences with each hash, offset by one so
+    // zero means empty
+    std::array<uint32, 1 << sHashLog> table = {};
+
+    byte* output = destination;
+    byte* outputEnd = destination + destinationCapacity;
+    size_t anchor = 0;
+    size_t position = 0;
+
+    while (position + sMatchFindLimit <= sourceSize) {
+        uint32 sequence = Read32(source + position);
+        uint32 hash = HashSequence(sequence);
+        size_t reference = table[hash];
+        table[hash] = static_cast<uint32>(position + 1);
+
+        if (reference == 0 || position + 1 - reference > sMaxOffset || Read32(source + reference - 1) != sequence) {
+            position++;
+            continue;
+        }
+        reference--;
+
+        // Extend the match forwards and backwards
+        size_t matchEnd = position + sMinMatch;
+        while (matchEnd < sourceSize - sLastLiterals && source[matchEnd] == source[reference + matchEnd - position]) {
+            matchEnd++;
+        }
+        while (position > anchor && reference > 0 && source[position - 1] == source[reference - 1]) {
+            position--;
+            reference--;
+        }
+
+        size_t literalLength = position - anchor;
+        size_t matchLength = matchEnd - position - sMinMatch;
+        size_t sequenceSize = 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1;
+        if (sequenceSize > static_cast<size_t>(outputEnd - output)) {
+            return 0;
+        }
+
+        byte* token = output++;
+        *token = static_cast<byte>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchLength, 15));
+        if (literalLength >= 15) {
+            output = WriteLength(output, literalLength - 15);
+        }
+        if (literalLength > 0) {
+            std::memcpy(output, source + anchor, literalLength);
+        }
+        output += literalLength;
+
+        size_t offset = position - reference;
+        *output++ = static_cast<byte>(offset & 0xFF);
+        *output++ = static_cast<byte>(offset >> 8);
+        if (matchLength >= 15) {
+            output = WriteLength(output, matchLength - 15);
+        }
+
+        position = matchEnd;
+        anchor = position;
+    }
+
+    // The remaining bytes are stored as literals in the last sequence
+    size_t literalLength = sourceSize - anchor;
+    size_t sequenceSize = 1 + literalLength / 255 + 1 + literalLength;
+    if (sequenceSize > static_cast<size_t>(outputEnd - output)) {
+        return 0;
+    }
+    byte* token = output++;
+    *token = static_cast<byte>(std::min<size_t>(literalLength, 15) << 4);
+    if (literalLength >= 15) {
+        output = WriteLength(output, literalLength - 15);
+    }
+    if (literalLength > 0) {
+        std::memcpy(output, source + anchor, literalLength);
+    }
+    output += literalLength;
+
+    return static_cast<size_t>(output - destination);
+}
+
+bool Decompress(const byte* source, size_t sourceSize, byte* destination, size_t destinationSize) {
+    size_t input = 0;
+    size_t output = 0;
+
+    while (input < sourceSize) {
+        byte token = source[input++];
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(source, sourceSize, &input, &literalLength)) {
+            return false;
+        }
+        if (literalLength > sourceSize - input || literalLength > destinationSize - output) {
+            return false;
+        }
+        if (literalLength > 0) {
+            std::memcpy(destination + output, source + input, literalLength);
+        }
+        input += literalLength;
+        output += literalLength;
+
+        // The last sequence only contains literals
+        if (input == sourceSize) {
+            return output == destinationSize;
+        }
+
+        if (sourceSize - input < 2) {
+            return false;
+        }
+        size_t offset = source[input] | (static_cast<size_t>(source[input + 1]) << 8);
+        input += 2;
+        if (offset == 0 || offset > output) {
+            return false;
+        }
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(source, sourceSize, &input, &matchLength)) {
+            return false;
+        }
+        matchLength += sMinMatch;
+        if (matchLength > destinationSize - output) {
+            return false;
+        }
+
+        // The match can overlap with the bytes being written
+        byte* match = destination + output - offset;
+        if (offset >= matchLength) {
+            std::memcpy(destination + output, match, matchLength);
+        } else {
+            for (size_t i = 0; i < matchLength; i++) {
+                destination[output + i] = match[i];
+            }
+        }
+        output += matchLength;
+    }
+
+    return false;
+}
+
+}  // namespace lz4
+
+}  // namespace engine
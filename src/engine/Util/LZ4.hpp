@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+namespace engine {
+
+namespace lz4 {
+
+/**
+ * @brief Get the maximum size of the compressed data
+ *
+ * @param size The size in bytes of the data to compress
+ * @return The size that the destination buffer of Compress needs to
+ *         hold the worst case output
+ */
+ENGINE_API size_t GetCompressBound(size_t size);
+
+/**
+ * @brief Compress a block of memory using the LZ4 block format
+ *
+ * @details The output is compatible with LZ4_decompress_safe, it uses a
+ *          single pass greedy matcher so it favors speed over ratio
+ *
+ * @param source The data to compress
+ * @param sourceSize Size in bytes of the data to compress
+ * @param destination Buffer that receives the compressed data
+ * @param destinationCapacity Size in bytes of the destination buffer
+ *
+ * @return The size of the compressed data, or 0 if it doesn't fit in
+ *         the destination buffer
+ */
+ENGINE_API size_t Compress(const byte* source, size_t sourceSize, byte* destination, size_t destinationCapacity);
+
+/**
+ * @brief Decompress a block of memory compressed with the LZ4 block
+ *        format
+ *
+ * @details The input is validated, malformed data never reads or
+ *          writes outside of the buffers
+ *
+ * @param source The compressed data
+ * @param sourceSize Size in bytes of the compressed data
+ * @param destination Buffer that receives the decompressed data
+ * @param destinationSize Size in bytes of the decompressed data
+ *
+ * @return true if the data was decompressed and its size matches
+ *         destinationSize, false otherwise
+ */
+ENGINE_API bool Decompress(const byte* source, size_t sourceSize, byte* destination, size_t destinationSize);
+
+}  // namespace lz4
+
+}  // namespace engine
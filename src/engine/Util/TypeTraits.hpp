@@ -47,6 +47,26 @@ inline constexpr bool alignment_of_v = alignment_of<T>::value;  // NOLINT
 template <typename T>
 inline constexpr bool size_of_v = size_of<T>::value;  // NOLINT
 
+template <typename T, typename = void>
+struct is_contiguous_string : std::false_type {};
+
+template <typename T>
+struct is_contiguous_string<T, std::void_t<decltype(std::declval<const T&>().getData()),
+                                           decltype(std::declval<const T&>().getDataSize())>>
+      : std::is_convertible<decltype(std::declval<const T&>().getData()), const char*> {};
+
+template <typename T>
+inline constexpr bool is_contiguous_string_v = is_contiguous_string<T>::value;  // NOLINT
+
+template <typename T, typename = void>
+struct is_transparent : std::false_type {};
+
+template <typename T>
+struct is_transparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_transparent_v = is_transparent<T>::value;  // NOLINT
+
 }  // namespace type
 
 }  // namespace engine
@@ -0,0 +1,954 @@
+#include <Util/UTF.hpp>
+
+#include <atomic>
+#include <string>
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define UTF_ARCH_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define UTF_ARCH_ARM64
+    #include <arm_neon.h>
+#endif
+
+// The x86 kernels are compiled for their own instruction set and only
+// called after checking the CPU at runtime
+#if defined(UTF_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define UTF_TARGET_SSE4 __attribute__((target("sse4.1")))
+    #define UTF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define UTF_TARGET_SSE4
+    #define UTF_TARGET_AVX2
+#endif
+
+namespace engine::utf {
+
+namespace {
+
+struct Kernels {
+    InstructionSet instructionSet;
+    // Number of ASCII bytes at the start of the data
+    size_t (*countAscii)(const uint8* data, size_t size);
+    bool (*validate)(const uint8* data, size_t size);
+    // Convert the ASCII characters at the start of the data, they
+    // return the number of characters converted
+    size_t (*widenAscii16)(const uint8* data, size_t size, char16* output);
+    size_t (*widenAscii32)(const uint8* data, size_t size, char32* output);
+    size_t (*narrowAscii16)(const char16* data, size_t size, char* output);
+    size_t (*narrowAscii32)(const char32* data, size_t size, char* output);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Scalar kernels
+////////////////////////////////////////////////////////////////////////////////
+
+inline bool IsContinuation(uint8 value) {
+    return (value & 0xC0) == 0x80;
+}
+
+// Decode a code point and return its length, 0 if it's not valid
+inline size_t DecodeUtf8(const uint8* it, const uint8* end, char32* codePoint) {
+    uint8 lead = it[0];
+    size_t remaining = static_cast<size_t>(end - it);
+
+    if (lead < 0x80) {
+        *codePoint = lead;
+        return 1;
+    }
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        if (remaining < 2 || !IsContinuation(it[1])) {
+            return 0;
+        }
+        *codePoint = (char32(lead & 0x1F) << 6) | char32(it[1] & 0x3F);
+        return 2;
+    }
+    if (lead >= 0xE0 && lead <= 0xEF) {
+        if (remaining < 3 || !IsContinuation(it[1]) || !IsContinuation(it[2])) {
+            return 0;
+        }
+        char32 value = (char32(lead & 0x0F) << 12) | (char32(it[1] & 0x3F) << 6) | char32(it[2] & 0x3F);
+        // Overlong encodings and surrogates
+        if (value < 0x800 || (value >= 0xD800 && value <= 0xDFFF)) {
+            return 0;
+        }
+        *codePoint = value;
+        return 3;
+    }
+    if (lead >= 0xF0 && lead <= 0xF4) {
+        if (remaining < 4 || !IsContinuation(it[1]) || !IsContinuation(it[2]) || !IsContinuation(it[3])) {
+            return 0;
+        }
+        char32 value = (char32(lead & 0x07) << 18) | (char32(it[1] & 0x3F) << 12) | (char32(it[2] & 0x3F) << 6) |
+                       char32(it[3] & 0x3F);
+        if (value < 0x10000 || value > 0x10FFFF) {
+            return 0;
+        }
+        *codePoint = value;
+        return 4;
+    }
+    return 0;
+}
+
+inline size_t DecodeUtf16(const char16* it, const char16* end, char32* codePoint) {
+    char16 first = it[0];
+    if (first < 0xD800 || first > 0xDFFF) {
+        *codePoint = first;
+        return 1;
+    }
+    if (first <= 0xDBFF && (end - it) >= 2 && it[1] >= 0xDC00 && it[1] <= 0xDFFF) {
+        *codePoint = ((char32(first & 0x3FF) << 10) | char32(it[1] & 0x3FF)) + 0x10000;
+        return 2;
+    }
+    return 0;
+}
+
+inline char* EncodeUtf8(char32 codePoint, char* output) {
+    if (codePoint < 0x80) {
+        *output++ = static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        *output++ = static_cast<char>(0xC0 | (codePoint >> 6));
+        *output++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        *output++ = static_cast<char>(0xE0 | (codePoint >> 12));
+        *output++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        *output++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        *output++ = static_cast<char>(0xF0 | (codePoint >> 18));
+        *output++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        *output++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        *output++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    return output;
+}
+
+inline char16* EncodeUtf16(char32 codePoint, char16* output) {
+    if (codePoint < 0x10000) {
+        *output++ = static_cast<char16>(codePoint);
+    } else {
+        codePoint -= 0x10000;
+        *output++ = static_cast<char16>(0xD800 | (codePoint >> 10));
+        *output++ = static_cast<char16>(0xDC00 | (codePoint & 0x3FF));
+    }
+    return output;
+}
+
+size_t CountAsciiScalar(const uint8* data, size_t size) {
+    size_t i = 0;
+    // Check 8 bytes at a time
+    for (; i + 8 <= size; i += 8) {
+        uint64 word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if ((word & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+    while (i < size && data[i] < 0x80) {
+        i++;
+    }
+    return i;
+}
+
+bool ValidateScalar(const uint8* data, size_t size) {
+    const uint8* it = data;
+    const uint8* end = data + size;
+    while (it < end) {
+        it += CountAsciiScalar(it, static_cast<size_t>(end - it));
+        if (it == end) {
+            break;
+        }
+        char32 codePoint;
+        size_t length = DecodeUtf8(it, end, &codePoint);
+        if (length == 0) {
+            return false;
+        }
+        it += length;
+    }
+    return true;
+}
+
+template <typename Char>
+size_t WidenAsciiScalar(const uint8* data, size_t size, Char* output) {
+    size_t i = 0;
+    while (i < size && data[i] < 0x80) {
+        output[i] = data[i];
+        i++;
+    }
+    return i;
+}
+
+template <typename Char>
+size_t NarrowAsciiScalar(const Char* data, size_t size, char* output) {
+    size_t i = 0;
+    while (i < size && data[i] < 0x80) {
+        output[i] = static_cast<char>(data[i]);
+        i++;
+    }
+    return i;
+}
+
+const Kernels sScalarKernels = {
+    InstructionSet::SCALAR,     &CountAsciiScalar,           &ValidateScalar,
+    &WidenAsciiScalar<char16>,  &WidenAsciiScalar<char32>,   &NarrowAsciiScalar<char16>,
+    &NarrowAsciiScalar<char32>,
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Vectorized UTF-8 validation
+////////////////////////////////////////////////////////////////////////////////
+
+// Errors found looking at the high and low nibbles of each byte and the
+// high nibble of the next one. Every invalid two bytes sequence sets the
+// same bit in the three tables. Based on "Validating UTF-8 In Less Than
+// One Instruction Per Byte" by John Keiser and Daniel Lemire.
+constexpr uint8 sTooShort = 1 << 0;
+constexpr uint8 sTooLong = 1 << 1;
+constexpr uint8 sOverlong3 = 1 << 2;
+constexpr uint8 sTooLarge = 1 << 3;
+constexpr uint8 sSurrogate = 1 << 4;
+constexpr uint8 sOverlong2 = 1 << 5;
+constexpr uint8 sTooLarge1000 = 1 << 6;
+constexpr uint8 sOverlong4 = 1 << 6;
+constexpr uint8 sTwoContinuations = 1 << 7;
+constexpr uint8 sCarry = sTooShort | sTooLong | sTwoContinuations;
+
+[[maybe_unused]] alignas(16) const uint8 sByte1HighTable[16] = {
+    // 0_______ ________ <ASCII in byte 1>
+    sTooLong, sTooLong, sTooLong, sTooLong, sTooLong, sTooLong, sTooLong, sTooLong,
+    // 10______ ________ <continuation in byte 1>
+    sTwoContinuations, sTwoContinuations, sTwoContinuations, sTwoContinuations,
+    // 1100____ ________ <two byte lead in byte 1>
+    sTooShort | sOverlong2,
+    // 1101____ ________ <two byte lead in byte 1>
+    sTooShort,
+    // 1110____ ________ <three byte lead in byte 1>
+    sTooShort | sOverlong3 | sSurrogate,
+    // 1111____ ________ <four+ byte lead in byte 1>
+    sTooShort | sTooLarge | sTooLarge1000 | sOverlong4,
+};
+
+[[maybe_unused]] alignas(16) const uint8 sByte1LowTable[16] = {
+    // ____0000 ________
+    sCarry | sOverlong3 | sOverlong2 | sOverlong4,
+    // ____0001 ________
+    sCarry | sOverlong2,
+    // ____001_ ________
+    sCarry,
+    sCarry,
+    // ____0100 ________
+    sCarry | sTooLarge,
+    // ____0101 ________
+    sCarry | sTooLarge | sTooLarge1000,
+    // ____011_ ________
+    sCarry | sTooLarge | sTooLarge1000,
+    sCarry | sTooLarge | sTooLarge1000,
+    // ____1___ ________
+    sCarry | sTooLarge | sTooLarge1000,
+    sCarry | sTooLarge | sTooLarge1000,
+    sCarry | sTooLarge | sTooLarge1000,
+    sCarry | sTooLarge | sTooLarge1000,
+    sCarry | sTooLarge | sTooLarge1000,
+    // ____1101 ________
+    sCarry | sTooLarge | sTooLarge1000 | sSurrogate,
+    sCarry | sTooLarge | sTooLarge1000,
+    sCarry | sTooLarge | sTooLarge1000,
+};
+
+[[maybe_unused]] alignas(16) const uint8 sByte2HighTable[16] = {
+    // ________ 0_______ <ASCII in byte 2>
+    sTooShort, sTooShort, sTooShort, sTooShort, sTooShort, sTooShort, sTooShort, sTooShort,
+    // ________ 1000____
+    sTooLong | sOverlong2 | sTwoContinuations | sOverlong3 | sTooLarge1000 | sOverlong4,
+    // ________ 1001____
+    sTooLong | sOverlong2 | sTwoContinuations | sOverlong3 | sTooLarge,
+    // ________ 101_____
+    sTooLong | sOverlong2 | sTwoContinuations | sSurrogate | sTooLarge,
+    sTooLong | sOverlong2 | sTwoContinuations | sSurrogate | sTooLarge,
+    // ________ 11______
+    sTooShort, sTooShort, sTooShort, sTooShort,
+};
+
+// Maximum values of the last three bytes of a block that don't start a
+// sequence that continues in the next block
+[[maybe_unused]] alignas(32) const uint8 sIncompleteMax[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+};
+
+#if defined(UTF_ARCH_X86)
+
+inline uint32 CountTrailingZeros(uint32 value) {
+    #if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<uint32>(index);
+    #else
+    return static_cast<uint32>(__builtin_ctz(value));
+    #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SSE4.1 kernels
+////////////////////////////////////////////////////////////////////////////////
+
+UTF_TARGET_SSE4 size_t CountAsciiSse4(const uint8* data, size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        int mask = _mm_movemask_epi8(chunk);
+        if (mask != 0) {
+            return i + CountTrailingZeros(static_cast<uint32>(mask));
+        }
+    }
+    return i + CountAsciiScalar(data + i, size - i);
+}
+
+UTF_TARGET_SSE4 inline __m128i CheckBlockSse4(__m128i input, __m128i previous) {
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i byte1HighTable = _mm_load_si128(reinterpret_cast<const __m128i*>(sByte1HighTable));
+    const __m128i byte1LowTable = _mm_load_si128(reinterpret_cast<const __m128i*>(sByte1LowTable));
+    const __m128i byte2HighTable = _mm_load_si128(reinterpret_cast<const __m128i*>(sByte2HighTable));
+
+    __m128i previous1 = _mm_alignr_epi8(input, previous, 15);
+    __m128i byte1High = _mm_shuffle_epi8(byte1HighTable, _mm_and_si128(_mm_srli_epi16(previous1, 4), nibbleMask));
+    __m128i byte1Low = _mm_shuffle_epi8(byte1LowTable, _mm_and_si128(previous1, nibbleMask));
+    __m128i byte2High = _mm_shuffle_epi8(byte2HighTable, _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask));
+    __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+    // The third and fourth bytes of the sequences must be continuations
+    __m128i previous2 = _mm_alignr_epi8(input, previous, 14);
+    __m128i previous3 = _mm_alignr_epi8(input, previous, 13);
+    __m128i isThirdByte = _mm_subs_epu8(previous2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m128i isFourthByte = _mm_subs_epu8(previous3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m128i mustBeContinuation =
+          _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte), _mm_set1_epi8(static_cast<char>(0x80)));
+    return _mm_xor_si128(mustBeContinuation, special);
+}
+
+UTF_TARGET_SSE4 bool ValidateSse4(const uint8* data, size_t size) {
+    const __m128i incompleteMax = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sIncompleteMax + 16));
+
+    __m128i error = _mm_setzero_si128();
+    __m128i previous = _mm_setzero_si128();
+    __m128i previousIncomplete = _mm_setzero_si128();
+    for (size_t i = 0; i < size; i += 16) {
+        __m128i input;
+        if (i + 16 <= size) {
+            input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        } else {
+            // Pad the last block with ASCII
+            alignas(16) uint8 buffer[16] = {};
+            std::memcpy(buffer, data + i, size - i);
+            input = _mm_load_si128(reinterpret_cast<const __m128i*>(buffer));
+        }
+
+        if (_mm_movemask_epi8(input) == 0) {
+            // ASCII blocks are only invalid after an unfinished sequence
+            error = _mm_or_si128(error, previousIncomplete);
+            previousIncomplete = _mm_setzero_si128();
+        } else {
+            error = _mm_or_si128(error, CheckBlockSse4(input, previous));
+            previousIncomplete = _mm_subs_epu8(input, incompleteMax);
+        }
+        previous = input;
+    }
+    error = _mm_or_si128(error, previousIncomplete);
+    return _mm_testz_si128(error, error) != 0;
+}
+
+UTF_TARGET_SSE4 size_t WidenAscii16Sse4(const uint8* data, size_t size, char16* output) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_cvtepu8_epi16(chunk));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 8), _mm_cvtepu8_epi16(_mm_srli_si128(chunk, 8)));
+    }
+    return i + WidenAsciiScalar(data + i, size - i, output + i);
+}
+
+UTF_TARGET_SSE4 size_t WidenAscii32Sse4(const uint8* data, size_t size, char32* output) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            break;
+        }
+        auto* destination = reinterpret_cast<__m128i*>(output + i);
+        _mm_storeu_si128(destination, _mm_cvtepu8_epi32(chunk));
+        _mm_storeu_si128(destination + 1, _mm_cvtepu8_epi32(_mm_srli_si128(chunk, 4)));
+        _mm_storeu_si128(destination + 2, _mm_cvtepu8_epi32(_mm_srli_si128(chunk, 8)));
+        _mm_storeu_si128(destination + 3, _mm_cvtepu8_epi32(_mm_srli_si128(chunk, 12)));
+    }
+    return i + WidenAsciiScalar(data + i, size - i, output + i);
+}
+
+UTF_TARGET_SSE4 size_t NarrowAscii16Sse4(const char16* data, size_t size, char* output) {
+    const __m128i nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const auto* source = reinterpret_cast<const __m128i*>(data + i);
+        __m128i first = _mm_loadu_si128(source);
+        __m128i second = _mm_loadu_si128(source + 1);
+        if (_mm_testz_si128(_mm_or_si128(first, second), nonAscii) == 0) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packus_epi16(first, second));
+    }
+    return i + NarrowAsciiScalar(data + i, size - i, output + i);
+}
+
+UTF_TARGET_SSE4 size_t NarrowAscii32Sse4(const char32* data, size_t size, char* output) {
+    const __m128i nonAscii = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const auto* source = reinterpret_cast<const __m128i*>(data + i);
+        __m128i first = _mm_loadu_si128(source);
+        __m128i second = _mm_loadu_si128(source + 1);
+        __m128i third = _mm_loadu_si128(source + 2);
+        __m128i fourth = _mm_loadu_si128(source + 3);
+        __m128i all = _mm_or_si128(_mm_or_si128(first, second), _mm_or_si128(third, fourth));
+        if (_mm_testz_si128(all, nonAscii) == 0) {
+            break;
+        }
+        __m128i packed = _mm_packus_epi16(_mm_packus_epi32(first, second), _mm_packus_epi32(third, fourth));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed);
+    }
+    return i + NarrowAsciiScalar(data + i, size - i, output + i);
+}
+
+const Kernels sSse4Kernels = {
+    InstructionSet::SSE4, &CountAsciiSse4,    &ValidateSse4,      &WidenAscii16Sse4,
+    &WidenAscii32Sse4,    &NarrowAscii16Sse4, &NarrowAscii32Sse4,
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+////////////////////////////////////////////////////////////////////////////////
+
+UTF_TARGET_AVX2 size_t CountAsciiAvx2(const uint8* data, size_t size) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        int mask = _mm256_movemask_epi8(chunk);
+        if (mask != 0) {
+            return i + CountTrailingZeros(static_cast<uint32>(mask));
+        }
+    }
+    return i + CountAsciiScalar(data + i, size - i);
+}
+
+// Get the input shifted N bytes with the end of the previous block
+template <int N>
+UTF_TARGET_AVX2 inline __m256i PreviousAvx2(__m256i input, __m256i previous) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+}
+
+UTF_TARGET_AVX2 inline __m256i LoadTableAvx2(const uint8* table) {
+    return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table)));
+}
+
+UTF_TARGET_AVX2 inline __m256i CheckBlockAvx2(__m256i input, __m256i previous) {
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+    const __m256i byte1HighTable = LoadTableAvx2(sByte1HighTable);
+    const __m256i byte1LowTable = LoadTableAvx2(sByte1LowTable);
+    const __m256i byte2HighTable = LoadTableAvx2(sByte2HighTable);
+
+    __m256i previous1 = PreviousAvx2<1>(input, previous);
+    __m256i byte1High =
+          _mm256_shuffle_epi8(byte1HighTable, _mm256_and_si256(_mm256_srli_epi16(previous1, 4), nibbleMask));
+    __m256i byte1Low = _mm256_shuffle_epi8(byte1LowTable, _mm256_and_si256(previous1, nibbleMask));
+    __m256i byte2High =
+          _mm256_shuffle_epi8(byte2HighTable, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+    __m256i previous2 = PreviousAvx2<2>(input, previous);
+    __m256i previous3 = PreviousAvx2<3>(input, previous);
+    __m256i isThirdByte = _mm256_subs_epu8(previous2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m256i isFourthByte = _mm256_subs_epu8(previous3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m256i mustBeContinuation =
+          _mm256_and_si256(_mm256_or_si256(isThirdByte, isFourthByte), _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(mustBeContinuation, special);
+}
+
+UTF_TARGET_AVX2 bool ValidateAvx2(const uint8* data, size_t size) {
+    const __m256i incompleteMax = _mm256_load_si256(reinterpret_cast<const __m256i*>(sIncompleteMax));
+
+    __m256i error = _mm256_setzero_si256();
+    __m256i previous = _mm256_setzero_si256();
+    __m256i previousIncomplete = _mm256_setzero_si256();
+    for (size_t i = 0; i < size; i += 32) {
+        __m256i input;
+        if (i + 32 <= size) {
+            input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        } else {
+            // Pad the last block with ASCII
+            alignas(32) uint8 buffer[32] = {};
+            std::memcpy(buffer, data + i, size - i);
+            input = _mm256_load_si256(reinterpret_cast<const __m256i*>(buffer));
+        }
+
+        if (_mm256_movemask_epi8(input) == 0) {
+            // ASCII blocks are only invalid after an unfinished sequence
+            error = _mm256_or_si256(error, previousIncomplete);
+            previousIncomplete = _mm256_setzero_si256();
+        } else {
+            error = _mm256_or_si256(error, CheckBlockAvx2(input, previous));
+            previousIncomplete = _mm256_subs_epu8(input, incompleteMax);
+        }
+        previous = input;
+    }
+    error = _mm256_or_si256(error, previousIncomplete);
+    return _mm256_testz_si256(error, error) != 0;
+}
+
+UTF_TARGET_AVX2 size_t WidenAscii16Avx2(const uint8* data, size_t size, char16* output) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        if (_mm256_movemask_epi8(chunk) != 0) {
+            break;
+        }
+        auto* destination = reinterpret_cast<__m256i*>(output + i);
+        _mm256_storeu_si256(destination, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(chunk)));
+        _mm256_storeu_si256(destination + 1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(chunk, 1)));
+    }
+    return i + WidenAsciiScalar(data + i, size - i, output + i);
+}
+
+UTF_TARGET_AVX2 size_t WidenAscii32Avx2(const uint8* data, size_t size, char32* output) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        if (_mm256_movemask_epi8(chunk) != 0) {
+            break;
+        }
+        __m128i low = _mm256_castsi256_si128(chunk);
+        __m128i high = _mm256_extracti128_si256(chunk, 1);
+        auto* destination = reinterpret_cast<__m256i*>(output + i);
+        _mm256_storeu_si256(destination, _mm256_cvtepu8_epi32(low));
+        _mm256_storeu_si256(destination + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+        _mm256_storeu_si256(destination + 2, _mm256_cvtepu8_epi32(high));
+        _mm256_storeu_si256(destination + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+    }
+    return i + WidenAsciiScalar(data + i, size - i, output + i);
+}
+
+UTF_TARGET_AVX2 size_t NarrowAscii16Avx2(const char16* data, size_t size, char* output) {
+    const __m256i nonAscii = _mm256_set1_epi16(static_cast<short>(0xFF80));
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const auto* source = reinterpret_cast<const __m256i*>(data + i);
+        __m256i first = _mm256_loadu_si256(source);
+        __m256i second = _mm256_loadu_si256(source + 1);
+        if (_mm256_testz_si256(_mm256_or_si256(first, second), nonAscii) == 0) {
+            break;
+        }
+        // The packs work on each 128 bits lane, restore the order
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), packed);
+    }
+    return i + NarrowAsciiScalar(data + i, size - i, output + i);
+}
+
+UTF_TARGET_AVX2 size_t NarrowAscii32Avx2(const char32* data, size_t size, char* output) {
+    const __m256i nonAscii = _mm256_set1_epi32(static_cast<int>(0xFFFFFF80));
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const auto* source = reinterpret_cast<const __m256i*>(data + i);
+        __m256i first = _mm256_loadu_si256(source);
+        __m256i second = _mm256_loadu_si256(source + 1);
+        __m256i third = _mm256_loadu_si256(source + 2);
+        __m256i fourth = _mm256_loadu_si256(source + 3);
+        __m256i all = _mm256_or_si256(_mm256_or_si256(first, second), _mm256_or_si256(third, fourth));
+        if (_mm256_testz_si256(all, nonAscii) == 0) {
+            break;
+        }
+        __m256i packed =
+              _mm256_packus_epi16(_mm256_packus_epi32(first, second), _mm256_packus_epi32(third, fourth));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_permutevar8x32_epi32(packed, order));
+    }
+    return i + NarrowAsciiScalar(data + i, size - i, output + i);
+}
+
+const Kernels sAvx2Kernels = {
+    InstructionSet::AVX2, &CountAsciiAvx2,    &ValidateAvx2,      &WidenAscii16Avx2,
+    &WidenAscii32Avx2,    &NarrowAscii16Avx2, &NarrowAscii32Avx2,
+};
+
+#elif defined(UTF_ARCH_ARM64)
+
+////////////////////////////////////////////////////////////////////////////////
+// NEON kernels
+////////////////////////////////////////////////////////////////////////////////
+
+size_t CountAsciiNeon(const uint8* data, size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(data + i)) >= 0x80) {
+            break;
+        }
+    }
+    return i + CountAsciiScalar(data + i, size - i);
+}
+
+inline uint8x16_t CheckBlockNeon(uint8x16_t input, uint8x16_t previous) {
+    const uint8x16_t nibbleMask = vdupq_n_u8(0x0F);
+    const uint8x16_t byte1HighTable = vld1q_u8(sByte1HighTable);
+    const uint8x16_t byte1LowTable = vld1q_u8(sByte1LowTable);
+    const uint8x16_t byte2HighTable = vld1q_u8(sByte2HighTable);
+
+    uint8x16_t previous1 = vextq_u8(previous, input, 15);
+    uint8x16_t byte1High = vqtbl1q_u8(byte1HighTable, vshrq_n_u8(previous1, 4));
+    uint8x16_t byte1Low = vqtbl1q_u8(byte1LowTable, vandq_u8(previous1, nibbleMask));
+    uint8x16_t byte2High = vqtbl1q_u8(byte2HighTable, vshrq_n_u8(input, 4));
+    uint8x16_t special = vandq_u8(vandq_u8(byte1High, byte1Low), byte2High);
+
+    uint8x16_t previous2 = vextq_u8(previous, input, 14);
+    uint8x16_t previous3 = vextq_u8(previous, input, 13);
+    uint8x16_t isThirdByte = vqsubq_u8(previous2, vdupq_n_u8(0xE0 - 0x80));
+    uint8x16_t isFourthByte = vqsubq_u8(previous3, vdupq_n_u8(0xF0 - 0x80));
+    uint8x16_t mustBeContinuation = vandq_u8(vorrq_u8(isThirdByte, isFourthByte), vdupq_n_u8(0x80));
+    return veorq_u8(mustBeContinuation, special);
+}
+
+bool ValidateNeon(const uint8* data, size_t size) {
+    const uint8x16_t incompleteMax = vld1q_u8(sIncompleteMax + 16);
+
+    uint8x16_t error = vdupq_n_u8(0);
+    uint8x16_t previous = vdupq_n_u8(0);
+    uint8x16_t previousIncomplete = vdupq_n_u8(0);
+    for (size_t i = 0; i < size; i += 16) {
+        uint8x16_t input;
+        if (i + 16 <= size) {
+            input = vld1q_u8(data + i);
+        } else {
+            // Pad the last block with ASCII
+            uint8 buffer[16] = {};
+            std::memcpy(buffer, data + i, size - i);
+            input = vld1q_u8(buffer);
+        }
+
+        if (vmaxvq_u8(input) < 0x80) {
+            // ASCII blocks are only invalid after an unfinished sequence
+            error = vorrq_u8(error, previousIncomplete);
+            previousIncomplete = vdupq_n_u8(0);
+        } else {
+            error = vorrq_u8(error, CheckBlockNeon(input, previous));
+            previousIncomplete = vqsubq_u8(input, incompleteMax);
+        }
+        previous = input;
+    }
+    error = vorrq_u8(error, previousIncomplete);
+    return vmaxvq_u8(error) == 0;
+}
+
+size_t WidenAscii16Neon(const uint8* data, size_t size, char16* output) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t chunk = vld1q_u8(data + i);
+        if (vmaxvq_u8(chunk) >= 0x80) {
+            break;
+        }
+        auto* destination = reinterpret_cast<uint16*>(output + i);
+        vst1q_u16(destination, vmovl_u8(vget_low_u8(chunk)));
+        vst1q_u16(destination + 8, vmovl_high_u8(chunk));
+    }
+    return i + WidenAsciiScalar(data + i, size - i, output + i);
+}
+
+size_t WidenAscii32Neon(const uint8* data, size_t size, char32* output) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t chunk = vld1q_u8(data + i);
+        if (vmaxvq_u8(chunk) >= 0x80) {
+            break;
+        }
+        uint16x8_t low = vmovl_u8(vget_low_u8(chunk));
+        uint16x8_t high = vmovl_high_u8(chunk);
+        auto* destination = reinterpret_cast<uint32*>(output + i);
+        vst1q_u32(destination, vmovl_u16(vget_low_u16(low)));
+        vst1q_u32(destination + 4, vmovl_high_u16(low));
+        vst1q_u32(destination + 8, vmovl_u16(vget_low_u16(high)));
+        vst1q_u32(destination + 12, vmovl_high_u16(high));
+    }
+    return i + WidenAsciiScalar(data + i, size - i, output + i);
+}
+
+size_t NarrowAscii16Neon(const char16* data, size_t size, char* output) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const auto* source = reinterpret_cast<const uint16*>(data + i);
+        uint16x8_t first = vld1q_u16(source);
+        uint16x8_t second = vld1q_u16(source + 8);
+        if (vmaxvq_u16(vorrq_u16(first, second)) >= 0x80) {
+            break;
+        }
+        vst1q_u8(reinterpret_cast<uint8*>(output + i), vcombine_u8(vmovn_u16(first), vmovn_u16(second)));
+    }
+    return i + NarrowAsciiScalar(data + i, size - i, output + i);
+}
+
+size_t NarrowAscii32Neon(const char32* data, size_t size, char* output) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const auto* source = reinterpret_cast<const uint32*>(data + i);
+        uint32x4_t first = vld1q_u32(source);
+        uint32x4_t second = vld1q_u32(source + 4);
+        if (vmaxvq_u32(vorrq_u32(first, second)) >= 0x80) {
+            break;
+        }
+        uint16x8_t narrowed = vcombine_u16(vmovn_u32(first), vmovn_u32(second));
+        vst1_u8(reinterpret_cast<uint8*>(output + i), vmovn_u16(narrowed));
+    }
+    return i + NarrowAsciiScalar(data + i, size - i, output + i);
+}
+
+const Kernels sNeonKernels = {
+    InstructionSet::NEON, &CountAsciiNeon,    &ValidateNeon,      &WidenAscii16Neon,
+    &WidenAscii32Neon,    &NarrowAscii16Neon, &NarrowAscii32Neon,
+};
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Dispatch
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(UTF_ARCH_X86) && defined(_MSC_VER) && !defined(__clang__)
+
+bool CpuSupportsSse4() {
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 19)) != 0;
+}
+
+bool CpuSupportsAvx2() {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // The OS must save the YMM registers
+    __cpuid(info, 1);
+    bool hasOsxsave = (info[2] & (1 << 27)) != 0;
+    if (!hasOsxsave || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+#elif defined(UTF_ARCH_X86)
+
+bool CpuSupportsSse4() {
+    return __builtin_cpu_supports("sse4.1");
+}
+
+bool CpuSupportsAvx2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif
+
+const Kernels* GetKernelsFor(InstructionSet instructionSet) {
+    switch (instructionSet) {
+        case InstructionSet::SCALAR:
+            return &sScalarKernels;
+#if defined(UTF_ARCH_X86)
+        case InstructionSet::SSE4:
+            return CpuSupportsSse4() ? &sSse4Kernels : nullptr;
+        case InstructionSet::AVX2:
+            return CpuSupportsAvx2() ? &sAvx2Kernels : nullptr;
+#elif defined(UTF_ARCH_ARM64)
+        case InstructionSet::NEON:
+            return &sNeonKernels;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+const Kernels* SelectKernels() {
+    for (InstructionSet instructionSet : {InstructionSet::AVX2, InstructionSet::SSE4, InstructionSet::NEON}) {
+        const Kernels* kernels = GetKernelsFor(instructionSet);
+        if (kernels != nullptr) {
+            return kernels;
+        }
+    }
+    return &sScalarKernels;
+}
+
+std::atomic<const Kernels*> sKernels(nullptr);
+
+const Kernels& GetKernels() {
+    const Kernels* kernels = sKernels.load(std::memory_order_acquire);
+    if (kernels == nullptr) {
+        kernels = SelectKernels();
+        sKernels.store(kernels, std::memory_order_release);
+    }
+    return *kernels;
+}
+
+}  // namespace
+
+InstructionSet GetInstructionSet() {
+    return GetKernels().instructionSet;
+}
+
+bool SetInstructionSet(InstructionSet instructionSet) {
+    const Kernels* kernels = GetKernelsFor(instructionSet);
+    if (kernels == nullptr) {
+        return false;
+    }
+    sKernels.store(kernels, std::memory_order_release);
+    return true;
+}
+
+bool IsInstructionSetSupported(InstructionSet instructionSet) {
+    return GetKernelsFor(instructionSet) != nullptr;
+}
+
+const char* FindNonAscii(const char* begin, const char* end) {
+    const auto* data = reinterpret_cast<const uint8*>(begin);
+    return begin + GetKernels().countAscii(data, static_cast<size_t>(end - begin));
+}
+
+bool IsValidUtf8(const char* begin, const char* end) {
+    const auto* data = reinterpret_cast<const uint8*>(begin);
+    return GetKernels().validate(data, static_cast<size_t>(end - begin));
+}
+
+bool Utf8ToUtf16(const char* begin, const char* end, std::basic_string<char16>* result) {
+    const Kernels& kernels = GetKernels();
+    const auto* it = reinterpret_cast<const uint8*>(begin);
+    const auto* last = reinterpret_cast<const uint8*>(end);
+
+    // Each byte produces at most one code unit
+    size_t initialSize = result->size();
+    result->resize(initialSize + static_cast<size_t>(last - it));
+    char16* output = result->data() + initialSize;
+
+    while (it < last) {
+        size_t converted = kernels.widenAscii16(it, static_cast<size_t>(last - it), output);
+        it += converted;
+        output += converted;
+
+        // Decode the code points until the next ASCII character
+        while (it < last && *it >= 0x80) {
+            char32 codePoint;
+            size_t length = DecodeUtf8(it, last, &codePoint);
+            if (length == 0) {
+                result->resize(initialSize);
+                return false;
+            }
+            it += length;
+            output = EncodeUtf16(codePoint, output);
+        }
+    }
+
+    result->resize(static_cast<size_t>(output - result->data()));
+    return true;
+}
+
+bool Utf8ToUtf32(const char* begin, const char* end, std::basic_string<char32>* result) {
+    const Kernels& kernels = GetKernels();
+    const auto* it = reinterpret_cast<const uint8*>(begin);
+    const auto* last = reinterpret_cast<const uint8*>(end);
+
+    // Each byte produces at most one code unit
+    size_t initialSize = result->size();
+    result->resize(initialSize + static_cast<size_t>(last - it));
+    char32* output = result->data() + initialSize;
+
+    while (it < last) {
+        size_t converted = kernels.widenAscii32(it, static_cast<size_t>(last - it), output);
+        it += converted;
+        output += converted;
+
+        // Decode the code points until the next ASCII character
+        while (it < last && *it >= 0x80) {
+            size_t length = DecodeUtf8(it, last, output);
+            if (length == 0) {
+                result->resize(initialSize);
+                return false;
+            }
+            it += length;
+            output++;
+        }
+    }
+
+    result->resize(static_cast<size_t>(output - result->data()));
+    return true;
+}
+
+bool Utf16ToUtf8(const char16* begin, const char16* end, std::basic_string<char>* result) {
+    const Kernels& kernels = GetKernels();
+    const char16* it = begin;
+
+    // Each code unit produces at most three bytes, the surrogate pairs
+    // produce four bytes from two code units
+    size_t initialSize = result->size();
+    result->resize(initialSize + static_cast<size_t>(end - begin) * 3);
+    char* output = result->data() + initialSize;
+
+    while (it < end) {
+        size_t converted = kernels.narrowAscii16(it, static_cast<size_t>(end - it), output);
+        it += converted;
+        output += converted;
+
+        // Encode the code points until the next ASCII character
+        while (it < end && *it >= 0x80) {
+            char32 codePoint;
+            size_t length = DecodeUtf16(it, end, &codePoint);
+            if (length == 0) {
+                result->resize(initialSize);
+                return false;
+            }
+            it += length;
+            output = EncodeUtf8(codePoint, output);
+        }
+    }
+
+    result->resize(static_cast<size_t>(output - result->data()));
+    return true;
+}
+
+bool Utf32ToUtf8(const char32* begin, const char32* end, std::basic_string<char>* result) {
+    const Kernels& kernels = GetKernels();
+    const char32* it = begin;
+
+    // Each code point produces at most four bytes
+    size_t initialSize = result->size();
+    result->resize(initialSize + static_cast<size_t>(end - begin) * 4);
+    char* output = result->data() + initialSize;
+
+    while (it < end) {
+        size_t converted = kernels.narrowAscii32(it, static_cast<size_t>(end - it), output);
+        it += converted;
+        output += converted;
+
+        // Encode the code points until the next ASCII character
+        while (it < end && *it >= 0x80) {
+            char32 codePoint = *it;
+            if (codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+                result->resize(initialSize);
+                return false;
+            }
+            it++;
+            output = EncodeUtf8(codePoint, output);
+        }
+    }
+
+    result->resize(static_cast<size_t>(output - result->data()));
+    return true;
+}
+
+}  // namespace engine::utf
@@ -801,6 +801,100 @@ constexpr size_t GetSize(Iter begin, Iter end);
 template <Encoding Base, typename Iter>
 constexpr bool IsValid(Iter begin, Iter end);
 
+/**
+ * @brief Instruction sets used by the runtime UTF conversions
+ */
+enum class InstructionSet {
+    SCALAR,  ///< Portable implementation, always available
+    SSE4,    ///< x86 SSE4.1 kernels
+    AVX2,    ///< x86 AVX2 kernels
+    NEON,    ///< ARM64 NEON kernels
+};
+
+/**
+ * @brief Get the instruction set used by the runtime UTF conversions
+ *
+ * @details The first call selects the best instruction set supported
+ *          by the CPU
+ *
+ * @return The instruction set in use
+ */
+ENGINE_API InstructionSet GetInstructionSet();
+
+/**
+ * @brief Force the instruction set used by the runtime UTF conversions
+ *
+ * @param instructionSet The instruction set to use
+ * @return true if the CPU supports it, false otherwise
+ */
+ENGINE_API bool SetInstructionSet(InstructionSet instructionSet);
+
+/**
+ * @brief Check if the CPU supports an instruction set
+ *
+ * @param instructionSet The instruction set to check
+ * @return true if it can be used, false otherwise
+ */
+ENGINE_API bool IsInstructionSetSupported(InstructionSet instructionSet);
+
+/**
+ * @brief Get the first byte of an UTF-8 string that is not ASCII
+ *
+ * @param begin The start of the UTF-8 string
+ * @param end The end of the UTF-8 string
+ * @return Pointer to the first non ASCII byte, or `end` if all the
+ *         bytes are ASCII
+ */
+ENGINE_API const char* FindNonAscii(const char* begin, const char* end);
+
+/**
+ * @brief Validate an UTF-8 string using the SIMD kernels
+ *
+ * @details Unlike @ref IsValid this follows the Unicode rules strictly,
+ *          the surrogates and the code points over U+10FFFF are rejected
+ *
+ * @param begin The start of the UTF-8 string
+ * @param end The end of the UTF-8 string
+ * @return true If is valid, false otherwise
+ */
+ENGINE_API bool IsValidUtf8(const char* begin, const char* end);
+
+/**
+ * @brief Convert an UTF-8 string to UTF-16 using the SIMD kernels
+ *
+ * @details The converted string is appended to `result`, which is not
+ *          modified if the input is not valid
+ *
+ * @param begin The start of the UTF-8 string
+ * @param end The end of the UTF-8 string
+ * @param result The string to append the result to
+ * @return true if the input was valid, false otherwise
+ */
+ENGINE_API bool Utf8ToUtf16(const char* begin, const char* end, std::basic_string<char16>* result);
+
+/**
+ * @copydoc Utf8ToUtf16
+ */
+ENGINE_API bool Utf8ToUtf32(const char* begin, const char* end, std::basic_string<char32>* result);
+
+/**
+ * @brief Convert an UTF-16 string to UTF-8 using the SIMD kernels
+ *
+ * @details The converted string is appended to `result`, which is not
+ *          modified if the input is not valid
+ *
+ * @param begin The start of the UTF-16 string
+ * @param end The end of the UTF-16 string
+ * @param result The string to append the result to
+ * @return true if the input was valid, false otherwise
+ */
+ENGINE_API bool Utf16ToUtf8(const char16* begin, const char16* end, std::basic_string<char>* result);
+
+/**
+ * @copydoc Utf16ToUtf8
+ */
+ENGINE_API bool Utf32ToUtf8(const char32* begin, const char32* end, std::basic_string<char>* result);
+
 // template <size_t I, typename T>
 // auto& get(engine::utf::CodeUnit<8, T>& cp) noexcept;
 
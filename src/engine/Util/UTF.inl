@@ -2,7 +2,10 @@
 
 #include <Util/Prerequisites.hpp>
 
+#include <algorithm>
+#include <compare>
 #include <string>
+#include <type_traits>
 
 namespace engine::utf {
 
@@ -512,10 +515,15 @@ constexpr std::strong_ordering CodeUnitRange<Base, Iter>::operator<=>(const Code
         return std::strong_ordering::less;
     } else if (size > otherSize) {
         return std::strong_ordering::greater;
-    } else if (std::equal(m_range.first, m_range.second, other.m_range.first)) {
-        return std::strong_ordering::equal;
     }
-    return std::strong_ordering::equivalent;
+    // With the same size the code units are ordered like the code points
+    // they encode, compared as unsigned so the bytes of UTF-8 sequences
+    // stored in a signed char are not negative
+    return std::lexicographical_compare_three_way(
+        m_range.first, m_range.second, other.m_range.first, other.m_range.second, [](auto left, auto right) {
+            return static_cast<uint32>(static_cast<std::make_unsigned_t<decltype(left)>>(left)) <=>
+                   static_cast<uint32>(static_cast<std::make_unsigned_t<decltype(right)>>(right));
+        });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4,7 +4,7 @@
 #include <Renderer/RenderStates.hpp>
 #include <System/LogManager.hpp>
 #include <System/String.hpp>
-#include <System/StringFormat.hpp>
+#include <System/StringBuilder.hpp>
 #include <Util/Container/Vector.hpp>
 
 #include "GL_Dependencies.hpp"
@@ -12,6 +12,7 @@
 #include "GL_Shader.hpp"
 #include "GL_ShaderManager.hpp"
 #include "GL_Texture2D.hpp"
+#include "GL_TextureManager.hpp"
 #include "GL_Utilities.hpp"
 
 #include <utility>
@@ -39,9 +40,7 @@ GL_Mesh::~GL_Mesh() {
     }
 }
 
-void GL_Mesh::loadFromData(Vector<Vertex> vertices,
-                           Vector<uint32> indices,
-                           Vector<std::pair<Texture2D*, TextureType>> textures) {
+void GL_Mesh::loadFromData(Vector<Vertex> vertices, Vector<uint32> indices, MeshTextures textures) {
     m_vertices = std::move(vertices);
     m_indices = std::move(indices);
     m_textures = std::move(textures);
@@ -81,21 +80,22 @@ void GL_Mesh::setupMesh() {
 void GL_Mesh::draw(RenderWindow& target, const RenderStates& states) const {
     auto& window = static_cast<GL_RenderWindow&>(target);
     GL_Shader* shader = GL_ShaderManager::GetInstance().getActiveShader();
+    GL_TextureManager& textureManager = GL_TextureManager::GetInstance();
 
     uint32 diffuseNum = 1;
     uint32 specularNum = 1;
     for (size_t i = 0; i < m_textures.size(); i++) {
         const auto& pair = m_textures[i];
-        auto* currentTexture = static_cast<GL_Texture2D*>(pair.first);
+        auto* currentTexture = static_cast<GL_Texture2D*>(textureManager.getTexture2D(pair.first));
         TextureType currentTextureType = pair.second;
 
-        String uniformName;
+        InlineString<32> uniformName;
         switch (currentTextureType) {
             case TextureType::DIFFUSE:
-                uniformName += "tex_diffuse{}"_format(diffuseNum++);
+                uniformName.format("tex_diffuse{}", diffuseNum++);
                 break;
             case TextureType::SPECULAR:
-                uniformName += "tex_specular{}"_format(specularNum++);
+                uniformName.format("tex_specular{}", specularNum++);
                 break;
             default:
                 continue;
@@ -107,6 +107,12 @@ void GL_Mesh::draw(RenderWindow& target, const RenderStates& states) const {
             shader->setUniform(uniformName, static_cast<GLint>(i));
         }
 
+        // The evicted textures are drawn with the default texture until
+        // they are streamed in
+        if (currentTexture != nullptr && !currentTexture->isResident()) {
+            currentTexture = static_cast<GL_Texture2D*>(textureManager.getTexture2D(TextureManager::sDefaultTextureId));
+        }
+
         if (currentTexture) {
             currentTexture->use();
         }
@@ -17,9 +17,7 @@ public:
 
     ~GL_Mesh() override;
 
-    void loadFromData(Vector<Vertex> vertices,
-                      Vector<uint32> indices,
-                      Vector<std::pair<Texture2D*, TextureType>> textures) override;
+    void loadFromData(Vector<Vertex> vertices, Vector<uint32> indices, MeshTextures textures) override;
 
     void draw(RenderWindow& target, const RenderStates& states) const override;
 
@@ -187,47 +187,47 @@ void GL_Shader::uploadUniformBuffers() {
     GL_CALL(glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, m_uniformBuffers.dynamicBuffer));
 }
 
-void GL_Shader::setUniform(const String& name, float val) {
+void GL_Shader::setUniform(const StringView& name, float val) {
     GLint location = getUniformLocation(name);
     if (location != -1) GL_CALL(glUniform1f(location, val));
 }
 
-void GL_Shader::setUniform(const String& name, int32 val) {
+void GL_Shader::setUniform(const StringView& name, int32 val) {
     GLint location = getUniformLocation(name);
     if (location != -1) GL_CALL(glUniform1i(location, val));
 }
 
-void GL_Shader::setUniform(const String& name, uint32 val) {
+void GL_Shader::setUniform(const StringView& name, uint32 val) {
     GLint location = getUniformLocation(name);
     if (location != -1) GL_CALL(glUniform1ui(location, val));
 }
 
-void GL_Shader::setUniform(const String& name, const math::mat4& val) {
+void GL_Shader::setUniform(const StringView& name, const math::mat4& val) {
     GLint location = getUniformLocation(name);
     if (location != -1) GL_CALL(glUniformMatrix4fv(location, 1, GL_FALSE, &val[0]));
 }
 
-void GL_Shader::setUniform(const String& name, const math::mat3& val) {
+void GL_Shader::setUniform(const StringView& name, const math::mat3& val) {
     GLint location = getUniformLocation(name);
     if (location != -1) GL_CALL(glUniformMatrix3fv(location, 1, GL_FALSE, &val[0]));
 }
 
-void GL_Shader::setUniform(const String& name, const math::mat2& val) {
+void GL_Shader::setUniform(const StringView& name, const math::mat2& val) {
     GLint location = getUniformLocation(name);
     if (location != -1) GL_CALL(glUniformMatrix2fv(location, 1, GL_FALSE, &val[0]));
 }
 
-void GL_Shader::setUniform(const String& name, const math::vec4& val) {
+void GL_Shader::setUniform(const StringView& name, const math::vec4& val) {
     GLint location = getUniformLocation(name);
     if (location != -1) GL_CALL(glUniform4f(location, val[0], val[1], val[2], val[3]));
 }
 
-void GL_Shader::setUniform(const String& name, const math::vec3& val) {
+void GL_Shader::setUniform(const StringView& name, const math::vec3& val) {
     GLint location = getUniformLocation(name);
     if (location != -1) GL_CALL(glUniform3f(location, val[0], val[1], val[2]));
 }
 
-void GL_Shader::setUniform(const String& name, const math::vec2& val) {
+void GL_Shader::setUniform(const StringView& name, const math::vec2& val) {
     GLint location = getUniformLocation(name);
     if (location != -1) GL_CALL(glUniform2f(location, val[0], val[1]));
 }
@@ -298,15 +298,16 @@ void GL_Shader::cleanUpShaders() {
     }
 }
 
-GLint GL_Shader::getUniformLocation(const String& name) {
+GLint GL_Shader::getUniformLocation(const StringView& name) {
     const auto it = m_uniforms.find(name);
 
     if (it != m_uniforms.end()) {
         return it->second;
     }
-    GLint location = glGetUniformLocation(m_program, name.toUtf8().c_str());
+    String nameString(name);
+    GLint location = glGetUniformLocation(m_program, nameString.toUtf8().c_str());
 
-    m_uniforms.insert(std::make_pair(name, location));
+    m_uniforms.insert(std::make_pair(std::move(nameString), location));
 
     if (location == -1) {
         LogError(sTag, "Parameter \"{}\" not found in shader", name);
@@ -4,6 +4,7 @@
 #include <Renderer/Shader.hpp>
 #include <Renderer/UniformBufferObject.hpp>
 #include <System/String.hpp>
+#include <System/StringView.hpp>
 #include <Util/Container/Vector.hpp>
 
 #include "GL_Config.hpp"
@@ -35,15 +36,15 @@ public:
 
     void uploadUniformBuffers();
 
-    void setUniform(const String& name, float val);
-    void setUniform(const String& name, int32 val);
-    void setUniform(const String& name, uint32 val);
-    void setUniform(const String& name, const math::mat4& val);
-    void setUniform(const String& name, const math::mat3& val);
-    void setUniform(const String& name, const math::mat2& val);
-    void setUniform(const String& name, const math::vec4& val);
-    void setUniform(const String& name, const math::vec3& val);
-    void setUniform(const String& name, const math::vec2& val);
+    void setUniform(const StringView& name, float val);
+    void setUniform(const StringView& name, int32 val);
+    void setUniform(const StringView& name, uint32 val);
+    void setUniform(const StringView& name, const math::mat4& val);
+    void setUniform(const StringView& name, const math::mat3& val);
+    void setUniform(const StringView& name, const math::mat2& val);
+    void setUniform(const StringView& name, const math::vec4& val);
+    void setUniform(const StringView& name, const math::vec3& val);
+    void setUniform(const StringView& name, const math::vec2& val);
 
     static const Vector<const char*>& GetRequiredExtensions();
 
@@ -56,7 +57,7 @@ private:
 
     void cleanUpShaders();
 
-    GLint getUniformLocation(const String& name);
+    GLint getUniformLocation(const StringView& name);
 
     json m_descriptor;
 
@@ -71,7 +72,7 @@ private:
         GLuint dynamicBuffer;
     } m_uniformBuffers;
 
-    std::map<String, GLint> m_uniforms;
+    std::map<String, GLint, std::less<>> m_uniforms;
 };
 
 }  // namespace engine::plugin::opengl
@@ -47,7 +47,7 @@ GL_Shader* GL_ShaderManager::loadFromMemory(const String& name, const std::map<S
     return reinterpret_cast<GL_Shader*>(baseShader);
 }
 
-GL_Shader* GL_ShaderManager::getShader(const String& name) {
+GL_Shader* GL_ShaderManager::getShader(const StringId& name) {
     Shader* baseShader = ShaderManager::getShader(name);
     return reinterpret_cast<GL_Shader*>(baseShader);
 }
@@ -22,7 +22,7 @@ public:
 
     GL_Shader* loadFromMemory(const String& name, const std::map<ShaderType, String*>& shaderDataMap);
 
-    GL_Shader* getShader(const String& name);
+    GL_Shader* getShader(const StringId& name);
 
     GL_Shader* getActiveShader();
 
@@ -32,6 +32,14 @@ bool GL_Texture2D::loadFromImage(const Image& img) {
     return true;
 }
 
+void GL_Texture2D::unload() {
+    // Release the texture storage and keep a fresh name to load it again
+    if (m_texture) {
+        GL_CALL(glDeleteTextures(1, &m_texture));
+    }
+    GL_CALL(glGenTextures(1, &m_texture));
+}
+
 void GL_Texture2D::use() {
     GL_CALL(glBindTexture(GL_TEXTURE_2D, m_texture));
 }
@@ -16,6 +16,8 @@ public:
 
     bool loadFromImage(const Image& img) override;
 
+    void unload() override;
+
     void use() override;
 
 private:
@@ -38,12 +38,10 @@ Vk_Mesh::~Vk_Mesh() {
     m_indexBuffer.destroy();
 }
 
-void Vk_Mesh::loadFromData(Vector<Vertex> vertices,
-                           Vector<uint32> indices,
-                           Vector<std::pair<Texture2D*, TextureType>> textures) {
-    m_vertices = vertices;
-    m_indices = indices;
-    m_textures = textures;
+void Vk_Mesh::loadFromData(Vector<Vertex> vertices, Vector<uint32> indices, MeshTextures textures) {
+    m_vertices = std::move(vertices);
+    m_indices = std::move(indices);
+    m_textures = std::move(textures);
     setupMesh();
 }
 
@@ -210,12 +208,16 @@ void Vk_Mesh::draw(RenderWindow& target, const RenderStates& states) const {
                                           VkPipelineLayout& pipelineLayout) {
         uint32 dynamicOffset = 0;
 
-        Vk_Texture2D* texture = Vk_TextureManager::GetInstance().getActiveTexture2D();
+        Vk_TextureManager& textureManager = Vk_TextureManager::GetInstance();
+        Vk_Texture2D* texture = textureManager.getActiveTexture2D();
         Vk_Shader* shader = Vk_ShaderManager::GetInstance().getActiveShader();
 
+        // Stale texture handles and the evicted textures still being
+        // streamed in fallback to the active texture
         for (const auto& pair : m_textures) {
-            if (pair.second == TextureType::DIFFUSE) {
-                texture = static_cast<Vk_Texture2D*>(pair.first);
+            Texture2D* diffuseTexture = textureManager.getTexture2D(pair.first);
+            if (pair.second == TextureType::DIFFUSE && diffuseTexture != nullptr && diffuseTexture->isResident()) {
+                texture = static_cast<Vk_Texture2D*>(diffuseTexture);
             }
         }
 
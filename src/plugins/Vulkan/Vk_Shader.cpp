@@ -1,6 +1,7 @@
 #include <System/LogManager.hpp>
 #include <System/StringFormat.hpp>
 #include <System/StringView.hpp>
+#include <Util/Container/SmallVector.hpp>
 #include <Util/Container/Vector.hpp>
 
 #include "Vk_Context.hpp"
@@ -163,7 +164,7 @@ bool Vk_Shader::createUboDescriptorSetLayout() {
 
     const json& bindings = m_descriptor["renderer"]["vulkan"]["descriptor_set_layouts"]["bindings"];
 
-    Vector<VkDescriptorSetLayoutBinding> layoutBindings;
+    SmallVector<VkDescriptorSetLayoutBinding, 8> layoutBindings;
     for (const auto& binding : bindings) {
         const json& pos = binding["pos"];
         const json& type = binding["type"];
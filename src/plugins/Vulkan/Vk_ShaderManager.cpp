@@ -47,7 +47,7 @@ Vk_Shader* Vk_ShaderManager::loadFromMemory(const String& name, const std::map<S
     return reinterpret_cast<Vk_Shader*>(baseShader);
 }
 
-Vk_Shader* Vk_ShaderManager::getShader(const String& name) {
+Vk_Shader* Vk_ShaderManager::getShader(const StringId& name) {
     Shader* baseShader = ShaderManager::getShader(name);
     return reinterpret_cast<Vk_Shader*>(baseShader);
 }
@@ -68,4 +68,9 @@ const StringView& Vk_ShaderManager::getShaderFolder() const {
     return sShaderFolder;
 }
 
+bool Vk_ShaderManager::isReloadSupported() const {
+    // The graphics pipeline is created only once with the active shader
+    return false;
+}
+
 }  // namespace engine::plugin::vulkan
@@ -22,7 +22,7 @@ public:
 
     Vk_Shader* loadFromMemory(const String& name, const std::map<ShaderType, String*>& shaderDataMap);
 
-    Vk_Shader* getShader(const String& name);
+    Vk_Shader* getShader(const StringId& name);
 
     Vk_Shader* getActiveShader();
 
@@ -42,6 +42,8 @@ protected:
     void useShader(Shader* shader) override;
 
     const StringView& getShaderFolder() const override;
+
+    bool isReloadSupported() const override;
 };
 
 }  // namespace engine::plugin::vulkan
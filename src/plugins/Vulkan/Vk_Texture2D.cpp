@@ -15,7 +15,7 @@ const StringView sTag("Vk_Texture2D");
 
 }  // namespace
 
-Vk_Texture2D::Vk_Texture2D() = default;
+Vk_Texture2D::Vk_Texture2D() : m_sampler(VK_NULL_HANDLE), m_descriptorSet(VK_NULL_HANDLE) {}
 
 Vk_Texture2D::~Vk_Texture2D() {
     Vk_Context& context = Vk_Context::GetInstance();
@@ -24,6 +24,9 @@ Vk_Texture2D::~Vk_Texture2D() {
 
     vkQueueWaitIdle(graphicsQueue.handle);
 
+    freeDescriptorSet(m_descriptorSet);
+    m_descriptorSet = VK_NULL_HANDLE;
+
     if (m_sampler != VK_NULL_HANDLE) {
         vkDestroySampler(device, m_sampler, nullptr);
         m_sampler = VK_NULL_HANDLE;
@@ -31,6 +34,9 @@ Vk_Texture2D::~Vk_Texture2D() {
 }
 
 bool Vk_Texture2D::loadFromImage(const Image& img) {
+    // Release the previous data if the texture is being loaded again
+    unload();
+
     if (!m_image.createImage(img.getSize(), VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL,
                              (VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT))) {
         LogError(sTag, "Could not create image");
@@ -47,7 +53,7 @@ bool Vk_Texture2D::loadFromImage(const Image& img) {
         return false;
     }
 
-    if (!createSampler()) {
+    if (m_sampler == VK_NULL_HANDLE && !createSampler()) {
         LogError(sTag, "Could not create sampler");
         return false;
     }
@@ -57,12 +63,37 @@ bool Vk_Texture2D::loadFromImage(const Image& img) {
         return false;
     }
 
-    allocateDescriptorSet();
+    // Write the new image in a new descriptor set instead of updating the
+    // one bound by the command buffers recorded before
+    VkDescriptorSet previousDescriptorSet = m_descriptorSet;
+    if (!allocateDescriptorSet()) {
+        m_descriptorSet = previousDescriptorSet;
+        return false;
+    }
     updateDescriptorSet();
 
+    // The queue was idle since unload() so nothing uses the previous set
+    freeDescriptorSet(previousDescriptorSet);
+
     return true;
 }
 
+void Vk_Texture2D::unload() {
+    if (m_image.getHandle() == VK_NULL_HANDLE && m_stagingBuffer.getHandle() == VK_NULL_HANDLE) {
+        return;
+    }
+
+    // The command buffers submitted in the previous frames may still be
+    // sampling the image, wait for them before releasing it
+    Vk_Context& context = Vk_Context::GetInstance();
+    QueueParameters& graphicsQueue = context.getGraphicsQueue();
+    vkQueueWaitIdle(graphicsQueue.handle);
+
+    // The sampler is reused when loading it again
+    m_image.destroy();
+    m_stagingBuffer.destroy();
+}
+
 void Vk_Texture2D::use() {}
 
 VkDescriptorSet& Vk_Texture2D::getDescriptorSet() {
@@ -277,6 +308,18 @@ bool Vk_Texture2D::allocateDescriptorSet() {
     return true;
 }
 
+void Vk_Texture2D::freeDescriptorSet(VkDescriptorSet descriptorSet) {
+    Vk_TextureManager* textureManager = Vk_TextureManager::GetInstancePtr();
+    if (descriptorSet == VK_NULL_HANDLE || textureManager == nullptr) {
+        return;
+    }
+
+    Vk_Context& context = Vk_Context::GetInstance();
+    VkDevice& device = context.getVulkanDevice();
+
+    vkFreeDescriptorSets(device, textureManager->getDescriptorPool(), 1, &descriptorSet);
+}
+
 bool Vk_Texture2D::updateDescriptorSet() {
     // This tell the driver which resources are going to be used by the descriptor set
 
@@ -19,6 +19,8 @@ public:
 
     bool loadFromImage(const Image& img) override;
 
+    void unload() override;
+
     void use() override;
 
     VkDescriptorSet& getDescriptorSet();
@@ -29,6 +31,7 @@ private:
     bool copyTextureData(const Image& img);
 
     bool allocateDescriptorSet();
+    void freeDescriptorSet(VkDescriptorSet descriptorSet);
     bool updateDescriptorSet();
 
     Vk_Image m_image;
@@ -89,7 +89,8 @@ bool Vk_TextureManager::createDescriptorPool() {
     VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {
         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
         .pNext = nullptr,
-        .flags = 0,
+        // The textures replace their descriptor set when loaded again
+        .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
         .maxSets = sMaxDescriptorSets,
         .poolSizeCount = 1,
         .pPoolSizes = &poolSize,
@@ -0,0 +1,91 @@
+#include "Benchmark.hpp"
+
+#include <System/LogManager.hpp>
+
+#include <atomic>
+#include <new>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace engine;
+
+namespace benchmark {
+
+namespace {
+
+const StringView sTag("Benchmark");
+
+struct BenchmarkEntry {
+    const char* name;
+    BenchmarkFunction function;
+};
+
+const BenchmarkEntry sBenchmarks[] = {
+    {"HashMap", &RunHashMapBenchmark},
+    {"JSON", &RunJSONBenchmark},
+    {"PackFile", &RunPackFileBenchmark},
+    {"Signal", &RunSignalBenchmark},
+    {"String", &RunStringBenchmark},
+    {"UTF", &RunUTFBenchmark},
+};
+
+std::atomic<uint64> sAllocationCount(0);
+
+}  // namespace
+
+uint64 GetAllocationCount() {
+    return sAllocationCount.load(std::memory_order_relaxed);
+}
+
+void ReportThroughput(const StringView& name, uint64 bytes, const Time& time) {
+    double seconds = static_cast<double>(time.asNanoseconds()) / 1e9;
+    double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    double throughput = (seconds > 0.0) ? megabytes / seconds : 0.0;
+    LogInfo(sTag, "{:<32} {:>10.2f} MiB in {:>8.3f} s {:>10.2f} MiB/s", name, megabytes, seconds, throughput);
+}
+
+}  // namespace benchmark
+
+// Count the allocations of the whole process so the benchmarks can report
+// the memory traffic of each implementation
+void* operator new(std::size_t size) {
+    benchmark::sAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* pointer = std::malloc(size > 0 ? size : 1);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept {
+    std::free(pointer);
+}
+
+/**
+ * Runs the engine benchmarks and reports their throughput.
+ *
+ * Usage: Benchmark <name> [<arguments>...]
+ */
+int main(int argc, char* argv[]) {
+    LogManager logManager("Benchmark", "benchmark.log");
+    logManager.enableFileLogging(false);
+
+    if (argc >= 2) {
+        for (const auto& benchmark : benchmark::sBenchmarks) {
+            if (std::strcmp(argv[1], benchmark.name) == 0) {
+                return benchmark.function(argc - 2, argv + 2);
+            }
+        }
+    }
+
+    LogError(benchmark::sTag, "Usage: {} <name> [<arguments>...]", argv[0]);
+    for (const auto& benchmark : benchmark::sBenchmarks) {
+        LogError(benchmark::sTag, "Available benchmark: {}", benchmark.name);
+    }
+    return 1;
+}
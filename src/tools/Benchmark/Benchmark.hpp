@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Util/Prerequisites.hpp>
+
+#include <System/StringView.hpp>
+#include <System/Time.hpp>
+
+namespace benchmark {
+
+/**
+ * @brief Signature of the entry point of each benchmark
+ *
+ * @param argc The number of arguments after the benchmark name
+ * @param argv The arguments after the benchmark name
+ * @return The exit code of the tool
+ */
+using BenchmarkFunction = int (*)(int argc, char* argv[]);
+
+/**
+ * @brief Print the throughput of a measured operation
+ *
+ * @param name The name of the operation
+ * @param bytes The number of bytes processed
+ * @param time The time it took to process them
+ */
+void ReportThroughput(const engine::StringView& name, engine::uint64 bytes, const engine::Time& time);
+
+/**
+ * @brief Get the number of heap allocations made by the process so far
+ */
+engine::uint64 GetAllocationCount();
+
+int RunHashMapBenchmark(int argc, char* argv[]);
+
+int RunJSONBenchmark(int argc, char* argv[]);
+
+int RunPackFileBenchmark(int argc, char* argv[]);
+
+int RunSignalBenchmark(int argc, char* argv[]);
+
+int RunStringBenchmark(int argc, char* argv[]);
+
+int RunUTFBenchmark(int argc, char* argv[]);
+
+}  // namespace benchmark
@@ -0,0 +1,145 @@
+#include "Benchmark.hpp"
+
+#include <System/LogManager.hpp>
+#include <System/Stopwatch.hpp>
+#include <System/String.hpp>
+#include <System/StringView.hpp>
+#include <Util/Container/FlatHashMap.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <cstdlib>
+
+using namespace engine;
+
+namespace benchmark {
+
+namespace {
+
+const StringView sTag("HashMapBenchmark");
+
+// Transparent hash so std::unordered_map can also be looked up with a
+// StringView, like the FlatHashMap
+struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()(const StringView& str) const {
+        return FlatHash<StringView>()(str);
+    }
+};
+
+// Names like the ones of the resources looked up by the managers
+Vector<String> MakeNames(size_t count, const char* prefix) {
+    Vector<String> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        names.emplace_back(std::string(prefix) + "/resource_" + std::to_string(i * 2654435761u % 1000003) + ".png");
+    }
+    return names;
+}
+
+Vector<int> MakeKeys(size_t count, int offset) {
+    Vector<int> keys;
+    keys.reserve(count);
+    std::mt19937 random(42);
+    for (size_t i = 0; i < count; i++) {
+        keys.push_back(static_cast<int>(random() >> 2) * 2 + offset);
+    }
+    return keys;
+}
+
+void Report(const char* container, const char* operation, size_t count, int iterations, const Time& time,
+            uint64 allocations) {
+    double operations = static_cast<double>(count) * iterations;
+    double nanoseconds = static_cast<double>(time.asNanoseconds()) / operations;
+    std::string name = std::string(container) + " " + operation;
+    LogInfo(sTag, "{:<44} {:>8.2f} ns/op {:>10} allocations", name, nanoseconds, allocations);
+}
+
+template <typename Map, typename Key, typename LookupKey>
+uint64 MeasureMap(const char* container, const Vector<Key>& keys, const Vector<Key>& missingKeys, int iterations) {
+    uint64 checksum = 0;
+    auto measure = [&](const char* operation, auto&& function) {
+        uint64 allocations = GetAllocationCount();
+        Stopwatch stopwatch;
+        stopwatch.start();
+        for (int i = 0; i < iterations; i++) {
+            function();
+        }
+        Time time = stopwatch.getElapsedTime();
+        Report(container, operation, keys.size(), iterations, time, GetAllocationCount() - allocations);
+    };
+
+    Map map;
+    measure("insert", [&]() {
+        map = Map();
+        for (size_t i = 0; i < keys.size(); i++) {
+            map.emplace(keys[i], static_cast<uint32>(i));
+        }
+    });
+    measure("hit lookup", [&]() {
+        for (const Key& key : keys) {
+            auto it = map.find(LookupKey(key));
+            checksum += (it != map.end()) ? it->second : 0;
+        }
+    });
+    measure("miss lookup", [&]() {
+        for (const Key& key : missingKeys) {
+            checksum += (map.find(LookupKey(key)) != map.end()) ? 1 : 0;
+        }
+    });
+    measure("erase and insert", [&]() {
+        for (size_t i = 0; i < keys.size(); i++) {
+            map.erase(keys[i]);
+            map.emplace(keys[i], static_cast<uint32>(i));
+        }
+    });
+    return checksum;
+}
+
+}  // namespace
+
+/**
+ * Measures the insertion, lookup and removal of int and String keys in
+ * std::map, std::unordered_map and FlatHashMap. The String maps are
+ * looked up with a StringView like the resource managers do.
+ *
+ * Usage: Benchmark HashMap [<elements>] [<iterations>]
+ */
+int RunHashMapBenchmark(int argc, char* argv[]) {
+    int elements = (argc >= 1) ? std::atoi(argv[0]) : 1 << 12;
+    int iterations = (argc >= 2) ? std::atoi(argv[1]) : 100;
+    if (elements <= 0 || iterations <= 0) {
+        LogError(sTag, "Usage: Benchmark HashMap [<elements>] [<iterations>]");
+        return 1;
+    }
+
+    size_t count = static_cast<size_t>(elements);
+    Vector<int> keys = MakeKeys(count, 0);
+    Vector<int> missingKeys = MakeKeys(count, 1);
+    LogInfo(sTag, "{} int keys", count);
+    uint64 checksum = 0;
+    checksum += MeasureMap<std::map<int, uint32>, int, int>("std::map<int>", keys, missingKeys, iterations);
+    checksum += MeasureMap<std::unordered_map<int, uint32>, int, int>("std::unordered_map<int>", keys, missingKeys,
+                                                                      iterations);
+    checksum += MeasureMap<FlatHashMap<int, uint32>, int, int>("FlatHashMap<int>", keys, missingKeys, iterations);
+
+    Vector<String> names = MakeNames(count, "textures");
+    Vector<String> missingNames = MakeNames(count, "models");
+    LogInfo(sTag, "{} String keys", count);
+    checksum += MeasureMap<std::map<String, uint32, std::less<>>, String, StringView>("std::map<String>", names,
+                                                                                      missingNames, iterations);
+    checksum += MeasureMap<std::unordered_map<String, uint32, StringHash, std::equal_to<>>, String, StringView>(
+        "std::unordered_map<String>", names, missingNames, iterations);
+    checksum += MeasureMap<FlatHashMap<String, uint32>, String, StringView>("FlatHashMap<String>", names,
+                                                                            missingNames, iterations);
+
+    LogDebug(sTag, "Checksum {}", checksum);
+    return 0;
+}
+
+}  // namespace benchmark
@@ -0,0 +1,139 @@
+#include "Benchmark.hpp"
+
+#include <Math/Math.hpp>
+#include <Renderer/SceneDescriptor.hpp>
+#include <Renderer/Transform.hpp>
+#include <System/JSON.hpp>
+#include <System/LogManager.hpp>
+#include <System/Stopwatch.hpp>
+#include <System/String.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <string>
+
+#include <cstdlib>
+
+using namespace engine;
+
+namespace benchmark {
+
+namespace {
+
+const StringView sTag("JSONBenchmark");
+
+std::string MakeScene(int objectCount) {
+    std::string scene = "{\"name\": \"Benchmark\", \"data\": {\"objects\": [";
+    for (int i = 0; i < objectCount; i++) {
+        if (i > 0) {
+            scene += ",";
+        }
+        scene += "{\"model\": \"models/object_" + std::to_string(i % 100) + ".obj\", \"position\": [" +
+                 std::to_string(i * 0.5) + ", 0.0, " + std::to_string(-i * 0.25) + "], \"rotation\": [0, " +
+                 std::to_string(i % 360) + ", 0], \"scale\": 1.5}";
+    }
+    scene += "]}}";
+    return scene;
+}
+
+// Loads the scene the way it was done before the SAX readers, validating
+// the document first and then walking a json DOM
+size_t LoadWithDOM(const std::string& data) {
+    if (!json::accept(data.begin(), data.end())) {
+        return 0;
+    }
+    json document = json::parse(data.begin(), data.end());
+
+    Vector<String> modelNames;
+    Vector<Transform> transforms;
+    for (const json& jsonObject : document["data"]["objects"]) {
+        const json& positionJson = jsonObject["position"];
+        const json& rotationJson = jsonObject["rotation"];
+        const json& scaleJson = jsonObject["scale"];
+
+        Transform modelMatrix;
+        if (!scaleJson.is_null()) {
+            modelMatrix.scale(math::vec3(float(scaleJson)));
+        }
+        if (!rotationJson.is_null()) {
+            modelMatrix.rotate({float(rotationJson[0]), float(rotationJson[1]), float(rotationJson[2])});
+        }
+        if (!positionJson.is_null()) {
+            modelMatrix.translate({float(positionJson[0]), float(positionJson[1]), float(positionJson[2])});
+        }
+        modelNames.push_back(jsonObject["model"].get<String>());
+        transforms.push_back(modelMatrix);
+    }
+    return modelNames.size();
+}
+
+size_t LoadWithReader(const std::string& data) {
+    SceneDescriptor descriptor;
+    if (!descriptor.loadFromMemory(reinterpret_cast<const byte*>(data.data()), data.size())) {
+        return 0;
+    }
+    return descriptor.getObjectCount();
+}
+
+size_t LoadCompiled(const Vector<byte>& data) {
+    SceneDescriptor descriptor;
+    if (!descriptor.loadFromBinary(data.data(), data.size())) {
+        return 0;
+    }
+    return descriptor.getObjectCount();
+}
+
+}  // namespace
+
+/**
+ * Compares loading a large generated scene validating it first and then
+ * building a json DOM, against the single pass SceneDescriptor reader and
+ * the compiled scene format.
+ *
+ * Usage: Benchmark JSON [<objects>] [<iterations>]
+ */
+int RunJSONBenchmark(int argc, char* argv[]) {
+    int objectCount = (argc >= 1) ? std::atoi(argv[0]) : 100000;
+    int iterations = (argc >= 2) ? std::atoi(argv[1]) : 10;
+    if (objectCount <= 0 || iterations <= 0) {
+        LogError(sTag, "Usage: Benchmark JSON [<objects>] [<iterations>]");
+        return 1;
+    }
+
+    std::string scene = MakeScene(objectCount);
+    LogInfo(sTag, "Scene with {} objects, {} bytes", objectCount, scene.size());
+
+    SceneDescriptor descriptor;
+    Vector<byte> compiled;
+    descriptor.loadFromMemory(reinterpret_cast<const byte*>(scene.data()), scene.size());
+    descriptor.saveToBinary(&compiled);
+    LogInfo(sTag, "Compiled scene {} bytes", compiled.size());
+
+    // The throughput is reported relative to the json scene size so the
+    // results of all the formats can be compared
+    auto measure = [&](const StringView& name, auto&& function, const auto& data) {
+        if (function(data) != static_cast<size_t>(objectCount)) {
+            LogError(sTag, "{} did not load all the objects", name);
+            return false;
+        }
+        uint64 allocations = GetAllocationCount();
+        Stopwatch stopwatch;
+        stopwatch.start();
+        for (int i = 0; i < iterations; i++) {
+            function(data);
+        }
+        Time elapsed = stopwatch.getElapsedTime();
+        allocations = GetAllocationCount() - allocations;
+        ReportThroughput(name, static_cast<uint64>(scene.size()) * iterations, elapsed);
+        LogInfo(sTag, "{:<32} {:>10} allocations per load", name, allocations / iterations);
+        return true;
+    };
+
+    if (!measure("Accept, parse and DOM", &LoadWithDOM, scene) ||
+        !measure("Single pass reader", &LoadWithReader, scene) ||
+        !measure("Compiled scene", &LoadCompiled, compiled)) {
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace benchmark
@@ -0,0 +1,140 @@
+#include "Benchmark.hpp"
+
+#include <System/IOStream.hpp>
+#include <System/LogManager.hpp>
+#include <System/PackFile.hpp>
+#include <System/Stopwatch.hpp>
+#include <System/String.hpp>
+#include <Util/AsyncTaskRunner.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <cstdlib>
+
+using namespace engine;
+
+namespace benchmark {
+
+namespace {
+
+const StringView sTag("PackFileBenchmark");
+
+using FileList = Vector<std::pair<String, String>>;
+
+uint64 ReadFiles(const FileList& files, Vector<byte>* buffer) {
+    uint64 total = 0;
+    for (const auto& file : files) {
+        IOStream stream;
+        if (!stream.open(file.second, "rb")) {
+            continue;
+        }
+        buffer->resize(stream.getSize());
+        total += stream.read(buffer->data(), 1, buffer->size());
+    }
+    return total;
+}
+
+uint64 ReadArchive(const PackFile& archive, const FileList& files, AsyncTaskRunner* taskRunner, Vector<byte>* buffer) {
+    uint64 total = 0;
+    for (const auto& file : files) {
+        size_t size = 0;
+        if (!archive.getFileSize(file.first, &size)) {
+            continue;
+        }
+        buffer->resize(size);
+        if (archive.read(file.first, 0, size, buffer->data(), taskRunner)) {
+            total += size;
+        }
+    }
+    return total;
+}
+
+}  // namespace
+
+/**
+ * Compares reading the files of a directory from the OS file system and
+ * from uncompressed and LZ4 archives, decompressing the blocks serially
+ * and in parallel.
+ *
+ * Usage: Benchmark PackFile <directory> [<iterations>] [<block size>]
+ */
+int RunPackFileBenchmark(int argc, char* argv[]) {
+    if (argc < 1) {
+        LogError(sTag, "Usage: Benchmark PackFile <directory> [<iterations>] [<block size>]");
+        return 1;
+    }
+    int iterations = (argc >= 2) ? std::atoi(argv[1]) : 10;
+    uint32 blockSize = (argc >= 3) ? static_cast<uint32>(std::strtoul(argv[2], nullptr, 10))
+                                   : PackFile::sDefaultBlockSize;
+
+    std::filesystem::path root(argv[0]);
+    std::error_code error;
+    FileList files;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root, error)) {
+        if (entry.is_regular_file()) {
+            std::string relativePath = std::filesystem::relative(entry.path(), root).generic_string();
+            files.emplace_back(String(relativePath), String(entry.path().string()));
+        }
+    }
+    if (error || files.empty()) {
+        LogError(sTag, "No files found in: {}", argv[0]);
+        return 1;
+    }
+
+    std::filesystem::path tempDirectory = std::filesystem::temp_directory_path(error);
+    std::filesystem::path rawPath = tempDirectory / "Benchmark_raw.pak";
+    std::filesystem::path lz4Path = tempDirectory / "Benchmark_lz4.pak";
+    String rawFilename(rawPath.string());
+    String lz4Filename(lz4Path.string());
+    if (!PackFile::Create(rawFilename, files) ||
+        !PackFile::Create(lz4Filename, files, PackFile::Codec::LZ4, blockSize)) {
+        return 1;
+    }
+
+    PackFile rawArchive;
+    PackFile lz4Archive;
+    if (!rawArchive.open(rawFilename) || !lz4Archive.open(lz4Filename)) {
+        return 1;
+    }
+
+    uint64 rawSize = std::filesystem::file_size(rawPath, error);
+    uint64 lz4Size = std::filesystem::file_size(lz4Path, error);
+    LogInfo(sTag,
+            "{} files, raw archive {} bytes, LZ4 archive {} bytes ({:.1f}%)",
+            files.size(),
+            rawSize,
+            lz4Size,
+            (rawSize > 0) ? 100.0 * static_cast<double>(lz4Size) / static_cast<double>(rawSize) : 0.0);
+
+    AsyncTaskRunner taskRunner;
+    Vector<byte> buffer;
+
+    auto measure = [&](const StringView& name, auto&& function) {
+        // Warm up the page cache so only the read path is compared
+        function();
+        uint64 total = 0;
+        Stopwatch stopwatch;
+        stopwatch.start();
+        for (int i = 0; i < iterations; i++) {
+            total += function();
+        }
+        ReportThroughput(name, total, stopwatch.getElapsedTime());
+    };
+
+    measure("OS files", [&]() { return ReadFiles(files, &buffer); });
+    measure("Raw archive", [&]() { return ReadArchive(rawArchive, files, nullptr, &buffer); });
+    measure("LZ4 archive (serial)", [&]() { return ReadArchive(lz4Archive, files, nullptr, &buffer); });
+    measure("LZ4 archive (parallel)", [&]() { return ReadArchive(lz4Archive, files, &taskRunner, &buffer); });
+
+    rawArchive.close();
+    lz4Archive.close();
+    std::filesystem::remove(rawPath, error);
+    std::filesystem::remove(lz4Path, error);
+    return 0;
+}
+
+}  // namespace benchmark
@@ -0,0 +1,101 @@
+#include "Benchmark.hpp"
+
+#include <System/LogManager.hpp>
+#include <System/Signal.hpp>
+#include <System/Stopwatch.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <cstdlib>
+
+using namespace engine;
+
+namespace benchmark {
+
+namespace {
+
+const StringView sTag("SignalBenchmark");
+
+const int sSlotCounts[] = {1, 10, 100};
+
+constexpr int sEmitterThreads = 4;
+
+// Per thread, so the slots don't contend on anything but the signal
+thread_local uint64 tChecksum = 0;
+
+void Report(const char* operation, int slots, uint64 emits, const Time& time) {
+    double nanoseconds = static_cast<double>(time.asNanoseconds()) / static_cast<double>(emits);
+    std::string name = std::string(operation) + " " + std::to_string(slots) + " slots";
+    LogInfo(sTag, "{:<44} {:>8.2f} ns/emit {:>8.2f} ns/slot", name, nanoseconds, nanoseconds / slots);
+}
+
+// Emits from several threads at the same time, like the input events
+// received while the file watcher reports changes
+Time MeasureConcurrentEmit(Signal<int>& signal, int iterations) {
+    std::atomic<bool> start(false);
+    Vector<std::thread> threads;
+    for (int i = 0; i < sEmitterThreads; i++) {
+        threads.emplace_back([&signal, &start, iterations]() {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            for (int j = 0; j < iterations; j++) {
+                signal.emit(int(j));
+            }
+        });
+    }
+
+    Stopwatch stopwatch;
+    stopwatch.start();
+    start.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return stopwatch.getElapsedTime();
+}
+
+}  // namespace
+
+/**
+ * Measures the cost of emitting a signal with 1, 10 and 100 connected
+ * slots, from a single thread and from several threads at once.
+ *
+ * Usage: Benchmark Signal [<iterations>]
+ */
+int RunSignalBenchmark(int argc, char* argv[]) {
+    int iterations = (argc >= 1) ? std::atoi(argv[0]) : 1 << 20;
+    if (iterations <= 0) {
+        LogError(sTag, "Usage: Benchmark Signal [<iterations>]");
+        return 1;
+    }
+
+    // The engine always runs more than one thread, and the C library
+    // only takes the fast single thread path of a mutex before that
+    std::thread([]() {}).join();
+
+    for (int slots : sSlotCounts) {
+        Signal<int> signal;
+        for (int i = 0; i < slots; i++) {
+            signal.connect([](int value) { tChecksum += static_cast<uint64>(value); });
+        }
+
+        int emits = iterations / slots;
+        Stopwatch stopwatch;
+        stopwatch.start();
+        for (int i = 0; i < emits; i++) {
+            signal.emit(int(i));
+        }
+        Report("emit", slots, emits, stopwatch.getElapsedTime());
+
+        Time time = MeasureConcurrentEmit(signal, emits);
+        Report("concurrent emit", slots, static_cast<uint64>(emits) * sEmitterThreads, time);
+    }
+
+    LogDebug(sTag, "Checksum {}", tChecksum);
+    return 0;
+}
+
+}  // namespace benchmark
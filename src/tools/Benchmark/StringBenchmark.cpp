@@ -0,0 +1,124 @@
+#include "Benchmark.hpp"
+
+#include <System/LogManager.hpp>
+#include <System/Stopwatch.hpp>
+#include <System/String.hpp>
+#include <Util/UTF.hpp>
+
+#include <string>
+
+#include <cstdlib>
+
+using namespace engine;
+
+namespace benchmark {
+
+namespace {
+
+const StringView sTag("StringBenchmark");
+
+// Same kind of text used by the StringTests, repeated up to the size
+String MakeText(size_t size, bool ascii) {
+    const String asciiWords[] = {"The quick brown fox ", "jumps over ", "the lazy dog. ", "textures/grass.png "};
+    const String mixedWords[] = {"The quick brown fox ", u8"Привет ", u8"水氵 ", u8"\U0001F600\U0001F603 "};
+
+    String text;
+    size_t index = 0;
+    while (text.getSize() < size) {
+        text += ascii ? asciiWords[index % 4] : mixedWords[index % 4];
+        index = index * 7 + 3;
+    }
+    return text.subString(0, size);
+}
+
+}  // namespace
+
+/**
+ * Measures the code point operations of ASCII and mixed script strings,
+ * and the indexing by walking the UTF-8 iterators for reference.
+ *
+ * Usage: Benchmark String [<characters>] [<iterations>]
+ */
+int RunStringBenchmark(int argc, char* argv[]) {
+    int characters = (argc >= 1) ? std::atoi(argv[0]) : 1 << 12;
+    int iterations = (argc >= 2) ? std::atoi(argv[1]) : 100;
+    if (characters <= 0 || iterations <= 0) {
+        LogError(sTag, "Usage: Benchmark String [<characters>] [<iterations>]");
+        return 1;
+    }
+
+    const String texts[] = {MakeText(static_cast<size_t>(characters), true),
+                            MakeText(static_cast<size_t>(characters), false)};
+    const char* names[] = {"ASCII", "Mixed"};
+
+    uint64 checksum = 0;
+    for (int t = 0; t < 2; t++) {
+        const String& text = texts[t];
+        String::size_type size = text.getSize();
+        LogInfo(sTag, "{} text with {} characters, {} UTF-8 bytes", names[t], size, text.getDataSize());
+
+        // The throughput is reported relative to the UTF-8 size
+        auto measure = [&](const char* operation, auto&& function) {
+            Stopwatch stopwatch;
+            stopwatch.start();
+            for (int i = 0; i < iterations; i++) {
+                function();
+            }
+            std::string name = std::string(names[t]) + " " + operation;
+            ReportThroughput(StringView(name.data(), name.size()), static_cast<uint64>(text.getDataSize()) * iterations,
+                             stopwatch.getElapsedTime());
+        };
+
+        measure("iterator indexing", [&]() {
+            // Each access walks the string from the beginning
+            for (String::size_type i = 0; i < size; i += 16) {
+                auto it = text.cbegin();
+                for (String::size_type j = 0; j < i; j++) {
+                    ++it;
+                }
+                checksum += static_cast<byte>(*it.getPtr());
+            }
+        });
+        measure("getSize", [&]() {
+            for (String::size_type i = 0; i < size; i += 16) {
+                checksum += text.getSize();
+            }
+        });
+        measure("operator[]", [&]() {
+            for (String::size_type i = 0; i < size; i += 16) {
+                checksum += text[i].getData()[0];
+            }
+        });
+        measure("subString", [&]() {
+            for (String::size_type i = 0; i + 16 <= size; i += 16) {
+                checksum += text.subString(i, 16).getDataSize();
+            }
+        });
+        measure("find", [&]() {
+            String needle = text.subString(size - 8, 8);
+            for (String::size_type i = 0; i < size; i += size / 16 + 1) {
+                checksum += text.find(needle, i);
+            }
+        });
+        const String erased(u8"水 erased");
+        measure("erase and insert", [&]() {
+            String copy = text;
+            for (String::size_type i = 0; i + 16 <= size; i += 64) {
+                copy.erase(i, 8);
+                copy.insert(i, erased);
+            }
+            checksum += copy.getSize();
+        });
+        const String replaced(u8"é");
+        measure("replace", [&]() {
+            String copy = text;
+            copy.replace("quick", replaced);
+            checksum += copy.getSize();
+        });
+    }
+
+    LogDebug(sTag, "Checksum {}", checksum);
+    return 0;
+}
+
+}  // namespace benchmark
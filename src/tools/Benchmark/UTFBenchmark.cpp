@@ -0,0 +1,147 @@
+#include "Benchmark.hpp"
+
+#include <System/LogManager.hpp>
+#include <System/Stopwatch.hpp>
+#include <Util/UTF.hpp>
+
+#include <string>
+
+#include <cstdlib>
+
+using namespace engine;
+
+namespace benchmark {
+
+namespace {
+
+const StringView sTag("UTFBenchmark");
+
+struct InstructionSetEntry {
+    const char* name;
+    utf::InstructionSet instructionSet;
+};
+
+const InstructionSetEntry sInstructionSets[] = {
+    {"Scalar", utf::InstructionSet::SCALAR},
+    {"SSE4", utf::InstructionSet::SSE4},
+    {"AVX2", utf::InstructionSet::AVX2},
+    {"NEON", utf::InstructionSet::NEON},
+};
+
+// Mostly ASCII text with some words in other scripts, like the text of
+// the user interfaces and the asset paths
+std::basic_string<char32> MakeMixedText(size_t size) {
+    const std::basic_string<char32> words[] = {
+        U"The quick brown fox jumps over the lazy dog. ",
+        U"Привет мир ",
+        U"textures/terrain/grass_01.png ",
+        U"你好世界 ",
+        U"Mañana été ",
+        U"\U0001F600 ",
+    };
+
+    std::basic_string<char32> text;
+    size_t index = 0;
+    while (text.size() < size) {
+        text += words[index % 6];
+        index = index * 7 + 3;
+    }
+    text.resize(size);
+    return text;
+}
+
+}  // namespace
+
+/**
+ * Measures the UTF-8 validation and the conversions between UTF-8, UTF-16
+ * and UTF-32 of mixed script text with each supported instruction set,
+ * and the templated conversions for reference.
+ *
+ * Usage: Benchmark UTF [<characters>] [<iterations>]
+ */
+int RunUTFBenchmark(int argc, char* argv[]) {
+    int characters = (argc >= 1) ? std::atoi(argv[0]) : 1 << 20;
+    int iterations = (argc >= 2) ? std::atoi(argv[1]) : 100;
+    if (characters <= 0 || iterations <= 0) {
+        LogError(sTag, "Usage: Benchmark UTF [<characters>] [<iterations>]");
+        return 1;
+    }
+
+    std::basic_string<char32> text32 = MakeMixedText(static_cast<size_t>(characters));
+    std::basic_string<char16> text16;
+    std::basic_string<char> text8;
+    utf::UtfToUtf<utf::UTF_32, utf::UTF_16>(text32.begin(), text32.end(), &text16);
+    utf::UtfToUtf<utf::UTF_32, utf::UTF_8>(text32.begin(), text32.end(), &text8);
+    // Read through a volatile so the compiler can't hoist the conversions
+    // of the same text out of the loops
+    const char* volatile source8 = text8.data();
+    const char* begin8 = source8;
+    const char* end8 = begin8 + text8.size();
+    LogInfo(sTag, "Text with {} characters, {} UTF-8 bytes", characters, text8.size());
+
+    // The throughput is reported relative to the UTF-8 size
+    auto measure = [&](const std::string& name, auto&& function) {
+        if (!function()) {
+            LogError(sTag, "{} failed", name);
+            return false;
+        }
+        bool result = true;
+        Stopwatch stopwatch;
+        stopwatch.start();
+        for (int i = 0; i < iterations; i++) {
+            result = function() && result;
+        }
+        if (!result) {
+            LogError(sTag, "{} failed", name);
+            return false;
+        }
+        ReportThroughput(StringView(name.data(), name.size()), static_cast<uint64>(text8.size()) * iterations,
+                         stopwatch.getElapsedTime());
+        return true;
+    };
+
+    std::basic_string<char> output8;
+    std::basic_string<char16> output16;
+    std::basic_string<char32> output32;
+    auto templateValidation = [&]() { return utf::IsValid<utf::UTF_8>(source8, end8); };
+    auto templateUtf8ToUtf16 = [&]() {
+        output16.clear();
+        return utf::UtfToUtf<utf::UTF_8, utf::UTF_16>(source8, end8, &output16) == end8;
+    };
+    auto templateUtf16ToUtf8 = [&]() {
+        output8.clear();
+        return utf::UtfToUtf<utf::UTF_16, utf::UTF_8>(text16.cbegin(), text16.cend(), &output8) == text16.cend();
+    };
+    auto validation = [&]() { return utf::IsValidUtf8(begin8, end8); };
+    auto utf8ToUtf16 = [&]() {
+        output16.clear();
+        return utf::Utf8ToUtf16(begin8, end8, &output16);
+    };
+    auto utf8ToUtf32 = [&]() {
+        output32.clear();
+        return utf::Utf8ToUtf32(begin8, end8, &output32);
+    };
+    auto utf16ToUtf8 = [&]() {
+        output8.clear();
+        return utf::Utf16ToUtf8(text16.data(), text16.data() + text16.size(), &output8);
+    };
+
+    bool succeeded = measure("Template validation", templateValidation) &&
+                     measure("Template UTF-8 to UTF-16", templateUtf8ToUtf16) &&
+                     measure("Template UTF-16 to UTF-8", templateUtf16ToUtf8);
+
+    utf::InstructionSet defaultInstructionSet = utf::GetInstructionSet();
+    for (const auto& entry : sInstructionSets) {
+        if (!succeeded || !utf::SetInstructionSet(entry.instructionSet)) {
+            continue;
+        }
+        std::string name(entry.name);
+        succeeded = measure(name + " validation", validation) && measure(name + " UTF-8 to UTF-16", utf8ToUtf16) &&
+                    measure(name + " UTF-8 to UTF-32", utf8ToUtf32) && measure(name + " UTF-16 to UTF-8", utf16ToUtf8);
+    }
+    utf::SetInstructionSet(defaultInstructionSet);
+
+    return succeeded ? 0 : 1;
+}
+
+}  // namespace benchmark
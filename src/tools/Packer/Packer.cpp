@@ -0,0 +1,94 @@
+#include <Util/Prerequisites.hpp>
+
+#include <System/LogManager.hpp>
+#include <System/PackFile.hpp>
+#include <System/String.hpp>
+#include <System/StringView.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace engine;
+
+namespace {
+
+const StringView sTag("Packer");
+
+}  // namespace
+
+/**
+ * Packs the content of one or more directories in a PackFile archive
+ * that can be used as a FileSystem search path.
+ *
+ * Usage: Packer [--codec none|lz4] [--block-size <bytes>] <output.pak> <directory> [<directory>...]
+ */
+int main(int argc, char* argv[]) {
+    // PackFile reports its errors through the LogManager
+    LogManager logManager("Packer", "packer.log");
+    logManager.enableFileLogging(false);
+
+    PackFile::Codec codec = PackFile::Codec::NONE;
+    uint32 blockSize = PackFile::sDefaultBlockSize;
+
+    int first = 1;
+    for (; first + 1 < argc; first += 2) {
+        const char* option = argv[first];
+        const char* value = argv[first + 1];
+        if (std::strcmp(option, "--codec") == 0) {
+            if (std::strcmp(value, "none") == 0) {
+                codec = PackFile::Codec::NONE;
+            } else if (std::strcmp(value, "lz4") == 0) {
+                codec = PackFile::Codec::LZ4;
+            } else {
+                LogError(sTag, "Unknown codec: {}", value);
+                return 1;
+            }
+        } else if (std::strcmp(option, "--block-size") == 0) {
+            blockSize = static_cast<uint32>(std::strtoul(value, nullptr, 10));
+        } else {
+            break;
+        }
+    }
+
+    if (argc - first < 2) {
+        LogError(sTag,
+                 "Usage: {} [--codec none|lz4] [--block-size <bytes>] <output{}> <directory> [<directory>...]",
+                 argv[0],
+                 PackFile::sExtension);
+        return 1;
+    }
+
+    const char* output = argv[first];
+
+    Vector<std::pair<String, String>> files;
+    for (int i = first + 1; i < argc; i++) {
+        std::filesystem::path root(argv[i]);
+        std::error_code error;
+        if (!std::filesystem::is_directory(root, error)) {
+            LogError(sTag, "Directory not found: {}", argv[i]);
+            return 1;
+        }
+
+        // The files are stored relative to the packed directory
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(root, error)) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+            std::string relativePath = std::filesystem::relative(entry.path(), root).generic_string();
+            files.emplace_back(String(relativePath), String(entry.path().string()));
+        }
+    }
+
+    if (!PackFile::Create(output, files, codec, blockSize)) {
+        return 1;
+    }
+
+    LogInfo(sTag, "Packed {} files in: {}", files.size(), output);
+    return 0;
+}
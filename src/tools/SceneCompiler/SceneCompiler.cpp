@@ -0,0 +1,88 @@
+#include <Util/Prerequisites.hpp>
+
+#include <Renderer/SceneDescriptor.hpp>
+#include <System/IOStream.hpp>
+#include <System/LogManager.hpp>
+#include <System/String.hpp>
+#include <System/StringView.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <filesystem>
+
+using namespace engine;
+
+namespace {
+
+const StringView sTag("SceneCompiler");
+
+bool ReadFile(const String& filename, Vector<byte>* content) {
+    IOStream stream;
+    if (!stream.open(filename, "rb")) {
+        return false;
+    }
+    content->resize(stream.getSize());
+    return stream.read(content->data(), 1, content->size()) == content->size();
+}
+
+bool WriteFile(const String& filename, const Vector<byte>& content) {
+    IOStream stream;
+    if (!stream.open(filename, "wb")) {
+        return false;
+    }
+    return stream.write(content.data(), 1, content.size()) == content.size();
+}
+
+}  // namespace
+
+/**
+ * Compiles json scenes to the binary format that the SceneManager loads
+ * without parsing. The compiled scene is written next to the json one
+ * unless an output path is provided.
+ *
+ * Usage: SceneCompiler <input.json> [<output.scene>]
+ */
+int main(int argc, char* argv[]) {
+    LogManager logManager("SceneCompiler", "scenecompiler.log");
+    logManager.enableFileLogging(false);
+
+    if (argc < 2 || argc > 3) {
+        LogError(sTag, "Usage: {} <input.json> [<output{}>]", argv[0], SceneDescriptor::sCompiledExtension);
+        return 1;
+    }
+
+    String input(argv[1]);
+    String output;
+    if (argc == 3) {
+        output = argv[2];
+    } else {
+        std::filesystem::path outputPath(argv[1]);
+        outputPath.replace_extension(std::filesystem::path(SceneDescriptor::sCompiledExtension.getData()));
+        output = String(outputPath.string());
+    }
+
+    Vector<byte> content;
+    if (!ReadFile(input, &content)) {
+        LogError(sTag, "Could not read scene: {}", input);
+        return 1;
+    }
+
+    SceneDescriptor descriptor;
+    String error;
+    if (!descriptor.loadFromMemory(content.data(), content.size(), &error)) {
+        LogError(sTag, "Invalid scene: {} ({})", input, error);
+        return 1;
+    }
+
+    descriptor.saveToBinary(&content);
+    if (!WriteFile(output, content)) {
+        LogError(sTag, "Could not write compiled scene: {}", output);
+        return 1;
+    }
+
+    LogInfo(sTag,
+            "Compiled {} objects and {} models in: {}",
+            descriptor.getObjectCount(),
+            descriptor.models.size(),
+            output);
+    return 0;
+}
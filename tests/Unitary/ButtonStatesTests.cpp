@@ -0,0 +1,53 @@
+#include <catch2/catch.hpp>
+
+#include <Input/Button.hpp>
+
+using namespace engine;
+
+TEST_CASE("ButtonStates update", "[ButtonStates]") {
+    ButtonStates states;
+    const size_t first = 0;
+    const size_t last = ButtonStates::sButtonCount - 1;
+
+    SECTION("Buttons start released") {
+        for (size_t i = 0; i < ButtonStates::sButtonCount; i++) {
+            REQUIRE_FALSE(states.isDown(i));
+            REQUIRE_FALSE(states.wentDown(i));
+            REQUIRE_FALSE(states.wentUp(i));
+        }
+    }
+    SECTION("Pressing and releasing a button") {
+        states.update(last, true);
+        REQUIRE(states.isDown(last));
+        REQUIRE(states.wentDown(last));
+        REQUIRE_FALSE(states.wentUp(last));
+        REQUIRE_FALSE(states.isDown(first));
+
+        states.advanceFrame();
+        REQUIRE(states.isDown(last));
+        REQUIRE_FALSE(states.wentDown(last));
+
+        states.update(last, true);
+        REQUIRE_FALSE(states.wentDown(last));
+
+        states.update(last, false);
+        REQUIRE_FALSE(states.isDown(last));
+        REQUIRE(states.wentUp(last));
+
+        states.advanceFrame();
+        REQUIRE_FALSE(states.wentUp(last));
+    }
+    SECTION("A button pressed and released in the same frame") {
+        states.update(first, true);
+        states.update(first, false);
+        REQUIRE_FALSE(states.isDown(first));
+        REQUIRE(states.wentDown(first));
+        REQUIRE(states.wentUp(first));
+    }
+    SECTION("Invalid buttons are never down") {
+        states.update(ButtonStates::sInvalidIndex, true);
+        REQUIRE_FALSE(states.isDown(ButtonStates::sInvalidIndex));
+        REQUIRE_FALSE(states.wentDown(ButtonStates::sInvalidIndex));
+        REQUIRE_FALSE(states.isDown(last));
+    }
+}
@@ -0,0 +1,158 @@
+#include <catch2/catch.hpp>
+
+#include <System/EventBus.hpp>
+#include <Util/AsyncTaskRunner.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace engine;
+
+namespace {
+
+struct ValueEvent {
+    int value;
+};
+
+struct OtherEvent {
+    int value;
+};
+
+struct SumEvent {
+    int value;
+
+    bool coalesce(const SumEvent& next) {
+        value += next.value;
+        return true;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("EventBus dispatch", "[EventBus]") {
+    EventBus bus;
+    Vector<int> received;
+    bus.subscribe<ValueEvent>([&received](const ValueEvent& event) { received.push_back(event.value); });
+
+    SECTION("Events are delivered when dispatched") {
+        bus.post(ValueEvent{1});
+        bus.post(ValueEvent{2});
+        REQUIRE(received.empty());
+        bus.dispatch();
+        REQUIRE(received == Vector<int>{1, 2});
+        bus.dispatch();
+        REQUIRE(received == Vector<int>{1, 2});
+    }
+    SECTION("Events of different types are delivered in the posting order") {
+        bus.subscribe<OtherEvent>([&received](const OtherEvent& event) { received.push_back(-event.value); });
+        bus.post(ValueEvent{1});
+        bus.post(ValueEvent{2});
+        bus.post(OtherEvent{3});
+        bus.post(ValueEvent{4});
+        bus.dispatch();
+        REQUIRE(received == Vector<int>{1, 2, -3, 4});
+    }
+    SECTION("Events are delivered only to the handlers of their type") {
+        int other = 0;
+        bus.subscribe<OtherEvent>([&other](const OtherEvent& event) { other += event.value; });
+        bus.post(OtherEvent{5});
+        bus.post(ValueEvent{1});
+        bus.dispatch();
+        REQUIRE(received == Vector<int>{1});
+        REQUIRE(other == 5);
+    }
+    SECTION("Events posted while dispatching are delivered by the next dispatch") {
+        bus.subscribe<OtherEvent>([&bus](const OtherEvent& event) { bus.post(ValueEvent{event.value}); });
+        bus.post(OtherEvent{3});
+        bus.dispatch();
+        REQUIRE(received.empty());
+        bus.dispatch();
+        REQUIRE(received == Vector<int>{3});
+    }
+    SECTION("Disconnected handlers are not called") {
+        SignalConnection connection =
+            bus.subscribe<ValueEvent>([&received](const ValueEvent& event) { received.push_back(-event.value); });
+        bus.post(ValueEvent{1});
+        bus.dispatch();
+        connection.disconnect();
+        bus.post(ValueEvent{2});
+        bus.dispatch();
+        REQUIRE(received == Vector<int>{1, -1, 2});
+    }
+    SECTION("Coalescable events are merged") {
+        int sum = 0;
+        int count = 0;
+        bus.subscribe<SumEvent>([&sum, &count](const SumEvent& event) {
+            sum += event.value;
+            count++;
+        });
+        for (int i = 1; i <= 10; i++) {
+            bus.post(SumEvent{i});
+        }
+        bus.dispatch();
+        REQUIRE(sum == 55);
+        REQUIRE(count == 1);
+    }
+    SECTION("Coalescable events are not merged across other events") {
+        Vector<int> sums;
+        bus.subscribe<SumEvent>([&sums](const SumEvent& event) { sums.push_back(event.value); });
+        bus.post(SumEvent{1});
+        bus.post(SumEvent{2});
+        bus.post(ValueEvent{10});
+        bus.post(SumEvent{3});
+        bus.dispatch();
+        REQUIRE(sums == Vector<int>{3, 3});
+        REQUIRE(received == Vector<int>{10});
+    }
+}
+
+TEST_CASE("EventBus worker dispatch", "[EventBus]") {
+    AsyncTaskRunner taskRunner;
+    EventBus bus;
+    bus.setTaskRunner(&taskRunner);
+
+    std::atomic<int> workerSum(0);
+    std::atomic<int> otherSum(0);
+    int mainSum = 0;
+    bus.subscribe<ValueEvent>([&workerSum](const ValueEvent& event) { workerSum += event.value; },
+                              EventDispatch::WORKER_THREAD);
+    bus.subscribe<OtherEvent>([&otherSum](const OtherEvent& event) { otherSum += event.value; },
+                              EventDispatch::WORKER_THREAD);
+    bus.subscribe<ValueEvent>([&mainSum](const ValueEvent& event) { mainSum += event.value; });
+
+    SECTION("The dispatch waits for the worker handlers") {
+        for (int frame = 0; frame < 100; frame++) {
+            for (int i = 1; i <= 10; i++) {
+                bus.post(ValueEvent{i});
+                bus.post(OtherEvent{i});
+            }
+            bus.dispatch();
+            REQUIRE(workerSum == (frame + 1) * 55);
+            REQUIRE(otherSum == (frame + 1) * 55);
+        }
+        REQUIRE(mainSum == 100 * 55);
+    }
+    SECTION("The worker handlers finish before the other handlers are called") {
+        // The OtherEvent is posted after, but its worker handler runs first
+        int seenSum = 0;
+        bus.subscribe<ValueEvent>([&otherSum, &seenSum](const ValueEvent&) { seenSum = otherSum; });
+        bus.post(ValueEvent{1});
+        bus.post(OtherEvent{5});
+        bus.dispatch();
+        REQUIRE(seenSum == 5);
+    }
+    SECTION("The exceptions of the worker handlers are rethrown") {
+        bus.subscribe<OtherEvent>([](const OtherEvent&) { throw std::runtime_error("handler"); },
+                                  EventDispatch::WORKER_THREAD);
+        bus.post(OtherEvent{1});
+        bus.post(ValueEvent{1});
+        REQUIRE_THROWS_AS(bus.dispatch(), std::runtime_error);
+
+        // The events of the failed dispatch are not delivered again
+        bus.post(ValueEvent{2});
+        bus.dispatch();
+        REQUIRE(workerSum == 3);
+        REQUIRE(otherSum == 1);
+    }
+}
@@ -1,12 +1,39 @@
 #include <catch2/catch.hpp>
 
+#include "TemporaryDirectory.hpp"
+
 #include <System/FileSystem.hpp>
+#include <System/IOStream.hpp>
+#include <System/PackFile.hpp>
 #include <System/String.hpp>
+#include <System/StringBuilder.hpp>
+
+#include <cstring>
+#include <utility>
 
 using namespace engine;
 
 static FileSystem fileSystem;
 
+namespace {
+
+// Restores the search paths of the shared FileSystem when destroyed
+class SearchPathsGuard {
+public:
+    explicit SearchPathsGuard(Vector<String> searchPaths) : m_previous(fileSystem.getSearchPaths()) {
+        fileSystem.setSearchPaths(std::move(searchPaths));
+    }
+
+    ~SearchPathsGuard() {
+        fileSystem.setSearchPaths(m_previous);
+    }
+
+private:
+    Vector<String> m_previous;
+};
+
+}  // namespace
+
 TEST_CASE("FileSystem::IsAbsolutePath", "[FileSystem]") {
     SECTION("true if the path is absolute, false otherwise") {
 #if PLATFORM_IS(PLATFORM_WINDOWS)
@@ -154,3 +181,330 @@ TEST_CASE("FileSystem::Join", "[FileSystem]") {
         REQUIRE(joined1 == joined2);
     }
 }
+
+TEST_CASE("FileSystem paths without allocations", "[FileSystem]") {
+    InlineString<64> result;
+
+    SECTION("must normalize the paths into the builder") {
+#if PLATFORM_IS(PLATFORM_WINDOWS)
+        REQUIRE(fileSystem.normalizePathInto("a\\..\\..\\b\\.\\c\\\\d\\..", &result) == StringView("..\\b\\c"));
+        REQUIRE(fileSystem.normalizePathInto("C:\\..\\a", &result) == StringView("C:\\a"));
+#else
+        REQUIRE(fileSystem.normalizePathInto("a/../../b/./c//d/..", &result) == StringView("../b/c"));
+        REQUIRE(fileSystem.normalizePathInto("/../a", &result) == StringView("/a"));
+#endif
+        REQUIRE(fileSystem.normalizePathInto("", &result) == StringView("."));
+        REQUIRE(result.isInline());
+    }
+    SECTION("must join the paths into the builder") {
+#if PLATFORM_IS(PLATFORM_WINDOWS)
+        REQUIRE(fileSystem.joinInto("textures", "grass.png", &result) == StringView("textures\\grass.png"));
+#else
+        REQUIRE(fileSystem.joinInto("textures", "grass.png", &result) == StringView("textures/grass.png"));
+#endif
+        REQUIRE(fileSystem.joinInto("", "grass.png", &result) == StringView("grass.png"));
+        REQUIRE(result.isInline());
+    }
+    SECTION("must give the same result than the String versions") {
+        String path = fileSystem.join("models", "..", "textures", "terrain", "grass.png");
+        REQUIRE(fileSystem.normalizePathInto(path, &result) == fileSystem.normalizePath(path));
+    }
+}
+
+TEST_CASE("FileSystem path cache", "[FileSystem]") {
+    const char* filename = "cache.txt";
+    TemporaryDirectory directory("FileSystemTests");
+    SearchPathsGuard searchPathsGuard({directory.getPath()});
+
+    SECTION("missing files must be cached") {
+        PathCacheStats before = fileSystem.getPathCacheStats();
+        REQUIRE_FALSE(fileSystem.fileExists(filename));
+        REQUIRE_FALSE(fileSystem.fileExists(filename));
+        PathCacheStats after = fileSystem.getPathCacheStats();
+        REQUIRE(after.misses == before.misses + 1);
+        REQUIRE(after.missingHits == before.missingHits + 1);
+        REQUIRE(after.missingEntries == 1);
+    }
+    SECTION("found files must be cached") {
+        IOStream file;
+        REQUIRE(fileSystem.openFile(filename, "wb", &file));
+        file.close();
+
+        PathCacheStats before = fileSystem.getPathCacheStats();
+        REQUIRE(fileSystem.fileExists(filename));
+        REQUIRE(fileSystem.openFile(filename, "rb", &file));
+        PathCacheStats after = fileSystem.getPathCacheStats();
+        REQUIRE(after.misses == before.misses + 1);
+        REQUIRE(after.hits == before.hits + 1);
+        REQUIRE(after.entries == 1);
+        REQUIRE(after.missingEntries == 0);
+    }
+    SECTION("creating a file must invalidate its missing entry") {
+        REQUIRE_FALSE(fileSystem.fileExists(filename));
+        IOStream file;
+        REQUIRE(fileSystem.openFile(filename, "wb", &file));
+        file.close();
+        REQUIRE(fileSystem.fileExists(filename));
+    }
+    SECTION("invalidated entries must be resolved again") {
+        REQUIRE_FALSE(fileSystem.fileExists(filename));
+        IOStream file;
+        REQUIRE(file.open(directory.getPath(filename), "wb"));
+        file.close();
+        REQUIRE_FALSE(fileSystem.fileExists(filename));
+        fileSystem.invalidatePathCache(filename);
+        REQUIRE(fileSystem.fileExists(filename));
+        REQUIRE(fileSystem.getPathCacheStats().entries == 1);
+        fileSystem.invalidatePathCache();
+        REQUIRE(fileSystem.getPathCacheStats().entries == 0);
+    }
+}
+
+TEST_CASE("FileSystem::MapFile", "[FileSystem]") {
+    const char* filename = "map.txt";
+    TemporaryDirectory directory("FileSystemTests");
+    SearchPathsGuard searchPathsGuard({directory.getPath()});
+
+    IOStream file;
+    REQUIRE(fileSystem.openFile(filename, "wb", &file));
+    REQUIRE(file.write("mapped data", 1, 11) == 11);
+    file.close();
+
+    SECTION("must map the whole file") {
+        MappedFile mappedFile;
+        REQUIRE(fileSystem.mapFile(filename, &mappedFile, MappedFile::Advice::SEQUENTIAL));
+        REQUIRE(mappedFile.getSize() == 11);
+        REQUIRE(String::FromUtf8(mappedFile.begin(), mappedFile.end()) == "mapped data");
+        mappedFile.close();
+        REQUIRE_FALSE(mappedFile.isOpen());
+    }
+    SECTION("must open the empty files") {
+        REQUIRE(fileSystem.openFile("empty.txt", "wb", &file));
+        file.close();
+
+        MappedFile mappedFile;
+        REQUIRE(fileSystem.mapFile("empty.txt", &mappedFile));
+        REQUIRE(mappedFile.isOpen());
+        REQUIRE(mappedFile.getSize() == 0);
+        REQUIRE(mappedFile.begin() == mappedFile.end());
+    }
+    SECTION("must fail if the file does not exist") {
+        MappedFile mappedFile;
+        REQUIRE_FALSE(fileSystem.mapFile("missing.txt", &mappedFile));
+        REQUIRE_FALSE(mappedFile.isOpen());
+    }
+}
+
+TEST_CASE("FileSystem::ReadFilesAsync", "[FileSystem]") {
+    const char* filename = "async.txt";
+    TemporaryDirectory directory("FileSystemTests");
+    SearchPathsGuard searchPathsGuard({directory.getPath()});
+
+    IOStream file;
+    REQUIRE(fileSystem.openFile(filename, "wb", &file));
+    REQUIRE(file.write("0123456789", 1, 10) == 10);
+    file.close();
+
+    SECTION("must complete all the requests of the batch") {
+        byte destination[4] = {};
+        Vector<FileReadRequest> requests(3);
+        requests[0].filename = filename;
+        requests[1].filename = filename;
+        requests[1].offset = 6;
+        requests[1].size = 4;
+        requests[1].destination = destination;
+        requests[2].filename = "missing.txt";
+
+        Vector<FileReadRequest> completed = fileSystem.readFilesAsync(std::move(requests)).get();
+        REQUIRE(completed.size() == 3);
+        REQUIRE(completed[0].succeeded);
+        REQUIRE(completed[0].bytesRead == 10);
+        REQUIRE(String::FromUtf8(completed[0].data.begin(), completed[0].data.end()) == "0123456789");
+        REQUIRE(completed[1].succeeded);
+        REQUIRE(completed[1].data.empty());
+        REQUIRE(std::memcmp(destination, "6789", 4) == 0);
+        REQUIRE_FALSE(completed[2].succeeded);
+    }
+    SECTION("must fail the reads past the end of the file") {
+        Vector<FileReadRequest> requests(2);
+        requests[0].filename = filename;
+        requests[0].offset = 8;
+        requests[0].size = 4;
+        requests[1].filename = filename;
+        requests[1].offset = 11;
+
+        Vector<FileReadRequest> completed = fileSystem.readFilesAsync(std::move(requests)).get();
+        REQUIRE_FALSE(completed[0].succeeded);
+        REQUIRE(completed[0].bytesRead == 2);
+        REQUIRE_FALSE(completed[1].succeeded);
+    }
+}
+
+TEST_CASE("FileSystem compressed archives", "[FileSystem]") {
+    TemporaryDirectory directory("FileSystemTests");
+    String filename = directory.getPath("packed.txt");
+    String content;
+    for (int i = 0; i < 1000; i++) {
+        content += "compressed data ";
+    }
+
+    IOStream file;
+    REQUIRE(file.open(filename, "wb"));
+    REQUIRE(file.write(content.toUtf8().data(), 1, content.getSize()) == content.getSize());
+    file.close();
+
+    Vector<std::pair<String, String>> files;
+    files.emplace_back("packed.txt", filename);
+    String archiveFilename = directory.getPath("packed.pak");
+    REQUIRE(PackFile::Create(archiveFilename, files, PackFile::Codec::LZ4, 1024));
+    SearchPathsGuard searchPathsGuard({archiveFilename});
+
+    SECTION("must decompress the loaded files") {
+        String data;
+        REQUIRE(fileSystem.loadFileData("packed.txt", &data));
+        REQUIRE(data == content);
+    }
+    SECTION("must decompress the opened and mapped files") {
+        REQUIRE(fileSystem.openFile("packed.txt", "rb", &file));
+        REQUIRE(file.getSize() == content.getSize());
+
+        MappedFile mappedFile;
+        REQUIRE(fileSystem.mapFile("packed.txt", &mappedFile));
+        REQUIRE(String::FromUtf8(mappedFile.begin(), mappedFile.end()) == content);
+    }
+    SECTION("must decompress the asynchronous reads") {
+        Vector<FileReadRequest> requests(1);
+        requests[0].filename = "packed.txt";
+        requests[0].offset = 1020;
+        requests[0].size = 16;
+
+        Vector<FileReadRequest> completed = fileSystem.readFilesAsync(std::move(requests)).get();
+        REQUIRE(completed[0].succeeded);
+        REQUIRE(String::FromUtf8(completed[0].data.begin(), completed[0].data.end()) == "ata compressed d");
+    }
+}
+
+TEST_CASE("FileSystem archives along with directories", "[FileSystem]") {
+    TemporaryDirectory directory("FileSystemTests");
+    String searchPath = directory.createDirectory("data");
+
+    auto writeFile = [](const String& filename, const char* content) {
+        IOStream stream;
+        size_t size = std::strlen(content);
+        return stream.open(filename, "wb") && stream.write(content, 1, size) == size;
+    };
+    REQUIRE(writeFile(directory.getPath("packed.txt"), "packed"));
+    REQUIRE(writeFile(directory.getPath("empty.txt"), ""));
+    REQUIRE(writeFile(fileSystem.join(searchPath, "packed.txt"), "loose"));
+    REQUIRE(writeFile(fileSystem.join(searchPath, "loose.txt"), "loose"));
+
+    Vector<std::pair<String, String>> files;
+    files.emplace_back("packed.txt", directory.getPath("packed.txt"));
+    files.emplace_back("empty.txt", directory.getPath("empty.txt"));
+    REQUIRE(PackFile::Create(searchPath + PackFile::sExtension, files));
+
+    SearchPathsGuard searchPathsGuard({searchPath});
+
+    SECTION("must look up the archive before the directory") {
+        String data;
+        REQUIRE(fileSystem.loadFileData("packed.txt", &data));
+        REQUIRE(data == "packed");
+    }
+    SECTION("must find the loose files missing in the archive") {
+        String data;
+        REQUIRE(fileSystem.loadFileData("loose.txt", &data));
+        REQUIRE(data == "loose");
+    }
+    SECTION("must open the empty files of the archive") {
+        IOStream file;
+        REQUIRE(fileSystem.openFile("empty.txt", "rb", &file));
+        REQUIRE(file.getSize() == 0);
+    }    SECTION("the mapped files must keep the archive after the search paths change") {
+        MappedFile mappedFile;
+        REQUIRE(fileSystem.mapFile("packed.txt", &mappedFile));
+        fileSystem.setSearchPaths({});
+        REQUIRE(String::FromUtf8(mappedFile.begin(), mappedFile.end()) == "packed");
+    }
+}
+
+TEST_CASE("FileSystem file watching", "[FileSystem]") {
+    const char* filename = "watched/watched.txt";
+    TemporaryDirectory directory("FileSystemTests");
+    TemporaryDirectory overrideDirectory("FileSystemTests");
+    directory.createDirectory("watched");
+    directory.createDirectory("ignored");
+    overrideDirectory.createDirectory("watched");
+    SearchPathsGuard searchPathsGuard({overrideDirectory.getPath(), directory.getPath()});
+    fileSystem.watchFolder("watched");
+    if (!fileSystem.setFileWatchingEnabled(true)) {
+        // The changes can't be detected in this platform
+        fileSystem.unwatchFolder("watched");
+        return;
+    }
+
+    Vector<String> changes;
+    size_t emitCount = 0;
+    auto onFilesChanged = [&changes, &emitCount](const Vector<String>& files) {
+        changes = files;
+        emitCount++;
+    };
+    SignalConnection connection = fileSystem.onFilesChanged.connect(onFilesChanged);
+
+    SECTION("must coalesce the changes of a file") {
+        IOStream file;
+        for (int i = 0; i < 3; i++) {
+            REQUIRE(file.open(directory.getPath(filename), "wb"));
+            REQUIRE(file.write("data", 1, 4) == 4);
+            file.close();
+        }
+
+        fileSystem.pollFileChanges();
+        REQUIRE(emitCount == 1);
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes[0] == fileSystem.normalizePath(filename));
+
+        fileSystem.pollFileChanges();
+        REQUIRE(emitCount == 1);
+    }
+    SECTION("must invalidate the cached path of the changed files") {
+        REQUIRE_FALSE(fileSystem.fileExists(filename));
+        IOStream file;
+        REQUIRE(file.open(directory.getPath(filename), "wb"));
+        file.close();
+        REQUIRE_FALSE(fileSystem.fileExists(filename));
+
+        fileSystem.pollFileChanges();
+        REQUIRE(fileSystem.fileExists(filename));
+    }
+    SECTION("must only watch the watched folders") {
+        IOStream file;
+        REQUIRE(file.open(directory.getPath("ignored/ignored.txt"), "wb"));
+        file.close();
+
+        fileSystem.pollFileChanges();
+        REQUIRE(emitCount == 0);
+    }
+    SECTION("must ignore the changes of the shadowed files") {
+        IOStream file;
+        REQUIRE(file.open(overrideDirectory.getPath(filename), "wb"));
+        file.close();
+        fileSystem.pollFileChanges();
+        REQUIRE(emitCount == 1);
+
+        REQUIRE(file.open(directory.getPath(filename), "wb"));
+        file.close();
+        fileSystem.pollFileChanges();
+        REQUIRE(emitCount == 1);
+
+        REQUIRE(file.open(overrideDirectory.getPath(filename), "wb"));
+        REQUIRE(file.write("data", 1, 4) == 4);
+        file.close();
+        fileSystem.pollFileChanges();
+        REQUIRE(emitCount == 2);
+        REQUIRE(changes[0] == fileSystem.normalizePath(filename));
+    }
+
+    fileSystem.onFilesChanged.disconnect(connection);
+    fileSystem.setFileWatchingEnabled(false);
+    fileSystem.unwatchFolder("watched");
+}
@@ -0,0 +1,172 @@
+#include <catch2/catch.hpp>
+
+#include <System/String.hpp>
+#include <System/StringView.hpp>
+#include <Util/Container/FlatHashMap.hpp>
+#include <Util/Container/FlatHashSet.hpp>
+
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+
+using namespace engine;
+
+TEST_CASE("FlatHashMap", "[FlatHashMap]") {
+    FlatHashMap<int, int> map;
+
+    SECTION("Empty maps don't allocate") {
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getCapacity() == 0);
+        REQUIRE(map.find(1) == map.end());
+        REQUIRE(map.erase(1) == 0);
+        REQUIRE(map.begin() == map.end());
+    }
+    SECTION("Elements can be inserted and found") {
+        REQUIRE(map.insert(std::make_pair(1, 10)).second);
+        REQUIRE(map.emplace(2, 20).second);
+        REQUIRE(map.tryEmplace(3, 30).second);
+        map[4] = 40;
+        REQUIRE(map.getSize() == 4);
+
+        REQUIRE_FALSE(map.insert(std::make_pair(1, 11)).second);
+        REQUIRE_FALSE(map.tryEmplace(2, 21).second);
+        REQUIRE(map.getSize() == 4);
+
+        for (int i = 1; i <= 4; i++) {
+            auto it = map.find(i);
+            REQUIRE(it != map.end());
+            REQUIRE(it->first == i);
+            REQUIRE(it->second == i * 10);
+        }
+        REQUIRE_FALSE(map.contains(5));
+        REQUIRE(map[5] == 0);
+        REQUIRE(map.contains(5));
+    }
+    SECTION("The map grows and keeps its elements") {
+        for (int i = 0; i < 10000; i++) {
+            map[i * 7] = i;
+        }
+        REQUIRE(map.getSize() == 10000);
+        REQUIRE(map.getCapacity() - map.getCapacity() / 8 >= map.getSize());
+        for (int i = 0; i < 10000; i++) {
+            REQUIRE(map.find(i * 7)->second == i);
+            REQUIRE_FALSE(map.contains(i * 7 + 1));
+        }
+    }
+    SECTION("Erased elements are not found and their slots are reused") {
+        for (int i = 0; i < 1000; i++) {
+            map[i] = i;
+        }
+        for (int i = 0; i < 1000; i += 2) {
+            REQUIRE(map.erase(i) == 1);
+        }
+        REQUIRE(map.getSize() == 500);
+        for (int i = 0; i < 1000; i++) {
+            REQUIRE(map.contains(i) == (i % 2 == 1));
+        }
+
+        // Inserting and erasing without growing fills the table with
+        // deleted slots, they must be reclaimed
+        size_t capacity = map.getCapacity();
+        for (int i = 1000; i < 100000; i++) {
+            map[i] = i;
+            map.erase(map.find(i));
+        }
+        REQUIRE(map.getCapacity() == capacity);
+        REQUIRE(map.getSize() == 500);
+        REQUIRE(map.find(999)->second == 999);
+    }
+    SECTION("Iteration visits each element once") {
+        for (int i = 0; i < 100; i++) {
+            map[i] = i;
+        }
+        map.erase(50);
+        int sum = 0;
+        size_t count = 0;
+        for (const auto& pair : map) {
+            sum += pair.second;
+            count++;
+        }
+        REQUIRE(count == 99);
+        REQUIRE(sum == 99 * 100 / 2 - 50);
+    }
+    SECTION("The map behaves like std::map") {
+        std::map<int, int> reference;
+        std::mt19937 random(42);
+        for (int i = 0; i < 20000; i++) {
+            int key = static_cast<int>(random() % 2000);
+            if (random() % 3 == 0) {
+                REQUIRE(map.erase(key) == reference.erase(key));
+            } else {
+                map[key] = i;
+                reference[key] = i;
+            }
+        }
+        REQUIRE(map.getSize() == reference.size());
+        for (const auto& pair : reference) {
+            REQUIRE(map.find(pair.first)->second == pair.second);
+        }
+    }
+}
+
+TEST_CASE("FlatHashMap with String keys", "[FlatHashMap]") {
+    FlatHashMap<String, int> map;
+    map["textures/grass.png"] = 1;
+    map[String("textures/rock.png")] = 2;
+
+    SECTION("The map is looked up with a StringView") {
+        REQUIRE(map.find(StringView("textures/grass.png"))->second == 1);
+        REQUIRE(map.contains(StringView("textures/rock.png")));
+        REQUIRE_FALSE(map.contains(StringView("textures/grass")));
+        REQUIRE(map.erase(StringView("textures/rock.png")) == 1);
+        REQUIRE(map.getSize() == 1);
+    }
+    SECTION("The elements with a non-trivial type are moved when growing") {
+        for (int i = 0; i < 1000; i++) {
+            map[String(std::to_string(i))] = i;
+        }
+        for (int i = 0; i < 1000; i++) {
+            REQUIRE(map.find(String(std::to_string(i)))->second == i);
+        }
+        REQUIRE(map.find(StringView("textures/grass.png"))->second == 1);
+    }
+    SECTION("The map can be copied and moved") {
+        FlatHashMap<String, int> copy(map);
+        copy["textures/sand.png"] = 3;
+        REQUIRE(copy.getSize() == 3);
+        REQUIRE(map.getSize() == 2);
+
+        FlatHashMap<String, int> moved(std::move(copy));
+        REQUIRE(moved.getSize() == 3);
+        REQUIRE(copy.isEmpty());  // NOLINT(bugprone-use-after-move)
+        REQUIRE(moved.find(StringView("textures/sand.png"))->second == 3);
+
+        copy = moved;
+        REQUIRE(copy.getSize() == 3);
+        map = std::move(moved);
+        REQUIRE(map.getSize() == 3);
+    }
+    SECTION("Move-only values are supported") {
+        FlatHashMap<String, std::unique_ptr<int>> pointers;
+        for (int i = 0; i < 100; i++) {
+            pointers.tryEmplace(String(std::to_string(i)), std::make_unique<int>(i));
+        }
+        REQUIRE(*pointers.find(StringView("42"))->second == 42);
+        pointers.clear();
+        REQUIRE(pointers.isEmpty());
+        REQUIRE_FALSE(pointers.contains(StringView("42")));
+    }
+}
+
+TEST_CASE("FlatHashSet", "[FlatHashMap]") {
+    FlatHashSet<String> set;
+    REQUIRE(set.insert("first").second);
+    REQUIRE(set.emplace("second").second);
+    REQUIRE_FALSE(set.insert("first").second);
+    REQUIRE(set.getSize() == 2);
+    REQUIRE(set.contains(StringView("second")));
+    REQUIRE(*set.find(StringView("first")) == StringView("first"));
+    REQUIRE(set.erase(String("first")) == 1);
+    REQUIRE_FALSE(set.contains(StringView("first")));
+}
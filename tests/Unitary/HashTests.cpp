@@ -0,0 +1,32 @@
+#include <catch2/catch.hpp>
+
+#include <Util/Hash.hpp>
+
+#include <cstring>
+
+using namespace engine;
+
+TEST_CASE("Hash64 reference values", "[Hash]") {
+    SECTION("Empty input") {
+        REQUIRE(Hash64("", 0) == 0xEF46DB3751D8E999ULL);
+    }
+    SECTION("Short input") {
+        REQUIRE(Hash64("a", 1) == 0xD24EC4F1A98C6E5BULL);
+    }
+    SECTION("Input longer than a stripe") {
+        const char* text = "Nobody inspects the spammish repetition";
+        REQUIRE(Hash64(text, std::strlen(text)) == 0xFBCEA83C8A378BF1ULL);
+    }
+}
+
+TEST_CASE("Hash64 seeds", "[Hash]") {
+    const char* text = "Engine";
+    REQUIRE(Hash64(text, std::strlen(text), 1) != Hash64(text, std::strlen(text)));
+    REQUIRE(Hash64(text, std::strlen(text), 1) == Hash64(text, std::strlen(text), 1));
+}
+
+TEST_CASE("HashString64 reference values", "[Hash]") {
+    static_assert(HashString64("", 0) == 0xCBF29CE484222325ULL);
+    REQUIRE(HashString64("a", 1) == 0xAF63DC4C8601EC8CULL);
+    REQUIRE(HashString64("foobar", 6) == 0x85944171F73967E8ULL);
+}
@@ -0,0 +1,107 @@
+#include <catch2/catch.hpp>
+
+#include <Renderer/ModelDescriptor.hpp>
+#include <Renderer/SceneDescriptor.hpp>
+#include <System/String.hpp>
+
+#include <cstring>
+
+using namespace engine;
+
+namespace {
+
+template <typename Descriptor>
+bool Load(Descriptor& descriptor, const char* data, String* error = nullptr) {
+    return descriptor.loadFromMemory(reinterpret_cast<const byte*>(data), std::strlen(data), error);
+}
+
+}  // namespace
+
+TEST_CASE("SceneDescriptor loading", "[JSONReader]") {
+    SceneDescriptor descriptor;
+    String error;
+
+    SECTION("Valid scenes are loaded") {
+        const char* scene = R"({
+            "name": "Scene",
+            "unknown": {"values": [1, 2, {"model": 3}]},
+            "data": {
+                "objects": [
+                    {"model": "a.obj", "position": [1, 2, 3], "rotation": [0, 90, 0], "scale": 2},
+                    {"model": "b.obj"},
+                    {"model": "a.obj"}
+                ]
+            }
+        })";
+        REQUIRE(Load(descriptor, scene, &error));
+        REQUIRE(descriptor.name == "Scene");
+        REQUIRE(descriptor.hasData);
+        REQUIRE(descriptor.getObjectCount() == 3);
+        REQUIRE(descriptor.models.size() == 2);
+        REQUIRE(descriptor.models[descriptor.objectModels[0]] == "a.obj");
+        REQUIRE(descriptor.objectTransforms[0].getTranslation().x == 1.0f);
+        REQUIRE(descriptor.objectTransforms[0].getTranslation().z == 3.0f);
+        REQUIRE(descriptor.models[descriptor.objectModels[1]] == "b.obj");
+        REQUIRE(descriptor.objectTransforms[1].getTranslation().y == 0.0f);
+        // The models are only stored once
+        REQUIRE(descriptor.objectModels[2] == descriptor.objectModels[0]);
+    }
+    SECTION("Members are optional") {
+        REQUIRE(Load(descriptor, "{}"));
+        REQUIRE(descriptor.name.isEmpty());
+        REQUIRE_FALSE(descriptor.hasData);
+    }
+    SECTION("Invalid syntax is rejected") {
+        REQUIRE_FALSE(Load(descriptor, R"({"name": "Scene", "data": {)", &error));
+        REQUIRE_FALSE(error.isEmpty());
+        REQUIRE_FALSE(Load(descriptor, ""));
+    }
+    SECTION("Wrong types are rejected") {
+        REQUIRE_FALSE(Load(descriptor, R"({"name": 1})", &error));
+        REQUIRE_FALSE(error.isEmpty());
+        REQUIRE_FALSE(Load(descriptor, R"({"data": {"objects": [{"scale": "big"}]}})"));
+        REQUIRE_FALSE(Load(descriptor, R"({"data": {"objects": [{"model": "a", "position": [1, 2, 3, 4]}]}})"));
+        REQUIRE_FALSE(Load(descriptor, R"({"data": {"objects": [{"position": [1, 2, 3]}]}})"));
+    }
+    SECTION("The root must be an object") {
+        REQUIRE_FALSE(Load(descriptor, "[]"));
+        REQUIRE_FALSE(Load(descriptor, "\"scene\""));
+    }
+}
+
+TEST_CASE("ModelDescriptor loading", "[JSONReader]") {
+    ModelDescriptor descriptor;
+
+    SECTION("Valid descriptors are loaded") {
+        const char* model = R"({
+            "properties": {"scale": 0.5, "rotation": [90, 0, 0]},
+            "materials": [
+                {"id": 3, "textures": [{"type": "diffuse", "name": "a.png"}, {"type": "specular"}]}
+            ],
+            "meshes": [{"name": "body", "material_id": 3}, {"material_id": 1}]
+        })";
+        REQUIRE(Load(descriptor, model));
+        REQUIRE(descriptor.hasProperties);
+        REQUIRE(descriptor.hasScale);
+        REQUIRE(descriptor.scale == 0.5f);
+        REQUIRE(descriptor.hasRotation);
+        REQUIRE(descriptor.rotation.x == 90.0f);
+        REQUIRE(descriptor.hasMaterials);
+        REQUIRE(descriptor.materials.size() == 1);
+        REQUIRE(descriptor.materials[0].hasId);
+        REQUIRE(descriptor.materials[0].id == 3);
+        // Textures without name and meshes without name are skipped
+        REQUIRE(descriptor.materials[0].textures.size() == 1);
+        REQUIRE(descriptor.materials[0].textures[0].first == "diffuse");
+        REQUIRE(descriptor.materials[0].textures[0].second == "a.png");
+        REQUIRE(descriptor.meshes.size() == 1);
+        REQUIRE(descriptor.meshes[0].name == "body");
+        REQUIRE(descriptor.meshes[0].materialId == 3);
+    }
+    SECTION("Invalid descriptors are reset") {
+        REQUIRE_FALSE(Load(descriptor, R"({"properties": {"scale": 2}, "materials": {}})"));
+        REQUIRE_FALSE(descriptor.hasProperties);
+        REQUIRE_FALSE(Load(descriptor, R"({"meshes": [{"name": "body", "material_id": "3"}]})"));
+        REQUIRE(descriptor.meshes.empty());
+    }
+}
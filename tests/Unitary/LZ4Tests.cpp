@@ -0,0 +1,119 @@
+#include <catch2/catch.hpp>
+
+#include <Util/Container/Vector.hpp>
+#include <Util/LZ4.hpp>
+
+using namespace engine;
+
+namespace {
+
+Vector<byte> Compress(const Vector<byte>& data) {
+    Vector<byte> compressed(lz4::GetCompressBound(data.size()));
+    size_t size = lz4::Compress(data.data(), data.size(), compressed.data(), compressed.size());
+    REQUIRE(size > 0);
+    compressed.resize(size);
+    return compressed;
+}
+
+bool Decompress(const Vector<byte>& compressed, size_t size, Vector<byte>* data) {
+    data->assign(size, 0);
+    return lz4::Decompress(compressed.data(), compressed.size(), data->data(), data->size());
+}
+
+// Deterministic data that can't be compressed
+Vector<byte> CreateNoise(size_t size) {
+    Vector<byte> data(size);
+    uint32 state = 12345;
+    for (byte& value : data) {
+        state = state * 1103515245 + 12345;
+        value = static_cast<byte>(state >> 16);
+    }
+    return data;
+}
+
+// Data with short literal runs between long repetitions
+Vector<byte> CreatePattern(size_t size) {
+    Vector<byte> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<byte>((i % 1000 < 600) ? 'a' : i % 7);
+    }
+    return data;
+}
+
+}  // namespace
+
+TEST_CASE("lz4 round trip", "[LZ4]") {
+    SECTION("must compress and decompress the empty data") {
+        Vector<byte> data;
+        Vector<byte> compressed = Compress(data);
+        REQUIRE(compressed.size() == 1);
+
+        Vector<byte> decompressed;
+        REQUIRE(Decompress(compressed, 0, &decompressed));
+        REQUIRE(lz4::Decompress(compressed.data(), compressed.size(), nullptr, 0));
+    }
+    SECTION("must keep the data smaller than a match") {
+        Vector<byte> data = {'a', 'b', 'c'};
+        Vector<byte> decompressed;
+        REQUIRE(Decompress(Compress(data), data.size(), &decompressed));
+        REQUIRE(decompressed == data);
+    }
+    SECTION("must compress the repeated data") {
+        Vector<byte> data = CreatePattern(100000);
+        Vector<byte> compressed = Compress(data);
+        REQUIRE(compressed.size() < data.size() / 10);
+
+        Vector<byte> decompressed;
+        REQUIRE(Decompress(compressed, data.size(), &decompressed));
+        REQUIRE(decompressed == data);
+    }
+    SECTION("must keep the data that can't be compressed") {
+        Vector<byte> data = CreateNoise(100000);
+        Vector<byte> compressed = Compress(data);
+        REQUIRE(compressed.size() <= lz4::GetCompressBound(data.size()));
+
+        Vector<byte> decompressed;
+        REQUIRE(Decompress(compressed, data.size(), &decompressed));
+        REQUIRE(decompressed == data);
+    }
+    SECTION("must fail if the destination is too small") {
+        Vector<byte> data = CreateNoise(1000);
+        Vector<byte> compressed(data.size() / 2);
+        REQUIRE(lz4::Compress(data.data(), data.size(), compressed.data(), compressed.size()) == 0);
+    }
+}
+
+TEST_CASE("lz4 corrupted data", "[LZ4]") {
+    Vector<byte> data = CreatePattern(10000);
+    Vector<byte> compressed = Compress(data);
+    Vector<byte> decompressed;
+
+    SECTION("must fail if the decompressed size doesn't match") {
+        REQUIRE_FALSE(Decompress(compressed, data.size() - 1, &decompressed));
+        REQUIRE_FALSE(Decompress(compressed, data.size() + 1, &decompressed));
+    }
+    SECTION("must fail if the data is truncated") {
+        for (size_t size = 0; size < compressed.size(); size++) {
+            Vector<byte> truncated(compressed.begin(), compressed.begin() + size);
+            REQUIRE_FALSE(Decompress(truncated, data.size(), &decompressed));
+        }
+    }
+    SECTION("must fail if a match starts before the data") {
+        // Literal "a" followed by a match with an offset of 2
+        Vector<byte> invalid = {0x10, 'a', 0x02, 0x00, 0x00};
+        REQUIRE_FALSE(Decompress(invalid, 5, &decompressed));
+    }
+    SECTION("must fail if a match has an offset of zero") {
+        Vector<byte> invalid = {0x10, 'a', 0x00, 0x00, 0x00};
+        REQUIRE_FALSE(Decompress(invalid, 5, &decompressed));
+    }
+    SECTION("must stay inside the buffers with any corrupted byte") {
+        for (size_t i = 0; i < compressed.size(); i++) {
+            Vector<byte> corrupted = compressed;
+            corrupted[i] ^= 0xA5;
+            // The result doesn't matter, only that the buffers are not
+            // overflowed
+            Decompress(corrupted, data.size(), &decompressed);
+        }
+    }
+}
@@ -0,0 +1,171 @@
+#include <catch2/catch.hpp>
+
+#include <System/IOStream.hpp>
+#include <System/LogManager.hpp>
+#include <System/String.hpp>
+#include <System/StringView.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace engine;
+
+namespace {
+
+const StringView sTag("LogManagerTests");
+
+std::string ReadContent(const char* filename) {
+    IOStream stream;
+    if (!stream.open(filename, "rb")) {
+        return std::string();
+    }
+    std::string content(stream.getSize(), '\0');
+    stream.read(content.data(), 1, content.size());
+    return content;
+}
+
+size_t CountLines(const char* filename) {
+    std::string content = ReadContent(filename);
+    return static_cast<size_t>(std::count(content.begin(), content.end(), '\n'));
+}
+
+}  // namespace
+
+TEST_CASE("LogManager asynchronous writer", "[LogManager]") {
+    const char* filename = "LogManagerTests.log";
+    std::remove(filename);
+
+    LogManager logManager("LogManagerTests", filename);
+    logManager.enableConsoleLogging(false);
+
+    SECTION("Messages are written synchronously before initialize") {
+        LogInfo(sTag, "Synchronous {}", 1);
+        logManager.flush();
+        REQUIRE(CountLines(filename) == 1);
+    }
+    SECTION("Messages from several threads are written by the writer") {
+        logManager.setOverflowPolicy(LogOverflowPolicy::BLOCK);
+        logManager.setBufferCapacity(16);
+        logManager.initialize();
+
+        Vector<std::thread> threads;
+        for (int i = 0; i < 4; i++) {
+            threads.emplace_back([i]() {
+                for (int j = 0; j < 100; j++) {
+                    LogInfo(sTag, "Thread {} message {}", i, j);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        logManager.flush();
+        REQUIRE(CountLines(filename) == 400);
+        REQUIRE(logManager.getStatistics().droppedRecords == 0);
+        logManager.shutdown();
+    }
+    SECTION("Shutdown writes the queued messages") {
+        logManager.initialize();
+        for (int i = 0; i < 10; i++) {
+            LogWarning(sTag, "Queued message {}", i);
+        }
+        logManager.shutdown();
+        REQUIRE(CountLines(filename) == 10);
+    }
+    SECTION("Non ASCII messages are written whole") {
+        const String message(u8"Caf\u00e9 \u6c34 \U0001F600");
+        logManager.initialize();
+        LogInfo(sTag, "Unicode {}", message);
+        logManager.shutdown();
+
+        std::string content = ReadContent(filename);
+        REQUIRE(content.find("Unicode " + std::string(message.getData())) != std::string::npos);
+    }
+}
+
+TEST_CASE("LogManager filters and deferred formatting", "[LogManager]") {
+    const char* filename = "LogManagerTests_filters.log";
+    std::remove(filename);
+
+    LogManager logManager("LogManagerTests", filename);
+    logManager.enableConsoleLogging(false);
+
+    SECTION("Messages below the minimum priority are skipped") {
+        logManager.setMinPriority(LogPriority::WARN);
+        REQUIRE_FALSE(logManager.isEnabled(LogPriority::INFO, sTag));
+        REQUIRE(logManager.isEnabled(LogPriority::ERROR, sTag));
+        LogInfo(sTag, "Skipped {}", 1);
+        LogError(sTag, "Written {}", 2);
+        logManager.flush();
+        REQUIRE(CountLines(filename) == 1);
+    }
+    SECTION("Tag priorities override the minimum priority") {
+        logManager.setMinPriority(LogPriority::ERROR);
+        logManager.setTagPriority("Verbose", LogPriority::VERBOSE);
+        logManager.setTagPriority("Silent", LogPriority::FATAL);
+        REQUIRE(logManager.isEnabled(LogPriority::VERBOSE, "Verbose"));
+        REQUIRE_FALSE(logManager.isEnabled(LogPriority::ERROR, "Silent"));
+        REQUIRE_FALSE(logManager.isEnabled(LogPriority::WARN, sTag));
+
+        logManager.clearTagPriorities();
+        REQUIRE_FALSE(logManager.isEnabled(LogPriority::VERBOSE, "Verbose"));
+        REQUIRE(logManager.isEnabled(LogPriority::ERROR, "Silent"));
+    }
+    SECTION("Deferred messages are formatted by the writer") {
+        logManager.setMinPriority(LogPriority::INFO);
+        logManager.enableBinaryLogging(true);
+        logManager.initialize();
+        {
+            // The arguments that don't own their data are copied
+            std::string name("first");
+            LogInfo(sTag, "Deferred {} {} {}", StringView(name.data(), name.size()), name.c_str(), 42);
+            name = "changed";
+        }
+        logManager.shutdown();
+
+        std::string content = ReadContent(filename);
+        REQUIRE(content.find("[LogManagerTests/INFO] : Deferred first first 42") != std::string::npos);
+    }
+    SECTION("Deferred messages copy the format strings") {
+        logManager.setMinPriority(LogPriority::INFO);
+        logManager.enableBinaryLogging(true);
+        logManager.initialize();
+        {
+            char format[32] = "Buffer {}";
+            LogInfo(sTag, format, 7);
+            std::strcpy(format, "Changed {}");
+        }
+        LogInfo(sTag, u8"Caf\u00e9 {}", 8);
+        logManager.shutdown();
+
+        std::string content = ReadContent(filename);
+        REQUIRE(content.find("[LogManagerTests/INFO] : Buffer 7") != std::string::npos);
+        REQUIRE(content.find("Caf" + std::string(String(u8"\u00e9").getData()) + " 8") != std::string::npos);
+    }
+    SECTION("Deferred messages with an invalid format are reported") {
+        logManager.setMinPriority(LogPriority::INFO);
+        logManager.enableBinaryLogging(true);
+        logManager.initialize();
+        LogInfo(sTag, "Missing {} {}", 1);
+        LogInfo(sTag, "Next {}", 2);
+        logManager.shutdown();
+
+        std::string content = ReadContent(filename);
+        REQUIRE(content.find("Invalid log format \"Missing {} {}\"") != std::string::npos);
+        REQUIRE(content.find("[LogManagerTests/INFO] : Next 2") != std::string::npos);
+    }
+    SECTION("Deferred messages are formatted immediately without the writer") {
+        logManager.setMinPriority(LogPriority::INFO);
+        logManager.enableBinaryLogging(true);
+        LogWarning(sTag, "Immediate {}", 3.5);
+        logManager.flush();
+
+        std::string content = ReadContent(filename);
+        REQUIRE(content.find("[LogManagerTests/WARN] : Immediate 3.5") != std::string::npos);
+    }
+}
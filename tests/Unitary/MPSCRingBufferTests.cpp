@@ -0,0 +1,100 @@
+#include <catch2/catch.hpp>
+
+#include <Util/Container/MPSCRingBuffer.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <memory>
+#include <thread>
+
+using namespace engine;
+
+TEST_CASE("MPSCRingBuffer single thread", "[MPSCRingBuffer]") {
+    MPSCRingBuffer<std::unique_ptr<int>> buffer(3);
+
+    SECTION("The capacity is rounded to a power of two") {
+        REQUIRE(buffer.getCapacity() == 4);
+    }
+    SECTION("Elements are popped in order") {
+        std::unique_ptr<int> value;
+        REQUIRE_FALSE(buffer.tryPop(&value));
+        for (int i = 0; i < 10; i++) {
+            REQUIRE(buffer.tryPush(std::make_unique<int>(i)));
+            REQUIRE(buffer.tryPop(&value));
+            REQUIRE(*value == i);
+        }
+        REQUIRE_FALSE(buffer.tryPop(&value));
+    }
+    SECTION("Full buffers reject the elements without moving them") {
+        for (int i = 0; i < 4; i++) {
+            REQUIRE(buffer.tryPush(std::make_unique<int>(i)));
+        }
+        auto rejected = std::make_unique<int>(4);
+        REQUIRE_FALSE(buffer.tryPush(std::move(rejected)));
+        REQUIRE(rejected != nullptr);
+
+        std::unique_ptr<int> value;
+        REQUIRE(buffer.tryPop(&value));
+        REQUIRE(*value == 0);
+        REQUIRE(buffer.tryPush(std::move(rejected)));
+    }
+}
+
+TEST_CASE("MPSCRingBuffer small capacities", "[MPSCRingBuffer]") {
+    for (size_t capacity : {0, 1, 2}) {
+        MPSCRingBuffer<int> buffer(capacity);
+        REQUIRE(buffer.getCapacity() == 2);
+
+        int value = 0;
+        for (int i = 0; i < 10; i++) {
+            REQUIRE(buffer.tryPush(2 * i));
+            REQUIRE(buffer.tryPush(2 * i + 1));
+            REQUIRE_FALSE(buffer.tryPush(-1));
+            REQUIRE(buffer.tryPop(&value));
+            REQUIRE(value == 2 * i);
+            REQUIRE(buffer.tryPop(&value));
+            REQUIRE(value == 2 * i + 1);
+            REQUIRE_FALSE(buffer.tryPop(&value));
+        }
+    }
+}
+
+TEST_CASE("MPSCRingBuffer multiple producers", "[MPSCRingBuffer]") {
+    const int producerCount = 4;
+    const int valuesPerProducer = 10000;
+    MPSCRingBuffer<int> buffer(64);
+
+    Vector<std::thread> producers;
+    for (int producer = 0; producer < producerCount; producer++) {
+        producers.emplace_back([&buffer, producer]() {
+            for (int i = 0; i < valuesPerProducer; i++) {
+                int value = producer * valuesPerProducer + i;
+                while (!buffer.tryPush(std::move(value))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer must be seen in order and all the values only once
+    Vector<int> lastValues(producerCount, -1);
+    int received = 0;
+    bool isOrdered = true;
+    while (received < producerCount * valuesPerProducer) {
+        int value;
+        if (!buffer.tryPop(&value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / valuesPerProducer;
+        isOrdered = isOrdered && value % valuesPerProducer == lastValues[producer] + 1;
+        lastValues[producer] = value % valuesPerProducer;
+        received++;
+    }
+
+    for (std::thread& thread : producers) {
+        thread.join();
+    }
+    REQUIRE(isOrdered);
+    int value;
+    REQUIRE_FALSE(buffer.tryPop(&value));
+}
@@ -0,0 +1,161 @@
+#include <catch2/catch.hpp>
+
+#include "TemporaryDirectory.hpp"
+
+#include <System/IOStream.hpp>
+#include <System/PackFile.hpp>
+#include <System/String.hpp>
+#include <Util/AsyncTaskRunner.hpp>
+
+#include <cstring>
+#include <utility>
+
+using namespace engine;
+
+namespace {
+
+bool WriteFile(const String& filename, const char* content) {
+    IOStream stream;
+    if (!stream.open(filename, "wb")) {
+        return false;
+    }
+    size_t size = std::strlen(content);
+    return stream.write(content, 1, size) == size;
+}
+
+Vector<byte> MakeCompressibleData(size_t size) {
+    Vector<byte> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<byte>((i / 7) % 13 + (i % 5));
+    }
+    return data;
+}
+
+bool WriteFile(const String& filename, const Vector<byte>& content) {
+    IOStream stream;
+    if (!stream.open(filename, "wb")) {
+        return false;
+    }
+    return stream.write(content.data(), 1, content.size()) == content.size();
+}
+
+}  // namespace
+
+TEST_CASE("PackFile lookup", "[PackFile]") {
+    TemporaryDirectory directory("PackFileTests");
+    REQUIRE(WriteFile(directory.getPath("first.txt"), "first file"));
+    REQUIRE(WriteFile(directory.getPath("second.txt"), "second"));
+    REQUIRE(WriteFile(directory.getPath("empty.txt"), ""));
+
+    Vector<std::pair<String, String>> files;
+    files.emplace_back("models/first.txt", directory.getPath("first.txt"));
+    files.emplace_back("textures/second.txt", directory.getPath("second.txt"));
+    files.emplace_back("empty.txt", directory.getPath("empty.txt"));
+    REQUIRE(PackFile::Create(directory.getPath("archive.pak"), files));
+
+    PackFile packFile;
+    REQUIRE(packFile.open(directory.getPath("archive.pak")));
+    REQUIRE(packFile.getEntryCount() == 3);
+
+    SECTION("Files are found with their data") {
+        size_t size = 0;
+        const byte* data = packFile.find("models/first.txt", &size);
+        REQUIRE(data != nullptr);
+        REQUIRE(size == 10);
+        REQUIRE(std::memcmp(data, "first file", size) == 0);
+
+        data = packFile.find("textures/second.txt", &size);
+        REQUIRE(data != nullptr);
+        REQUIRE(size == 6);
+        REQUIRE(std::memcmp(data, "second", size) == 0);
+
+        REQUIRE(packFile.find("empty.txt", &size) != nullptr);
+        REQUIRE(size == 0);
+    }
+    SECTION("Paths are normalized") {
+        REQUIRE(packFile.contains("models\\first.txt"));
+        REQUIRE(packFile.contains("/textures/second.txt"));
+        REQUIRE(packFile.contains("./empty.txt"));
+    }
+    SECTION("Missing files are not found") {
+        REQUIRE_FALSE(packFile.contains("first.txt"));
+        REQUIRE_FALSE(packFile.contains("models/first.txt2"));
+        REQUIRE_FALSE(packFile.contains(""));
+    }
+    SECTION("Closed archives contain nothing") {
+        packFile.close();
+        REQUIRE_FALSE(packFile.isOpen());
+        REQUIRE_FALSE(packFile.contains("models/first.txt"));
+    }
+}
+
+TEST_CASE("PackFile validation", "[PackFile]") {
+    TemporaryDirectory directory("PackFileTests");
+    PackFile packFile;
+
+    SECTION("Missing archives can't be opened") {
+        REQUIRE_FALSE(packFile.open(directory.getPath("missing.pak")));
+    }
+    SECTION("Invalid archives can't be opened") {
+        REQUIRE(WriteFile(directory.getPath("invalid.pak"), "this is not an archive, just some random text"));
+        REQUIRE_FALSE(packFile.open(directory.getPath("invalid.pak")));
+        REQUIRE_FALSE(packFile.isOpen());
+    }
+}
+
+TEST_CASE("PackFile compression", "[PackFile]") {
+    TemporaryDirectory directory("PackFileTests");
+    // Spans several blocks with a partial one at the end
+    const uint32 blockSize = 4096;
+    Vector<byte> compressible = MakeCompressibleData(blockSize * 5 + 123);
+    REQUIRE(WriteFile(directory.getPath("compressible.bin"), compressible));
+    REQUIRE(WriteFile(directory.getPath("small.txt"), "x"));
+
+    Vector<std::pair<String, String>> files;
+    files.emplace_back("compressible.bin", directory.getPath("compressible.bin"));
+    files.emplace_back("small.txt", directory.getPath("small.txt"));
+    REQUIRE(PackFile::Create(directory.getPath("lz4.pak"), files, PackFile::Codec::LZ4, blockSize));
+
+    PackFile packFile;
+    REQUIRE(packFile.open(directory.getPath("lz4.pak")));
+
+    SECTION("Compressed files are not mapped directly") {
+        size_t size = 0;
+        REQUIRE(packFile.find("compressible.bin", &size) == nullptr);
+        REQUIRE(packFile.getFileSize("compressible.bin", &size));
+        REQUIRE(size == compressible.size());
+    }
+    SECTION("Files that don't compress are stored raw") {
+        size_t size = 0;
+        const byte* data = packFile.find("small.txt", &size);
+        REQUIRE(data != nullptr);
+        REQUIRE(size == 1);
+        REQUIRE(data[0] == 'x');
+    }
+    SECTION("Whole files are decompressed") {
+        Vector<byte> data(compressible.size());
+        REQUIRE(packFile.read("compressible.bin", 0, data.size(), data.data()));
+        REQUIRE(data == compressible);
+    }
+    SECTION("Ranges across blocks are decompressed") {
+        Vector<byte> data(blockSize + 100);
+        uint64 offset = blockSize - 50;
+        REQUIRE(packFile.read("compressible.bin", offset, data.size(), data.data()));
+        REQUIRE(std::memcmp(data.data(), compressible.data() + offset, data.size()) == 0);
+
+        offset = compressible.size() - 10;
+        REQUIRE(packFile.read("compressible.bin", offset, 10, data.data()));
+        REQUIRE(std::memcmp(data.data(), compressible.data() + offset, 10) == 0);
+    }
+    SECTION("Blocks are decompressed in parallel") {
+        AsyncTaskRunner taskRunner;
+        Vector<byte> data(compressible.size());
+        REQUIRE(packFile.read("compressible.bin", 0, data.size(), data.data(), &taskRunner));
+        REQUIRE(data == compressible);
+    }
+    SECTION("Ranges out of the file are rejected") {
+        byte data[16];
+        REQUIRE_FALSE(packFile.read("compressible.bin", compressible.size() - 8, sizeof(data), data));
+        REQUIRE_FALSE(packFile.read("missing.bin", 0, 1, data));
+    }
+}
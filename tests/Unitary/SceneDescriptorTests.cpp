@@ -0,0 +1,84 @@
+#include <catch2/catch.hpp>
+
+#include <Renderer/SceneDescriptor.hpp>
+#include <System/String.hpp>
+#include <Util/Container/Vector.hpp>
+
+#include <cstring>
+
+using namespace engine;
+
+namespace {
+
+const char* sScene = R"({
+    "name": "Compiled",
+    "data": {
+        "objects": [
+            {"model": "a.obj", "position": [1, 2, 3], "rotation": [0, 90, 0], "scale": 2},
+            {"model": "b.obj", "position": [-1, 0, 5]},
+            {"model": "a.obj", "scale": 0.5}
+        ]
+    }
+})";
+
+}  // namespace
+
+TEST_CASE("SceneDescriptor compiled scenes", "[SceneDescriptor]") {
+    SceneDescriptor source;
+    REQUIRE(source.loadFromMemory(reinterpret_cast<const byte*>(sScene), std::strlen(sScene)));
+
+    Vector<byte> compiled;
+    source.saveToBinary(&compiled);
+
+    SceneDescriptor descriptor;
+    String error;
+
+    SECTION("Compiled scenes keep all the data") {
+        REQUIRE(descriptor.loadFromBinary(compiled.data(), compiled.size(), &error));
+        REQUIRE(descriptor.name == "Compiled");
+        REQUIRE(descriptor.hasData);
+        REQUIRE(descriptor.models == source.models);
+        REQUIRE(descriptor.objectModels == source.objectModels);
+        REQUIRE(descriptor.getObjectCount() == 3);
+        for (size_t i = 0; i < descriptor.getObjectCount(); i++) {
+            const Transform& expected = source.objectTransforms[i];
+            const Transform& transform = descriptor.objectTransforms[i];
+            for (size_t j = 0; j < 3; j++) {
+                REQUIRE(transform.getTranslation()[j] == expected.getTranslation()[j]);
+                REQUIRE(transform.getRotation()[j] == expected.getRotation()[j]);
+                REQUIRE(transform.getScale()[j] == expected.getScale()[j]);
+            }
+        }
+        REQUIRE(descriptor.sourceHash == SceneDescriptor::ComputeSourceHash(reinterpret_cast<const byte*>(sScene),
+                                                                            std::strlen(sScene)));
+    }
+    SECTION("Compiled scenes keep the non ASCII paths") {
+        SceneDescriptor unicode;
+        unicode.name = u8"Escena \u00f1and\u00fa";
+        unicode.models = {u8"modelos/\u00e1rbol.obj", u8"\u6a21\u578b/\U0001F600.obj", "c.obj"};
+        unicode.objectModels = {2, 1, 0};
+        unicode.objectTransforms.resize(3);
+        unicode.saveToBinary(&compiled);
+        REQUIRE(descriptor.loadFromBinary(compiled.data(), compiled.size(), &error));
+        REQUIRE(descriptor.name == unicode.name);
+        REQUIRE(descriptor.models == unicode.models);
+        REQUIRE(descriptor.objectModels == unicode.objectModels);
+    }
+    SECTION("Empty scenes can be compiled") {
+        SceneDescriptor empty;
+        empty.saveToBinary(&compiled);
+        REQUIRE(descriptor.loadFromBinary(compiled.data(), compiled.size()));
+        REQUIRE(descriptor.name.isEmpty());
+        REQUIRE_FALSE(descriptor.hasData);
+        REQUIRE(descriptor.getObjectCount() == 0);
+    }
+    SECTION("Json files are not compiled scenes") {
+        REQUIRE_FALSE(descriptor.loadFromBinary(reinterpret_cast<const byte*>(sScene), std::strlen(sScene), &error));
+        REQUIRE_FALSE(error.isEmpty());
+    }
+    SECTION("Truncated files are rejected") {
+        REQUIRE_FALSE(descriptor.loadFromBinary(compiled.data(), compiled.size() / 2));
+        REQUIRE(descriptor.getObjectCount() == 0);
+        REQUIRE_FALSE(descriptor.loadFromBinary(compiled.data(), 8));
+    }
+}
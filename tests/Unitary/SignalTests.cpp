@@ -2,6 +2,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <sstream>
 
 #include <System/Signal.hpp>
@@ -148,4 +149,74 @@ TEST_CASE("Signal emmition", "[Signal]") {
         sig.emit(1, 5.5F, 0.1, false);
         REQUIRE(gStream.str() == result);
     }
+    SECTION("Slots are called in connection order") {
+        const String result = gStaticFunctionStr + gLambdaFunctionStr + gStaticFunctionStr;
+        Signal<> sig;
+        sig.connect(GlobalFunction);
+        SignalConnection connection = sig.connect(GlobalFunction);
+        sig.connect(lambdaFunction);
+        sig.connect(GlobalFunction);
+        connection.disconnect();
+        sig.emit();
+        REQUIRE(gStream.str() == result);
+    }
+    SECTION("Disconnect a slot while emitting") {
+        const String result = gLambdaFunctionStr + gStaticFunctionStr + gLambdaFunctionStr;
+        Signal<> sig;
+        SignalConnection connection;
+        sig.connect([&connection]() {
+            lambdaFunction();
+            connection.disconnect();
+        });
+        connection = sig.connect(GlobalFunction);
+        sig.emit();
+        sig.emit();
+        REQUIRE_FALSE(connection.isConnected());
+        REQUIRE(gStream.str() == result);
+    }
+    SECTION("Connect a slot while emitting") {
+        const String result = gLambdaFunctionStr + gLambdaFunctionStr + gStaticFunctionStr;
+        Signal<> sig;
+        bool connected = false;
+        sig.connect([&sig, &connected]() {
+            lambdaFunction();
+            if (!connected) {
+                connected = true;
+                sig.connect(GlobalFunction);
+            }
+        });
+        sig.emit();
+        sig.emit();
+        REQUIRE(gStream.str() == result);
+    }
+    SECTION("The slots disconnected while emitting are released after the emission") {
+        auto token = std::make_shared<int>(0);
+        Signal<> sig;
+        SignalConnection connection = sig.connect([token]() {});
+        sig.connect([&connection]() { connection.disconnect(); });
+        REQUIRE(token.use_count() == 2);
+        sig.emit();
+        REQUIRE(token.use_count() == 1);
+    }
+    SECTION("Move assignment keeps the slots") {
+        Signal<> sig;
+        Signal<> other;
+        other.connect(GlobalFunction);
+        sig.connect(lambdaFunction);
+        sig = std::move(other);
+        sig.emit();
+        REQUIRE(gStream.str() == gStaticFunctionStr);
+    }
+    SECTION("Disconnect all the slots while emitting") {
+        const String result = gLambdaFunctionStr + gStaticFunctionStr;
+        Signal<> sig;
+        sig.connect([&sig]() {
+            lambdaFunction();
+            sig.disconnectAll();
+        });
+        sig.connect(GlobalFunction);
+        sig.emit();
+        sig.emit();
+        REQUIRE(gStream.str() == result);
+    }
 }
@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+
+#include <System/SlabAllocator.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+using namespace engine;
+
+namespace {
+
+SlabAllocator& GetNodeAllocator() {
+    static SlabAllocator sNodeAllocator("SlabAllocatorTests_Node", 4);
+    return sNodeAllocator;
+}
+
+// Polymorphic type allocated like the engine objects
+class Node {
+public:
+    virtual ~Node() = default;
+
+    static void* operator new(size_t size) {
+        return GetNodeAllocator().allocate(size);
+    }
+
+    static void operator delete(void* pointer, size_t size) {
+        GetNodeAllocator().deallocate(pointer, size);
+    }
+
+    int value = 0;
+};
+
+class BigNode : public Node {
+public:
+    char data[100] = {};
+};
+
+}  // namespace
+
+TEST_CASE("SlabAllocator", "[SlabAllocator]") {
+    SlabAllocator allocator("SlabAllocatorTests", 4);
+
+    SECTION("Consecutive slots are contiguous and aligned") {
+        void* first = allocator.allocate(24);
+        void* second = allocator.allocate(24);
+        REQUIRE(static_cast<byte*>(second) - static_cast<byte*>(first) == 32);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(first) % alignof(std::max_align_t) == 0);
+        allocator.deallocate(first, 24);
+        allocator.deallocate(second, 24);
+    }
+    SECTION("Freed slots are reused") {
+        void* first = allocator.allocate(16);
+        allocator.deallocate(first, 16);
+        REQUIRE(allocator.allocate(16) == first);
+    }
+    SECTION("The allocator grows by slabs and keeps the addresses") {
+        void* slots[10];
+        for (void*& slot : slots) {
+            slot = allocator.allocate(64);
+            std::fill_n(static_cast<byte*>(slot), 64, byte(0xAB));
+        }
+        REQUIRE(std::unique(std::begin(slots), std::end(slots)) == std::end(slots));
+
+        auto stats = allocator.getStats();
+        REQUIRE(stats.size() == 1);
+        REQUIRE(stats[0].name == StringView("SlabAllocatorTests"));
+        REQUIRE(stats[0].slotSize == 64);
+        REQUIRE(stats[0].slabCount == 3);
+        REQUIRE(stats[0].slotCount == 12);
+        REQUIRE(stats[0].usedCount == 10);
+
+        for (void* slot : slots) {
+            allocator.deallocate(slot, 64);
+        }
+        stats = allocator.getStats();
+        REQUIRE(stats[0].usedCount == 0);
+        REQUIRE(stats[0].peakCount == 10);
+        REQUIRE(stats[0].slabCount == 3);
+    }
+    SECTION("Each size has its own slots") {
+        void* small = allocator.allocate(8);
+        void* big = allocator.allocate(200);
+        REQUIRE(allocator.getStats().size() == 2);
+        allocator.deallocate(small, 8);
+        allocator.deallocate(big, 200);
+    }
+    SECTION("The stats of all the allocators are available") {
+        allocator.deallocate(allocator.allocate(8), 8);
+        auto stats = SlabAllocator::GetAllStats();
+        REQUIRE(std::any_of(stats.begin(), stats.end(), [](const SlabAllocatorStats& allocatorStats) {
+            return allocatorStats.name == StringView("SlabAllocatorTests");
+        }));
+    }
+}
+
+TEST_CASE("SlabAllocator as class allocator", "[SlabAllocator]") {
+    std::unique_ptr<Node> node = std::make_unique<Node>();
+    std::unique_ptr<Node> bigNode = std::make_unique<BigNode>();
+    node->value = 1;
+    bigNode->value = 2;
+
+    auto stats = GetNodeAllocator().getStats();
+    REQUIRE(stats.size() == 2);
+    REQUIRE(stats[0].usedCount == 1);
+    REQUIRE(stats[1].usedCount == 1);
+
+    // The derived objects are freed with their own size
+    bigNode.reset();
+    node.reset();
+    stats = GetNodeAllocator().getStats();
+    REQUIRE(stats[0].usedCount == 0);
+    REQUIRE(stats[1].usedCount == 0);
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch.hpp>
+
+#include <Util/Container/SlotMap.hpp>
+
+#include <memory>
+
+using namespace engine;
+
+TEST_CASE("SlotMap insertion and lookup", "[SlotMap]") {
+    SlotMap<int> slotMap;
+
+    SECTION("Default handles are never valid") {
+        Handle<int> handle;
+        REQUIRE_FALSE(handle.isValid());
+        REQUIRE_FALSE(slotMap.contains(handle));
+        REQUIRE(slotMap.get(handle) == nullptr);
+    }
+    SECTION("Insert and get elements") {
+        auto first = slotMap.insert(1);
+        auto second = slotMap.emplace(2);
+        REQUIRE(first.isValid());
+        REQUIRE(first != second);
+        REQUIRE(slotMap.getSize() == 2);
+        REQUIRE(*slotMap.get(first) == 1);
+        REQUIRE(*slotMap.get(second) == 2);
+    }
+    SECTION("Iterate over the elements") {
+        slotMap.insert(1);
+        slotMap.insert(2);
+        slotMap.insert(3);
+        int sum = 0;
+        for (int value : slotMap) {
+            sum += value;
+        }
+        REQUIRE(sum == 6);
+        REQUIRE(*slotMap.get(slotMap.getHandle(1)) == 2);
+    }
+}
+
+TEST_CASE("SlotMap removal", "[SlotMap]") {
+    SlotMap<std::unique_ptr<int>> slotMap;
+    auto first = slotMap.emplace(std::make_unique<int>(1));
+    auto second = slotMap.emplace(std::make_unique<int>(2));
+    auto third = slotMap.emplace(std::make_unique<int>(3));
+
+    SECTION("Erase keeps the other handles valid") {
+        REQUIRE(slotMap.erase(first));
+        REQUIRE(slotMap.getSize() == 2);
+        REQUIRE(slotMap.get(first) == nullptr);
+        REQUIRE(**slotMap.get(second) == 2);
+        REQUIRE(**slotMap.get(third) == 3);
+    }
+    SECTION("Stale handles are detected") {
+        REQUIRE(slotMap.erase(second));
+        REQUIRE_FALSE(slotMap.erase(second));
+        auto reused = slotMap.emplace(std::make_unique<int>(4));
+        REQUIRE(reused.getIndex() == second.getIndex());
+        REQUIRE(reused != second);
+        REQUIRE_FALSE(slotMap.contains(second));
+        REQUIRE(**slotMap.get(reused) == 4);
+    }
+    SECTION("Clear invalidates all the handles") {
+        slotMap.clear();
+        REQUIRE(slotMap.isEmpty());
+        REQUIRE_FALSE(slotMap.contains(first));
+        REQUIRE_FALSE(slotMap.contains(second));
+        REQUIRE_FALSE(slotMap.contains(third));
+        auto handle = slotMap.emplace(std::make_unique<int>(5));
+        REQUIRE(**slotMap.get(handle) == 5);
+    }
+}
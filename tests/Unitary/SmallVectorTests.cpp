@@ -0,0 +1,113 @@
+#include <catch2/catch.hpp>
+
+#include <System/String.hpp>
+#include <Util/Container/SmallVector.hpp>
+
+#include <memory>
+#include <utility>
+
+using namespace engine;
+
+TEST_CASE("SmallVector storage", "[SmallVector]") {
+    SmallVector<String, 4> vector;
+
+    SECTION("Elements are stored inline up to the inline capacity") {
+        REQUIRE(vector.empty());
+        REQUIRE(vector.capacity() == 4);
+        for (int i = 0; i < 4; i++) {
+            vector.emplace_back(std::to_string(i));
+        }
+        REQUIRE(vector.isInline());
+        REQUIRE(vector.size() == 4);
+
+        vector.push_back("4");
+        REQUIRE_FALSE(vector.isInline());
+        REQUIRE(vector.capacity() >= 5);
+        for (int i = 0; i < 5; i++) {
+            REQUIRE(vector[i] == String(std::to_string(i)));
+        }
+    }
+    SECTION("Elements of the vector can be pushed while it grows") {
+        vector = {"a", "b", "c", "d"};
+        vector.push_back(vector[0]);
+        vector.push_back(vector.back());
+        REQUIRE(vector.size() == 6);
+        REQUIRE(vector[4] == StringView("a"));
+        REQUIRE(vector[5] == StringView("a"));
+    }
+    SECTION("Elements can be inserted and erased") {
+        vector = {"a", "c"};
+        vector.insert(vector.begin() + 1, "b");
+        vector.emplace(vector.end(), "d");
+        vector.insert(vector.begin(), "0");
+        REQUIRE(vector == SmallVector<String, 4>({"0", "a", "b", "c", "d"}));
+
+        vector.erase(vector.begin());
+        vector.erase(vector.begin() + 1, vector.begin() + 3);
+        REQUIRE(vector == SmallVector<String, 4>({"a", "d"}));
+        vector.pop_back();
+        REQUIRE(vector.size() == 1);
+    }
+    SECTION("The vector can be resized") {
+        vector.resize(6, "x");
+        REQUIRE(vector.size() == 6);
+        REQUIRE(vector.back() == StringView("x"));
+        vector.resize(2);
+        REQUIRE(vector.size() == 2);
+        vector.clear();
+        REQUIRE(vector.empty());
+    }
+}
+
+TEST_CASE("SmallVector copy and move", "[SmallVector]") {
+    SmallVector<std::unique_ptr<int>, 2> pointers;
+    pointers.push_back(std::make_unique<int>(1));
+    pointers.push_back(std::make_unique<int>(2));
+
+    SECTION("Inline elements are moved one by one") {
+        SmallVector<std::unique_ptr<int>, 2> moved(std::move(pointers));
+        REQUIRE(moved.isInline());
+        REQUIRE(*moved[1] == 2);
+        REQUIRE(pointers.empty());  // NOLINT(bugprone-use-after-move)
+    }
+    SECTION("Heap buffers are moved without moving the elements") {
+        pointers.push_back(std::make_unique<int>(3));
+        const int* third = pointers[2].get();
+        std::unique_ptr<int>* data = pointers.data();
+
+        SmallVector<std::unique_ptr<int>, 2> moved;
+        moved = std::move(pointers);
+        REQUIRE(moved.data() == data);
+        REQUIRE(moved[2].get() == third);
+        REQUIRE(pointers.isInline());  // NOLINT(bugprone-use-after-move)
+    }
+    SECTION("Copies are independent") {
+        SmallVector<int, 2> values = {1, 2, 3};
+        SmallVector<int, 2> copy = values;
+        copy[0] = 10;
+        REQUIRE(values[0] == 1);
+        REQUIRE(copy.size() == 3);
+        values = copy;
+        REQUIRE(values == copy);
+    }
+}
+
+TEST_CASE("SmallVector functional helpers", "[SmallVector]") {
+    SmallVector<int, 8> values = {1, 2, 3, 4, 5};
+
+    REQUIRE(values.map([](int value) { return value * 2; }) == SmallVector<int, 8>({2, 4, 6, 8, 10}));
+    REQUIRE(values.mapIndexed([](size_t i, int value) { return static_cast<int>(i) + value; })[4] == 9);
+    REQUIRE(values.filter([](int value) { return value % 2 == 0; }) == SmallVector<int, 8>({2, 4}));
+    REQUIRE(values.filterIndexed([](size_t i, int) { return i < 2; }).size() == 2);
+    REQUIRE(*values.find([](int value) { return value > 3; }) == 4);
+    REQUIRE(values.find([](int value) { return value > 5; }) == nullptr);
+    REQUIRE(values.first() == 1);
+    REQUIRE(values.first([](int value) { return value > 1; }) == 2);
+    REQUIRE(values.firstOrNull([](int value) { return value > 5; }) == nullptr);
+    REQUIRE(SmallVector<int, 1>().firstOrNull() == nullptr);
+
+    int sum = 0;
+    values.forEach([&sum](int value) { sum += value; });
+    values.forEachIndexed([&sum](size_t i, int&) { sum += static_cast<int>(i); });
+    REQUIRE(sum == 15 + 10);
+}
@@ -0,0 +1,51 @@
+#include <catch2/catch.hpp>
+
+#include <System/String.hpp>
+#include <System/StringBuilder.hpp>
+#include <System/StringView.hpp>
+
+#include <cstring>
+
+using namespace engine;
+
+TEST_CASE("StringBuilder", "[StringBuilder]") {
+    InlineString<16> builder;
+
+    SECTION("Starts empty and null-terminated") {
+        REQUIRE(builder.isEmpty());
+        REQUIRE(builder.getDataSize() == 0);
+        REQUIRE(builder.getCapacity() == 15);
+        REQUIRE(std::strlen(builder.getData()) == 0);
+    }
+    SECTION("Appends strings and characters") {
+        builder.append("tex").append('_').append(u8"\U00006C34");
+        REQUIRE(builder.getView() == StringView(u8"tex_\U00006C34"));
+        REQUIRE(builder.toString() == u8"tex_\U00006C34");
+        REQUIRE(builder.isInline());
+    }
+    SECTION("Formats the arguments in place") {
+        builder.format("tex_diffuse{}", 12).format("/{}", "a");
+        REQUIRE(builder.getView() == StringView("tex_diffuse12/a"));
+        REQUIRE(std::strlen(builder.getData()) == builder.getDataSize());
+        REQUIRE(builder.isInline());
+    }
+    SECTION("Moves to the heap when the content doesn't fit") {
+        builder.append("0123456789");
+        builder.format("{}{}", "abcdefghij", 42);
+        REQUIRE_FALSE(builder.isInline());
+        REQUIRE(builder.getView() == StringView("0123456789abcdefghij42"));
+        for (int i = 0; i < 100; i++) {
+            builder.append('x');
+        }
+        REQUIRE(builder.getDataSize() == 122);
+        REQUIRE(std::strlen(builder.getData()) == 122);
+    }
+    SECTION("Keeps the capacity when cleared or truncated") {
+        builder.append("0123456789");
+        builder.truncate(4);
+        REQUIRE(builder.getView() == StringView("0123"));
+        builder.clear();
+        REQUIRE(builder.isEmpty());
+        REQUIRE(builder.getCapacity() == 15);
+    }
+}
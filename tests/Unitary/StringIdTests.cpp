@@ -0,0 +1,59 @@
+#include <catch2/catch.hpp>
+
+#include <System/String.hpp>
+#include <System/StringId.hpp>
+#include <System/StringView.hpp>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace engine;
+
+TEST_CASE("StringId", "[StringId]") {
+    SECTION("The literals are hashed at compile time") {
+        constexpr StringId id("cameraFront");
+        static_assert(id.isValid());
+        static_assert(id == StringId("cameraFront"));
+        static_assert(id != StringId("cameraFront2"));
+        REQUIRE_FALSE(StringId().isValid());
+    }
+    SECTION("The literals and the runtime strings have the same identifier") {
+        REQUIRE(StringId("textures/grass.png") == StringId(String("textures/grass.png")));
+        REQUIRE(StringId("textures/grass.png") == StringId(StringView("textures/grass.png")));
+        REQUIRE(StringId(String(u8"\U00006C34")) == StringId("\xE6\xB0\xB4"));
+        REQUIRE(StringId("") == StringId(String()));
+    }
+    SECTION("The runtime strings are interned") {
+        StringId id(String("StringIdTests_interned"));
+        REQUIRE(id.getString() == StringView("StringIdTests_interned"));
+        REQUIRE(StringId("StringIdTests_interned").getString() == StringView("StringIdTests_interned"));
+        REQUIRE(StringId("StringIdTests_unknown").getString().isEmpty());
+    }
+    SECTION("The identifiers are written as their string or their hash") {
+        std::ostringstream stream;
+        stream << StringId(String("StringIdTests_written"));
+        REQUIRE(stream.str() == "StringIdTests_written");
+
+        stream.str("");
+        stream << StringId("StringIdTests_hashed");
+        REQUIRE(stream.str().front() == '#');
+    }
+    SECTION("The strings can be interned from several threads") {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([]() {
+                for (int i = 0; i < 1000; i++) {
+                    StringId(String(std::to_string(i % 100) + "_StringIdTests_thread"));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (int i = 0; i < 100; i++) {
+            String name(std::to_string(i) + "_StringIdTests_thread");
+            REQUIRE(StringId(name).getString() == name);
+        }
+    }
+}
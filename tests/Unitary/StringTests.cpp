@@ -42,6 +42,20 @@ TEST_CASE("String from other encodings", "[String]") {
         REQUIRE(a == b);
         REQUIRE(b == c);
     }
+    SECTION("from invalid UTF-16 and UTF-32 strings") {
+        std::u16string utf16 = u"ab\U0001F600";
+        utf16 += char16(0xDC00);
+        utf16 += u"cd";
+        std::u32string utf32 = U"ab\U0001F600";
+        utf32 += char32(0x110000);
+        utf32 += U"cd";
+        REQUIRE(String(utf16) == u"ab\U0001F600");
+        REQUIRE(String(utf16.data()) == u"ab\U0001F600");
+        REQUIRE(String::FromUtf16(utf16.data(), utf16.data() + utf16.size()) == u"ab\U0001F600");
+        REQUIRE(String(utf32) == U"ab\U0001F600");
+        REQUIRE(String(utf32.data()) == U"ab\U0001F600");
+        REQUIRE(String::FromUtf32(utf32.data(), utf32.data() + utf32.size()).getSize() == 3);
+    }
 }
 
 TEST_CASE("String to other encodings", "[String]") {
@@ -317,3 +331,81 @@ TEST_CASE("String::operator+=", "[String]") {
         REQUIRE(string == u8"\U0001F600\U0001F603\U0001F604\U0001F601\U0001F606");
     }
 }
+
+TEST_CASE("String::operator<=>", "[String]") {
+    SECTION("must order the strings lexicographically") {
+        REQUIRE(String("a.obj") < String("b.obj"));
+        REQUIRE(String("b.obj") > String("a.obj"));
+        REQUIRE(String("abc") < String("abd"));
+        REQUIRE(String("ab") < String("abc"));
+        REQUIRE((String("abc") <=> String("abc")) == std::strong_ordering::equal);
+    }
+    SECTION("must order the UTF-8 strings by code point") {
+        REQUIRE(String(u8"\U00006C34") < String(u8"\U00006C35"));   // "水" < "氵"
+        REQUIRE(String("z") < String(u8"\U000000E9"));              // "z" < "é"
+        REQUIRE(String(u8"\U000000E9") < String(u8"\U0001F600"));  // "é" < "😀"
+    }
+    SECTION("must not consider equal a string and its prefix") {
+        REQUIRE(String("abc") == String("abc"));
+        REQUIRE_FALSE(String("ab") == String("abc"));
+        REQUIRE_FALSE(String("abc") == String("ab"));
+        REQUIRE_FALSE(String("abc") == StringView("abcd"));
+    }
+}
+
+TEST_CASE("String code point index", "[String]") {
+    // Long enough to need several breadcrumbs
+    std::u32string expected;
+    for (int i = 0; i < 300; i++) {
+        expected += (i % 3 == 0) ? U'\U00006C34' : (i % 7 == 0) ? U'\U0001F600' : static_cast<char32_t>('a' + i % 26);
+    }
+    String string(expected.c_str());
+
+    auto requireEqual = [](const String& string, const std::u32string& expected) {
+        REQUIRE(string.getSize() == expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            REQUIRE(string[i] == utf::CodeUnit<utf::UTF_8>(static_cast<char32>(expected[i])));
+        }
+    };
+
+    SECTION("must keep the size and the ASCII flag") {
+        REQUIRE(string.getSize() == 300);
+        REQUIRE_FALSE(string.isAscii());
+        REQUIRE(String("ASCII only").isAscii());
+        REQUIRE(String().isAscii());
+
+        String ascii("abc");
+        ascii += U'\U00006C34';
+        REQUIRE(ascii.getSize() == 4);
+        REQUIRE_FALSE(ascii.isAscii());
+        ascii.erase(3, 1);
+        REQUIRE(ascii.isAscii());
+    }
+    SECTION("must access any code point of long strings") {
+        requireEqual(string, expected);
+        REQUIRE(string.subString(130, 100) == String(expected.substr(130, 100).c_str()));
+    }
+    SECTION("must find the code point positions of long strings") {
+        REQUIRE(string.find(String(expected.substr(200, 5).c_str())) == 200);
+        REQUIRE(string.find(String(expected.substr(200, 5).c_str()), 201) == String::sInvalidPos);
+        REQUIRE(string.findFirstOf(u8"\U0001F600", 100) == 112);
+        REQUIRE(string.findLastOf(u8"\U0001F600", 200) == 196);
+    }
+    SECTION("must keep the index updated after the modifications") {
+        string.erase(10, 120);
+        expected.erase(10, 120);
+        requireEqual(string, expected);
+
+        string.insert(50, u8"\U0001F603 inserted \U0001F604");
+        expected.insert(50, U"\U0001F603 inserted \U0001F604");
+        requireEqual(string, expected);
+
+        string.replace(70, 20, "replaced");
+        expected.replace(70, 20, U"replaced");
+        requireEqual(string, expected);
+
+        string += u8"\U0001F601 appended";
+        expected += U"\U0001F601 appended";
+        requireEqual(string, expected);
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <System/String.hpp>
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+
+/**
+ * @brief Directory created inside the system temporary directory, it is
+ *        removed with all its content when destroyed
+ */
+class TemporaryDirectory {
+public:
+    explicit TemporaryDirectory(const std::string& prefix) {
+        std::random_device random;
+        std::filesystem::path base = std::filesystem::temp_directory_path();
+        do {
+            m_path = base / (prefix + "_" + std::to_string(random()));
+        } while (!std::filesystem::create_directory(m_path));
+    }
+
+    ~TemporaryDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(m_path, error);
+    }
+
+    TemporaryDirectory(const TemporaryDirectory&) = delete;
+    TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+    engine::String getPath() const {
+        return engine::String(m_path.u8string());
+    }
+
+    engine::String getPath(const char* filename) const {
+        return engine::String((m_path / filename).u8string());
+    }
+
+    /**
+     * @brief Create a subdirectory
+     *
+     * @return The path of the subdirectory
+     */
+    engine::String createDirectory(const char* name) const {
+        std::filesystem::create_directory(m_path / name);
+        return getPath(name);
+    }
+
+private:
+    std::filesystem::path m_path;
+};
@@ -2,6 +2,9 @@
 
 #include <Util/UTF.hpp>
 
+#include <algorithm>
+#include <string>
+
 using namespace engine;
 
 TEST_CASE("Calling utf::GetEncodingSize", "[UTF]") {
@@ -414,3 +417,90 @@ TEST_CASE("Calling utf::IsValid", "[UTF]") {
         REQUIRE(utf::IsValid<utf::UTF_16>(smiley16.begin(), smiley16.end()) == false);
     }
 }
+
+namespace {
+
+const utf::InstructionSet sInstructionSets[] = {utf::InstructionSet::SCALAR, utf::InstructionSet::SSE4,
+                                                utf::InstructionSet::AVX2, utf::InstructionSet::NEON};
+
+// Mixed script text with runs of ASCII, two, three and four byte characters
+std::basic_string<char32> MakeMixedText(size_t count) {
+    const std::basic_string<char32> pattern = U"Hello world, \u041F\u0440\u0438\u0432\u0435\u0442 "
+                                              U"\u4F60\u597D\u4E16\u754C \U0001F600 the quick brown fox \u00F1";
+    std::basic_string<char32> text;
+    while (text.size() < count) {
+        text += pattern;
+    }
+    text.resize(count);
+    return text;
+}
+
+}  // namespace
+
+TEST_CASE("Calling the utf SIMD conversions", "[UTF]") {
+    utf::InstructionSet defaultInstructionSet = utf::GetInstructionSet();
+    REQUIRE(utf::IsInstructionSetSupported(utf::InstructionSet::SCALAR));
+
+    for (utf::InstructionSet instructionSet : sInstructionSets) {
+        if (!utf::SetInstructionSet(instructionSet)) {
+            REQUIRE_FALSE(utf::IsInstructionSetSupported(instructionSet));
+            continue;
+        }
+        REQUIRE(utf::GetInstructionSet() == instructionSet);
+
+        // Lengths around the sizes of the SIMD blocks
+        for (size_t count : {0, 1, 15, 16, 17, 31, 32, 33, 64, 100, 1000}) {
+            std::basic_string<char32> text32 = MakeMixedText(count);
+            std::basic_string<char> text8;
+            std::basic_string<char16> text16;
+            utf::UtfToUtf<utf::UTF_32, utf::UTF_8>(text32.begin(), text32.end(), &text8);
+            utf::UtfToUtf<utf::UTF_32, utf::UTF_16>(text32.begin(), text32.end(), &text16);
+
+            const char* begin8 = text8.data();
+            const char* end8 = begin8 + text8.size();
+            REQUIRE(utf::IsValidUtf8(begin8, end8));
+            REQUIRE(utf::FindNonAscii(begin8, end8) == begin8 + std::min<size_t>(text8.size(), 13));
+
+            std::basic_string<char16> output16;
+            std::basic_string<char32> output32;
+            REQUIRE(utf::Utf8ToUtf16(begin8, end8, &output16));
+            REQUIRE(utf::Utf8ToUtf32(begin8, end8, &output32));
+            REQUIRE(output16 == text16);
+            REQUIRE(output32 == text32);
+
+            std::basic_string<char> output8 = "prefix";
+            REQUIRE(utf::Utf16ToUtf8(text16.data(), text16.data() + text16.size(), &output8));
+            REQUIRE(output8 == "prefix" + text8);
+            output8.clear();
+            REQUIRE(utf::Utf32ToUtf8(text32.data(), text32.data() + text32.size(), &output8));
+            REQUIRE(output8 == text8);
+        }
+
+        // Invalid sequences at every position of the SIMD blocks
+        std::basic_string<char> valid(70, 'a');
+        const char* invalidSequences[] = {"\xFF",         "\x80",         "\xC3",         "\xC0\x80",
+                                          "\xE0\x80\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xF0\x9F\x98"};
+        for (const char* sequence : invalidSequences) {
+            for (size_t position = 0; position <= valid.size(); position++) {
+                std::basic_string<char> text = valid;
+                text.insert(position, sequence);
+                REQUIRE_FALSE(utf::IsValidUtf8(text.data(), text.data() + text.size()));
+
+                std::basic_string<char16> output16 = u"unchanged";
+                REQUIRE_FALSE(utf::Utf8ToUtf16(text.data(), text.data() + text.size(), &output16));
+                REQUIRE(output16 == u"unchanged");
+            }
+        }
+
+        std::basic_string<char16> lowSurrogate = u"abc";
+        lowSurrogate += char16(0xDC00);
+        std::basic_string<char32> tooLarge = U"abc";
+        tooLarge += char32(0x110000);
+        std::basic_string<char> output8;
+        REQUIRE_FALSE(utf::Utf16ToUtf8(lowSurrogate.data(), lowSurrogate.data() + lowSurrogate.size(), &output8));
+        REQUIRE_FALSE(utf::Utf32ToUtf8(tooLarge.data(), tooLarge.data() + tooLarge.size(), &output8));
+        REQUIRE(output8.empty());
+    }
+
+    utf::SetInstructionSet(defaultInstructionSet);
+}